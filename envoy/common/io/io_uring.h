@@ -2,7 +2,10 @@
 
 #include <functional>
 
+#include "envoy/buffer/buffer.h"
+#include "envoy/common/optref.h"
 #include "envoy/common/pure.h"
+#include "envoy/event/file_event.h"
 #include "envoy/network/address.h"
 #include "envoy/thread_local/thread_local.h"
 
@@ -133,6 +136,20 @@ public:
    */
   virtual IoUringResult prepareClose(os_fd_t fd, Request* user_data) PURE;
 
+  /**
+   * Prepares a cancellation and puts it into the submission queue.
+   * Returns IoUringResult::Failed in case the submission queue is full already
+   * and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult prepareCancel(Request* cancelling_user_data, Request* user_data) PURE;
+
+  /**
+   * Prepares a shutdown system call and puts it into the submission queue.
+   * Returns IoUringResult::Failed in case the submission queue is full already
+   * and IoUringResult::Ok otherwise.
+   */
+  virtual IoUringResult prepareShutdown(os_fd_t fd, int how, Request* user_data) PURE;
+
   /**
    * Submits the entries in the submission queue to the kernel using the
    * `io_uring_enter()` system call.
@@ -166,6 +183,36 @@ public:
 using IoUringPtr = std::unique_ptr<IoUring>;
 class IoUringWorker;
 
+/**
+ * The status of IoUringSocket.
+ */
+enum class IoUringSocketStatus {
+  Initialized,
+  ReadEnabled,
+  ReadDisabled,
+  RemoteClosed,
+  Closed,
+};
+
+/**
+ * The data returned from the read request.
+ */
+struct ReadParam {
+  // The buffer which holds all the data read from the socket and not consumed yet.
+  Buffer::Instance& buf_;
+  // Once the buffer is drained, this is the result the read should return: 0 on the remote close,
+  // a negative errno on error and -EAGAIN if there is no more data for now.
+  int32_t result_;
+};
+
+/**
+ * The data returned from the write request.
+ */
+struct WriteParam {
+  // A negative errno if the socket hit an error on writing.
+  int32_t result_;
+};
+
 /**
  * Abstract for each socket.
  */
@@ -251,6 +298,79 @@ public:
    * @param type the request type of injected completion.
    */
   virtual void injectCompletion(Request::RequestType type) PURE;
+
+  /**
+   * Enable reading on the socket. The data read will be delivered by the file ready callback.
+   */
+  virtual void enableRead() PURE;
+
+  /**
+   * Disable reading on the socket. The data already read is kept until reading is enabled again.
+   */
+  virtual void disableRead() PURE;
+
+  /**
+   * Enable or disable the close event when the reading is disabled.
+   * @param enable whether the close event is enabled.
+   */
+  virtual void enableCloseEvent(bool enable) PURE;
+
+  /**
+   * Connect to the given address asynchronously. The result is reported by a write event.
+   * @param address the remote address.
+   */
+  virtual void connect(const Network::Address::InstanceConstSharedPtr& address) PURE;
+
+  /**
+   * Write data to the socket. The data accepted is drained from the given buffer and sent
+   * asynchronously. The socket only buffers a bounded amount of data which has not been written
+   * yet. Once it is full it accepts no more data, and raises a write event when it has room again.
+   * @param data the data to be written.
+   * @return the number of bytes accepted.
+   */
+  virtual uint64_t write(Buffer::Instance& data) PURE;
+
+  /**
+   * Write the slices to the socket. The data accepted is copied and sent asynchronously. Like the
+   * write of a buffer, this accepts no more data than the socket has room for.
+   * @param slices the slices to be written.
+   * @param num_slice the number of slices.
+   * @return the number of bytes accepted.
+   */
+  virtual uint64_t write(const Buffer::RawSlice* slices, uint64_t num_slice) PURE;
+
+  /**
+   * Shutdown the socket once all the pending data has been written.
+   * @param how is SHUT_RD, SHUT_WR or SHUT_RDWR.
+   */
+  virtual void shutdown(int how) PURE;
+
+  /**
+   * Close the socket. All the pending data is flushed before the fd is closed and the socket
+   * removes itself from the worker after the close completes.
+   */
+  virtual void close() PURE;
+
+  /**
+   * Return the read parameter of the read event being delivered, if any.
+   */
+  virtual OptRef<ReadParam> getReadParam() PURE;
+
+  /**
+   * Return the write parameter of the write event being delivered, if any.
+   */
+  virtual OptRef<WriteParam> getWriteParam() PURE;
+
+  /**
+   * Set the callback which is invoked with the events ready on the socket.
+   * @param cb the file ready callback.
+   */
+  virtual void setFileReadyCb(Event::FileReadyCb cb) PURE;
+
+  /**
+   * Return the status of the socket.
+   */
+  virtual IoUringSocketStatus getStatus() const PURE;
 };
 
 using IoUringSocketPtr = std::unique_ptr<IoUringSocket>;
@@ -266,6 +386,48 @@ public:
    * Return the current thread's dispatcher.
    */
   virtual Event::Dispatcher& dispatcher() PURE;
+
+  /**
+   * Add an accepted socket to the worker. Reading starts as soon as the socket is added.
+   * @param fd the accepted socket fd.
+   * @param cb the callback invoked with the events ready on the socket.
+   */
+  virtual IoUringSocket& addServerSocket(os_fd_t fd, Event::FileReadyCb cb) PURE;
+
+  /**
+   * Add a client socket to the worker. Reading starts once the socket is connected.
+   * @param fd the client socket fd.
+   * @param cb the callback invoked with the events ready on the socket.
+   */
+  virtual IoUringSocket& addClientSocket(os_fd_t fd, Event::FileReadyCb cb) PURE;
+
+  /**
+   * Return the number of sockets in the worker.
+   */
+  virtual uint32_t getNumOfSockets() const PURE;
+};
+
+/**
+ * Abstract factory for per-thread IoUringWorkers.
+ */
+class IoUringWorkerFactory {
+public:
+  virtual ~IoUringWorkerFactory() = default;
+
+  /**
+   * Returns the IoUringWorker of the current thread, if any.
+   */
+  virtual OptRef<IoUringWorker> getIoUringWorker() PURE;
+
+  /**
+   * Initializes the per-thread workers. Must be called on the main thread.
+   */
+  virtual void onWorkerThreadInitialized() PURE;
+
+  /**
+   * Returns true if the current thread has a registered IoUringWorker.
+   */
+  virtual bool currentThreadRegistered() PURE;
 };
 
 /**
@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <map>
+#include <string>
 
 #include "envoy/common/pure.h"
 
@@ -78,6 +79,17 @@ public:
    * @param factory factory function used to create filter instances.
    */
   virtual void applyFilterFactoryCb(FilterContext context, FilterFactoryCb& factory) PURE;
+
+  /**
+   * Same as applyFilterFactoryCb(), for a context that is built once when the filter chain is
+   * configured and shared by every stream the filter factory is applied to. This saves copying
+   * the filter names for every filter of every stream. The filters refer to the context, which
+   * must outlive them, e.g. by being owned by the filter chain configuration.
+   * @param context supplies additional contextual information of filter factory.
+   * @param factory factory function used to create filter instances.
+   */
+  virtual void applySharedFilterFactoryCb(const FilterContext& context,
+                                          FilterFactoryCb& factory) PURE;
 };
 
 /**
@@ -205,6 +205,12 @@ public:
    */
   virtual std::chrono::milliseconds fileFlushIntervalMsec() const PURE;
 
+  /**
+   * @return bool whether all access log files are flushed by a single shared thread, rather than
+   *         by a thread per file.
+   */
+  virtual bool fileFlushSharedThread() const PURE;
+
   /**
    * @return const std::string& the server's cluster.
    */
@@ -227,6 +227,32 @@ public:
   virtual bool addOrUpdateCluster(const envoy::config::cluster::v3::Cluster& cluster,
                                   const std::string& version_info) PURE;
 
+  /**
+   * Same as addOrUpdateCluster() above, for callers that already computed the hash of the cluster
+   * configuration, e.g. in parallel with configIngestionParallelFor().
+   *
+   * @param cluster supplies the cluster configuration.
+   * @param version_info supplies the xDS version of the cluster.
+   * @param cluster_hash supplies MessageUtil::hash() of the cluster configuration.
+   * @return true if the action results in an add/update of a cluster.
+   */
+  virtual bool addOrUpdateCluster(const envoy::config::cluster::v3::Cluster& cluster,
+                                  const std::string& version_info, uint64_t cluster_hash) PURE;
+
+  /**
+   * @return the number of threads, including the main thread, that the thread safe parts of large
+   *         CDS and EDS updates are spread over. 1 if they are processed on the main thread only.
+   */
+  virtual uint32_t configIngestionConcurrency() const PURE;
+
+  /**
+   * Calls fn(index) for every index in [0, count) on up to configIngestionConcurrency() threads and
+   * returns once all calls have completed. Must be called on the main thread. The calls may run
+   * concurrently, so fn must be thread safe and must not throw. Results are expected to be applied
+   * on the main thread afterwards.
+   */
+  virtual void configIngestionParallelFor(size_t count, const std::function<void(size_t)>& fn) PURE;
+
   /**
    * Set a callback that will be invoked when all primary clusters have been initialized.
    */
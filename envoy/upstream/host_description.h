@@ -1,10 +1,12 @@
 #pragma once
 
+#include <chrono>
 #include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "envoy/common/optref.h"
 #include "envoy/common/time.h"
 #include "envoy/config/core/v3/base.pb.h"
 #include "envoy/network/address.h"
@@ -16,6 +18,7 @@
 #include "envoy/upstream/resource_manager.h"
 
 #include "absl/strings/string_view.h"
+#include "xds/data/orca/v3/orca_load_report.pb.h"
 
 namespace Envoy {
 namespace Upstream {
@@ -84,6 +87,37 @@ public:
   virtual StatMapPtr latch() PURE;
 };
 
+/**
+ * Per host state owned by the load balancing policy of the host's cluster. It is shared by all
+ * workers and must be thread safe. Policies only override the notifications they need.
+ */
+class HostLbPolicyData {
+public:
+  virtual ~HostLbPolicyData() = default;
+
+  /**
+   * Called on a worker when an upstream request to the host is done.
+   * @param latency supplies the time from the first byte of the request being sent until the
+   *        response was complete, or until the request was reset or abandoned.
+   */
+  virtual void onUpstreamRequestComplete(std::chrono::microseconds) {}
+
+  /**
+   * Called on a worker when the host attached an ORCA load report to the response headers or
+   * trailers of an upstream request.
+   * @param report supplies the parsed load report.
+   */
+  virtual void onOrcaLoadReport(const xds::data::orca::v3::OrcaLoadReport&) {}
+
+  /**
+   * @return whether the policy consumes ORCA load reports. The load report headers of responses
+   *         are only looked up and parsed for the hosts of policies which do.
+   */
+  virtual bool consumesOrcaLoadReports() const { return false; }
+};
+
+using HostLbPolicyDataPtr = std::unique_ptr<HostLbPolicyData>;
+
 class ClusterInfo;
 
 /**
@@ -129,6 +163,11 @@ public:
    */
   virtual Outlier::DetectorHostMonitor& outlierDetector() const PURE;
 
+  /**
+   * @return the state kept for the host by its cluster's load balancing policy, if any.
+   */
+  virtual OptRef<HostLbPolicyData> lbPolicyData() const PURE;
+
   /**
    * @return the host's health checker monitor.
    */
@@ -282,6 +282,12 @@ public:
    */
   virtual void setOutlierDetector(Outlier::DetectorHostMonitorPtr&& outlier_detector) PURE;
 
+  /**
+   * Set the state kept for the host by its cluster's load balancing policy. This must be called
+   * at most once, on the main thread, before the host is used across threads.
+   */
+  virtual void setLbPolicyData(HostLbPolicyDataPtr&& lb_policy_data) PURE;
+
   /**
    * Set the timestamp of when the host has transitioned from unhealthy to healthy state via an
    * active health checking.
@@ -963,6 +969,17 @@ public:
    */
   virtual float peekaheadRatio() const PURE;
 
+  /**
+   * @return how many connections each thread establishes to every healthy host when the cluster
+   *         is added to it.
+   */
+  virtual uint32_t perUpstreamWarmConnections() const PURE;
+
+  /**
+   * @return whether the TCP connection pools are warmed instead of the HTTP connection pools.
+   */
+  virtual bool warmTcpConnectionPools() const PURE;
+
   /**
    * @return soft limit on size of the cluster's connections read and write buffers.
    */
@@ -1084,6 +1101,13 @@ public:
    */
   virtual OptRef<const envoy::config::core::v3::TypedExtensionConfig> upstreamConfig() const PURE;
 
+  /**
+   * @return uint64_t a hash of the configuration deciding how connections to the cluster's hosts
+   *         are made: its transport sockets, upstream bind config and upstream connection options.
+   *         Only computed for clusters with health checks that share their probes, 0 otherwise.
+   */
+  virtual uint64_t connectionConfigHash() const PURE;
+
   /**
    * @return Whether the cluster is currently in maintenance mode and should not be routed to.
    *         Different filters may handle this situation in different ways. The implementation
@@ -1,5 +1,7 @@
 #include "source/common/access_log/access_log_manager_impl.h"
 
+#include <algorithm>
+#include <atomic>
 #include <string>
 
 #include "envoy/common/exception.h"
@@ -13,6 +15,63 @@
 namespace Envoy {
 namespace AccessLog {
 
+AccessLogFlushThread::AccessLogFlushThread(Thread::ThreadFactory& thread_factory)
+    : thread_(thread_factory.createThread([this]() -> void { threadFunc(); },
+                                          Thread::Options{"AccessLogFlush"})) {}
+
+AccessLogFlushThread::~AccessLogFlushThread() {
+  {
+    Thread::LockGuard lock(lock_);
+    exit_ = true;
+    flush_event_.notifyOne();
+  }
+  thread_->join();
+}
+
+void AccessLogFlushThread::requestFlush(AccessLogFileImpl& file) {
+  Thread::LockGuard lock(lock_);
+  if (std::find(pending_files_.begin(), pending_files_.end(), &file) == pending_files_.end()) {
+    pending_files_.push_back(&file);
+    flush_event_.notifyOne();
+  }
+}
+
+void AccessLogFlushThread::removeFile(AccessLogFileImpl& file) {
+  Thread::LockGuard lock(lock_);
+  pending_files_.erase(std::remove(pending_files_.begin(), pending_files_.end(), &file),
+                       pending_files_.end());
+  while (flushing_file_ == &file) {
+    flush_done_.wait(lock_);
+  }
+}
+
+void AccessLogFlushThread::threadFunc() {
+  while (true) {
+    AccessLogFileImpl* file;
+    {
+      Thread::LockGuard lock(lock_);
+      while (pending_files_.empty() && !exit_) {
+        flush_event_.wait(lock_);
+      }
+      if (exit_) {
+        return;
+      }
+      file = pending_files_.front();
+      pending_files_.erase(pending_files_.begin());
+      // Files are only destroyed after removing themselves, which waits for this flush to finish.
+      flushing_file_ = file;
+    }
+
+    file->flushShards();
+
+    {
+      Thread::LockGuard lock(lock_);
+      flushing_file_ = nullptr;
+      flush_done_.notifyAll();
+    }
+  }
+}
+
 AccessLogManagerImpl::~AccessLogManagerImpl() {
   for (auto& [log_key, log_file_ptr] : access_logs_) {
     ENVOY_LOG(debug, "destroying access logger {}", log_key);
@@ -34,23 +93,31 @@ AccessLogManagerImpl::createAccessLog(const Filesystem::FilePathAndType& file_in
   if (access_logs_.count(file_name)) {
     return access_logs_[file_name];
   }
-  access_logs_[file_name] =
-      std::make_shared<AccessLogFileImpl>(std::move(file), dispatcher_, lock_, file_stats_,
-                                          file_flush_interval_msec_, api_.threadFactory());
+  if (file_flush_shared_thread_ && flush_thread_ == nullptr) {
+    flush_thread_ = std::make_shared<AccessLogFlushThread>(api_.threadFactory());
+  }
+  access_logs_[file_name] = std::make_shared<AccessLogFileImpl>(
+      std::move(file), dispatcher_, lock_, file_stats_, file_flush_interval_msec_,
+      api_.threadFactory(), flush_thread_);
   return access_logs_[file_name];
 }
 
 AccessLogFileImpl::AccessLogFileImpl(Filesystem::FilePtr&& file, Event::Dispatcher& dispatcher,
                                      Thread::BasicLockable& lock, AccessLogFileStats& stats,
                                      std::chrono::milliseconds flush_interval_msec,
-                                     Thread::ThreadFactory& thread_factory)
+                                     Thread::ThreadFactory& thread_factory,
+                                     AccessLogFlushThreadSharedPtr shared_flush_thread)
     : file_(std::move(file)), file_lock_(lock),
       flush_timer_(dispatcher.createTimer([this]() -> void {
         stats_.flushed_by_timer_.inc();
-        flush_event_.notifyOne();
+        requestFlush();
         flush_timer_->enableTimer(flush_interval_msec_);
       })),
-      thread_factory_(thread_factory), flush_interval_msec_(flush_interval_msec), stats_(stats) {
+      thread_factory_(thread_factory), flush_interval_msec_(flush_interval_msec), stats_(stats),
+      shared_flush_thread_(std::move(shared_flush_thread)) {
+  if (shared_flush_thread_ != nullptr) {
+    write_shards_ = std::make_unique<std::array<WriteShard, NUM_WRITE_SHARDS>>();
+  }
   flush_timer_->enableTimer(flush_interval_msec_);
   auto open_result = open();
   if (!open_result.return_value_) {
@@ -75,10 +142,25 @@ Api::IoCallBoolResult AccessLogFileImpl::open() {
 void AccessLogFileImpl::reopen() {
   Thread::LockGuard lock(write_lock_);
   reopen_file_ = true;
-  flush_event_.notifyOne();
+  requestFlush();
+}
+
+void AccessLogFileImpl::requestFlush() {
+  if (shared_flush_thread_ != nullptr) {
+    shared_flush_thread_->requestFlush(*this);
+  } else {
+    flush_event_.notifyOne();
+  }
 }
 
 AccessLogFileImpl::~AccessLogFileImpl() {
+  if (shared_flush_thread_ != nullptr) {
+    // Once removed, the shared thread no longer flushes this file, and any data left in the write
+    // shards is flushed below.
+    shared_flush_thread_->removeFile(*this);
+    collectShards();
+  }
+
   {
     Thread::LockGuard lock(write_lock_);
     flush_thread_exit_ = true;
@@ -94,6 +176,9 @@ AccessLogFileImpl::~AccessLogFileImpl() {
     if (flush_buffer_.length() > 0) {
       doWrite(flush_buffer_);
     }
+    if (about_to_write_buffer_.length() > 0) {
+      doWrite(about_to_write_buffer_);
+    }
     const Api::IoCallBoolResult result = file_->close();
     ASSERT(result.return_value_, fmt::format("unable to close file '{}': {}", file_->path(),
                                              result.err_->getErrorDetails()));
@@ -168,24 +253,73 @@ void AccessLogFileImpl::flushThreadFunc() {
     }
 
     if (do_reopen) {
-      if (file_->isOpen()) {
-        const Api::IoCallBoolResult result = file_->close();
-        ASSERT(result.return_value_, fmt::format("unable to close file '{}': {}", file_->path(),
-                                                 result.err_->getErrorDetails()));
-      }
-      const Api::IoCallBoolResult open_result = open();
-      if (!open_result.return_value_) {
-        stats_.reopen_failed_.inc();
-      } else {
-        do_reopen = false;
-      }
+      do_reopen = !reopenFile();
+    }
+    // doWrite no matter file isOpen, if not, we can drain buffer
+    doWrite(about_to_write_buffer_);
+  }
+}
+
+bool AccessLogFileImpl::reopenFile() {
+  if (file_->isOpen()) {
+    const Api::IoCallBoolResult result = file_->close();
+    ASSERT(result.return_value_, fmt::format("unable to close file '{}': {}", file_->path(),
+                                             result.err_->getErrorDetails()));
+  }
+  const Api::IoCallBoolResult open_result = open();
+  if (!open_result.return_value_) {
+    stats_.reopen_failed_.inc();
+    return false;
+  }
+  return true;
+}
+
+void AccessLogFileImpl::flushShards() {
+  bool do_reopen;
+  {
+    Thread::LockGuard write_lock(write_lock_);
+    do_reopen = reopen_file_;
+    reopen_file_ = false;
+  }
+
+  bool reopen_failed = false;
+  {
+    Thread::LockGuard flush_lock(flush_lock_);
+    if (do_reopen) {
+      reopen_failed = !reopenFile();
     }
+    collectShards();
     // doWrite no matter file isOpen, if not, we can drain buffer
     doWrite(about_to_write_buffer_);
   }
+
+  if (reopen_failed) {
+    // Retry on the next flush of this file, rather than in a tight loop. The flush timer is
+    // re-armed on every tick and requests a flush whether or not anything was written, so the
+    // reopen is retried at least once per flush interval even if the file stays idle.
+    Thread::LockGuard write_lock(write_lock_);
+    reopen_file_ = true;
+  }
+}
+
+void AccessLogFileImpl::collectShards() {
+  for (WriteShard& shard : *write_shards_) {
+    Thread::LockGuard lock(shard.lock_);
+    about_to_write_buffer_.move(shard.buffer_);
+  }
 }
 
 void AccessLogFileImpl::flush() {
+  if (shared_flush_thread_ != nullptr) {
+    // Holding flush_lock_ waits for a flush in progress on the shared thread to finish.
+    Thread::LockGuard flush_lock(flush_lock_);
+    collectShards();
+    if (about_to_write_buffer_.length() > 0) {
+      doWrite(about_to_write_buffer_);
+    }
+    return;
+  }
+
   std::unique_lock<Thread::BasicLockable> flush_buffer_lock;
 
   {
@@ -210,6 +344,11 @@ void AccessLogFileImpl::flush() {
 }
 
 void AccessLogFileImpl::write(absl::string_view data) {
+  if (shared_flush_thread_ != nullptr) {
+    writeToShard(data);
+    return;
+  }
+
   Thread::LockGuard lock(write_lock_);
 
   if (flush_thread_ == nullptr) {
@@ -224,6 +363,35 @@ void AccessLogFileImpl::write(absl::string_view data) {
   }
 }
 
+void AccessLogFileImpl::writeToShard(absl::string_view data) {
+  // Threads are assigned a shard the first time they write to any file.
+  static std::atomic<uint32_t> next_shard_index{0};
+  static thread_local const uint32_t shard_index = next_shard_index++ % NUM_WRITE_SHARDS;
+  WriteShard& shard = (*write_shards_)[shard_index];
+
+  bool request_flush;
+  {
+    Thread::LockGuard lock(shard.lock_);
+    const uint64_t length = shard.buffer_.length();
+    if (length + data.size() > MAX_WRITE_SHARD_SIZE) {
+      stats_.write_dropped_.inc();
+      return;
+    }
+    if (length > MIN_FLUSH_SIZE) {
+      // A flush of this shard was requested but has not happened yet.
+      stats_.write_backlogged_.inc();
+    }
+    stats_.write_buffered_.inc();
+    stats_.write_total_buffered_.add(data.length());
+    shard.buffer_.add(data.data(), data.size());
+    request_flush = length <= MIN_FLUSH_SIZE && shard.buffer_.length() > MIN_FLUSH_SIZE;
+  }
+
+  if (request_flush) {
+    shared_flush_thread_->requestFlush(*this);
+  }
+}
+
 void AccessLogFileImpl::createFlushStructures() {
   flush_thread_ = thread_factory_.createThread([this]() -> void { flushThreadFunc(); },
                                                Thread::Options{"AccessLogFlush"});
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <array>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "envoy/access_log/access_log.h"
 #include "envoy/api/api.h"
@@ -21,7 +24,9 @@ namespace Envoy {
   COUNTER(flushed_by_timer)                                                                        \
   COUNTER(reopen_failed)                                                                           \
   COUNTER(write_buffered)                                                                          \
+  COUNTER(write_backlogged)                                                                        \
   COUNTER(write_completed)                                                                         \
+  COUNTER(write_dropped)                                                                           \
   COUNTER(write_failed)                                                                            \
   GAUGE(write_total_buffered, Accumulate)
 
@@ -31,12 +36,50 @@ struct AccessLogFileStats {
 
 namespace AccessLog {
 
+class AccessLogFileImpl;
+
+/**
+ * A thread that flushes the access log files of an AccessLogManagerImpl, shared by all of its
+ * files when the manager is configured to use one flush thread rather than a thread per file.
+ * Flushes requested for a file while it is already queued are coalesced into a single flush.
+ */
+class AccessLogFlushThread {
+public:
+  explicit AccessLogFlushThread(Thread::ThreadFactory& thread_factory);
+  ~AccessLogFlushThread();
+
+  /**
+   * Queues a file to be flushed. Does nothing if the file is already queued.
+   */
+  void requestFlush(AccessLogFileImpl& file);
+
+  /**
+   * Removes a file from the queue, waiting for a flush of the file that is in progress to finish.
+   * The file will not be flushed by this thread once this returns.
+   */
+  void removeFile(AccessLogFileImpl& file);
+
+private:
+  void threadFunc();
+
+  Thread::MutexBasicLockable lock_;
+  Thread::CondVar flush_event_;
+  Thread::CondVar flush_done_;
+  std::vector<AccessLogFileImpl*> pending_files_ ABSL_GUARDED_BY(lock_);
+  AccessLogFileImpl* flushing_file_ ABSL_GUARDED_BY(lock_){nullptr};
+  bool exit_ ABSL_GUARDED_BY(lock_){false};
+  Thread::ThreadPtr thread_;
+};
+
+using AccessLogFlushThreadSharedPtr = std::shared_ptr<AccessLogFlushThread>;
+
 class AccessLogManagerImpl : public AccessLogManager, Logger::Loggable<Logger::Id::main> {
 public:
-  AccessLogManagerImpl(std::chrono::milliseconds file_flush_interval_msec, Api::Api& api,
-                       Event::Dispatcher& dispatcher, Thread::BasicLockable& lock,
-                       Stats::Store& stats_store)
-      : file_flush_interval_msec_(file_flush_interval_msec), api_(api), dispatcher_(dispatcher),
+  AccessLogManagerImpl(std::chrono::milliseconds file_flush_interval_msec,
+                       bool file_flush_shared_thread, Api::Api& api, Event::Dispatcher& dispatcher,
+                       Thread::BasicLockable& lock, Stats::Store& stats_store)
+      : file_flush_interval_msec_(file_flush_interval_msec),
+        file_flush_shared_thread_(file_flush_shared_thread), api_(api), dispatcher_(dispatcher),
         lock_(lock), file_stats_{
                          ACCESS_LOG_FILE_STATS(POOL_COUNTER_PREFIX(stats_store, "filesystem."),
                                                POOL_GAUGE_PREFIX(stats_store, "filesystem."))} {}
@@ -48,26 +91,34 @@ public:
 
 private:
   const std::chrono::milliseconds file_flush_interval_msec_;
+  const bool file_flush_shared_thread_;
   Api::Api& api_;
   Event::Dispatcher& dispatcher_;
   Thread::BasicLockable& lock_;
   AccessLogFileStats file_stats_;
   absl::node_hash_map<std::string, AccessLogFileSharedPtr> access_logs_;
+  // Created with the first file when file_flush_shared_thread_ is set. Files keep a reference to
+  // it, so that it outlives any file that is still in use when the manager is destroyed.
+  AccessLogFlushThreadSharedPtr flush_thread_;
 };
 
 /**
  * This is a file implementation geared for writing out access logs. It turn out that in certain
  * cases even if a standard file is opened with O_NONBLOCK, the kernel can still block when writing.
- * This implementation uses a flush thread per file, with the idea there aren't that many
- * files. If this turns out to be a good implementation we can potentially have a single flush
- * thread that flushes all files, but we will start with this.
+ * By default this implementation uses a flush thread per file, with the idea there aren't that
+ * many files. Alternatively all files of a manager can be flushed by a single shared
+ * AccessLogFlushThread. In that mode writes go to buffers sharded by writing thread rather than
+ * to a single buffer, so that workers logging to the same file do not contend on one lock. The
+ * shards are written one after the other, so lines written by different threads are not written
+ * in time order.
  */
 class AccessLogFileImpl : public AccessLogFile {
 public:
   AccessLogFileImpl(Filesystem::FilePtr&& file, Event::Dispatcher& dispatcher,
                     Thread::BasicLockable& lock, AccessLogFileStats& stats,
                     std::chrono::milliseconds flush_interval_msec,
-                    Thread::ThreadFactory& thread_factory);
+                    Thread::ThreadFactory& thread_factory,
+                    AccessLogFlushThreadSharedPtr shared_flush_thread);
   ~AccessLogFileImpl() override;
 
   // AccessLog::AccessLogFile
@@ -81,9 +132,28 @@ public:
   void reopen() override;
   void flush() override;
 
+  /**
+   * Flushes the write shards, and reopens the file first if requested. Called by the shared flush
+   * thread.
+   */
+  void flushShards();
+
 private:
+  // A buffer of writes made by the threads that map to it. Aligned so that shards written by
+  // different threads do not share cache lines.
+  struct alignas(64) WriteShard {
+    Thread::MutexBasicLockable lock_;
+    Buffer::OwnedImpl buffer_ ABSL_GUARDED_BY(lock_);
+  };
+
   void doWrite(Buffer::Instance& buffer);
   void flushThreadFunc();
+  void requestFlush();
+  void writeToShard(absl::string_view data);
+  // Moves the contents of all write shards to about_to_write_buffer_.
+  void collectShards();
+  // Closes and reopens the file. Returns false if it could not be opened.
+  bool reopenFile();
   Api::IoCallBoolResult open();
   void createFlushStructures();
 
@@ -92,6 +162,12 @@ private:
 
   // Minimum size before the flush thread will be told to flush.
   static const uint64_t MIN_FLUSH_SIZE = 1024 * 64;
+  // Number of write shards when using a shared flush thread. Threads are assigned to shards round
+  // robin, so up to this many threads write to the file without contending.
+  static const uint32_t NUM_WRITE_SHARDS = 16;
+  // Maximum size of a write shard. Writes that would grow a shard past this size are dropped, so
+  // that a file that cannot be written fast enough does not buffer without bound.
+  static const uint64_t MAX_WRITE_SHARD_SIZE = 1024 * 1024;
 
   Filesystem::FilePtr file_;
 
@@ -99,6 +175,8 @@ private:
   //    1) write_lock_
   //    2) flush_lock_
   //    3) file_lock_
+  // The locks of the write shards are acquired while holding flush_lock_ when collecting the
+  // shards, and are otherwise never held together with another lock.
   Thread::BasicLockable& file_lock_;      // This lock is used only by the flush thread when writing
                                           // to disk. This is used to make sure that file blocks do
                                           // not get interleaved by multiple processes writing to
@@ -134,6 +212,9 @@ private:
                                                         // matter if it reached the MIN_FLUSH_SIZE
                                                         // or not.
   AccessLogFileStats& stats_;
+  const AccessLogFlushThreadSharedPtr shared_flush_thread_;
+  // Only allocated when using a shared flush thread.
+  std::unique_ptr<std::array<WriteShard, NUM_WRITE_SHARDS>> write_shards_;
 };
 
 } // namespace AccessLog
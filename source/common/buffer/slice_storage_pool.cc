@@ -0,0 +1,208 @@
+#include "source/common/buffer/slice_storage_pool.h"
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+#include "source/common/common/macros.h"
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+// Bumped by releaseIdleMemory(). Each thread cache drains itself when it notices the change.
+std::atomic<uint64_t> release_epoch{0};
+
+uint64_t maxCachedBlocks(uint32_t size_class) {
+  return SliceStoragePool::MaxCachedBytesPerSizeClass /
+         ((size_class + 1) * SliceStoragePool::SizeClassGranularity);
+}
+
+// The cache of a single thread. Only the owning thread mutates the free lists. The counters are
+// atomics so that stats() can read them from any thread; since each has a single writer, plain
+// load/store pairs are used instead of read-modify-write operations.
+class ThreadCache {
+public:
+  ThreadCache() : epoch_(release_epoch.load(std::memory_order_relaxed)) {
+    for (uint32_t i = 0; i < SliceStoragePool::NumSizeClasses; i++) {
+      free_lists_[i].reserve(maxCachedBlocks(i));
+    }
+  }
+
+  ~ThreadCache() { drain(); }
+
+  uint8_t* allocate(uint32_t size_class) {
+    maybeDrain();
+    auto& free_list = free_lists_[size_class];
+    if (!free_list.empty()) {
+      uint8_t* mem = free_list.back();
+      free_list.pop_back();
+      increment(hits_, 1);
+      decrement(resident_bytes_, classSize(size_class));
+      return mem;
+    }
+    increment(misses_, 1);
+    return new uint8_t[classSize(size_class)];
+  }
+
+  void deallocate(uint8_t* mem, uint32_t size_class) {
+    maybeDrain();
+    auto& free_list = free_lists_[size_class];
+    if (free_list.size() < maxCachedBlocks(size_class)) {
+      free_list.push_back(mem);
+      increment(resident_bytes_, classSize(size_class));
+      return;
+    }
+    delete[] mem;
+  }
+
+  void drain() {
+    for (auto& free_list : free_lists_) {
+      for (uint8_t* mem : free_list) {
+        delete[] mem;
+      }
+      free_list.clear();
+    }
+    resident_bytes_.store(0, std::memory_order_relaxed);
+  }
+
+  void maybeDrain() {
+    const uint64_t epoch = release_epoch.load(std::memory_order_relaxed);
+    if (epoch != epoch_) {
+      epoch_ = epoch;
+      drain();
+    }
+  }
+
+  uint64_t hits() const { return hits_.load(std::memory_order_relaxed); }
+  uint64_t misses() const { return misses_.load(std::memory_order_relaxed); }
+  uint64_t residentBytes() const { return resident_bytes_.load(std::memory_order_relaxed); }
+
+private:
+  static uint64_t classSize(uint32_t size_class) {
+    return (size_class + 1) * SliceStoragePool::SizeClassGranularity;
+  }
+  static void increment(std::atomic<uint64_t>& counter, uint64_t value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+  }
+  static void decrement(std::atomic<uint64_t>& counter, uint64_t value) {
+    counter.store(counter.load(std::memory_order_relaxed) - value, std::memory_order_relaxed);
+  }
+
+  std::array<std::vector<uint8_t*>, SliceStoragePool::NumSizeClasses> free_lists_;
+  uint64_t epoch_;
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+  std::atomic<uint64_t> resident_bytes_{0};
+};
+
+// All live thread caches, plus the counters of caches whose threads have exited.
+struct Registry {
+  absl::Mutex mutex_;
+  absl::flat_hash_set<ThreadCache*> caches_ ABSL_GUARDED_BY(mutex_);
+  uint64_t retired_hits_ ABSL_GUARDED_BY(mutex_){0};
+  uint64_t retired_misses_ ABSL_GUARDED_BY(mutex_){0};
+};
+
+// Leaked so that it outlives thread_local destructors running during process exit.
+Registry& registry() { MUTABLE_CONSTRUCT_ON_FIRST_USE(Registry); }
+
+// The cache pointer and the destroyed flag are trivially destructible so they remain usable while
+// other thread_local objects (which may own slice storage) are being destroyed. The holder is what
+// actually tears the cache down at thread exit.
+thread_local ThreadCache* thread_cache = nullptr;
+thread_local bool thread_cache_destroyed = false;
+
+struct ThreadCacheHolder {
+  ~ThreadCacheHolder() {
+    if (thread_cache == nullptr) {
+      return;
+    }
+    {
+      Registry& reg = registry();
+      absl::MutexLock lock(&reg.mutex_);
+      reg.caches_.erase(thread_cache);
+      reg.retired_hits_ += thread_cache->hits();
+      reg.retired_misses_ += thread_cache->misses();
+    }
+    delete thread_cache;
+    thread_cache = nullptr;
+    thread_cache_destroyed = true;
+  }
+};
+
+thread_local ThreadCacheHolder thread_cache_holder;
+
+ThreadCache* threadCache() {
+  if (thread_cache != nullptr || thread_cache_destroyed) {
+    return thread_cache;
+  }
+  // Touch the holder so that its destructor is registered for this thread.
+  (void)thread_cache_holder;
+  thread_cache = new ThreadCache();
+  Registry& reg = registry();
+  absl::MutexLock lock(&reg.mutex_);
+  reg.caches_.insert(thread_cache);
+  return thread_cache;
+}
+
+// Returns the size class for a block size, or NumSizeClasses if the size is not pooled.
+uint32_t sizeClass(uint64_t size) {
+  if (size == 0 || size > SliceStoragePool::MaxSizeClassSize ||
+      size % SliceStoragePool::SizeClassGranularity != 0) {
+    return SliceStoragePool::NumSizeClasses;
+  }
+  return size / SliceStoragePool::SizeClassGranularity - 1;
+}
+
+} // namespace
+
+uint8_t* SliceStoragePool::allocate(uint64_t size) {
+  const uint32_t size_class = sizeClass(size);
+  if (size_class < NumSizeClasses) {
+    ThreadCache* cache = threadCache();
+    if (cache != nullptr) {
+      return cache->allocate(size_class);
+    }
+  }
+  return new uint8_t[size];
+}
+
+void SliceStoragePool::deallocate(uint8_t* mem, uint64_t size) {
+  const uint32_t size_class = sizeClass(size);
+  if (size_class < NumSizeClasses) {
+    ThreadCache* cache = threadCache();
+    if (cache != nullptr) {
+      cache->deallocate(mem, size_class);
+      return;
+    }
+  }
+  delete[] mem;
+}
+
+void SliceStoragePool::releaseIdleMemory() {
+  release_epoch.fetch_add(1, std::memory_order_relaxed);
+  if (thread_cache != nullptr) {
+    thread_cache->maybeDrain();
+  }
+}
+
+SliceStoragePool::Stats SliceStoragePool::stats() {
+  Stats stats;
+  Registry& reg = registry();
+  absl::MutexLock lock(&reg.mutex_);
+  stats.hits_ = reg.retired_hits_;
+  stats.misses_ = reg.retired_misses_;
+  for (const ThreadCache* cache : reg.caches_) {
+    stats.hits_ += cache->hits();
+    stats.misses_ += cache->misses();
+    stats.resident_bytes_ += cache->residentBytes();
+  }
+  return stats;
+}
+
+} // namespace Buffer
+} // namespace Envoy
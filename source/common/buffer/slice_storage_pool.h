@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Envoy {
+namespace Buffer {
+
+/**
+ * Per-thread free lists of slice backing memory, bucketed by size class.
+ *
+ * Slice storage is always a multiple of 4 KiB (see Slice::sliceSize()), so each size class is one
+ * multiple of the page size. Blocks released by a thread are cached on that thread's free list for
+ * the matching size class and handed back out on the next allocation of the same size, which keeps
+ * the allocator out of the hot read/write path. Sizes above the largest size class are passed
+ * straight through to the allocator.
+ *
+ * Memory may be freed on a different thread than it was allocated on; it simply ends up cached on
+ * the freeing thread. The number of bytes each thread may cache is bounded per size class.
+ */
+class SliceStoragePool {
+public:
+  static constexpr uint64_t SizeClassGranularity = 4096;
+  static constexpr uint32_t NumSizeClasses = 8;
+  static constexpr uint64_t MaxSizeClassSize = NumSizeClasses * SizeClassGranularity;
+  // Upper bound on the bytes cached by a single thread for one size class.
+  static constexpr uint64_t MaxCachedBytesPerSizeClass = 256 * 1024;
+
+  struct Stats {
+    // Allocations served from a free list.
+    uint64_t hits_{};
+    // Allocations of a pooled size class that had to go to the allocator.
+    uint64_t misses_{};
+    // Bytes currently held on free lists across all threads.
+    uint64_t resident_bytes_{};
+  };
+
+  /**
+   * Allocate a block of slice storage.
+   * @param size the size of the block in bytes.
+   * @return a block of at least size bytes. Never nullptr, even for a zero size.
+   */
+  static uint8_t* allocate(uint64_t size);
+
+  /**
+   * Release a block previously returned by allocate().
+   * @param mem the block to release.
+   * @param size the size that was passed to allocate().
+   */
+  static void deallocate(uint8_t* mem, uint64_t size);
+
+  /**
+   * Ask every thread to return its cached blocks to the allocator. The calling thread's cache is
+   * drained immediately; other threads drain their caches the next time they allocate or release
+   * slice storage. This is intended to be used under memory pressure.
+   */
+  static void releaseIdleMemory();
+
+  /**
+   * @return the pool statistics aggregated across all threads, including threads that have exited.
+   */
+  static Stats stats();
+};
+
+} // namespace Buffer
+} // namespace Envoy
@@ -0,0 +1,105 @@
+#include "source/common/common/arena.h"
+
+#include <vector>
+
+#include "source/common/common/assert.h"
+
+namespace Envoy {
+namespace {
+
+// The blocks released by the arenas of a thread, freed when the thread exits.
+class BlockFreeList {
+public:
+  ~BlockFreeList() {
+    for (void* block : blocks_) {
+      ::operator delete(block);
+    }
+  }
+
+  void* pop() {
+    if (blocks_.empty()) {
+      return nullptr;
+    }
+    void* block = blocks_.back();
+    blocks_.pop_back();
+    return block;
+  }
+
+  bool push(void* block) {
+    if (blocks_.size() >= Arena::MaxCachedBlocks) {
+      return false;
+    }
+    blocks_.push_back(block);
+    return true;
+  }
+
+  size_t size() const { return blocks_.size(); }
+
+private:
+  std::vector<void*> blocks_;
+};
+
+BlockFreeList& freeList() {
+  thread_local BlockFreeList free_list;
+  return free_list;
+}
+
+} // namespace
+
+void* Arena::allocateSlow(size_t size, size_t alignment) {
+  // Blocks are aligned for any fundamental type; stricter alignments are obtained by padding.
+  const size_t header = (sizeof(Block) + alignof(std::max_align_t) - 1) &
+                        ~(alignof(std::max_align_t) - 1);
+  const size_t needed = header + size + (alignment > alignof(std::max_align_t) ? alignment : 0);
+
+  if (needed > BlockSize) {
+    // Give the allocation a block of its own, and keep serving from the current block.
+    Block* block = newBlock(needed);
+    return alignUp(reinterpret_cast<char*>(block) + header, alignment);
+  }
+
+  Block* block = newBlock(BlockSize);
+  ptr_ = reinterpret_cast<char*>(block) + header;
+  end_ = reinterpret_cast<char*>(block) + BlockSize;
+  char* aligned = alignUp(ptr_, alignment);
+  ASSERT(aligned + size <= end_);
+  ptr_ = aligned + size;
+  return aligned;
+}
+
+Arena::Block* Arena::newBlock(size_t size) {
+  void* memory = size == BlockSize ? freeList().pop() : nullptr;
+  if (memory == nullptr) {
+    memory = ::operator new(size);
+  }
+  Block* block = static_cast<Block*>(memory);
+  block->next_ = blocks_;
+  block->size_ = size;
+  blocks_ = block;
+  return block;
+}
+
+void Arena::reset() {
+  BlockFreeList& free_list = freeList();
+  while (blocks_ != nullptr) {
+    Block* block = blocks_;
+    blocks_ = block->next_;
+    if (block->size_ != BlockSize || !free_list.push(block)) {
+      ::operator delete(block);
+    }
+  }
+  ptr_ = nullptr;
+  end_ = nullptr;
+}
+
+size_t Arena::blocks() const {
+  size_t count = 0;
+  for (const Block* block = blocks_; block != nullptr; block = block->next_) {
+    count++;
+  }
+  return count;
+}
+
+size_t Arena::cachedBlocks() { return freeList().size(); }
+
+} // namespace Envoy
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "source/common/common/non_copyable.h"
+
+namespace Envoy {
+
+/**
+ * A monotonic allocator for objects that all die at about the same time, such as the objects of
+ * a single HTTP stream. Memory is handed out from fixed size blocks and is only released, all at
+ * once, when the arena is reset or destroyed. Released blocks are kept in a per-thread free list,
+ * so that an arena used on a worker usually reuses the blocks of the arenas that came before it.
+ *
+ * The arena does not run destructors: objects placed in it with create() must be destroyed in
+ * place by their owner before the arena releases their memory.
+ */
+class Arena : NonCopyable {
+public:
+  // The size of the blocks that are recycled through the per-thread free lists. Allocations that
+  // do not fit in a block get a block of their own, which is freed instead of recycled.
+  static constexpr size_t BlockSize = 4096;
+  // The number of blocks each thread keeps in its free list.
+  static constexpr size_t MaxCachedBlocks = 64;
+
+  Arena() = default;
+  ~Arena() { reset(); }
+
+  /**
+   * @return memory for an object of the given size and alignment, which lives until the arena is
+   *         reset or destroyed.
+   */
+  void* allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+    if (ptr_ != nullptr) {
+      char* aligned = alignUp(ptr_, alignment);
+      if (aligned <= end_ && size <= static_cast<size_t>(end_ - aligned)) {
+        ptr_ = aligned + size;
+        return aligned;
+      }
+    }
+    return allocateSlow(size, alignment);
+  }
+
+  /**
+   * Constructs an object in the arena. The caller is responsible for destroying it in place.
+   */
+  template <class T, class... Args> T* create(Args&&... args) {
+    return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+  }
+
+  /**
+   * Releases all the memory of the arena, which may be used again afterwards.
+   */
+  void reset();
+
+  /**
+   * @return the number of blocks the arena currently holds.
+   */
+  size_t blocks() const;
+
+  /**
+   * @return the number of blocks in the free list of the calling thread.
+   */
+  static size_t cachedBlocks();
+
+private:
+  struct Block {
+    Block* next_;
+    size_t size_;
+  };
+
+  static char* alignUp(char* ptr, size_t alignment) {
+    const uintptr_t value = reinterpret_cast<uintptr_t>(ptr);
+    return reinterpret_cast<char*>((value + alignment - 1) & ~(uintptr_t(alignment) - 1));
+  }
+
+  void* allocateSlow(size_t size, size_t alignment);
+  Block* newBlock(size_t size);
+
+  Block* blocks_{};
+  // The unused part of the block that allocations are currently served from.
+  char* ptr_{};
+  char* end_{};
+};
+
+/**
+ * Deleter of objects that may have been placed in an Arena with Arena::create(). Objects in an
+ * arena are destroyed in place, leaving their memory to the arena, other objects are deleted.
+ */
+class ArenaDeleter {
+public:
+  ArenaDeleter() = default;
+  explicit ArenaDeleter(bool in_arena) : in_arena_(in_arena) {}
+
+  template <class T> void operator()(T* object) const {
+    if (in_arena_) {
+      object->~T();
+    } else {
+      delete object;
+    }
+  }
+
+private:
+  bool in_arena_{};
+};
+
+/**
+ * A unique pointer to an object that may live in an Arena. The arena must outlive the pointer.
+ */
+template <class T> using ArenaPtr = std::unique_ptr<T, ArenaDeleter>;
+
+} // namespace Envoy
@@ -1,6 +1,8 @@
 #include "source/common/common/thread.h"
 
+#include <algorithm>
 #include <thread>
+#include <vector>
 
 #include "source/common/common/assert.h"
 #include "source/common/common/macros.h"
@@ -101,5 +103,33 @@ SkipAsserts::~SkipAsserts() { ThreadIds::get().decSkipAsserts(); }
 
 bool SkipAsserts::skip() { return ThreadIds::get().skipAsserts(); }
 
+void parallelFor(ThreadFactory& thread_factory, uint32_t concurrency, size_t count,
+                 const std::function<void(size_t)>& fn) {
+  const size_t num_threads = std::min<size_t>(concurrency, count);
+  if (num_threads <= 1) {
+    for (size_t i = 0; i < count; ++i) {
+      fn(i);
+    }
+    return;
+  }
+
+  std::atomic<size_t> next_index{0};
+  const auto run = [&next_index, count, &fn]() {
+    for (size_t i = next_index.fetch_add(1, std::memory_order_relaxed); i < count;
+         i = next_index.fetch_add(1, std::memory_order_relaxed)) {
+      fn(i);
+    }
+  };
+  std::vector<ThreadPtr> threads;
+  threads.reserve(num_threads - 1);
+  for (size_t i = 1; i < num_threads; ++i) {
+    threads.push_back(thread_factory.createThread(run, Options{"parallel_for"}));
+  }
+  run();
+  for (ThreadPtr& thread : threads) {
+    thread->join();
+  }
+}
+
 } // namespace Thread
 } // namespace Envoy
@@ -168,6 +168,21 @@ public:
   T* get(const MakeObject& make_object) { return BaseClass::get(0, make_object); }
 };
 
+/**
+ * Calls fn(index) once for every index in [0, count), spreading the calls over up to concurrency
+ * threads, one of which is the calling thread, and returns once all calls have completed. Indexes
+ * are handed out in increasing order but the calls may run concurrently and complete in any order,
+ * so fn must be thread safe and must not throw. With a concurrency of 1 or less, or fewer than two
+ * indexes, all calls run inline on the calling thread.
+ *
+ * @param thread_factory supplies the factory used to create the additional threads.
+ * @param concurrency supplies the maximum number of threads to run fn on.
+ * @param count supplies the number of indexes to call fn for.
+ * @param fn supplies the function to call for every index.
+ */
+void parallelFor(ThreadFactory& thread_factory, uint32_t concurrency, size_t count,
+                 const std::function<void(size_t)>& fn);
+
 // We use platform-specific functions to determine whether the current thread is
 // the "test thread". It is only valid to call isTestThread() on platforms where
 // these functions are available. Currently this is available only on apple and
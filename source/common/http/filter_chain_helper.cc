@@ -45,8 +45,12 @@ void FilterChainUtility::createFilterChainForFactories(
     auto config = filter_config_provider.provider->config();
     if (config.has_value()) {
       Filter::NamedHttpFilterFactoryCb& factory_cb = config.value().get();
-      manager.applyFilterFactoryCb({filter_config_provider.provider->name(), factory_cb.name},
-                                   factory_cb.factory_cb);
+      if (filter_config_provider.context.has_value()) {
+        manager.applySharedFilterFactoryCb(*filter_config_provider.context, factory_cb.factory_cb);
+      } else {
+        manager.applyFilterFactoryCb({filter_config_provider.provider->name(), factory_cb.name},
+                                     factory_cb.factory_cb);
+      }
       continue;
     }
 
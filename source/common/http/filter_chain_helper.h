@@ -10,6 +10,8 @@
 #include "source/common/filter/config_discovery_impl.h"
 #include "source/common/http/dependency_manager.h"
 
+#include "absl/types/optional.h"
+
 namespace Envoy {
 namespace Http {
 
@@ -27,6 +29,9 @@ public:
     // If true, this filter is disabled by default and must be explicitly enabled by
     // route configuration.
     bool disabled{};
+    // The context of the filters created by a static provider, which all streams refer to. Unset
+    // for dynamic providers, whose filter type may change with their configuration.
+    absl::optional<FilterContext> context{};
   };
 
   using FilterFactoriesList = std::list<FilterFactoryProvider>;
@@ -137,7 +142,9 @@ private:
               MessageUtil::getJsonStringFromMessageOrError(
                   static_cast<const Protobuf::Message&>(proto_config.typed_config())));
 #endif
-    filter_factories.push_back({std::move(filter_config_provider), disabled_by_default});
+    FilterContext context{filter_config_provider->name(), factory->name()};
+    filter_factories.push_back(
+        {std::move(filter_config_provider), disabled_by_default, std::move(context)});
     return absl::OkStatus();
   }
 
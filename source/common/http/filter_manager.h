@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include "envoy/buffer/buffer.h"
 #include "envoy/common/optref.h"
@@ -14,8 +15,8 @@
 #include "envoy/protobuf/message_validator.h"
 
 #include "source/common/buffer/watermark_buffer.h"
+#include "source/common/common/arena.h"
 #include "source/common/common/dump_state_utils.h"
-#include "source/common/common/linked_object.h"
 #include "source/common/common/logger.h"
 #include "source/common/grpc/common.h"
 #include "source/common/http/header_utility.h"
@@ -65,9 +66,9 @@ private:
 struct ActiveStreamFilterBase : public virtual StreamFilterCallbacks,
                                 Logger::Loggable<Logger::Id::http> {
   ActiveStreamFilterBase(FilterManager& parent, bool is_encoder_decoder_filter,
-                         FilterContext filter_context)
+                         const FilterContext& filter_context)
       : parent_(parent), iteration_state_(IterationState::Continue),
-        filter_context_(std::move(filter_context)), iterate_from_current_filter_(false),
+        filter_context_(filter_context), iterate_from_current_filter_(false),
         headers_continued_(false), continued_1xx_headers_(false), end_stream_(false),
         is_encoder_decoder_filter_(is_encoder_decoder_filter), processed_headers_(false) {}
 
@@ -179,7 +180,9 @@ struct ActiveStreamFilterBase : public virtual StreamFilterCallbacks,
   FilterManager& parent_;
   IterationState iteration_state_{};
 
-  const FilterContext filter_context_;
+  // Owned by the filter chain configuration, or by the filter manager for contexts built per
+  // stream.
+  const FilterContext& filter_context_;
 
   // If the filter resumes iteration from a StopAllBuffer/Watermark state, the current filter
   // hasn't parsed data and trailers. As a result, the filter iteration should start with the
@@ -195,15 +198,18 @@ struct ActiveStreamFilterBase : public virtual StreamFilterCallbacks,
   bool processed_headers_ : 1;
 };
 
+struct ActiveStreamDecoderFilter;
+using ActiveStreamDecoderFilterPtr = ArenaPtr<ActiveStreamDecoderFilter>;
+using ActiveStreamDecoderFilters = std::vector<ActiveStreamDecoderFilterPtr>;
+
 /**
  * Wrapper for a stream decoder filter.
  */
 struct ActiveStreamDecoderFilter : public ActiveStreamFilterBase,
-                                   public StreamDecoderFilterCallbacks,
-                                   LinkedObject<ActiveStreamDecoderFilter> {
+                                   public StreamDecoderFilterCallbacks {
   ActiveStreamDecoderFilter(FilterManager& parent, StreamDecoderFilterSharedPtr filter,
-                            bool is_encoder_decoder_filter, FilterContext filter_context)
-      : ActiveStreamFilterBase(parent, is_encoder_decoder_filter, std::move(filter_context)),
+                            bool is_encoder_decoder_filter, const FilterContext& filter_context)
+      : ActiveStreamFilterBase(parent, is_encoder_decoder_filter, filter_context),
         handle_(std::move(filter)) {
     handle_->setDecoderFilterCallbacks(*this);
   }
@@ -280,21 +286,27 @@ struct ActiveStreamDecoderFilter : public ActiveStreamFilterBase,
   void requestDataTooLarge();
   void requestDataDrained();
 
+  // @return the position of the filter in the decoder filter chain of its manager.
+  ActiveStreamDecoderFilters::iterator entry();
+
   StreamDecoderFilterSharedPtr handle_;
   bool is_grpc_request_{};
+  // The index of the filter in FilterManager::decoder_filters_.
+  size_t entry_index_{};
 };
 
-using ActiveStreamDecoderFilterPtr = std::unique_ptr<ActiveStreamDecoderFilter>;
+struct ActiveStreamEncoderFilter;
+using ActiveStreamEncoderFilterPtr = ArenaPtr<ActiveStreamEncoderFilter>;
+using ActiveStreamEncoderFilters = std::vector<ActiveStreamEncoderFilterPtr>;
 
 /**
  * Wrapper for a stream encoder filter.
  */
 struct ActiveStreamEncoderFilter : public ActiveStreamFilterBase,
-                                   public StreamEncoderFilterCallbacks,
-                                   LinkedObject<ActiveStreamEncoderFilter> {
+                                   public StreamEncoderFilterCallbacks {
   ActiveStreamEncoderFilter(FilterManager& parent, StreamEncoderFilterSharedPtr filter,
-                            bool is_encoder_decoder_filter, FilterContext filter_context)
-      : ActiveStreamFilterBase(parent, is_encoder_decoder_filter, std::move(filter_context)),
+                            bool is_encoder_decoder_filter, const FilterContext& filter_context)
+      : ActiveStreamFilterBase(parent, is_encoder_decoder_filter, filter_context),
         handle_(std::move(filter)) {
     handle_->setEncoderFilterCallbacks(*this);
   }
@@ -340,11 +352,14 @@ struct ActiveStreamEncoderFilter : public ActiveStreamFilterBase,
   void responseDataTooLarge();
   void responseDataDrained();
 
+  // @return the position of the filter in the encoder filter chain of its manager.
+  ActiveStreamEncoderFilters::iterator entry();
+
   StreamEncoderFilterSharedPtr handle_;
+  // The index of the filter in FilterManager::encoder_filters_.
+  size_t entry_index_{};
 };
 
-using ActiveStreamEncoderFilterPtr = std::unique_ptr<ActiveStreamEncoderFilter>;
-
 /**
  * Callbacks invoked by the FilterManager to pass filter data/events back to the caller.
  */
@@ -639,7 +654,9 @@ public:
         proxy_100_continue_(proxy_100_continue), buffer_limit_(buffer_limit),
         filter_chain_factory_(filter_chain_factory),
         no_downgrade_to_canonical_name_(Runtime::runtimeFeatureEnabled(
-            "envoy.reloadable_features.no_downgrade_to_canonical_name")) {}
+            "envoy.reloadable_features.no_downgrade_to_canonical_name")),
+        use_arena_(Runtime::runtimeFeatureEnabled("envoy.reloadable_features.http_stream_arena")) {
+  }
   ~FilterManager() override {
     ASSERT(state_.destroyed_);
     ASSERT(state_.filter_call_state_ == 0);
@@ -669,23 +686,19 @@ public:
     //     - B
     //     - C
     // The decoder filter chain will iterate through filters A, B, C.
-    LinkedList::moveIntoListBack(std::move(filter), decoder_filters_);
+    filter->entry_index_ = decoder_filters_.size();
+    decoder_filters_.push_back(std::move(filter));
   }
   void addStreamEncoderFilter(ActiveStreamEncoderFilterPtr filter) {
-    // Note: configured encoder filters are prepended to encoder_filters_.
-    // This means that if filters are configured in the following order (assume all three filters
-    // are both decoder/encoder filters):
-    //   http_filters:
-    //     - A
-    //     - B
-    //     - C
-    // The encoder filter chain will iterate through filters C, B, A.
-    LinkedList::moveIntoList(std::move(filter), encoder_filters_);
+    // Note: configured encoder filters are appended to encoder_filters_, which is reversed once
+    // the filter chain is created. See finalizeFilterChain().
+    encoder_filters_.push_back(std::move(filter));
   }
   void addStreamFilterBase(StreamFilterBase* filter) { filters_.push_back(filter); }
 
   // FilterChainManager
   void applyFilterFactoryCb(FilterContext context, FilterFactoryCb& factory) override;
+  void applySharedFilterFactoryCb(const FilterContext& context, FilterFactoryCb& factory) override;
 
   void log(AccessLog::AccessLogType access_log_type) {
     RequestHeaderMap* request_headers = nullptr;
@@ -842,6 +855,12 @@ public:
   // Set up the Encoder/Decoder filter chain.
   bool createFilterChain();
 
+  /**
+   * Puts the encoder filters in iteration order. This must be called once after all the filters
+   * of a filter chain created without createFilterChain() have been added.
+   */
+  void finalizeFilterChain();
+
   OptRef<const Network::Connection> connection() const { return connection_; }
 
   uint64_t streamId() const { return stream_id_; }
@@ -909,13 +928,13 @@ private:
 
     void addStreamDecoderFilter(Http::StreamDecoderFilterSharedPtr filter) override {
       manager_.addStreamFilterBase(filter.get());
-      manager_.addStreamDecoderFilter(std::make_unique<ActiveStreamDecoderFilter>(
+      manager_.addStreamDecoderFilter(manager_.makeActiveFilter<ActiveStreamDecoderFilter>(
           manager_, std::move(filter), false, context_));
     }
 
     void addStreamEncoderFilter(Http::StreamEncoderFilterSharedPtr filter) override {
       manager_.addStreamFilterBase(filter.get());
-      manager_.addStreamEncoderFilter(std::make_unique<ActiveStreamEncoderFilter>(
+      manager_.addStreamEncoderFilter(manager_.makeActiveFilter<ActiveStreamEncoderFilter>(
           manager_, std::move(filter), false, context_));
     }
 
@@ -923,10 +942,10 @@ private:
       StreamDecoderFilter* decoder_filter = filter.get();
       manager_.addStreamFilterBase(decoder_filter);
 
-      manager_.addStreamDecoderFilter(
-          std::make_unique<ActiveStreamDecoderFilter>(manager_, filter, true, context_));
-      manager_.addStreamEncoderFilter(
-          std::make_unique<ActiveStreamEncoderFilter>(manager_, std::move(filter), true, context_));
+      manager_.addStreamDecoderFilter(manager_.makeActiveFilter<ActiveStreamDecoderFilter>(
+          manager_, filter, true, context_));
+      manager_.addStreamEncoderFilter(manager_.makeActiveFilter<ActiveStreamEncoderFilter>(
+          manager_, std::move(filter), true, context_));
     }
 
     void addAccessLogHandler(AccessLog::InstanceSharedPtr handler) override {
@@ -952,15 +971,23 @@ private:
     const Router::RouteConstSharedPtr route_;
   };
 
+  // Creates the wrapper of a filter of this stream, in the per-stream arena if it is enabled.
+  template <class T, class... Args> ArenaPtr<T> makeActiveFilter(Args&&... args) {
+    if (use_arena_) {
+      return ArenaPtr<T>(arena_.create<T>(std::forward<Args>(args)...), ArenaDeleter(true));
+    }
+    return ArenaPtr<T>(new T(std::forward<Args>(args)...));
+  }
+
   // Indicates which filter to start the iteration with.
   enum class FilterIterationStartState { AlwaysStartFromNext, CanStartFromCurrent };
 
   // Returns the encoder filter to start iteration with.
-  std::list<ActiveStreamEncoderFilterPtr>::iterator
+  ActiveStreamEncoderFilters::iterator
   commonEncodePrefix(ActiveStreamEncoderFilter* filter, bool end_stream,
                      FilterIterationStartState filter_iteration_start_state);
   // Returns the decoder filter to start iteration with.
-  std::list<ActiveStreamDecoderFilterPtr>::iterator
+  ActiveStreamDecoderFilters::iterator
   commonDecodePrefix(ActiveStreamDecoderFilter* filter,
                      FilterIterationStartState filter_iteration_start_state);
   void addDecodedData(ActiveStreamDecoderFilter& filter, Buffer::Instance& data, bool streaming);
@@ -969,7 +996,7 @@ private:
   // Helper function for the case where we have a header only request, but a filter adds a body
   // to it.
   void maybeContinueDecoding(
-      const std::list<ActiveStreamDecoderFilterPtr>::iterator& maybe_continue_data_entry);
+      const ActiveStreamDecoderFilters::iterator& maybe_continue_data_entry);
   void decodeHeaders(ActiveStreamDecoderFilter* filter, RequestHeaderMap& headers, bool end_stream);
   // Sends data through decoding filter chains. filter_iteration_start_state indicates which
   // filter to start the iteration with.
@@ -984,7 +1011,7 @@ private:
   // filters before calling encodeHeadersInternal which does final header munging and passes the
   // headers to the encoder.
   void maybeContinueEncoding(
-      const std::list<ActiveStreamEncoderFilterPtr>::iterator& maybe_continue_data_entry);
+      const ActiveStreamEncoderFilters::iterator& maybe_continue_data_entry);
   void encodeHeaders(ActiveStreamEncoderFilter* filter, ResponseHeaderMap& headers,
                      bool end_stream);
   // Sends data through encoding filter chains. filter_iteration_start_state indicates which
@@ -1020,9 +1047,17 @@ private:
   Buffer::BufferMemoryAccountSharedPtr account_;
   const bool proxy_100_continue_;
 
-  std::list<ActiveStreamDecoderFilterPtr> decoder_filters_;
-  std::list<ActiveStreamEncoderFilterPtr> encoder_filters_;
-  std::list<StreamFilterBase*> filters_;
+  // The contexts of the filters whose factory was applied with a context built for this stream.
+  // The filter wrappers refer to them, so they are declared before the filter lists.
+  std::list<FilterContext> stream_filter_contexts_;
+  // Holds the filter wrappers when use_arena_ is set. Declared before the filter lists so that it
+  // outlives them.
+  Arena arena_;
+  // The filter chains are built once per stream and only iterated afterwards, so they are kept in
+  // contiguous storage.
+  ActiveStreamDecoderFilters decoder_filters_;
+  ActiveStreamEncoderFilters encoder_filters_;
+  std::vector<StreamFilterBase*> filters_;
   std::list<AccessLog::InstanceSharedPtr> access_log_handlers_;
 
   // Stores metadata added in the decoding filter that is being processed. Will be cleared before
@@ -1076,6 +1111,7 @@ private:
   State state_;
 
   const bool no_downgrade_to_canonical_name_{};
+  const bool use_arena_{};
 };
 
 // The DownstreamFilterManager has explicit handling to send local replies.
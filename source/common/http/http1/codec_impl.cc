@@ -27,6 +27,7 @@
 #include "source/common/runtime/runtime_features.h"
 
 #include "absl/container/fixed_array.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/strings/ascii.h"
 
 namespace Envoy {
@@ -88,6 +89,10 @@ StatefulHeaderKeyFormatterPtr statefulFormatterFromSettings(const Http::Http1Set
 
 constexpr size_t CRLF_SIZE = 2;
 
+// The number of fragments of a header block that are collected without allocating, which covers
+// the start line and a few dozen headers.
+constexpr size_t MaxBatchedHeaderFragments = 128;
+
 } // namespace
 
 static constexpr absl::string_view CRLF = "\r\n";
@@ -138,6 +143,7 @@ void ResponseEncoderImpl::encode1xxHeaders(const ResponseHeaderMap& headers) {
 }
 
 void StreamEncoderImpl::encodeHeadersBase(const RequestOrResponseHeaderMap& headers,
+                                          absl::Span<const absl::string_view> start_line,
                                           absl::optional<uint64_t> status, bool end_stream,
                                           bool bodiless_request) {
   HeaderKeyFormatterOptConstRef formatter(headers.formatter());
@@ -147,25 +153,8 @@ void StreamEncoderImpl::encodeHeadersBase(const RequestOrResponseHeaderMap& head
 
   const Http::HeaderValues& header_values = Http::Headers::get();
   bool saw_content_length = false;
-  headers.iterate(
-      [this, &header_values, formatter](const HeaderEntry& header) -> HeaderMap::Iterate {
-        absl::string_view key_to_use = header.key().getStringView();
-        uint32_t key_size_to_use = header.key().size();
-        // Translate :authority -> host so that upper layers do not need to deal with this.
-        if (key_size_to_use > 1 && key_to_use[0] == ':' && key_to_use[1] == 'a') {
-          key_to_use = absl::string_view(header_values.HostLegacy.get());
-          key_size_to_use = header_values.HostLegacy.get().size();
-        }
-
-        // Skip all headers starting with ':' that make it here.
-        if (key_to_use[0] == ':') {
-          return HeaderMap::Iterate::Continue;
-        }
-
-        encodeFormattedHeader(key_to_use, header.value().getStringView(), formatter);
-
-        return HeaderMap::Iterate::Continue;
-      });
+  // The header that the codec adds to frame the body, if any, which is encoded after the others.
+  absl::optional<std::pair<absl::string_view, absl::string_view>> framing_header;
 
   if (headers.ContentLength()) {
     saw_content_length = true;
@@ -204,7 +193,7 @@ void StreamEncoderImpl::encodeHeadersBase(const RequestOrResponseHeaderMap& head
       // body, per https://tools.ietf.org/html/rfc7230#section-3.3.2
       if (!status || (*status >= 200 && *status != 204)) {
         if (!bodiless_request) {
-          encodeFormattedHeader(header_values.ContentLength.get(), "0", formatter);
+          framing_header.emplace(header_values.ContentLength.get(), "0");
         }
       }
       chunk_encoding_ = false;
@@ -214,8 +203,8 @@ void StreamEncoderImpl::encodeHeadersBase(const RequestOrResponseHeaderMap& head
       // For responses to connect requests, do not send the chunked encoding header:
       // https://tools.ietf.org/html/rfc7231#section-4.3.6.
       if (!is_response_to_connect_request_) {
-        encodeFormattedHeader(header_values.TransferEncoding.get(),
-                              header_values.TransferEncodingValues.Chunked, formatter);
+        framing_header.emplace(header_values.TransferEncoding.get(),
+                               header_values.TransferEncodingValues.Chunked);
       }
       // We do not apply chunk encoding for HTTP upgrades, including CONNECT style upgrades.
       // If there is a body in a response on the upgrade path, the chunks will be
@@ -229,7 +218,58 @@ void StreamEncoderImpl::encodeHeadersBase(const RequestOrResponseHeaderMap& head
     }
   }
 
-  connection_.buffer().add(CRLF);
+  // Keys that need formatting are encoded header by header, as the formatted keys need storage.
+  // Otherwise the fragments of the whole header block are collected first, so that the output
+  // buffer copies them into a single reservation of their total size.
+  const bool batch = connection_.batchHeaderSerialization() && !formatter.has_value();
+  absl::InlinedVector<absl::string_view, MaxBatchedHeaderFragments> fragments;
+  uint64_t batched_header_bytes = 0;
+  const auto encode_header = [&](absl::string_view key, absl::string_view value) {
+    if (batch) {
+      fragments.insert(fragments.end(), {key, COLON_SPACE, value, CRLF});
+      batched_header_bytes += key.size() + COLON_SPACE.size() + value.size() + CRLF.size();
+    } else {
+      encodeFormattedHeader(key, value, formatter);
+    }
+  };
+
+  if (batch) {
+    fragments.assign(start_line.begin(), start_line.end());
+  } else {
+    connection_.buffer().addFragments(start_line);
+  }
+
+  headers.iterate(
+      [&header_values, &encode_header](const HeaderEntry& header) -> HeaderMap::Iterate {
+        absl::string_view key_to_use = header.key().getStringView();
+        uint32_t key_size_to_use = header.key().size();
+        // Translate :authority -> host so that upper layers do not need to deal with this.
+        if (key_size_to_use > 1 && key_to_use[0] == ':' && key_to_use[1] == 'a') {
+          key_to_use = absl::string_view(header_values.HostLegacy.get());
+          key_size_to_use = header_values.HostLegacy.get().size();
+        }
+
+        // Skip all headers starting with ':' that make it here.
+        if (key_to_use[0] == ':') {
+          return HeaderMap::Iterate::Continue;
+        }
+
+        encode_header(key_to_use, header.value().getStringView());
+
+        return HeaderMap::Iterate::Continue;
+      });
+
+  if (framing_header.has_value()) {
+    encode_header(framing_header->first, framing_header->second);
+  }
+
+  if (batch) {
+    fragments.push_back(CRLF);
+    connection_.buffer().addFragments(fragments);
+    bytes_meter_->addHeaderBytesSent(batched_header_bytes);
+  } else {
+    connection_.buffer().add(CRLF);
+  }
 
   if (end_stream) {
     endEncode();
@@ -426,15 +466,14 @@ void ResponseEncoderImpl::encodeHeaders(const ResponseHeaderMap& headers, bool e
     reason_phrase = {status_string, status_string_len};
   }
 
-  connection_.buffer().addFragments(
-      {response_prefix, absl::StrCat(numeric_status), SPACE, reason_phrase, CRLF});
-
   if (numeric_status >= 300) {
     // Don't do special CONNECT logic if the CONNECT was rejected.
     is_response_to_connect_request_ = false;
   }
 
-  encodeHeadersBase(headers, absl::make_optional<uint64_t>(numeric_status), end_stream, false);
+  const std::string numeric_status_string = absl::StrCat(numeric_status);
+  encodeHeadersBase(headers, {response_prefix, numeric_status_string, SPACE, reason_phrase, CRLF},
+                    absl::make_optional<uint64_t>(numeric_status), end_stream, false);
 }
 
 static constexpr absl::string_view REQUEST_POSTFIX = " HTTP/1.1\r\n";
@@ -489,8 +528,8 @@ Status RequestEncoderImpl::encodeHeaders(const RequestHeaderMap& headers, bool e
     std::string url = absl::StrCat(scheme->value().getStringView(), "://",
                                    host->value().getStringView(), path->value().getStringView());
     ENVOY_CONN_LOG(trace, "Sending fully qualified URL: {}", connection_.connection(), url);
-    connection_.buffer().addFragments(
-        {method->value().getStringView(), SPACE, url, REQUEST_POSTFIX});
+    encodeHeadersBase(headers, {method->value().getStringView(), SPACE, url, REQUEST_POSTFIX},
+                      absl::nullopt, end_stream, HeaderUtility::requestShouldHaveNoBody(headers));
   } else {
     absl::string_view host_or_path_view;
     if (is_connect) {
@@ -499,12 +538,10 @@ Status RequestEncoderImpl::encodeHeaders(const RequestHeaderMap& headers, bool e
       host_or_path_view = path->value().getStringView();
     }
 
-    connection_.buffer().addFragments(
-        {method->value().getStringView(), SPACE, host_or_path_view, REQUEST_POSTFIX});
+    encodeHeadersBase(headers,
+                      {method->value().getStringView(), SPACE, host_or_path_view, REQUEST_POSTFIX},
+                      absl::nullopt, end_stream, HeaderUtility::requestShouldHaveNoBody(headers));
   }
-
-  encodeHeadersBase(headers, absl::nullopt, end_stream,
-                    HeaderUtility::requestShouldHaveNoBody(headers));
   return okStatus();
 }
 
@@ -532,7 +569,9 @@ ConnectionImpl::ConnectionImpl(Network::Connection& connection, CodecStats& stat
       encode_only_header_key_formatter_(encodeOnlyFormatterFromSettings(settings)),
       processing_trailers_(false), handling_upgrade_(false), reset_stream_called_(false),
       deferred_end_stream_headers_(false), dispatching_(false), max_headers_kb_(max_headers_kb),
-      max_headers_count_(max_headers_count) {
+      max_headers_count_(max_headers_count),
+      batch_header_serialization_(Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.http1_batch_header_serialization")) {
   if (codec_settings_.use_balsa_parser_) {
     parser_ = std::make_unique<BalsaParser>(type, this, max_headers_kb_ * 1024, enableTrailers(),
                                             codec_settings_.allow_custom_methods_);
@@ -24,6 +24,8 @@
 #include "source/common/http/http1/parser.h"
 #include "source/common/http/status.h"
 
+#include "absl/types/span.h"
+
 namespace Envoy {
 namespace Http {
 namespace Http1 {
@@ -92,8 +94,17 @@ public:
 
 protected:
   StreamEncoderImpl(ConnectionImpl& connection, StreamInfo::BytesMeterSharedPtr&& bytes_meter);
-  void encodeHeadersBase(const RequestOrResponseHeaderMap& headers, absl::optional<uint64_t> status,
-                         bool end_stream, bool bodiless_request);
+  /**
+   * Encodes the start line and the headers of a message.
+   * @param headers supplies the headers to encode.
+   * @param start_line supplies the fragments of the request or status line, including its CRLF.
+   * @param status supplies the status of a response, or absl::nullopt for a request.
+   * @param end_stream supplies whether the message has no body.
+   * @param bodiless_request supplies whether the message is a request that should have no body.
+   */
+  void encodeHeadersBase(const RequestOrResponseHeaderMap& headers,
+                         absl::Span<const absl::string_view> start_line,
+                         absl::optional<uint64_t> status, bool end_stream, bool bodiless_request);
   void encodeTrailersBase(const HeaderMap& headers);
 
   Buffer::BufferMemoryAccountSharedPtr buffer_memory_account_;
@@ -257,6 +268,7 @@ public:
   HeaderKeyFormatterOptConstRef formatter() const {
     return makeOptRefFromPtr(encode_only_header_key_formatter_.get());
   }
+  bool batchHeaderSerialization() const { return batch_header_serialization_; }
 
   // Http::Connection
   Http::Status dispatch(Buffer::Instance& data) override;
@@ -319,6 +331,9 @@ protected:
   StreamInfo::BytesMeterSharedPtr bytes_meter_before_stream_;
   const uint32_t max_headers_kb_;
   const uint32_t max_headers_count_;
+  // Whether the start line and the headers of a message are serialized into the output buffer in
+  // one go, rather than header by header.
+  const bool batch_header_serialization_;
 
 private:
   enum class HeaderParsingState { Field, Value, Done };
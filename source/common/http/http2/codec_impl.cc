@@ -656,7 +656,14 @@ ConnectionImpl::StreamDataFrameSource::SelectPayloadLength(size_t max_length) {
     stream_.data_deferred_ = true;
     return {kBlocked, false};
   } else {
-    const size_t length = std::min<size_t>(max_length, stream_.pending_send_data_->length());
+    size_t length = std::min<size_t>(max_length, stream_.pending_send_data_->length());
+    shortened_ = false;
+    if (stream_.parent_.align_data_frames_to_slices_ &&
+        length < stream_.pending_send_data_->length()) {
+      const size_t aligned_length = sliceAlignedPayloadLength(length);
+      shortened_ = aligned_length < length;
+      length = aligned_length;
+    }
     bool end_data = false;
     if (stream_.local_end_stream_ && length == stream_.pending_send_data_->length()) {
       end_data = true;
@@ -670,13 +677,28 @@ ConnectionImpl::StreamDataFrameSource::SelectPayloadLength(size_t max_length) {
   }
 }
 
+size_t ConnectionImpl::StreamDataFrameSource::sliceAlignedPayloadLength(size_t length) const {
+  // Ending the frame in the middle of a slice makes Send() copy the head of that slice, so the
+  // frame is shortened to the last slice boundary that fits, unless that would more than halve it.
+  size_t aligned_length = 0;
+  for (const Buffer::RawSlice& slice :
+       stream_.pending_send_data_->getRawSlices(MaxSlicesPerAlignedFrame)) {
+    if (aligned_length + slice.len_ > length) {
+      break;
+    }
+    aligned_length += slice.len_;
+  }
+  return aligned_length > 0 && aligned_length >= length / 2 ? aligned_length : length;
+}
+
 bool ConnectionImpl::StreamDataFrameSource::Send(absl::string_view frame_header,
                                                  size_t payload_length) {
   stream_.parent_.protocol_constraints_.incrementOutboundDataFrameCount();
 
   Buffer::OwnedImpl output;
   stream_.parent_.addOutboundFrameFragment(
-      output, reinterpret_cast<const uint8_t*>(frame_header.data()), frame_header.size());
+      output, reinterpret_cast<const uint8_t*>(frame_header.data()), frame_header.size(),
+      shortened_);
   if (!stream_.parent_.protocol_constraints_.checkOutboundFrameLimits().ok()) {
     ENVOY_CONN_LOG(debug, "error sending data frame: Too many frames in the outbound queue",
                    stream_.parent_.connection_);
@@ -862,7 +884,9 @@ ConnectionImpl::ConnectionImpl(Network::Connection& connection, CodecStats& stat
           http2_options.override_stream_error_on_invalid_http_message().value()),
       protocol_constraints_(stats, http2_options), dispatching_(false), raised_goaway_(false),
       random_(random_generator),
-      last_received_data_time_(connection_.dispatcher().timeSource().monotonicTime()) {
+      last_received_data_time_(connection_.dispatcher().timeSource().monotonicTime()),
+      align_data_frames_to_slices_(Runtime::runtimeFeatureEnabled(
+          "envoy.reloadable_features.http2_align_data_frames_to_slices")) {
   if (http2_options.has_use_oghttp2_codec()) {
     use_oghttp2_library_ = http2_options.use_oghttp2_codec().value();
   } else {
@@ -1322,13 +1346,16 @@ int ConnectionImpl::onBeforeFrameSend(int32_t /*stream_id*/, size_t /*length*/,
 }
 
 void ConnectionImpl::addOutboundFrameFragment(Buffer::OwnedImpl& output, const uint8_t* data,
-                                              size_t length) {
+                                              size_t length, bool shortened_data_frame) {
   // Reset the outbound frame type (set in the onBeforeFrameSend callback) since the
   // onBeforeFrameSend callback is not called for DATA frames.
   bool is_outbound_flood_monitored_control_frame = false;
   std::swap(is_outbound_flood_monitored_control_frame, is_outbound_flood_monitored_control_frame_);
   auto releasor =
-      protocol_constraints_.incrementOutboundFrameCount(is_outbound_flood_monitored_control_frame);
+      shortened_data_frame
+          ? protocol_constraints_.incrementOutboundShortenedDataFrameCount()
+          : protocol_constraints_.incrementOutboundFrameCount(
+                is_outbound_flood_monitored_control_frame);
   output.add(data, length);
   output.addDrainTracker(releasor);
 }
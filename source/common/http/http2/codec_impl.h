@@ -425,8 +425,18 @@ protected:
     bool send_fin() const override { return send_fin_; }
 
   private:
+    // The number of slices looked at when aligning a DATA frame to the slices of the body.
+    static constexpr uint64_t MaxSlicesPerAlignedFrame = 16;
+
+    // Returns the length of the whole slices at the front of the pending send data that fit in a
+    // frame of the given length, or the given length if aligning the frame would more than halve
+    // it.
+    size_t sliceAlignedPayloadLength(size_t length) const;
+
     StreamImpl& stream_;
     bool send_fin_ = true;
+    // Whether the frame being sent was shortened to end at a slice boundary.
+    bool shortened_ = false;
   };
 
   using StreamImplPtr = std::unique_ptr<StreamImpl>;
@@ -707,7 +717,8 @@ private:
   int onMetadataFrameComplete(int32_t stream_id, bool end_metadata);
 
   // Adds buffer fragment for a new outbound frame to the supplied Buffer::OwnedImpl.
-  void addOutboundFrameFragment(Buffer::OwnedImpl& output, const uint8_t* data, size_t length);
+  void addOutboundFrameFragment(Buffer::OwnedImpl& output, const uint8_t* data, size_t length,
+                                bool shortened_data_frame = false);
   virtual Status trackInboundFrames(int32_t stream_id, size_t length, uint8_t type, uint8_t flags,
                                     uint32_t padding_length) PURE;
   void onKeepaliveResponse();
@@ -727,6 +738,9 @@ private:
   Event::SchedulableCallbackPtr protocol_constraint_violation_callback_;
   Random::RandomGenerator& random_;
   MonotonicTime last_received_data_time_{};
+  // Whether DATA frames end at slice boundaries of the body where possible, so that their payload
+  // is moved to the connection rather than copied.
+  const bool align_data_frames_to_slices_;
   Event::TimerPtr keepalive_send_timer_;
   Event::TimerPtr keepalive_timeout_timer_;
   std::chrono::milliseconds keepalive_interval_;
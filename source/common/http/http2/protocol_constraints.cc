@@ -13,6 +13,7 @@ ProtocolConstraints::ProtocolConstraints(
       frame_buffer_releasor_([this]() { releaseOutboundFrame(); }),
       max_outbound_control_frames_(http2_options.max_outbound_control_frames().value()),
       control_frame_buffer_releasor_([this]() { releaseOutboundControlFrame(); }),
+      shortened_data_frame_buffer_releasor_([this]() { releaseOutboundShortenedDataFrame(); }),
       max_consecutive_inbound_frames_with_empty_payload_(
           http2_options.max_consecutive_inbound_frames_with_empty_payload().value()),
       max_inbound_priority_frames_per_stream_(
@@ -32,6 +33,13 @@ ProtocolConstraints::incrementOutboundFrameCount(bool is_outbound_flood_monitore
                                                    : frame_buffer_releasor_;
 }
 
+ProtocolConstraints::ReleasorProc ProtocolConstraints::incrementOutboundShortenedDataFrameCount() {
+  ++outbound_frames_;
+  stats_.outbound_frames_active_.set(outbound_frames_);
+  ++outbound_shortened_data_frames_;
+  return shortened_data_frame_buffer_releasor_;
+}
+
 void ProtocolConstraints::releaseOutboundFrame() {
   ASSERT(outbound_frames_ >= 1);
   --outbound_frames_;
@@ -45,13 +53,19 @@ void ProtocolConstraints::releaseOutboundControlFrame() {
   releaseOutboundFrame();
 }
 
+void ProtocolConstraints::releaseOutboundShortenedDataFrame() {
+  ASSERT(outbound_shortened_data_frames_ >= 1);
+  --outbound_shortened_data_frames_;
+  releaseOutboundFrame();
+}
+
 Status ProtocolConstraints::checkOutboundFrameLimits() {
   // Stop checking for further violations after the first failure.
   if (!status_.ok()) {
     return status_;
   }
 
-  if (outbound_frames_ > max_outbound_frames_) {
+  if (outbound_frames_ - outbound_shortened_data_frames_ / 2 > max_outbound_frames_) {
     stats_.outbound_flood_.inc();
     return status_ = bufferFloodError("Too many frames in the outbound queue.");
   }
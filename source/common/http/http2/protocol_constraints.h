@@ -45,6 +45,14 @@ public:
   // directions.
   ReleasorProc incrementOutboundFrameCount(bool is_outbound_flood_monitored_control_frame);
 
+  // Increment counters of pending outbound DATA frames which were shortened to end at a slice
+  // boundary of the body. Such a frame carries at least half the payload of the frame it replaces,
+  // so it only counts as half a frame against the outbound frame limit. This keeps aligning DATA
+  // frames to slices from tripping the outbound flood detection any sooner.
+  // Returns callable for decrementing frame counters when the frame was written to the underlying
+  // transport socket object.
+  ReleasorProc incrementOutboundShortenedDataFrameCount();
+
   // Track received frames of various types.
   // Return an error status if inbound frame constraints were violated.
   Status trackInboundFrames(size_t length, uint8_t type, uint8_t flags, uint32_t padding_length);
@@ -60,6 +68,7 @@ public:
 private:
   void releaseOutboundFrame();
   void releaseOutboundControlFrame();
+  void releaseOutboundShortenedDataFrame();
   Status checkInboundFrameLimits();
 
   Status status_;
@@ -83,6 +92,13 @@ private:
   const uint32_t max_outbound_control_frames_;
   ReleasorProc control_frame_buffer_releasor_;
 
+  // This counter keeps track of the number of outbound DATA frames shortened to end at a slice
+  // boundary (these that were buffered in the underlying connection but not yet written into the
+  // socket). They are also counted by `outbound_frames_', but only half of them count against the
+  // `max_outbound_frames_' limit.
+  uint32_t outbound_shortened_data_frames_ = 0;
+  ReleasorProc shortened_data_frame_buffer_releasor_;
+
   // This counter keeps track of the number of consecutive inbound frames of types HEADERS,
   // CONTINUATION and DATA with an empty payload and no end stream flag. If this counter exceeds
   // the `max_consecutive_inbound_frames_with_empty_payload_` value the connection is terminated.
@@ -0,0 +1,31 @@
+#include "source/common/io/io_uring_worker_factory_impl.h"
+
+namespace Envoy {
+namespace Io {
+
+IoUringWorkerFactoryImpl::IoUringWorkerFactoryImpl(uint32_t io_uring_size,
+                                                   bool use_submission_queue_polling,
+                                                   uint32_t read_buffer_size,
+                                                   ThreadLocal::SlotAllocator& tls)
+    : io_uring_size_(io_uring_size), use_submission_queue_polling_(use_submission_queue_polling),
+      read_buffer_size_(read_buffer_size), tls_(tls) {}
+
+OptRef<IoUringWorker> IoUringWorkerFactoryImpl::getIoUringWorker() {
+  return OptRef<IoUringWorker>(tls_.get());
+}
+
+void IoUringWorkerFactoryImpl::onWorkerThreadInitialized() {
+  tls_.set([io_uring_size = io_uring_size_,
+            use_submission_queue_polling = use_submission_queue_polling_,
+            read_buffer_size = read_buffer_size_](Event::Dispatcher& dispatcher) {
+    return std::make_shared<IoUringWorkerImpl>(io_uring_size, use_submission_queue_polling,
+                                               read_buffer_size, dispatcher);
+  });
+}
+
+bool IoUringWorkerFactoryImpl::currentThreadRegistered() {
+  return tls_.currentThreadRegistered() && tls_.get().has_value();
+}
+
+} // namespace Io
+} // namespace Envoy
@@ -3,6 +3,29 @@
 namespace Envoy {
 namespace Io {
 
+namespace {
+
+// The default size of the buffer each read request reads into.
+constexpr uint32_t DefaultReadBufferSize = 8192;
+// The max number of slices submitted by one write request.
+constexpr uint64_t MaxWriteSlices = 64;
+
+} // namespace
+
+ReadRequest::ReadRequest(IoUringSocket& socket, uint32_t size)
+    : Request(RequestType::Read, socket), buf_(new uint8_t[size]) {
+  iov_.iov_base = buf_.get();
+  iov_.iov_len = size;
+}
+
+WriteRequest::WriteRequest(IoUringSocket& socket, const Buffer::RawSliceVector& slices)
+    : Request(RequestType::Write, socket), iov_(new struct iovec[slices.size()]) {
+  for (size_t i = 0; i < slices.size(); i++) {
+    iov_[i].iov_base = slices[i].mem_;
+    iov_[i].iov_len = slices[i].len_;
+  }
+}
+
 IoUringSocketEntry::IoUringSocketEntry(os_fd_t fd, IoUringWorkerImpl& parent)
     : fd_(fd), parent_(parent) {}
 
@@ -25,12 +48,17 @@ void IoUringSocketEntry::injectCompletion(Request::RequestType type) {
 }
 
 IoUringWorkerImpl::IoUringWorkerImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
-                                     Event::Dispatcher& dispatcher)
+                                     uint32_t read_buffer_size, Event::Dispatcher& dispatcher)
     : IoUringWorkerImpl(std::make_unique<IoUringImpl>(io_uring_size, use_submission_queue_polling),
-                        dispatcher) {}
+                        read_buffer_size, dispatcher) {}
 
 IoUringWorkerImpl::IoUringWorkerImpl(IoUringPtr&& io_uring, Event::Dispatcher& dispatcher)
-    : io_uring_(std::move(io_uring)), dispatcher_(dispatcher) {
+    : IoUringWorkerImpl(std::move(io_uring), DefaultReadBufferSize, dispatcher) {}
+
+IoUringWorkerImpl::IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer_size,
+                                     Event::Dispatcher& dispatcher)
+    : io_uring_(std::move(io_uring)), read_buffer_size_(read_buffer_size),
+      dispatcher_(dispatcher) {
   const os_fd_t event_fd = io_uring_->registerEventfd();
   // We only care about the read event of Eventfd, since we only receive the
   // event here.
@@ -47,6 +75,18 @@ IoUringWorkerImpl::~IoUringWorkerImpl() {
 
 Event::Dispatcher& IoUringWorkerImpl::dispatcher() { return dispatcher_; }
 
+IoUringSocket& IoUringWorkerImpl::addServerSocket(os_fd_t fd, Event::FileReadyCb cb) {
+  ENVOY_LOG(trace, "add server socket, fd = {}", fd);
+  return addSocket(std::make_unique<IoUringServerSocket>(fd, *this, std::move(cb),
+                                                         read_buffer_size_, false));
+}
+
+IoUringSocket& IoUringWorkerImpl::addClientSocket(os_fd_t fd, Event::FileReadyCb cb) {
+  ENVOY_LOG(trace, "add client socket, fd = {}", fd);
+  return addSocket(
+      std::make_unique<IoUringServerSocket>(fd, *this, std::move(cb), read_buffer_size_, true));
+}
+
 IoUringSocketEntry& IoUringWorkerImpl::addSocket(IoUringSocketEntryPtr&& socket) {
   LinkedList::moveIntoListBack(std::move(socket), sockets_);
   return *sockets_.back();
@@ -65,6 +105,68 @@ void IoUringWorkerImpl::injectCompletion(IoUringSocket& socket, Request::Request
   file_event_->activate(Event::FileReadyType::Read);
 }
 
+Request* IoUringWorkerImpl::submitReadRequest(IoUringSocket& socket) {
+  ReadRequest* req = new ReadRequest(socket, read_buffer_size_);
+  ENVOY_LOG(trace, "submit read request, fd = {}, req = {}", socket.fd(), fmt::ptr(req));
+  prepareRequest([&]() { return io_uring_->prepareReadv(socket.fd(), &req->iov_, 1, 0, req); });
+  return req;
+}
+
+Request* IoUringWorkerImpl::submitWriteRequest(IoUringSocket& socket,
+                                               const Buffer::RawSliceVector& slices) {
+  WriteRequest* req = new WriteRequest(socket, slices);
+  ENVOY_LOG(trace, "submit write request, fd = {}, req = {}, num slices = {}", socket.fd(),
+            fmt::ptr(req), slices.size());
+  prepareRequest([&]() {
+    return io_uring_->prepareWritev(socket.fd(), req->iov_.get(), slices.size(), 0, req);
+  });
+  return req;
+}
+
+Request*
+IoUringWorkerImpl::submitConnectRequest(IoUringSocket& socket,
+                                        const Network::Address::InstanceConstSharedPtr& address) {
+  ConnectRequest* req = new ConnectRequest(socket, address);
+  ENVOY_LOG(trace, "submit connect request, fd = {}, req = {}", socket.fd(), fmt::ptr(req));
+  prepareRequest([&]() { return io_uring_->prepareConnect(socket.fd(), req->address_, req); });
+  return req;
+}
+
+Request* IoUringWorkerImpl::submitCloseRequest(IoUringSocket& socket) {
+  Request* req = new Request(Request::RequestType::Close, socket);
+  ENVOY_LOG(trace, "submit close request, fd = {}, req = {}", socket.fd(), fmt::ptr(req));
+  prepareRequest([&]() { return io_uring_->prepareClose(socket.fd(), req); });
+  return req;
+}
+
+Request* IoUringWorkerImpl::submitCancelRequest(IoUringSocket& socket,
+                                                Request* request_to_cancel) {
+  Request* req = new Request(Request::RequestType::Cancel, socket);
+  ENVOY_LOG(trace, "submit cancel request, fd = {}, req = {}, req to cancel = {}", socket.fd(),
+            fmt::ptr(req), fmt::ptr(request_to_cancel));
+  prepareRequest([&]() { return io_uring_->prepareCancel(request_to_cancel, req); });
+  return req;
+}
+
+Request* IoUringWorkerImpl::submitShutdownRequest(IoUringSocket& socket, int how) {
+  Request* req = new Request(Request::RequestType::Shutdown, socket);
+  ENVOY_LOG(trace, "submit shutdown request, fd = {}, req = {}, how = {}", socket.fd(),
+            fmt::ptr(req), how);
+  prepareRequest([&]() { return io_uring_->prepareShutdown(socket.fd(), how, req); });
+  return req;
+}
+
+void IoUringWorkerImpl::prepareRequest(absl::FunctionRef<IoUringResult()> prepare) {
+  if (prepare() == IoUringResult::Failed) {
+    // The submission queue is full, flush it to the kernel regardless of the delayed submit and
+    // try again.
+    io_uring_->submit();
+    const IoUringResult res = prepare();
+    RELEASE_ASSERT(res == IoUringResult::Ok, "unable to prepare io_uring request");
+  }
+  submit();
+}
+
 void IoUringWorkerImpl::onFileEvent() {
   ENVOY_LOG(trace, "io uring worker, on file event");
   delay_submit_ = true;
@@ -123,5 +225,288 @@ void IoUringWorkerImpl::submit() {
   }
 }
 
+IoUringServerSocket::IoUringServerSocket(os_fd_t fd, IoUringWorkerImpl& parent,
+                                         Event::FileReadyCb cb, uint32_t read_buffer_size,
+                                         bool is_client)
+    : IoUringSocketEntry(fd, parent), read_buffer_size_(read_buffer_size), connected_(!is_client) {
+  cb_ = std::move(cb);
+  // The accepted socket starts reading immediately, the client socket waits for the connect.
+  if (!is_client) {
+    enableRead();
+  }
+}
+
+bool IoUringServerSocket::shouldRead() const {
+  if (!connected_ || read_req_ != nullptr || read_error_.has_value() ||
+      status_ == IoUringSocketStatus::Closed) {
+    return false;
+  }
+  // Keep reading while the read is disabled only to detect the remote close, and stop once the
+  // buffered data reaches the size of one read.
+  return status_ == IoUringSocketStatus::ReadEnabled ||
+         (enable_close_event_ && read_buf_.length() < read_buffer_size_);
+}
+
+void IoUringServerSocket::submitReadRequest() {
+  if (shouldRead()) {
+    read_req_ = parent_.submitReadRequest(*this);
+  }
+}
+
+void IoUringServerSocket::submitWriteOrShutdownRequest() {
+  if (!connected_ || write_req_ != nullptr || shutdown_req_ != nullptr ||
+      write_error_.has_value()) {
+    return;
+  }
+  if (write_buf_.length() > 0) {
+    write_req_ = parent_.submitWriteRequest(*this, write_buf_.getRawSlices(MaxWriteSlices));
+  } else if (pending_shutdown_.has_value()) {
+    shutdown_req_ = parent_.submitShutdownRequest(*this, pending_shutdown_.value());
+    pending_shutdown_.reset();
+  }
+}
+
+void IoUringServerSocket::enableRead() {
+  if (status_ == IoUringSocketStatus::Closed) {
+    return;
+  }
+  status_ = IoUringSocketStatus::ReadEnabled;
+  // Deliver the data or the remote close which arrived while the read was disabled.
+  if (read_buf_.length() > 0 || read_error_.has_value()) {
+    injectCompletion(Request::RequestType::Read);
+  }
+  submitReadRequest();
+}
+
+void IoUringServerSocket::disableRead() {
+  if (status_ == IoUringSocketStatus::ReadEnabled) {
+    status_ = IoUringSocketStatus::ReadDisabled;
+  }
+}
+
+void IoUringServerSocket::enableCloseEvent(bool enable) {
+  enable_close_event_ = enable;
+  submitReadRequest();
+}
+
+void IoUringServerSocket::connect(const Network::Address::InstanceConstSharedPtr& address) {
+  ASSERT(!connected_ && connect_req_ == nullptr);
+  connect_req_ = parent_.submitConnectRequest(*this, address);
+}
+
+uint64_t IoUringServerSocket::write(Buffer::Instance& data) {
+  ASSERT(status_ != IoUringSocketStatus::Closed);
+  const uint64_t room = WriteBufferLimit - std::min(WriteBufferLimit, write_buf_.length());
+  const uint64_t bytes_written = std::min(room, data.length());
+  if (bytes_written < data.length()) {
+    write_blocked_ = true;
+  }
+  write_buf_.move(data, bytes_written);
+  submitWriteOrShutdownRequest();
+  return bytes_written;
+}
+
+uint64_t IoUringServerSocket::write(const Buffer::RawSlice* slices, uint64_t num_slice) {
+  ASSERT(status_ != IoUringSocketStatus::Closed);
+  uint64_t room = WriteBufferLimit - std::min(WriteBufferLimit, write_buf_.length());
+  uint64_t bytes_written = 0;
+  for (uint64_t i = 0; i < num_slice; i++) {
+    const uint64_t len = std::min<uint64_t>(room, slices[i].len_);
+    write_buf_.add(slices[i].mem_, len);
+    bytes_written += len;
+    room -= len;
+    if (len < slices[i].len_) {
+      write_blocked_ = true;
+      break;
+    }
+  }
+  submitWriteOrShutdownRequest();
+  return bytes_written;
+}
+
+void IoUringServerSocket::shutdown(int how) {
+  pending_shutdown_ = how;
+  submitWriteOrShutdownRequest();
+}
+
+void IoUringServerSocket::close() {
+  if (status_ == IoUringSocketStatus::Closed) {
+    return;
+  }
+  status_ = IoUringSocketStatus::Closed;
+  cb_ = nullptr;
+  closeInternal();
+}
+
+void IoUringServerSocket::closeInternal() {
+  ASSERT(status_ == IoUringSocketStatus::Closed);
+  if (close_req_ != nullptr) {
+    return;
+  }
+  // The read and the connect never complete by themselves, cancel them.
+  if (read_req_ != nullptr || connect_req_ != nullptr) {
+    if (cancel_req_ == nullptr) {
+      cancel_req_ =
+          parent_.submitCancelRequest(*this, read_req_ != nullptr ? read_req_ : connect_req_);
+    }
+    return;
+  }
+  // Wait for all the other requests, the socket can't be released before their completions.
+  if (write_req_ != nullptr || cancel_req_ != nullptr || shutdown_req_ != nullptr) {
+    return;
+  }
+  // Flush the pending data before closing the fd.
+  if (connected_ && write_buf_.length() > 0 && !write_error_.has_value()) {
+    submitWriteOrShutdownRequest();
+    return;
+  }
+  close_req_ = parent_.submitCloseRequest(*this);
+}
+
+void IoUringServerSocket::notifyRead() {
+  if (!cb_) {
+    return;
+  }
+  read_param_.emplace(ReadParam{read_buf_, read_error_.value_or(-EAGAIN)});
+  cb_(Event::FileReadyType::Read);
+  read_param_.reset();
+}
+
+void IoUringServerSocket::notifyWrite(absl::optional<int32_t> result) {
+  if (!cb_) {
+    return;
+  }
+  if (result.has_value()) {
+    write_param_.emplace(WriteParam{result.value()});
+  }
+  cb_(Event::FileReadyType::Write);
+  write_param_.reset();
+}
+
+void IoUringServerSocket::onConnect(Request* req, int32_t result, bool injected) {
+  IoUringSocketEntry::onConnect(req, result, injected);
+  if (injected) {
+    return;
+  }
+  ASSERT(connect_req_ == req);
+  connect_req_ = nullptr;
+  if (status_ == IoUringSocketStatus::Closed) {
+    closeInternal();
+    return;
+  }
+
+  ENVOY_LOG(trace, "connect completed, fd = {}, result = {}", fd_, result);
+  connected_ = result == 0;
+  // The connection learns the result of the connect from the write event.
+  notifyWrite(result);
+  submitReadRequest();
+  submitWriteOrShutdownRequest();
+}
+
+void IoUringServerSocket::onRead(Request* req, int32_t result, bool injected) {
+  IoUringSocketEntry::onRead(req, result, injected);
+  if (!injected) {
+    ASSERT(read_req_ == req);
+    read_req_ = nullptr;
+    if (result > 0) {
+      auto* read_req = static_cast<ReadRequest*>(req);
+      if (static_cast<uint32_t>(result) < read_buffer_size_ / 4) {
+        // A small read is cheaper to copy than pinning a whole read buffer in the slice list.
+        read_buf_.add(read_req->buf_.get(), result);
+      } else {
+        // Hand the memory the kernel read into over to the read buffer without copying.
+        auto* fragment = new Buffer::BufferFragmentImpl(
+            read_req->buf_.release(), result,
+            [](const void* data, size_t, const Buffer::BufferFragmentImpl* this_fragment) {
+              delete[] static_cast<const uint8_t*>(data);
+              delete this_fragment;
+            });
+        read_buf_.addBufferFragment(*fragment);
+      }
+    } else if (result != -ECANCELED) {
+      // The remote closed the connection or an error happened.
+      ENVOY_LOG(trace, "read end, fd = {}, result = {}", fd_, result);
+      read_error_ = result;
+    }
+  }
+
+  if (status_ == IoUringSocketStatus::Closed) {
+    if (!injected) {
+      closeInternal();
+    }
+    return;
+  }
+
+  if (status_ == IoUringSocketStatus::ReadEnabled) {
+    notifyRead();
+  } else if (!injected && read_error_.has_value() && enable_close_event_ && cb_) {
+    cb_(Event::FileReadyType::Closed);
+  }
+  submitReadRequest();
+}
+
+void IoUringServerSocket::onWrite(Request* req, int32_t result, bool injected) {
+  IoUringSocketEntry::onWrite(req, result, injected);
+  if (injected) {
+    if (status_ != IoUringSocketStatus::Closed) {
+      notifyWrite(absl::nullopt);
+    }
+    return;
+  }
+
+  ASSERT(write_req_ == req);
+  write_req_ = nullptr;
+  if (result > 0) {
+    write_buf_.drain(result);
+  } else if (result != -ECANCELED) {
+    ENVOY_LOG(trace, "write error, fd = {}, result = {}", fd_, result);
+    write_error_ = result;
+    write_buf_.drain(write_buf_.length());
+  }
+
+  if (status_ == IoUringSocketStatus::Closed) {
+    closeInternal();
+    return;
+  }
+  if (write_error_.has_value()) {
+    // Let the connection find the error on its next write.
+    notifyWrite(write_error_.value());
+    return;
+  }
+  submitWriteOrShutdownRequest();
+  if (write_blocked_ && write_buf_.length() < WriteBufferLimit) {
+    // Let the connection write the data it kept while the write buffer was full.
+    write_blocked_ = false;
+    notifyWrite(absl::nullopt);
+  }
+}
+
+void IoUringServerSocket::onClose(Request* req, int32_t result, bool injected) {
+  IoUringSocketEntry::onClose(req, result, injected);
+  ASSERT(!injected && close_req_ == req);
+  ENVOY_LOG(trace, "close completed, fd = {}, result = {}", fd_, result);
+  close_req_ = nullptr;
+  cleanup();
+}
+
+void IoUringServerSocket::onCancel(Request* req, int32_t result, bool injected) {
+  IoUringSocketEntry::onCancel(req, result, injected);
+  ASSERT(!injected && cancel_req_ == req);
+  cancel_req_ = nullptr;
+  if (status_ == IoUringSocketStatus::Closed) {
+    closeInternal();
+  }
+}
+
+void IoUringServerSocket::onShutdown(Request* req, int32_t result, bool injected) {
+  IoUringSocketEntry::onShutdown(req, result, injected);
+  ASSERT(!injected && shutdown_req_ == req);
+  ENVOY_LOG(trace, "shutdown completed, fd = {}, result = {}", fd_, result);
+  shutdown_req_ = nullptr;
+  if (status_ == IoUringSocketStatus::Closed) {
+    closeInternal();
+  }
+}
+
 } // namespace Io
 } // namespace Envoy
@@ -2,9 +2,13 @@
 
 #include "envoy/common/io/io_uring.h"
 
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/common/assert.h"
 #include "source/common/common/linked_object.h"
 #include "source/common/io/io_uring_impl.h"
 
+#include "absl/functional/function_ref.h"
+
 namespace Envoy {
 namespace Io {
 
@@ -14,12 +18,17 @@ using IoUringSocketEntryPtr = std::unique_ptr<IoUringSocketEntry>;
 class IoUringWorkerImpl : public IoUringWorker, private Logger::Loggable<Logger::Id::io> {
 public:
   IoUringWorkerImpl(uint32_t io_uring_size, bool use_submission_queue_polling,
+                    uint32_t read_buffer_size, Event::Dispatcher& dispatcher);
+  IoUringWorkerImpl(IoUringPtr&& io_uring, uint32_t read_buffer_size,
                     Event::Dispatcher& dispatcher);
   IoUringWorkerImpl(IoUringPtr&& io_uring, Event::Dispatcher& dispatcher);
   ~IoUringWorkerImpl() override;
 
   // IoUringWorker
   Event::Dispatcher& dispatcher() override;
+  IoUringSocket& addServerSocket(os_fd_t fd, Event::FileReadyCb cb) override;
+  IoUringSocket& addClientSocket(os_fd_t fd, Event::FileReadyCb cb) override;
+  uint32_t getNumOfSockets() const override { return sockets_.size(); }
 
   // Remove a socket from this worker.
   IoUringSocketEntryPtr removeSocket(IoUringSocketEntry& socket);
@@ -27,17 +36,27 @@ public:
   // Inject a request completion into the iouring instance for a specific socket.
   void injectCompletion(IoUringSocket& socket, Request::RequestType type, int32_t result);
 
-  // Return the number of sockets in this worker.
-  size_t getNumOfSockets() const { return sockets_.size(); }
+  // Submit the requests for a specific socket. The returned request is owned by the worker and
+  // released after the completion has been delivered to the socket.
+  Request* submitReadRequest(IoUringSocket& socket);
+  Request* submitWriteRequest(IoUringSocket& socket, const Buffer::RawSliceVector& slices);
+  Request* submitConnectRequest(IoUringSocket& socket,
+                                const Network::Address::InstanceConstSharedPtr& address);
+  Request* submitCloseRequest(IoUringSocket& socket);
+  Request* submitCancelRequest(IoUringSocket& socket, Request* request_to_cancel);
+  Request* submitShutdownRequest(IoUringSocket& socket, int how);
 
 protected:
   // Add a socket to the worker.
   IoUringSocketEntry& addSocket(IoUringSocketEntryPtr&& socket);
   void onFileEvent();
   void submit();
+  void prepareRequest(absl::FunctionRef<IoUringResult()> prepare);
 
   // The iouring instance.
   IoUringPtr io_uring_;
+  // The size of the buffer each read request reads into.
+  const uint32_t read_buffer_size_;
   // The dispatcher of this worker is running on.
   Event::Dispatcher& dispatcher_;
   // The file event of iouring's eventfd.
@@ -98,6 +117,13 @@ public:
   }
   void injectCompletion(Request::RequestType type) override;
 
+  // The generic entry only tracks the injected completions. It leaves the socket operations, i.e.
+  // reading, writing, connecting, shutting down and closing, to the concrete sockets.
+  OptRef<ReadParam> getReadParam() override { return {}; }
+  OptRef<WriteParam> getWriteParam() override { return {}; }
+  void setFileReadyCb(Event::FileReadyCb cb) override { cb_ = std::move(cb); }
+  IoUringSocketStatus getStatus() const override { return status_; }
+
 protected:
   /**
    * For the socket to remove itself from the IoUringWorker and defer deletion.
@@ -109,6 +135,117 @@ protected:
   // This records already injected completion request type to
   // avoid duplicated injections.
   uint8_t injected_completions_{0};
+  IoUringSocketStatus status_{IoUringSocketStatus::Initialized};
+  Event::FileReadyCb cb_;
+};
+
+/**
+ * The read request which owns the memory the kernel reads into. On completion the memory is
+ * handed over to the socket's read buffer without copying.
+ */
+class ReadRequest : public Request {
+public:
+  ReadRequest(IoUringSocket& socket, uint32_t size);
+
+  std::unique_ptr<uint8_t[]> buf_;
+  struct iovec iov_;
+};
+
+/**
+ * The write request which references the slices of the socket's write buffer. The slices must
+ * stay alive until the request completes.
+ */
+class WriteRequest : public Request {
+public:
+  WriteRequest(IoUringSocket& socket, const Buffer::RawSliceVector& slices);
+
+  std::unique_ptr<struct iovec[]> iov_;
+};
+
+/**
+ * The connect request which keeps the remote address alive until the request completes.
+ */
+class ConnectRequest : public Request {
+public:
+  ConnectRequest(IoUringSocket& socket, const Network::Address::InstanceConstSharedPtr& address)
+      : Request(RequestType::Connect, socket), address_(address) {}
+
+  const Network::Address::InstanceConstSharedPtr address_;
+};
+
+/**
+ * An IoUringSocket for the accepted and the client TCP sockets. It keeps one read request in
+ * flight while reading is enabled and one write request in flight while there is pending data.
+ */
+class IoUringServerSocket : public IoUringSocketEntry {
+public:
+  IoUringServerSocket(os_fd_t fd, IoUringWorkerImpl& parent, Event::FileReadyCb cb,
+                      uint32_t read_buffer_size, bool is_client);
+
+  // IoUringSocket
+  void enableRead() override;
+  void disableRead() override;
+  void enableCloseEvent(bool enable) override;
+  void connect(const Network::Address::InstanceConstSharedPtr& address) override;
+  uint64_t write(Buffer::Instance& data) override;
+  uint64_t write(const Buffer::RawSlice* slices, uint64_t num_slice) override;
+  void shutdown(int how) override;
+  void close() override;
+  OptRef<ReadParam> getReadParam() override {
+    return read_param_.has_value() ? makeOptRef(*read_param_) : OptRef<ReadParam>();
+  }
+  OptRef<WriteParam> getWriteParam() override {
+    return write_param_.has_value() ? makeOptRef(*write_param_) : OptRef<WriteParam>();
+  }
+
+  void onConnect(Request* req, int32_t result, bool injected) override;
+  void onRead(Request* req, int32_t result, bool injected) override;
+  void onWrite(Request* req, int32_t result, bool injected) override;
+  void onClose(Request* req, int32_t result, bool injected) override;
+  void onCancel(Request* req, int32_t result, bool injected) override;
+  void onShutdown(Request* req, int32_t result, bool injected) override;
+
+  // Return the data which has been read and is waiting to be consumed.
+  const Buffer::Instance& readBuffer() const { return read_buf_; }
+  // Return the data which is pending to be written.
+  const Buffer::Instance& writeBuffer() const { return write_buf_; }
+
+  // The number of bytes pending to be written above which the socket accepts no more data. This
+  // keeps the backpressure of a slow peer visible to the connection's watermarks, like the send
+  // buffer of the kernel does for the readiness based sockets.
+  static constexpr uint64_t WriteBufferLimit = 1024 * 1024;
+
+private:
+  bool shouldRead() const;
+  void submitReadRequest();
+  void submitWriteOrShutdownRequest();
+  void closeInternal();
+  void notifyRead();
+  void notifyWrite(absl::optional<int32_t> result);
+
+  const uint32_t read_buffer_size_;
+  bool connected_;
+  bool enable_close_event_{false};
+
+  Buffer::OwnedImpl read_buf_;
+  // The result of the last read once the connection hit the end or an error.
+  absl::optional<int32_t> read_error_;
+  Buffer::OwnedImpl write_buf_;
+  // Set when a write was refused because the write buffer is full, until there is room again.
+  bool write_blocked_{false};
+  absl::optional<int32_t> write_error_;
+  absl::optional<int> pending_shutdown_;
+
+  Request* connect_req_{nullptr};
+  Request* read_req_{nullptr};
+  Request* write_req_{nullptr};
+  Request* cancel_req_{nullptr};
+  Request* shutdown_req_{nullptr};
+  Request* close_req_{nullptr};
+
+  // Only set while a read or write event is being delivered.
+  absl::optional<ReadParam> read_param_;
+  absl::optional<WriteParam> write_param_;
 };
 
 } // namespace Io
@@ -0,0 +1,317 @@
+#include "source/common/network/io_uring_socket_handle_impl.h"
+
+#include "envoy/buffer/buffer.h"
+
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/common/assert.h"
+#include "source/common/common/utility.h"
+#include "source/common/network/io_socket_error_impl.h"
+
+namespace Envoy {
+namespace Network {
+
+IoUringSocketHandleImpl::IoUringSocketHandleImpl(
+    std::shared_ptr<Io::IoUringWorkerFactory> io_uring_worker_factory, os_fd_t fd,
+    bool socket_v6only, absl::optional<int> domain, IoUringSocketType type)
+    : IoSocketHandleImpl(fd, socket_v6only, domain),
+      io_uring_worker_factory_(std::move(io_uring_worker_factory)), type_(type) {}
+
+IoUringSocketHandleImpl::~IoUringSocketHandleImpl() {
+  // The io_uring worker is gone if the handle is destroyed after the thread local storage shut
+  // down, in which case the base class closes the fd with the system call.
+  if (SOCKET_VALID(fd_) && io_uring_socket_.has_value() &&
+      io_uring_worker_factory_->currentThreadRegistered()) {
+    IoUringSocketHandleImpl::close();
+  }
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::close() {
+  if (!io_uring_socket_.has_value()) {
+    return IoSocketHandleImpl::close();
+  }
+
+  ASSERT(SOCKET_VALID(fd_));
+  // The io_uring socket owns the fd from now on, it flushes the pending data and closes the fd
+  // asynchronously.
+  io_uring_socket_->close();
+  io_uring_socket_.reset();
+  SET_SOCKET_INVALID(fd_);
+  return Api::ioCallUint64ResultNoError();
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::readv(uint64_t max_length,
+                                                       Buffer::RawSlice* slices,
+                                                       uint64_t num_slice) {
+  if (!io_uring_socket_.has_value()) {
+    return IoSocketHandleImpl::readv(max_length, slices, num_slice);
+  }
+
+  OptRef<Io::ReadParam> read_param = io_uring_socket_->getReadParam();
+  if (!read_param.has_value()) {
+    return {0, IoSocketError::getIoSocketEagainError()};
+  }
+  if (read_param->buf_.length() == 0) {
+    return pendingReadResult(read_param->result_);
+  }
+
+  uint64_t bytes_read = 0;
+  for (uint64_t i = 0; i < num_slice && bytes_read < max_length; i++) {
+    const uint64_t len = std::min({read_param->buf_.length(), max_length - bytes_read,
+                                   static_cast<uint64_t>(slices[i].len_)});
+    if (len == 0) {
+      break;
+    }
+    read_param->buf_.copyOut(0, len, slices[i].mem_);
+    read_param->buf_.drain(len);
+    bytes_read += len;
+  }
+  return {bytes_read, Api::IoError::none()};
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::read(Buffer::Instance& buffer,
+                                                      absl::optional<uint64_t> max_length) {
+  if (!io_uring_socket_.has_value()) {
+    return IoSocketHandleImpl::read(buffer, max_length);
+  }
+
+  OptRef<Io::ReadParam> read_param = io_uring_socket_->getReadParam();
+  if (!read_param.has_value()) {
+    return {0, IoSocketError::getIoSocketEagainError()};
+  }
+  if (read_param->buf_.length() == 0) {
+    return pendingReadResult(read_param->result_);
+  }
+
+  // Move the slices the io_uring read into, no copy happens here.
+  const uint64_t bytes_read =
+      std::min(max_length.value_or(read_param->buf_.length()), read_param->buf_.length());
+  buffer.move(read_param->buf_, bytes_read);
+  return {bytes_read, Api::IoError::none()};
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::pendingReadResult(int32_t result) {
+  if (result == 0) {
+    // The remote closed the connection.
+    return {0, Api::IoError::none()};
+  }
+  ASSERT(result < 0);
+  if (result == -EAGAIN) {
+    return {0, IoSocketError::getIoSocketEagainError()};
+  }
+  return {0, IoSocketError::create(-result)};
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::writeError() {
+  ASSERT(write_error_.has_value());
+  return {0, IoSocketError::create(write_error_.value())};
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::writev(const Buffer::RawSlice* slices,
+                                                        uint64_t num_slice) {
+  if (!io_uring_socket_.has_value()) {
+    return IoSocketHandleImpl::writev(slices, num_slice);
+  }
+  if (write_error_.has_value()) {
+    return writeError();
+  }
+  uint64_t length = 0;
+  for (uint64_t i = 0; i < num_slice; i++) {
+    length += slices[i].len_;
+  }
+  const uint64_t bytes_written = io_uring_socket_->write(slices, num_slice);
+  if (bytes_written == 0 && length > 0) {
+    return {0, IoSocketError::getIoSocketEagainError()};
+  }
+  return {bytes_written, Api::IoError::none()};
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::write(Buffer::Instance& buffer) {
+  if (!io_uring_socket_.has_value()) {
+    return IoSocketHandleImpl::write(buffer);
+  }
+  if (write_error_.has_value()) {
+    return writeError();
+  }
+  if (buffer.length() == 0) {
+    return {0, Api::IoError::none()};
+  }
+  // The io_uring socket accepts no data while its write buffer is full, and raises a write event
+  // once it has room again.
+  const uint64_t bytes_written = io_uring_socket_->write(buffer);
+  if (bytes_written == 0) {
+    return {0, IoSocketError::getIoSocketEagainError()};
+  }
+  return {bytes_written, Api::IoError::none()};
+}
+
+Api::IoCallUint64Result IoUringSocketHandleImpl::recv(void* buffer, size_t length, int flags) {
+  if (!io_uring_socket_.has_value()) {
+    return IoSocketHandleImpl::recv(buffer, length, flags);
+  }
+
+  // The only flag used in Envoy is MSG_PEEK by the listener filters, e.g. the TLS inspector.
+  ASSERT(flags == 0 || flags == MSG_PEEK);
+  OptRef<Io::ReadParam> read_param = io_uring_socket_->getReadParam();
+  if (!read_param.has_value()) {
+    return {0, IoSocketError::getIoSocketEagainError()};
+  }
+  if (read_param->buf_.length() == 0) {
+    return pendingReadResult(read_param->result_);
+  }
+
+  const uint64_t bytes_read = std::min(read_param->buf_.length(), static_cast<uint64_t>(length));
+  read_param->buf_.copyOut(0, bytes_read, buffer);
+  if (flags != MSG_PEEK) {
+    read_param->buf_.drain(bytes_read);
+  }
+  return {bytes_read, Api::IoError::none()};
+}
+
+Api::SysCallIntResult IoUringSocketHandleImpl::listen(int backlog) {
+  type_ = IoUringSocketType::Accept;
+  return IoSocketHandleImpl::listen(backlog);
+}
+
+IoHandlePtr IoUringSocketHandleImpl::accept(struct sockaddr* addr, socklen_t* addrlen) {
+  auto result = Api::OsSysCallsSingleton::get().accept(fd_, addr, addrlen);
+  if (SOCKET_INVALID(result.return_value_)) {
+    return nullptr;
+  }
+  return std::make_unique<IoUringSocketHandleImpl>(io_uring_worker_factory_, result.return_value_,
+                                                   socket_v6only_, domain_,
+                                                   IoUringSocketType::Server);
+}
+
+Api::SysCallIntResult IoUringSocketHandleImpl::connect(Address::InstanceConstSharedPtr address) {
+  if (!io_uring_socket_.has_value()) {
+    return IoSocketHandleImpl::connect(address);
+  }
+
+  ASSERT(type_ == IoUringSocketType::Client);
+  connecting_ = true;
+  io_uring_socket_->connect(address);
+  return {-1, SOCKET_ERROR_IN_PROGRESS};
+}
+
+Api::SysCallIntResult IoUringSocketHandleImpl::getOption(int level, int optname, void* optval,
+                                                         socklen_t* optlen) {
+  // The result of the io_uring connect isn't left in the socket, report it from here.
+  if (level == SOL_SOCKET && optname == SO_ERROR && connect_error_.has_value()) {
+    ASSERT(*optlen >= sizeof(int));
+    *static_cast<int*>(optval) = connect_error_.value();
+    *optlen = sizeof(int);
+    return {0, 0};
+  }
+  return IoSocketHandleImpl::getOption(level, optname, optval, optlen);
+}
+
+void IoUringSocketHandleImpl::initializeFileEvent(Event::Dispatcher& dispatcher,
+                                                  Event::FileReadyCb cb,
+                                                  Event::FileTriggerType trigger,
+                                                  uint32_t events) {
+  if (io_uring_socket_.has_value()) {
+    // The socket has been handed to the io_uring already, e.g. by the listener filters before the
+    // connection is created.
+    cb_ = std::move(cb);
+    io_uring_socket_->setFileReadyCb(
+        [this](uint32_t ready_events) { onFileEvent(ready_events); });
+    enableFileEvents(events);
+    return;
+  }
+
+  OptRef<Io::IoUringWorker> worker = io_uring_worker_factory_->getIoUringWorker();
+  if (type_ == IoUringSocketType::Accept || !worker.has_value() ||
+      &worker->dispatcher() != &dispatcher) {
+    IoSocketHandleImpl::initializeFileEvent(dispatcher, cb, trigger, events);
+    return;
+  }
+
+  cb_ = std::move(cb);
+  auto file_ready_cb = [this](uint32_t ready_events) { onFileEvent(ready_events); };
+  if (type_ == IoUringSocketType::Server) {
+    io_uring_socket_ = worker->addServerSocket(fd_, file_ready_cb);
+  } else {
+    type_ = IoUringSocketType::Client;
+    io_uring_socket_ = worker->addClientSocket(fd_, file_ready_cb);
+  }
+  enableFileEvents(events);
+}
+
+void IoUringSocketHandleImpl::onFileEvent(uint32_t events) {
+  if (events & Event::FileReadyType::Write) {
+    OptRef<Io::WriteParam> write_param = io_uring_socket_->getWriteParam();
+    if (connecting_) {
+      connecting_ = false;
+      connect_error_ = write_param.has_value() ? -write_param->result_ : 0;
+    } else if (write_param.has_value() && !write_error_.has_value()) {
+      write_error_ = -write_param->result_;
+    }
+  }
+  if (cb_) {
+    cb_(events);
+  }
+}
+
+IoHandlePtr IoUringSocketHandleImpl::duplicate() {
+  auto result = Api::OsSysCallsSingleton::get().duplicate(fd_);
+  RELEASE_ASSERT(result.return_value_ != -1,
+                 fmt::format("duplicate failed for '{}': ({}) {}", fd_, result.errno_,
+                             errorDetails(result.errno_)));
+  return std::make_unique<IoUringSocketHandleImpl>(io_uring_worker_factory_, result.return_value_,
+                                                   socket_v6only_, domain_, type_);
+}
+
+void IoUringSocketHandleImpl::activateFileEvents(uint32_t events) {
+  if (!io_uring_socket_.has_value()) {
+    IoSocketHandleImpl::activateFileEvents(events);
+    return;
+  }
+
+  if (events & (Event::FileReadyType::Read | Event::FileReadyType::Closed)) {
+    io_uring_socket_->injectCompletion(Io::Request::RequestType::Read);
+  }
+  if (events & Event::FileReadyType::Write) {
+    io_uring_socket_->injectCompletion(Io::Request::RequestType::Write);
+  }
+}
+
+void IoUringSocketHandleImpl::enableFileEvents(uint32_t events) {
+  if (!io_uring_socket_.has_value()) {
+    IoSocketHandleImpl::enableFileEvents(events);
+    return;
+  }
+
+  // The write is always enabled, the io_uring socket writes the data it takes in the background
+  // and raises a write event when it has room for the data it refused.
+  if (events & Event::FileReadyType::Read) {
+    io_uring_socket_->enableRead();
+  } else {
+    io_uring_socket_->disableRead();
+  }
+  io_uring_socket_->enableCloseEvent((events & Event::FileReadyType::Closed) != 0);
+}
+
+void IoUringSocketHandleImpl::resetFileEvents() {
+  if (!io_uring_socket_.has_value()) {
+    IoSocketHandleImpl::resetFileEvents();
+    return;
+  }
+
+  // Keep the io_uring socket and the data it has read for the next initializeFileEvent().
+  io_uring_socket_->disableRead();
+  io_uring_socket_->enableCloseEvent(false);
+  io_uring_socket_->setFileReadyCb(nullptr);
+  cb_ = nullptr;
+}
+
+Api::SysCallIntResult IoUringSocketHandleImpl::shutdown(int how) {
+  if (!io_uring_socket_.has_value()) {
+    return IoSocketHandleImpl::shutdown(how);
+  }
+
+  io_uring_socket_->shutdown(how);
+  return {0, 0};
+}
+
+} // namespace Network
+} // namespace Envoy
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <memory>
+
+#include "envoy/common/io/io_uring.h"
+
+#include "source/common/network/io_socket_handle_impl.h"
+
+namespace Envoy {
+namespace Network {
+
+/**
+ * The type of the socket the IoUringSocketHandleImpl is for.
+ */
+enum class IoUringSocketType {
+  // The socket isn't used yet.
+  Unknown,
+  // The listener socket, it accepts with the readiness events of the dispatcher.
+  Accept,
+  // The socket accepted by a listener.
+  Server,
+  // The socket connecting to an upstream.
+  Client,
+};
+
+/**
+ * IoHandle for TCP sockets which submits the read, write, connect, shutdown and close of the
+ * socket to the io_uring of the current worker. It falls back to IoSocketHandleImpl on the
+ * threads without an io_uring worker and for the listener sockets.
+ */
+class IoUringSocketHandleImpl : public IoSocketHandleImpl {
+public:
+  IoUringSocketHandleImpl(std::shared_ptr<Io::IoUringWorkerFactory> io_uring_worker_factory,
+                          os_fd_t fd = INVALID_SOCKET, bool socket_v6only = false,
+                          absl::optional<int> domain = absl::nullopt,
+                          IoUringSocketType type = IoUringSocketType::Unknown);
+  ~IoUringSocketHandleImpl() override;
+
+  Api::IoCallUint64Result close() override;
+  Api::IoCallUint64Result readv(uint64_t max_length, Buffer::RawSlice* slices,
+                                uint64_t num_slice) override;
+  Api::IoCallUint64Result read(Buffer::Instance& buffer,
+                               absl::optional<uint64_t> max_length) override;
+  Api::IoCallUint64Result writev(const Buffer::RawSlice* slices, uint64_t num_slice) override;
+  Api::IoCallUint64Result write(Buffer::Instance& buffer) override;
+  Api::IoCallUint64Result recv(void* buffer, size_t length, int flags) override;
+  Api::SysCallIntResult listen(int backlog) override;
+  IoHandlePtr accept(struct sockaddr* addr, socklen_t* addrlen) override;
+  Api::SysCallIntResult connect(Address::InstanceConstSharedPtr address) override;
+  Api::SysCallIntResult getOption(int level, int optname, void* optval, socklen_t* optlen) override;
+  void initializeFileEvent(Event::Dispatcher& dispatcher, Event::FileReadyCb cb,
+                           Event::FileTriggerType trigger, uint32_t events) override;
+  IoHandlePtr duplicate() override;
+  void activateFileEvents(uint32_t events) override;
+  void enableFileEvents(uint32_t events) override;
+  void resetFileEvents() override;
+  Api::SysCallIntResult shutdown(int how) override;
+
+  IoUringSocketType type() const { return type_; }
+
+private:
+  void onFileEvent(uint32_t events);
+  Api::IoCallUint64Result pendingReadResult(int32_t result);
+  Api::IoCallUint64Result writeError();
+
+  // Shared so that the factory outlives the handles when the socket interface goes away first.
+  const std::shared_ptr<Io::IoUringWorkerFactory> io_uring_worker_factory_;
+  IoUringSocketType type_;
+  OptRef<Io::IoUringSocket> io_uring_socket_;
+  Event::FileReadyCb cb_;
+  bool connecting_{false};
+  // The errno of the connect, reported as SO_ERROR.
+  absl::optional<int> connect_error_;
+  // The errno of the first failed write, all the following writes fail with it.
+  absl::optional<int> write_error_;
+};
+
+} // namespace Network
+} // namespace Envoy
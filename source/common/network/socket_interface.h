@@ -1,5 +1,6 @@
 #pragma once
 
+#include "envoy/common/io/io_uring.h"
 #include "envoy/config/typed_config.h"
 #include "envoy/network/socket_interface.h"
 #include "envoy/registry/registry.h"
@@ -17,11 +18,21 @@ namespace Network {
 class SocketInterfaceExtension : public Server::BootstrapExtension {
 public:
   SocketInterfaceExtension(SocketInterface& sock_interface) : sock_interface_(sock_interface) {}
+  SocketInterfaceExtension(SocketInterface& sock_interface,
+                           std::shared_ptr<Io::IoUringWorkerFactory> io_uring_worker_factory)
+      : sock_interface_(sock_interface), io_uring_worker_factory_(io_uring_worker_factory) {}
   // Server::BootstrapExtension
-  void onServerInitialized() override {}
+  void onServerInitialized() override {
+    if (io_uring_worker_factory_ != nullptr) {
+      io_uring_worker_factory_->onWorkerThreadInitialized();
+    }
+  }
 
 protected:
   SocketInterface& sock_interface_;
+  // Owns the io_uring workers factory, the socket interface only keeps a weak reference to it
+  // since the socket interface outlives the thread local storage.
+  std::shared_ptr<Io::IoUringWorkerFactory> io_uring_worker_factory_;
 };
 
 // Class to be derived by all SocketInterface implementations.
@@ -9,6 +9,12 @@
 #include "source/common/network/address_impl.h"
 #include "source/common/network/io_socket_handle_impl.h"
 #include "source/common/network/win32_socket_handle_impl.h"
+#include "source/common/protobuf/utility.h"
+
+#ifdef __linux__
+#include "source/common/io/io_uring_worker_factory_impl.h"
+#include "source/common/network/io_uring_socket_handle_impl.h"
+#endif
 
 namespace Envoy {
 namespace Network {
@@ -70,7 +76,18 @@ IoHandlePtr SocketInterfaceImpl::socket(Socket::Type socket_type, Address::Type
       Api::OsSysCallsSingleton::get().socket(domain, flags, protocol);
   RELEASE_ASSERT(SOCKET_VALID(result.return_value_),
                  fmt::format("socket(2) failed, got error: {}", errorDetails(result.errno_)));
-  IoHandlePtr io_handle = makeSocket(result.return_value_, socket_v6only, domain);
+  IoHandlePtr io_handle;
+#ifdef __linux__
+  std::shared_ptr<Io::IoUringWorkerFactory> io_uring_worker_factory =
+      io_uring_worker_factory_.lock();
+  if (io_uring_worker_factory != nullptr && socket_type == Socket::Type::Stream) {
+    io_handle = std::make_unique<IoUringSocketHandleImpl>(
+        std::move(io_uring_worker_factory), result.return_value_, socket_v6only, domain);
+  }
+#endif
+  if (io_handle == nullptr) {
+    io_handle = makeSocket(result.return_value_, socket_v6only, domain);
+  }
 
 #if defined(__APPLE__) || defined(WIN32)
   // Cannot set SOCK_NONBLOCK as a ::socket flag.
@@ -115,9 +132,29 @@ bool SocketInterfaceImpl::ipFamilySupported(int domain) {
   return SOCKET_VALID(result.return_value_);
 }
 
-Server::BootstrapExtensionPtr
-SocketInterfaceImpl::createBootstrapExtension(const Protobuf::Message&,
-                                              Server::Configuration::ServerFactoryContext&) {
+Server::BootstrapExtensionPtr SocketInterfaceImpl::createBootstrapExtension(
+    [[maybe_unused]] const Protobuf::Message& message,
+    [[maybe_unused]] Server::Configuration::ServerFactoryContext& context) {
+#ifdef __linux__
+  const auto& config = MessageUtil::downcastAndValidate<
+      const envoy::extensions::network::socket_interface::v3::DefaultSocketInterface&>(
+      message, context.messageValidationVisitor());
+  if (config.has_io_uring_options()) {
+    if (!Io::isIoUringSupported()) {
+      ENVOY_LOG_MISC(warn, "io_uring is configured but not supported by the kernel, the default "
+                           "socket API is used instead.");
+    } else {
+      const auto& options = config.io_uring_options();
+      auto io_uring_worker_factory = std::make_shared<Io::IoUringWorkerFactoryImpl>(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(options, io_uring_size, 1000),
+          options.enable_submission_queue_polling(),
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(options, read_buffer_size, 8192),
+          context.threadLocal());
+      io_uring_worker_factory_ = io_uring_worker_factory;
+      return std::make_unique<SocketInterfaceExtension>(*this, io_uring_worker_factory);
+    }
+  }
+#endif
   return std::make_unique<SocketInterfaceExtension>(*this);
 }
 
@@ -0,0 +1,30 @@
+#include "source/common/orca/orca_parser.h"
+
+#include <string>
+
+#include "source/common/common/base64.h"
+#include "source/common/common/macros.h"
+
+namespace Envoy {
+namespace Orca {
+
+const Http::LowerCaseString& endpointLoadMetricsHeaderBin() {
+  CONSTRUCT_ON_FIRST_USE(Http::LowerCaseString, "endpoint-load-metrics-bin");
+}
+
+absl::StatusOr<OrcaLoadReport> parseOrcaLoadReportHeaders(const Http::HeaderMap& headers) {
+  const auto header = headers.get(endpointLoadMetricsHeaderBin());
+  if (header.empty()) {
+    return absl::NotFoundError("no ORCA load report header");
+  }
+
+  const std::string decoded = Base64::decodeWithoutPadding(header[0]->value().getStringView());
+  OrcaLoadReport report;
+  if (decoded.empty() || !report.ParseFromString(decoded)) {
+    return absl::InvalidArgumentError("malformed ORCA load report header");
+  }
+  return report;
+}
+
+} // namespace Orca
+} // namespace Envoy
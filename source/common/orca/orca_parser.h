@@ -0,0 +1,29 @@
+#pragma once
+
+#include "envoy/http/header_map.h"
+
+#include "absl/status/statusor.h"
+#include "xds/data/orca/v3/orca_load_report.pb.h"
+
+namespace Envoy {
+namespace Orca {
+
+using OrcaLoadReport = xds::data::orca::v3::OrcaLoadReport;
+
+/**
+ * @return the header used by endpoints to report their load with the Open Request Cost Aggregation
+ *         (ORCA) protocol. Its value is a base64 encoded, serialized OrcaLoadReport, which is how
+ *         gRPC encodes binary metadata.
+ */
+const Http::LowerCaseString& endpointLoadMetricsHeaderBin();
+
+/**
+ * Parses the ORCA load report from response headers or trailers.
+ * @param headers supplies the headers or trailers of the response.
+ * @return the load report, NotFoundError if there is none or InvalidArgumentError if it is
+ *         malformed.
+ */
+absl::StatusOr<OrcaLoadReport> parseOrcaLoadReportHeaders(const Http::HeaderMap& headers);
+
+} // namespace Orca
+} // namespace Envoy
@@ -0,0 +1,136 @@
+#include "source/common/router/compiled_route_table_matcher.h"
+
+#include <algorithm>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/logger.h"
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+bool childLess(const std::pair<uint8_t, uint32_t>& entry, uint8_t c) { return entry.first < c; }
+
+} // namespace
+
+void CompiledRouteTableMatcher::addPrefix(uint32_t index, absl::string_view prefix) {
+  ASSERT(!compiled_);
+  findOrCreateNode(prefix).prefix_routes_.push_back(index);
+}
+
+void CompiledRouteTableMatcher::addExact(uint32_t index, absl::string_view path) {
+  ASSERT(!compiled_);
+  findOrCreateNode(path).exact_routes_.push_back(index);
+}
+
+void CompiledRouteTableMatcher::addRegex(uint32_t index, absl::string_view regex) {
+  ASSERT(!compiled_);
+  regexes_.emplace_back(index, std::string(regex));
+}
+
+void CompiledRouteTableMatcher::addUnindexed(uint32_t index) {
+  ASSERT(!compiled_);
+  unindexed_.push_back(index);
+}
+
+void CompiledRouteTableMatcher::compile() {
+  ASSERT(!compiled_);
+  compiled_ = true;
+
+  if (!regexes_.empty()) {
+    re2::RE2::Options options;
+    options.set_log_errors(false);
+    auto regex_set = std::make_unique<re2::RE2::Set>(options, re2::RE2::ANCHOR_BOTH);
+    bool valid = true;
+    for (const auto& regex : regexes_) {
+      if (regex_set->Add(regex.second, nullptr) < 0) {
+        valid = false;
+        break;
+      }
+    }
+    if (valid && regex_set->Compile()) {
+      regex_set_ = std::move(regex_set);
+      for (const auto& regex : regexes_) {
+        regex_routes_.push_back(regex.first);
+      }
+    } else {
+      for (const auto& regex : regexes_) {
+        unindexed_.push_back(regex.first);
+      }
+    }
+    regexes_.clear();
+    regexes_.shrink_to_fit();
+  }
+
+  std::sort(unindexed_.begin(), unindexed_.end());
+}
+
+void CompiledRouteTableMatcher::candidates(absl::string_view path, Candidates& candidates) const {
+  ASSERT(compiled_);
+  candidates.assign(unindexed_.begin(), unindexed_.end());
+
+  // Walk the trie along the path. Every prefix route on the way matches, and the exact routes of
+  // the node that the walk ends on match if the whole path was consumed.
+  const TrieNode* node = &nodes_[0];
+  size_t consumed = 0;
+  while (node != nullptr) {
+    candidates.insert(candidates.end(), node->prefix_routes_.begin(), node->prefix_routes_.end());
+    if (consumed == path.size()) {
+      candidates.insert(candidates.end(), node->exact_routes_.begin(), node->exact_routes_.end());
+      break;
+    }
+    node = child(*node, path[consumed++]);
+  }
+
+  if (regex_set_ != nullptr) {
+    std::vector<int> matched;
+    re2::RE2::Set::ErrorInfo error_info;
+    if (regex_set_->Match(path, &matched, &error_info)) {
+      for (const int pattern : matched) {
+        candidates.push_back(regex_routes_[pattern]);
+      }
+    } else if (error_info.kind != re2::RE2::Set::kNoError) {
+      // The set failed to match rather than found no match, e.g. because its DFA ran out of
+      // memory, so any of the regex routes may match.
+      ENVOY_LOG_MISC(debug, "regex route set match failed with error {}",
+                     static_cast<int>(error_info.kind));
+      candidates.insert(candidates.end(), regex_routes_.begin(), regex_routes_.end());
+    }
+  }
+
+  // Restore route table order. A route appears at most once since each is added under a single
+  // criterion.
+  std::sort(candidates.begin(), candidates.end());
+}
+
+CompiledRouteTableMatcher::TrieNode&
+CompiledRouteTableMatcher::findOrCreateNode(absl::string_view key) {
+  uint32_t current = 0;
+  for (const uint8_t c : key) {
+    auto& children = nodes_[current].children_;
+    auto it = std::lower_bound(children.begin(), children.end(), c, childLess);
+    if (it != children.end() && it->first == c) {
+      current = it->second;
+      continue;
+    }
+    const uint32_t next = nodes_.size();
+    children.insert(it, {c, next});
+    // This may reallocate nodes_, so children must not be used afterwards.
+    nodes_.emplace_back();
+    current = next;
+  }
+  return nodes_[current];
+}
+
+const CompiledRouteTableMatcher::TrieNode* CompiledRouteTableMatcher::child(const TrieNode& node,
+                                                                           uint8_t c) const {
+  const auto& children = node.children_;
+  auto it = std::lower_bound(children.begin(), children.end(), c, childLess);
+  if (it == children.end() || it->first != c) {
+    return nullptr;
+  }
+  return &nodes_[it->second];
+}
+
+} // namespace Router
+} // namespace Envoy
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/container/inlined_vector.h"
+#include "absl/strings/string_view.h"
+#include "re2/set.h"
+
+namespace Envoy {
+namespace Router {
+
+/**
+ * Index over the path match criteria of an ordered list of routes. Given a request path, it
+ * produces the positions of the routes whose path criterion may match, in ascending order, so that
+ * the caller can evaluate only those routes and still preserve first-match semantics.
+ *
+ * Case sensitive prefix and exact paths are stored in a path trie, and regexes are combined into
+ * a single RE2::Set. Any route that cannot be indexed is added as unindexed and is returned as a
+ * candidate for every path, as are all the regex routes when the set fails to match a path. The
+ * caller must still fully evaluate each candidate, since a candidate is only known to possibly
+ * match on its path.
+ */
+class CompiledRouteTableMatcher {
+public:
+  using Candidates = absl::InlinedVector<uint32_t, 16>;
+
+  /**
+   * Index a route which matches paths starting with the given prefix.
+   * @param index the position of the route in the route table.
+   * @param prefix the prefix of the route.
+   */
+  void addPrefix(uint32_t index, absl::string_view prefix);
+
+  /**
+   * Index a route which matches exactly the given path.
+   * @param index the position of the route in the route table.
+   * @param path the path of the route.
+   */
+  void addExact(uint32_t index, absl::string_view path);
+
+  /**
+   * Index a route which matches paths that fully match the given regex.
+   * @param index the position of the route in the route table.
+   * @param regex the RE2 regex of the route.
+   */
+  void addRegex(uint32_t index, absl::string_view regex);
+
+  /**
+   * Add a route which has to be evaluated for every path.
+   * @param index the position of the route in the route table.
+   */
+  void addUnindexed(uint32_t index);
+
+  /**
+   * Finish building the matcher. Must be called once after all routes are added and before
+   * candidates() is used. If the regexes cannot be compiled into a set, the regex routes are
+   * treated as unindexed.
+   */
+  void compile();
+
+  /**
+   * Find the routes which may match a path.
+   * @param path the path to match, without query string or fragment.
+   * @param candidates receives the positions of the candidate routes in ascending order.
+   */
+  void candidates(absl::string_view path, Candidates& candidates) const;
+
+  /**
+   * @return the number of routes which are evaluated for every path.
+   */
+  uint32_t numUnindexed() const { return unindexed_.size(); }
+
+private:
+  struct TrieNode {
+    // Sorted by character.
+    std::vector<std::pair<uint8_t, uint32_t>> children_;
+    // Routes whose prefix ends at this node.
+    std::vector<uint32_t> prefix_routes_;
+    // Routes whose exact path ends at this node.
+    std::vector<uint32_t> exact_routes_;
+  };
+
+  TrieNode& findOrCreateNode(absl::string_view key);
+  const TrieNode* child(const TrieNode& node, uint8_t c) const;
+
+  // Node 0 is the root.
+  std::vector<TrieNode> nodes_{1};
+  std::unique_ptr<re2::RE2::Set> regex_set_;
+  // Pending regexes, as (route position, regex), until compile() is called.
+  std::vector<std::pair<uint32_t, std::string>> regexes_;
+  // Route position for each pattern in regex_set_.
+  std::vector<uint32_t> regex_routes_;
+  std::vector<uint32_t> unindexed_;
+  bool compiled_{false};
+};
+
+using CompiledRouteTableMatcherPtr = std::unique_ptr<CompiledRouteTableMatcher>;
+
+} // namespace Router
+} // namespace Envoy
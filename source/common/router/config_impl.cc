@@ -1821,9 +1821,54 @@ VirtualHostImpl::VirtualHostImpl(
                                                   optional_http_filters, factory_context, validator,
                                                   validation_clusters));
     }
+    if (Runtime::runtimeFeatureEnabled(
+            "envoy.reloadable_features.compiled_route_table_matcher")) {
+      compileRoutes();
+    }
   }
 }
 
+void VirtualHostImpl::compileRoutes() {
+  compiled_routes_ = std::make_unique<CompiledRouteTableMatcher>();
+  // The regexes are indexed with an RE2::Set, which only selects the routes that match when the
+  // regexes of the routes are RE2 ones too.
+  const bool index_regexes = dynamic_cast<const Regex::GoogleReEngine*>(
+                                 Regex::EngineSingleton::getExisting()) != nullptr;
+  for (uint32_t i = 0; i < routes_.size(); i++) {
+    const RouteEntryImplBase& route = *routes_[i];
+    switch (route.matchType()) {
+    case PathMatchType::Prefix:
+    case PathMatchType::PathSeparatedPrefix:
+      // Path separated prefixes are indexed by their prefix. The separator is checked when the
+      // candidate route is evaluated.
+      if (route.case_sensitive()) {
+        compiled_routes_->addPrefix(i, route.matcher());
+        continue;
+      }
+      break;
+    case PathMatchType::Exact:
+      if (route.case_sensitive()) {
+        compiled_routes_->addExact(i, route.matcher());
+        continue;
+      }
+      break;
+    case PathMatchType::Regex:
+      if (index_regexes) {
+        compiled_routes_->addRegex(i, route.matcher());
+        continue;
+      }
+      break;
+    case PathMatchType::None:
+    case PathMatchType::Template:
+      break;
+    }
+    compiled_routes_->addUnindexed(i);
+  }
+  compiled_routes_->compile();
+  ENVOY_LOG(debug, "compiled {} routes, {} of which could not be indexed", routes_.size(),
+            compiled_routes_->numUnindexed());
+}
+
 const std::shared_ptr<const SslRedirectRoute> VirtualHostImpl::SSL_REDIRECT_ROUTE{
     new SslRedirectRoute()};
 
@@ -1864,6 +1909,50 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromRoutes(
   return nullptr;
 }
 
+RouteConstSharedPtr VirtualHostImpl::getRouteFromCompiledRoutes(
+    const RouteCallback& cb, const Http::RequestHeaderMap& headers,
+    const StreamInfo::StreamInfo& stream_info, uint64_t random_value) const {
+  // Match on the same path that the route entries match on.
+  absl::string_view path = headers.getPathValue();
+  if (shared_virtual_host_->globalRouteConfig().ignorePathParametersInPathMatching()) {
+    path = path.substr(0, path.find_first_of(';'));
+  }
+  path = Http::PathUtil::removeQueryAndFragment(path);
+
+  CompiledRouteTableMatcher::Candidates candidates;
+  compiled_routes_->candidates(path, candidates);
+
+  // This evaluates the candidates exactly as getRouteFromRoutes() evaluates the full route table.
+  // The evaluation status is based on the position in the full route table so that callbacks see
+  // the same status with and without the compiled matcher.
+  for (const uint32_t index : candidates) {
+    RouteConstSharedPtr route_entry = routes_[index]->matches(headers, stream_info, random_value);
+    if (route_entry == nullptr) {
+      continue;
+    }
+
+    if (cb == nullptr) {
+      return route_entry;
+    }
+
+    RouteEvalStatus eval_status = (index + 1 == routes_.size()) ? RouteEvalStatus::NoMoreRoutes
+                                                                : RouteEvalStatus::HasMoreRoutes;
+    RouteMatchStatus match_status = cb(route_entry, eval_status);
+    if (match_status == RouteMatchStatus::Accept) {
+      return route_entry;
+    }
+    if (match_status == RouteMatchStatus::Continue &&
+        eval_status == RouteEvalStatus::NoMoreRoutes) {
+      ENVOY_LOG(debug,
+                "return null when route match status is Continue but there is no more routes");
+      return nullptr;
+    }
+  }
+
+  ENVOY_LOG(debug, "route was resolved but final route list did not match incoming request");
+  return nullptr;
+}
+
 RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const RouteCallback& cb,
                                                          const Http::RequestHeaderMap& headers,
                                                          const StreamInfo::StreamInfo& stream_info,
@@ -1912,7 +2001,11 @@ RouteConstSharedPtr VirtualHostImpl::getRouteFromEntries(const RouteCallback& cb
     return nullptr;
   }
 
-  // Check for a route that matches the request.
+  // Check for a route that matches the request. Requests without a path can only match pathless
+  // routes, which are not worth indexing, so those always take the linear scan.
+  if (compiled_routes_ != nullptr && headers.Path() != nullptr) {
+    return getRouteFromCompiledRoutes(cb, headers, stream_info, random_value);
+  }
   return getRouteFromRoutes(cb, headers, stream_info, random_value, routes_);
 }
 
@@ -31,6 +31,7 @@
 #include "source/common/network/transport_socket_options_impl.h"
 #include "source/common/network/upstream_server_name.h"
 #include "source/common/network/upstream_subject_alt_names.h"
+#include "source/common/orca/orca_parser.h"
 #include "source/common/router/config_impl.h"
 #include "source/common/router/debug_config.h"
 #include "source/common/router/router.h"
@@ -148,6 +149,7 @@ UpstreamRequest::UpstreamRequest(RouterFilterInterface& parent,
     // cluster filter chain, which only consists of the codec filter.
     created = parent_.cluster()->createFilterChain(*filter_manager_, false);
   }
+  filter_manager_->finalizeFilterChain();
   // There will always be a codec filter present, which sets the upstream
   // interface. Fast-fail any tests that don't set up mocks correctly.
   ASSERT(created && upstream_interface_.has_value());
@@ -202,6 +204,19 @@ void UpstreamRequest::cleanUp() {
         FilterUtility::percentageOfTimeout(response_time, parent_.timeout().per_try_timeout_));
   }
 
+  // Let the host's load balancing policy see how long the request took, if it keeps per host
+  // state. Requests which never reached the upstream are not counted.
+  if (upstream_host_ != nullptr) {
+    OptRef<Upstream::HostLbPolicyData> lb_policy_data = upstream_host_->lbPolicyData();
+    const absl::optional<MonotonicTime>& first_tx = upstreamTiming().first_upstream_tx_byte_sent_;
+    if (lb_policy_data.has_value() && first_tx.has_value()) {
+      const MonotonicTime end_time = upstreamTiming().last_upstream_rx_byte_received_.value_or(
+          parent_.callbacks()->dispatcher().timeSource().monotonicTime());
+      lb_policy_data->onUpstreamRequestComplete(
+          std::chrono::duration_cast<std::chrono::microseconds>(end_time - first_tx.value()));
+    }
+  }
+
   // Ditto for request/response size histograms.
   Upstream::ClusterRequestResponseSizeStatsOptRef req_resp_stats_opt =
       parent_.cluster()->requestResponseSizeStats();
@@ -284,6 +299,7 @@ void UpstreamRequest::decodeHeaders(Http::ResponseHeaderMapPtr&& headers, bool e
     upstream_headers_ = Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*headers);
   }
   stream_info_.setResponseCode(static_cast<uint32_t>(response_code));
+  maybeReportOrcaLoad(*headers);
 
   maybeHandleDeferredReadDisable();
   ASSERT(headers.get());
@@ -321,9 +337,28 @@ void UpstreamRequest::decodeTrailers(Http::ResponseTrailerMapPtr&& trailers) {
   if (!parent_.config().upstream_logs_.empty()) {
     upstream_trailers_ = Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*trailers);
   }
+  maybeReportOrcaLoad(*trailers);
   parent_.onUpstreamTrailers(std::move(trailers), *this);
 }
 
+void UpstreamRequest::maybeReportOrcaLoad(const Http::HeaderMap& headers) {
+  if (upstream_host_ == nullptr) {
+    return;
+  }
+  OptRef<Upstream::HostLbPolicyData> lb_policy_data = upstream_host_->lbPolicyData();
+  if (!lb_policy_data.has_value() || !lb_policy_data->consumesOrcaLoadReports() ||
+      headers.get(Orca::endpointLoadMetricsHeaderBin()).empty()) {
+    return;
+  }
+  absl::StatusOr<Orca::OrcaLoadReport> report = Orca::parseOrcaLoadReportHeaders(headers);
+  if (report.ok()) {
+    lb_policy_data->onOrcaLoadReport(*report);
+  } else {
+    ENVOY_STREAM_LOG(debug, "ignoring ORCA load report: {}", *parent_.callbacks(),
+                     report.status().message());
+  }
+}
+
 void UpstreamRequest::dumpState(std::ostream& os, int indent_level) const {
   const char* spaces = spacesForLevel(indent_level);
   os << spaces << "UpstreamRequest " << this << "\n";
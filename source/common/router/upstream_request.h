@@ -130,6 +130,9 @@ public:
   // Called upon receiving the first response headers from the upstream. And
   // applies read disabling to it if there is any pending read disabling.
   void maybeHandleDeferredReadDisable();
+  // Hands the ORCA load report in the response headers or trailers, if any, to the load balancing
+  // policy of the upstream host, if it keeps per host state.
+  void maybeReportOrcaLoad(const Http::HeaderMap& headers);
 
   struct DownstreamWatermarkManager : public Http::DownstreamWatermarkCallbacks {
     DownstreamWatermarkManager(UpstreamRequest& parent) : parent_(parent) {}
@@ -78,6 +78,7 @@ RUNTIME_GUARD(envoy_reloadable_features_ssl_transport_failure_reason_format);
 RUNTIME_GUARD(envoy_reloadable_features_stateful_session_encode_ttl_in_cookie);
 RUNTIME_GUARD(envoy_reloadable_features_stop_decode_metadata_on_local_reply);
 RUNTIME_GUARD(envoy_reloadable_features_test_feature_true);
+RUNTIME_GUARD(envoy_reloadable_features_thread_aware_lb_rebuild_updated_priority_only);
 RUNTIME_GUARD(envoy_reloadable_features_thrift_allow_negative_field_ids);
 RUNTIME_GUARD(envoy_reloadable_features_thrift_connection_draining);
 RUNTIME_GUARD(envoy_reloadable_features_token_passed_entirely);
@@ -118,12 +119,24 @@ FALSE_RUNTIME_GUARD(envoy_reloadable_features_quic_reject_all);
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_use_libcurl_to_fetch_aws_credentials);
 // TODO(adisuissa): enable by default once this is tested in prod.
 FALSE_RUNTIME_GUARD(envoy_restart_features_use_eds_cache_for_ads);
+// TODO(wbpcode): flip after soak time on clusters with frequent host weight updates.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_edf_lb_incremental_refresh);
 // TODO(#10646) change to true when UHV is sufficiently tested
 // For more information about Universal Header Validation, please see
 // https://github.com/envoyproxy/envoy/issues/10646
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_enable_universal_header_validator);
 // TODO(pksohn): enable after fixing https://github.com/envoyproxy/envoy/issues/29930
 FALSE_RUNTIME_GUARD(envoy_reloadable_features_quic_defer_logging_to_ack_listener);
+// TODO(alyssawilk): flip once the route fuzzer compares both matchers.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_compiled_route_table_matcher);
+// TODO(jmarantz): flip after the EDS scale benchmarks show no update regression.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_intern_upstream_host_data);
+// TODO(KBaichoo): flip once the filter manager fuzzer runs clean with the arena enabled.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_http_stream_arena);
+// TODO(yanavlasov) flip after the HTTP/2 flood and flow control tests run with it enabled.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_http2_align_data_frames_to_slices);
+// TODO(yanavlasov) flip once the HTTP/1 codec fuzzer checks both serializers match.
+FALSE_RUNTIME_GUARD(envoy_reloadable_features_http1_batch_header_serialization);
 
 // Block of non-boolean flags. Use of int flags is deprecated. Do not add more.
 ABSL_FLAG(uint64_t, re2_max_program_size_error_level, 100, ""); // NOLINT
@@ -261,11 +261,8 @@ bool StatName::startsWith(StatName prefix) const {
 
 std::vector<absl::string_view> SymbolTable::decodeStrings(StatName stat_name) const {
   std::vector<absl::string_view> strings;
-  Thread::LockGuard lock(lock_);
   Encoding::decodeTokens(
-      stat_name,
-      [this, &strings](Symbol symbol)
-          ABSL_NO_THREAD_SAFETY_ANALYSIS { strings.push_back(fromSymbol(symbol)); },
+      stat_name, [this, &strings](Symbol symbol) { strings.push_back(fromSymbol(symbol)); },
       [&strings](absl::string_view str) { strings.push_back(str); });
   return strings;
 }
@@ -306,24 +303,25 @@ void SymbolTable::addTokensToEncoding(const absl::string_view name, Encoding& en
     return;
   }
 
-  // We want to hold the lock for the minimum amount of time, so we do the
-  // string-splitting and prepare a temp vector of Symbol first.
   const std::vector<absl::string_view> tokens = absl::StrSplit(name, '.');
   std::vector<Symbol> symbols;
   symbols.reserve(tokens.size());
 
-  // Now take the lock and populate the Symbol objects, which involves bumping
-  // ref-counts in this.
-  {
-    Thread::LockGuard lock(lock_);
+  if (track_recent_lookups_.load(std::memory_order_relaxed)) {
+    absl::MutexLock lock(&recent_lookups_lock_);
     recent_lookups_.lookup(name);
-    for (auto& token : tokens) {
-      // TODO(jmarantz): consider using StatNameDynamicStorage for tokens with
-      // length below some threshold, say 4 bytes. It might be preferable not to
-      // reserve Symbols for every 3 digit number found (for example) in ipv4
-      // addresses.
-      symbols.push_back(toSymbol(token));
-    }
+  } else {
+    untracked_lookups_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Populate the Symbol objects, which involves bumping ref-counts in this.
+  // Each token only locks the shard it belongs to.
+  for (auto& token : tokens) {
+    // TODO(jmarantz): consider using StatNameDynamicStorage for tokens with
+    // length below some threshold, say 4 bytes. It might be preferable not to
+    // reserve Symbols for every 3 digit number found (for example) in ipv4
+    // addresses.
+    symbols.push_back(toSymbol(token));
   }
 
   // Now efficiently encode the array of 32-bit symbols into a uint8_t array.
@@ -331,9 +329,12 @@ void SymbolTable::addTokensToEncoding(const absl::string_view name, Encoding& en
 }
 
 uint64_t SymbolTable::numSymbols() const {
-  Thread::LockGuard lock(lock_);
-  ASSERT(encode_map_.size() == decode_map_.size());
-  return encode_map_.size();
+  uint64_t num_symbols = 0;
+  for (const EncodeShard& shard : encode_shards_) {
+    absl::ReaderMutexLock lock(&shard.mutex_);
+    num_symbols += shard.map_.size();
+  }
+  return num_symbols;
 }
 
 std::string SymbolTable::toString(const StatName& stat_name) const {
@@ -341,65 +342,86 @@ std::string SymbolTable::toString(const StatName& stat_name) const {
 }
 
 void SymbolTable::incRefCount(const StatName& stat_name) {
-  // Before taking the lock, decode the array of symbols from the SymbolTable::Storage.
+  // Before taking any locks, decode the array of symbols from the SymbolTable::Storage.
   const SymbolVec symbols = Encoding::decodeSymbols(stat_name);
 
-  Thread::LockGuard lock(lock_);
   for (Symbol symbol : symbols) {
-    auto decode_search = decode_map_.find(symbol);
-
-    ASSERT(decode_search != decode_map_.end(),
-           "Please see "
-           "https://github.com/envoyproxy/envoy/blob/main/source/docs/stats.md#"
-           "debugging-symbol-table-assertions");
-    auto encode_search = encode_map_.find(decode_search->second->toStringView());
-    ASSERT(encode_search != encode_map_.end(),
+    // The caller holds a reference to stat_name, so the token stays in the table.
+    const absl::string_view token = fromSymbol(symbol);
+    EncodeShard& shard = encodeShard(token);
+    absl::ReaderMutexLock lock(&shard.mutex_);
+    auto encode_search = shard.map_.find(token);
+    ASSERT(encode_search != shard.map_.end(),
            "Please see "
            "https://github.com/envoyproxy/envoy/blob/main/source/docs/stats.md#"
            "debugging-symbol-table-assertions");
 
-    ++encode_search->second.ref_count_;
+    encode_search->second.ref_count_.fetch_add(1, std::memory_order_relaxed);
   }
 }
 
 void SymbolTable::free(const StatName& stat_name) {
-  // Before taking the lock, decode the array of symbols from the SymbolTable::Storage.
+  // Before taking any locks, decode the array of symbols from the SymbolTable::Storage.
   const SymbolVec symbols = Encoding::decodeSymbols(stat_name);
 
-  Thread::LockGuard lock(lock_);
   for (Symbol symbol : symbols) {
-    auto decode_search = decode_map_.find(symbol);
-    ASSERT(decode_search != decode_map_.end());
-
-    auto encode_search = encode_map_.find(decode_search->second->toStringView());
-    ASSERT(encode_search != encode_map_.end());
-
-    // If that was the last remaining client usage of the symbol, erase the
-    // current mappings and add the now-unused symbol to the reuse pool.
-    //
-    // The "if (--EXPR.ref_count_)" pattern speeds up BM_CreateRace by 20% in
-    // symbol_table_speed_test.cc, relative to breaking out the decrement into a
-    // separate step, likely due to the non-trivial dereferences in EXPR.
-    if (--encode_search->second.ref_count_ == 0) {
-      decode_map_.erase(decode_search);
-      encode_map_.erase(encode_search);
-      pool_.push(symbol);
+    freeSymbol(symbol);
+  }
+}
+
+void SymbolTable::freeSymbol(Symbol symbol) {
+  // The reference being dropped keeps the token in the table until the count
+  // is decremented below.
+  const absl::string_view token = fromSymbol(symbol);
+  EncodeShard& shard = encodeShard(token);
+  {
+    // Fast path: this is not the last reference, so a shared lock suffices.
+    absl::ReaderMutexLock lock(&shard.mutex_);
+    auto encode_search = shard.map_.find(token);
+    ASSERT(encode_search != shard.map_.end());
+    std::atomic<uint32_t>& ref_count = encode_search->second.ref_count_;
+    uint32_t count = ref_count.load(std::memory_order_relaxed);
+    while (count > 1) {
+      if (ref_count.compare_exchange_weak(count, count - 1, std::memory_order_relaxed)) {
+        return;
+      }
     }
   }
+
+  // This may be the last reference. Other threads may have taken new references
+  // since the shared lock was released, so check again under the exclusive lock.
+  absl::MutexLock lock(&shard.mutex_);
+  auto encode_search = shard.map_.find(token);
+  ASSERT(encode_search != shard.map_.end());
+  if (encode_search->second.ref_count_.fetch_sub(1, std::memory_order_relaxed) > 1) {
+    return;
+  }
+
+  // That was the last remaining client usage of the symbol, so erase the
+  // current mappings and add the now-unused symbol to the reuse pool. The
+  // encode map entry is erased first as its key refers to the decoded string.
+  shard.map_.erase(encode_search);
+  {
+    DecodeShard& decode_shard = decodeShard(symbol);
+    absl::MutexLock decode_lock(&decode_shard.mutex_);
+    decode_shard.map_.erase(symbol);
+  }
+  absl::MutexLock symbol_lock(&symbol_lock_);
+  pool_.push(symbol);
 }
 
 uint64_t SymbolTable::getRecentLookups(const RecentLookupsFn& iter) const {
   uint64_t total = 0;
   absl::flat_hash_map<std::string, uint64_t> name_count_map;
 
-  // We don't want to hold lock_ while calling the iterator, but we need it to
-  // access recent_lookups_, so we buffer in name_count_map.
+  // We don't want to hold recent_lookups_lock_ while calling the iterator, but
+  // we need it to access recent_lookups_, so we buffer in name_count_map.
   {
-    Thread::LockGuard lock(lock_);
+    absl::MutexLock lock(&recent_lookups_lock_);
     recent_lookups_.forEach(
         [&name_count_map](absl::string_view str, uint64_t count)
             ABSL_NO_THREAD_SAFETY_ANALYSIS { name_count_map[std::string(str)] += count; });
-    total += recent_lookups_.total();
+    total += recent_lookups_.total() + untracked_lookups_.load(std::memory_order_relaxed);
   }
 
   // Now we have the collated name-count map data: we need to vectorize and
@@ -445,17 +467,19 @@ DynamicSpans SymbolTable::getDynamicSpans(StatName stat_name) const {
 }
 
 void SymbolTable::setRecentLookupCapacity(uint64_t capacity) {
-  Thread::LockGuard lock(lock_);
+  absl::MutexLock lock(&recent_lookups_lock_);
   recent_lookups_.setCapacity(capacity);
+  track_recent_lookups_.store(capacity > 0, std::memory_order_relaxed);
 }
 
 void SymbolTable::clearRecentLookups() {
-  Thread::LockGuard lock(lock_);
+  absl::MutexLock lock(&recent_lookups_lock_);
   recent_lookups_.clear();
+  untracked_lookups_.store(0, std::memory_order_relaxed);
 }
 
 uint64_t SymbolTable::recentLookupCapacity() const {
-  Thread::LockGuard lock(lock_);
+  absl::MutexLock lock(&recent_lookups_lock_);
   return recent_lookups_.capacity();
 }
 
@@ -466,39 +490,66 @@ StatNameSetPtr SymbolTable::makeSet(absl::string_view name) {
 }
 
 Symbol SymbolTable::toSymbol(absl::string_view sv) {
-  Symbol result;
-  auto encode_find = encode_map_.find(sv);
-  // If the string segment doesn't already exist,
-  if (encode_find == encode_map_.end()) {
-    // We create the actual string, place it in the decode_map_, and then insert
-    // a string_view pointing to it in the encode_map_. This allows us to only
-    // store the string once. We use unique_ptr so copies are not made as
-    // flat_hash_map moves values around.
-    InlineStringPtr str = InlineString::create(sv);
-    auto encode_insert = encode_map_.insert({str->toStringView(), SharedSymbol(next_symbol_)});
-    ASSERT(encode_insert.second);
-    auto decode_insert = decode_map_.insert({next_symbol_, std::move(str)});
-    ASSERT(decode_insert.second);
-
-    result = next_symbol_;
-    newSymbol();
-  } else {
-    // If the insertion didn't take place, return the actual value at that location and up the
-    // refcount at that location
-    result = encode_find->second.symbol_;
-    ++(encode_find->second.ref_count_);
+  EncodeShard& shard = encodeShard(sv);
+  {
+    // Fast path: the token is already in the table, so we only need to bump
+    // its refcount, which a shared lock allows.
+    absl::ReaderMutexLock lock(&shard.mutex_);
+    auto encode_find = shard.map_.find(sv);
+    if (encode_find != shard.map_.end()) {
+      encode_find->second.ref_count_.fetch_add(1, std::memory_order_relaxed);
+      return encode_find->second.symbol_;
+    }
   }
-  return result;
+
+  absl::MutexLock lock(&shard.mutex_);
+  auto encode_find = shard.map_.find(sv);
+  if (encode_find != shard.map_.end()) {
+    // Another thread added the token since the shared lock was released.
+    encode_find->second.ref_count_.fetch_add(1, std::memory_order_relaxed);
+    return encode_find->second.symbol_;
+  }
+
+  // We create the actual string, place it in the decode map, and then insert
+  // a string_view pointing to it in the encode map. This allows us to only
+  // store the string once. We use unique_ptr so copies are not made as
+  // flat_hash_map moves values around.
+  InlineStringPtr str = InlineString::create(sv);
+  const Symbol symbol = allocateSymbol();
+  auto encode_insert = shard.map_.insert({str->toStringView(), SharedSymbol(symbol)});
+  ASSERT(encode_insert.second);
+  DecodeShard& decode_shard = decodeShard(symbol);
+  absl::MutexLock decode_lock(&decode_shard.mutex_);
+  auto decode_insert = decode_shard.map_.insert({symbol, std::move(str)});
+  ASSERT(decode_insert.second);
+  return symbol;
+}
+
+absl::string_view SymbolTable::fromSymbol(const Symbol symbol) const {
+  const DecodeShard& shard = decodeShard(symbol);
+  absl::ReaderMutexLock lock(&shard.mutex_);
+  auto search = shard.map_.find(symbol);
+  RELEASE_ASSERT(search != shard.map_.end(), "no such symbol");
+  // The string is owned by the decode map entry, which is not moved by rehashing and is not
+  // erased while the caller holds a reference to the symbol.
+  return search->second->toStringView();
 }
 
-absl::string_view SymbolTable::fromSymbol(const Symbol symbol) const
-    ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
-  auto search = decode_map_.find(symbol);
-  RELEASE_ASSERT(search != decode_map_.end(), "no such symbol");
+absl::string_view SymbolTable::fromSymbolLockHeld(const Symbol symbol) const {
+  const DecodeShard& shard = decodeShard(symbol);
+  auto search = shard.map_.find(symbol);
+  RELEASE_ASSERT(search != shard.map_.end(), "no such symbol");
   return search->second->toStringView();
 }
 
-void SymbolTable::newSymbol() ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+Symbol SymbolTable::allocateSymbol() {
+  absl::MutexLock lock(&symbol_lock_);
+  const Symbol symbol = next_symbol_;
+  newSymbol();
+  return symbol;
+}
+
+void SymbolTable::newSymbol() {
   if (pool_.empty()) {
     next_symbol_ = ++monotonic_counter_;
   } else {
@@ -509,16 +560,8 @@ void SymbolTable::newSymbol() ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
   ASSERT(monotonic_counter_ != 0);
 }
 
-bool SymbolTable::lessThan(const StatName& a, const StatName& b) const {
-  // Proactively take the table lock in anticipation that we'll need to
-  // convert at least one symbol to a string_view, and it's easier not to
-  // bother to lazily take the lock.
-  Thread::LockGuard lock(lock_);
-  return lessThanLockHeld(a, b);
-}
-
-bool SymbolTable::lessThanLockHeld(const StatName& a, const StatName& b) const
-    ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+template <class FromSymbol>
+bool SymbolTable::lessThan(const StatName& a, const StatName& b, FromSymbol from_symbol) const {
   Encoding::TokenIter a_iter(a), b_iter(b);
   while (true) {
     Encoding::TokenIter::TokenType a_type = a_iter.next();
@@ -535,10 +578,10 @@ bool SymbolTable::lessThanLockHeld(const StatName& a, const StatName& b) const
     }
 
     absl::string_view a_token = a_type == Encoding::TokenIter::TokenType::Symbol
-                                    ? fromSymbol(a_iter.symbol())
+                                    ? from_symbol(a_iter.symbol())
                                     : a_iter.stringView();
     absl::string_view b_token = b_type == Encoding::TokenIter::TokenType::Symbol
-                                    ? fromSymbol(b_iter.symbol())
+                                    ? from_symbol(b_iter.symbol())
                                     : b_iter.stringView();
     if (a_token != b_token) {
       return a_token < b_token;
@@ -546,18 +589,29 @@ bool SymbolTable::lessThanLockHeld(const StatName& a, const StatName& b) const
   }
 }
 
+bool SymbolTable::lessThan(const StatName& a, const StatName& b) const {
+  return lessThan(a, b, [this](Symbol symbol) { return fromSymbol(symbol); });
+}
+
+bool SymbolTable::lessThanLockHeld(const StatName& a, const StatName& b) const {
+  return lessThan(a, b, [this](Symbol symbol) { return fromSymbolLockHeld(symbol); });
+}
+
 #ifndef ENVOY_CONFIG_COVERAGE
 void SymbolTable::debugPrint() const {
-  Thread::LockGuard lock(lock_);
-  std::vector<Symbol> symbols;
-  for (const auto& p : decode_map_) {
-    symbols.push_back(p.first);
+  std::vector<std::pair<Symbol, absl::string_view>> symbols;
+  for (const DecodeShard& shard : decode_shards_) {
+    absl::ReaderMutexLock lock(&shard.mutex_);
+    for (const auto& p : shard.map_) {
+      symbols.emplace_back(p.first, p.second->toStringView());
+    }
   }
   std::sort(symbols.begin(), symbols.end());
-  for (Symbol symbol : symbols) {
-    const InlineString& token = *decode_map_.find(symbol)->second;
-    const SharedSymbol& shared_symbol = encode_map_.find(token.toStringView())->second;
-    ENVOY_LOG_MISC(info, "{}: '{}' ({})", symbol, token.toStringView(), shared_symbol.ref_count_);
+  for (const auto& [symbol, token] : symbols) {
+    const EncodeShard& shard = encodeShard(token);
+    absl::ReaderMutexLock lock(&shard.mutex_);
+    const SharedSymbol& shared_symbol = shard.map_.find(token)->second;
+    ENVOY_LOG_MISC(info, "{}: '{}' ({})", symbol, token, shared_symbol.ref_count_.load());
   }
 }
 #endif
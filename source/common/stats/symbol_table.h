@@ -1,13 +1,14 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <memory>
 #include <stack>
 #include <string>
 #include <vector>
 
 #include "source/common/common/assert.h"
-#include "source/common/common/lock_guard.h"
 #include "source/common/common/mem_block_builder.h"
 #include "source/common/common/non_copyable.h"
 #include "source/common/common/thread.h"
@@ -17,8 +18,10 @@
 #include "absl/container/fixed_array.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/inlined_vector.h"
+#include "absl/hash/hash.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
+#include "absl/synchronization/mutex.h"
 
 namespace Envoy {
 namespace Stats {
@@ -72,6 +75,13 @@ using SymbolVec = std::vector<Symbol>;
  * that if a string is encoded, the resulting stat is destroyed, and then that
  * same string is re-encoded, it may or may not encode to the same underlying
  * symbol.
+ *
+ * The table is split into shards so that threads creating stat names rarely
+ * contend with each other. Tokens are sharded by hash for encoding and symbols
+ * are sharded by value for decoding. Encoding a token which is already in the
+ * table, and dropping a reference which is not the last one, only take a shared
+ * lock on one shard. Adding and removing tokens take an exclusive lock on the
+ * shards involved.
  */
 class SymbolTable final {
 public:
@@ -324,8 +334,6 @@ public:
    */
   DynamicSpans getDynamicSpans(StatName stat_name) const;
 
-  bool lessThanLockHeld(const StatName& a, const StatName& b) const;
-
   template <class GetStatName, class Obj> struct StatNameCompare {
     StatNameCompare(const SymbolTable& symbol_table, GetStatName getter)
         : symbol_table_(symbol_table), getter_(getter) {}
@@ -337,9 +345,9 @@ public:
   };
 
   /**
-   * Sorts a range by StatName. This API is more efficient than
-   * calling std::sort directly as it takes a single lock for the
-   * entire sort, rather than locking on each comparison.
+   * Sorts a range by StatName. The decode shards are locked once for the whole
+   * sort rather than for every symbol compared, so get_stat_name must not call
+   * back into the symbol table.
    *
    * @param begin the beginning of the range to sort
    * @param end the end of the range to sort
@@ -347,11 +355,10 @@ public:
    */
   template <class Obj, class Iter, class GetStatName>
   void sortByStatNames(Iter begin, Iter end, GetStatName get_stat_name) const {
-    // Grab the lock once before sorting begins, so we don't have to re-take
-    // it on every comparison.
-    Thread::LockGuard lock(lock_);
-    StatNameCompare<GetStatName, Obj> compare(*this, get_stat_name);
-    std::sort(begin, end, compare);
+    DecodeShardsReaderLock lock(*this);
+    std::sort(begin, end, [this, &get_stat_name](const Obj& a, const Obj& b) {
+      return lessThanLockHeld(get_stat_name(a), get_stat_name(b));
+    });
   }
 
 private:
@@ -395,15 +402,74 @@ private:
    */
   void incRefCount(const StatName& stat_name);
 
+  static constexpr uint32_t NumShards = 16;
+
   struct SharedSymbol {
     SharedSymbol(Symbol symbol) : symbol_(symbol) {}
+    // Entries are only moved while their shard is locked exclusively, so the
+    // reference count cannot change concurrently.
+    SharedSymbol(SharedSymbol&& other) noexcept
+        : symbol_(other.symbol_), ref_count_(other.ref_count_.load(std::memory_order_relaxed)) {}
+    SharedSymbol& operator=(SharedSymbol&& other) noexcept {
+      symbol_ = other.symbol_;
+      ref_count_.store(other.ref_count_.load(std::memory_order_relaxed),
+                       std::memory_order_relaxed);
+      return *this;
+    }
 
     Symbol symbol_;
-    uint32_t ref_count_{1};
+    // Incremented with only a shared lock on the shard. It is only decremented
+    // to zero with the shard locked exclusively, together with erasing the
+    // entry, so a reader never observes a zero count.
+    std::atomic<uint32_t> ref_count_{1};
+  };
+
+  // The encode map stores both the symbol and the ref count of that symbol.
+  // Using absl::string_view lets us only store the complete string once, in the decode map.
+  using EncodeMap = absl::flat_hash_map<absl::string_view, SharedSymbol>;
+  using DecodeMap = absl::flat_hash_map<Symbol, InlineStringPtr>;
+
+  // Shards are aligned to separate cache lines so that locking one shard does
+  // not slow down threads using its neighbors.
+  struct alignas(64) EncodeShard {
+    mutable absl::Mutex mutex_;
+    EncodeMap map_ ABSL_GUARDED_BY(mutex_);
   };
+  struct alignas(64) DecodeShard {
+    mutable absl::Mutex mutex_;
+    DecodeMap map_ ABSL_GUARDED_BY(mutex_);
+  };
+
+  EncodeShard& encodeShard(absl::string_view token) {
+    return encode_shards_[absl::Hash<absl::string_view>()(token) % NumShards];
+  }
+  const EncodeShard& encodeShard(absl::string_view token) const {
+    return encode_shards_[absl::Hash<absl::string_view>()(token) % NumShards];
+  }
+  DecodeShard& decodeShard(Symbol symbol) { return decode_shards_[symbol % NumShards]; }
+  const DecodeShard& decodeShard(Symbol symbol) const {
+    return decode_shards_[symbol % NumShards];
+  }
+
+  // Holds a reader lock on every decode shard, taken in shard order, so that
+  // many symbols can be decoded with fromSymbolLockHeld().
+  class DecodeShardsReaderLock {
+  public:
+    explicit DecodeShardsReaderLock(const SymbolTable& symbol_table)
+        ABSL_NO_THREAD_SAFETY_ANALYSIS : shards_(symbol_table.decode_shards_) {
+      for (const DecodeShard& shard : shards_) {
+        shard.mutex_.ReaderLock();
+      }
+    }
+    ~DecodeShardsReaderLock() ABSL_NO_THREAD_SAFETY_ANALYSIS {
+      for (auto shard = shards_.rbegin(); shard != shards_.rend(); ++shard) {
+        shard->mutex_.ReaderUnlock();
+      }
+    }
 
-  // This must be held during both encode() and free().
-  mutable Thread::MutexBasicLockable lock_;
+  private:
+    const std::array<DecodeShard, NumShards>& shards_;
+  };
 
   /**
    * Decodes a uint8_t array into an array of period-delimited strings. Note
@@ -426,20 +492,51 @@ private:
    * @param sv the individual string to be encoded as a symbol.
    * @return Symbol the encoded string.
    */
-  Symbol toSymbol(absl::string_view sv) ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  Symbol toSymbol(absl::string_view sv);
 
   /**
-   * Convenience function for decode(), decoding one symbol at a time.
+   * Convenience function for decode(), decoding one symbol at a time. The
+   * caller must hold a reference to the symbol for as long as it uses the
+   * returned string.
    *
    * @param symbol the individual symbol to be decoded.
    * @return absl::string_view the decoded string.
    */
-  absl::string_view fromSymbol(Symbol symbol) const ABSL_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  absl::string_view fromSymbol(Symbol symbol) const;
+
+  /**
+   * Like fromSymbol(), for callers holding a DecodeShardsReaderLock.
+   */
+  absl::string_view fromSymbolLockHeld(Symbol symbol) const ABSL_NO_THREAD_SAFETY_ANALYSIS;
+
+  /**
+   * Like lessThan(), for callers holding a DecodeShardsReaderLock.
+   */
+  bool lessThanLockHeld(const StatName& a, const StatName& b) const;
+
+  /**
+   * Compares two stat names, decoding symbols with from_symbol.
+   */
+  template <class FromSymbol>
+  bool lessThan(const StatName& a, const StatName& b, FromSymbol from_symbol) const;
+
+  /**
+   * Drops one reference to a symbol, removing it from the table if that was
+   * the last reference.
+   *
+   * @param symbol the symbol to release.
+   */
+  void freeSymbol(Symbol symbol);
+
+  /**
+   * @return a symbol for a token being added to the table.
+   */
+  Symbol allocateSymbol();
 
   /**
    * Stages a new symbol for use. To be called after a successful insertion.
    */
-  void newSymbol();
+  void newSymbol() ABSL_EXCLUSIVE_LOCKS_REQUIRED(symbol_lock_);
 
   /**
    * Tokenizes name, finds or allocates symbols for each token, and adds them
@@ -451,30 +548,35 @@ private:
   void addTokensToEncoding(absl::string_view name, Encoding& encoding);
 
   Symbol monotonicCounter() {
-    Thread::LockGuard lock(lock_);
+    absl::MutexLock lock(&symbol_lock_);
     return monotonic_counter_;
   }
 
+  std::array<EncodeShard, NumShards> encode_shards_;
+  std::array<DecodeShard, NumShards> decode_shards_;
+
+  // Guards allocation and release of symbols. Taken while holding a shard lock, never the
+  // other way around.
+  absl::Mutex symbol_lock_;
+
   // Stores the symbol to be used at next insertion. This should exist ahead of insertion time so
   // that if insertion succeeds, the value written is the correct one.
-  Symbol next_symbol_ ABSL_GUARDED_BY(lock_);
+  Symbol next_symbol_ ABSL_GUARDED_BY(symbol_lock_);
 
   // If the free pool is exhausted, we monotonically increase this counter.
-  Symbol monotonic_counter_;
-
-  // Bitmap implementation.
-  // The encode map stores both the symbol and the ref count of that symbol.
-  // Using absl::string_view lets us only store the complete string once, in the decode map.
-  using EncodeMap = absl::flat_hash_map<absl::string_view, SharedSymbol>;
-  using DecodeMap = absl::flat_hash_map<Symbol, InlineStringPtr>;
-  EncodeMap encode_map_ ABSL_GUARDED_BY(lock_);
-  DecodeMap decode_map_ ABSL_GUARDED_BY(lock_);
+  Symbol monotonic_counter_ ABSL_GUARDED_BY(symbol_lock_);
 
   // Free pool of symbols for re-use.
   // TODO(ambuc): There might be an optimization here relating to storing ranges of freed symbols
   // using an Envoy::IntervalSet.
-  std::stack<Symbol> pool_ ABSL_GUARDED_BY(lock_);
-  RecentLookups recent_lookups_ ABSL_GUARDED_BY(lock_);
+  std::stack<Symbol> pool_ ABSL_GUARDED_BY(symbol_lock_);
+
+  // Recent lookups are only recorded under recent_lookups_lock_ when a capacity is set, which
+  // is rare. Otherwise only the number of lookups is tracked, in untracked_lookups_.
+  mutable absl::Mutex recent_lookups_lock_;
+  RecentLookups recent_lookups_ ABSL_GUARDED_BY(recent_lookups_lock_);
+  std::atomic<bool> track_recent_lookups_{false};
+  std::atomic<uint64_t> untracked_lookups_{0};
 };
 
 // Base class for holding the backing-storing for a StatName. The two derived
@@ -1055,7 +1157,7 @@ template <class GetStatName, class Obj>
 bool SymbolTable::StatNameCompare<GetStatName, Obj>::operator()(const Obj& a, const Obj& b) const {
   StatName a_stat_name = getter_(a);
   StatName b_stat_name = getter_(b);
-  return symbol_table_.lessThanLockHeld(a_stat_name, b_stat_name);
+  return symbol_table_.lessThan(a_stat_name, b_stat_name);
 }
 
 using SymbolTablePtr = std::unique_ptr<SymbolTable>;
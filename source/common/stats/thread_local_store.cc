@@ -820,10 +820,14 @@ void ThreadLocalHistogramImpl::recordValue(uint64_t value) {
   used_ = true;
 }
 
-void ThreadLocalHistogramImpl::merge(histogram_t* target) {
+bool ThreadLocalHistogramImpl::merge(histogram_t* target) {
   histogram_t** other_histogram = &histograms_[otherHistogramIndex()];
+  if (hist_num_buckets(*other_histogram) == 0) {
+    return false;
+  }
   hist_accumulate(target, other_histogram, 1);
   hist_clear(*other_histogram);
+  return true;
 }
 
 ParentHistogramImpl::ParentHistogramImpl(StatName name, Histogram::Unit unit,
@@ -911,19 +915,32 @@ bool ParentHistogramImpl::hidden() const { return false; }
 void ParentHistogramImpl::merge() {
   Thread::ReleasableLockGuard lock(merge_lock_);
   if (merged_ || usedLockHeld()) {
-    hist_clear(interval_histogram_);
+    const bool interval_was_empty = hist_num_buckets(interval_histogram_) == 0;
+    if (!interval_was_empty) {
+      hist_clear(interval_histogram_);
+    }
     // Here we could copy all the pointers to TLS histograms in the tls_histogram_ list,
     // then release the lock before we do the actual merge. However it is not a big deal
     // because the tls_histogram merge is not that expensive as it is a single histogram
     // merge and adding TLS histograms is rare.
+    bool recorded = false;
     for (const TlsHistogramSharedPtr& tls_histogram : tls_histograms_) {
-      tls_histogram->merge(interval_histogram_);
+      if (tls_histogram->merge(interval_histogram_)) {
+        recorded = true;
+      }
     }
     // Since TLS merge is done, we can release the lock here.
     lock.release();
-    hist_accumulate(cumulative_histogram_, &interval_histogram_, 1);
-    cumulative_statistics_.refresh(cumulative_histogram_);
-    interval_statistics_.refresh(interval_histogram_);
+    if (recorded) {
+      hist_accumulate(cumulative_histogram_, &interval_histogram_, 1);
+      cumulative_statistics_.refresh(cumulative_histogram_);
+      interval_statistics_.refresh(interval_histogram_);
+    } else if (!interval_was_empty) {
+      // Nothing was recorded in this interval, so the cumulative histogram is unchanged. Most
+      // histograms of a large store are idle in a given interval, and skipping them keeps the
+      // cost of a flush proportional to the histograms that were actually recorded.
+      interval_statistics_.refresh(interval_histogram_);
+    }
     merged_ = true;
   }
 }
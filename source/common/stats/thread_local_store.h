@@ -37,7 +37,12 @@ public:
                            const StatNameTagVector& stat_name_tags, SymbolTable& symbol_table);
   ~ThreadLocalHistogramImpl() override;
 
-  void merge(histogram_t* target);
+  /**
+   * Merges the values collected before the last beginMerge() into target and clears them, keeping
+   * the histogram's storage for reuse.
+   * @return whether any values were collected.
+   */
+  bool merge(histogram_t* target);
 
   /**
    * Called in the beginning of merge process. Swaps the histogram used for collection so that we do
@@ -96,7 +101,8 @@ public:
    * This method is called during the main stats flush process for each of the histograms. It
    * iterates through the TLS histograms and collects the histogram data of all of them
    * in to "interval_histogram". Then the collected "interval_histogram" is merged to a
-   * "cumulative_histogram".
+   * "cumulative_histogram". Statistics are only recomputed if something was recorded since the
+   * previous merge, or if the previous interval was not empty.
    */
   void merge() override;
 
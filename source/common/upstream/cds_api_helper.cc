@@ -7,12 +7,19 @@
 
 #include "source/common/common/fmt.h"
 #include "source/common/config/resource_name.h"
+#include "source/common/protobuf/utility.h"
 #include "source/common/runtime/runtime_features.h"
 
 #include "absl/container/flat_hash_set.h"
 
 namespace Envoy {
 namespace Upstream {
+namespace {
+
+// Smaller updates are not worth the cost of starting threads to hash them.
+constexpr size_t MinClustersToHashInParallel = 16;
+
+} // namespace
 
 std::vector<std::string>
 CdsApiHelper::onConfigUpdate(const std::vector<Config::DecodedResourceRef>& added_resources,
@@ -36,7 +43,18 @@ CdsApiHelper::onConfigUpdate(const std::vector<Config::DecodedResourceRef>& adde
   bool any_applied = false;
   uint32_t added_or_updated = 0;
   uint32_t skipped = 0;
-  for (const auto& resource : added_resources) {
+  // Hashing the cluster configurations is CPU heavy and thread safe, so when enabled all of them
+  // are hashed in parallel up front. The clusters are still applied one by one below.
+  std::vector<uint64_t> cluster_hashes;
+  if (cm_.configIngestionConcurrency() > 1 &&
+      added_resources.size() >= MinClustersToHashInParallel) {
+    cluster_hashes.resize(added_resources.size());
+    cm_.configIngestionParallelFor(added_resources.size(), [&](size_t index) {
+      cluster_hashes[index] = MessageUtil::hash(added_resources[index].get().resource());
+    });
+  }
+  for (size_t index = 0; index < added_resources.size(); ++index) {
+    const auto& resource = added_resources[index];
     envoy::config::cluster::v3::Cluster cluster;
     TRY_ASSERT_MAIN_THREAD {
       cluster = dynamic_cast<const envoy::config::cluster::v3::Cluster&>(resource.get().resource());
@@ -46,7 +64,11 @@ CdsApiHelper::onConfigUpdate(const std::vector<Config::DecodedResourceRef>& adde
             fmt::format("{}: duplicate cluster {} found", cluster.name(), cluster.name()));
         continue;
       }
-      if (cm_.addOrUpdateCluster(cluster, resource.get().version())) {
+      const bool applied =
+          cluster_hashes.empty()
+              ? cm_.addOrUpdateCluster(cluster, resource.get().version())
+              : cm_.addOrUpdateCluster(cluster, resource.get().version(), cluster_hashes[index]);
+      if (applied) {
         any_applied = true;
         ENVOY_LOG(debug, "{}: add/update cluster '{}'", name_, cluster.name());
         ++added_or_updated;
@@ -24,6 +24,7 @@
 #include "source/common/common/assert.h"
 #include "source/common/common/enum_to_int.h"
 #include "source/common/common/fmt.h"
+#include "source/common/common/thread.h"
 #include "source/common/common/utility.h"
 #include "source/common/config/custom_config_validators_impl.h"
 #include "source/common/config/null_grpc_mux_impl.h"
@@ -304,6 +305,9 @@ ClusterManagerImpl::ClusterManagerImpl(
     : server_(server), factory_(factory), runtime_(runtime), stats_(stats), tls_(tls),
       random_(api.randomGenerator()),
       deferred_cluster_creation_(bootstrap.cluster_manager().enable_deferred_cluster_creation()),
+      config_ingestion_concurrency_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+          bootstrap.cluster_manager(), config_ingestion_concurrency, 1)),
+      thread_factory_(api.threadFactory()),
       bind_config_(bootstrap.cluster_manager().has_upstream_bind_config()
                        ? absl::make_optional(bootstrap.cluster_manager().upstream_bind_config())
                        : absl::nullopt),
@@ -749,6 +753,18 @@ void ClusterManagerImpl::applyUpdates(ClusterManagerCluster& cluster, uint32_t p
 
 bool ClusterManagerImpl::addOrUpdateCluster(const envoy::config::cluster::v3::Cluster& cluster,
                                             const std::string& version_info) {
+  return addOrUpdateCluster(cluster, version_info, MessageUtil::hash(cluster));
+}
+
+void ClusterManagerImpl::configIngestionParallelFor(size_t count,
+                                                    const std::function<void(size_t)>& fn) {
+  ASSERT_IS_MAIN_OR_TEST_THREAD();
+  Thread::parallelFor(thread_factory_, config_ingestion_concurrency_, count, fn);
+}
+
+bool ClusterManagerImpl::addOrUpdateCluster(const envoy::config::cluster::v3::Cluster& cluster,
+                                            const std::string& version_info,
+                                            uint64_t cluster_hash) {
   // First we need to see if this new config is new or an update to an existing dynamic cluster.
   // We don't allow updates to statically configured clusters in the main configuration. We check
   // both the warming clusters and the active clusters to see if we need an update or the update
@@ -756,7 +772,7 @@ bool ClusterManagerImpl::addOrUpdateCluster(const envoy::config::cluster::v3::Cl
   const std::string& cluster_name = cluster.name();
   const auto existing_active_cluster = active_clusters_.find(cluster_name);
   const auto existing_warming_cluster = warming_clusters_.find(cluster_name);
-  const uint64_t new_hash = MessageUtil::hash(cluster);
+  const uint64_t new_hash = cluster_hash;
   if (existing_warming_cluster != warming_clusters_.end()) {
     // If the cluster is the same as the warming cluster of the same name, block the update.
     if (existing_warming_cluster->second->blockUpdate(new_hash)) {
@@ -1281,6 +1297,14 @@ void ClusterManagerImpl::postThreadLocalClusterUpdate(ClusterManagerCluster& cm_
             per_priority.weighted_priority_health_, per_priority.overprovisioning_factor_, map);
       }
 
+      // Connect to the healthy hosts that have no connection pools yet, i.e. to all hosts of a new
+      // cluster before its users learn about it, and to the hosts that were added to or became
+      // healthy in an existing one.
+      if (auto it = cluster_manager->thread_local_clusters_.find(info->name());
+          it != cluster_manager->thread_local_clusters_.end()) {
+        it->second->warmConnPools();
+      }
+
       if (new_cluster != nullptr) {
         ThreadLocalClusterCommand command = [&new_cluster]() -> ThreadLocalCluster& {
           return *new_cluster;
@@ -1551,6 +1575,50 @@ void ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::drainConnP
   }
 }
 
+void ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::warmConnPools() {
+  const uint32_t warm_connections = cluster_info_->perUpstreamWarmConnections();
+  // The main thread does not proxy traffic, so it has no use for warm connections.
+  if (warm_connections == 0 || Envoy::Thread::MainThread::isMainThread()) {
+    return;
+  }
+  // The key of the HTTP pools streams use depends on their downstream connection if the cluster
+  // uses the downstream protocol or a pool per downstream connection. No stream would ever use a
+  // pool warmed without one.
+  if (!cluster_info_->warmTcpConnectionPools() &&
+      ((cluster_info_->features() & ClusterInfo::Features::USE_DOWNSTREAM_PROTOCOL) ||
+       cluster_info_->connectionPoolPerDownstreamConnection())) {
+    return;
+  }
+
+  for (const auto& host_set : priority_set_.hostSetsPerPriority()) {
+    for (const HostSharedPtr& host : host_set->healthyHosts()) {
+      // Hosts that already have connection pools were warmed by an earlier update, or carry
+      // traffic already.
+      ConnectionPool::Instance* pool = nullptr;
+      if (cluster_info_->warmTcpConnectionPools()) {
+        if (parent_.host_tcp_conn_pool_map_.contains(host)) {
+          continue;
+        }
+        pool = tcpConnPoolImpl(host, ResourcePriority::Default, nullptr);
+      } else {
+        if (parent_.host_http_conn_pool_map_.contains(host)) {
+          continue;
+        }
+        // Without a downstream protocol, socket options or transport socket options this is the
+        // key the router builds for streams of routes at the default priority.
+        pool = httpConnPoolImpl(host, ResourcePriority::Default, absl::nullopt, nullptr);
+      }
+      // Every preconnect establishes at most one connection, and fails once the pool can serve
+      // warm_connections streams, or hits its circuit breakers.
+      for (uint32_t i = 0; pool != nullptr && i < warm_connections; ++i) {
+        if (!pool->maybePreconnect(warm_connections)) {
+          break;
+        }
+      }
+    }
+  }
+}
+
 ClusterUpdateCallbacksHandlePtr
 ClusterManagerImpl::addThreadLocalClusterUpdateCallbacks(ClusterUpdateCallbacks& cb) {
   ThreadLocalClusterManagerImpl& cluster_manager = *tls_;
@@ -1988,6 +2056,13 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::httpConnPoolImp
     return nullptr;
   }
 
+  return httpConnPoolImpl(std::move(host), priority, downstream_protocol, context);
+}
+
+Http::ConnectionPool::Instance*
+ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::httpConnPoolImpl(
+    HostConstSharedPtr host, ResourcePriority priority,
+    absl::optional<Http::Protocol> downstream_protocol, LoadBalancerContext* context) {
   // Right now, HTTP, HTTP/2 and ALPN pools are considered separate.
   // We could do better here, and always use the ALPN pool and simply make sure
   // we end up on a connection of the correct protocol, but for simplicity we're
@@ -2118,6 +2193,12 @@ ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::tcpConnPoolImpl
     return nullptr;
   }
 
+  return tcpConnPoolImpl(std::move(host), priority, context);
+}
+
+Tcp::ConnectionPool::Instance*
+ClusterManagerImpl::ThreadLocalClusterManagerImpl::ClusterEntry::tcpConnPoolImpl(
+    HostConstSharedPtr host, ResourcePriority priority, LoadBalancerContext* context) {
   // Inherit socket options from downstream connection, if set.
   std::vector<uint8_t> hash_key = {uint8_t(priority)};
 
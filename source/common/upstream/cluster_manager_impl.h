@@ -265,6 +265,10 @@ public:
   // Upstream::ClusterManager
   bool addOrUpdateCluster(const envoy::config::cluster::v3::Cluster& cluster,
                           const std::string& version_info) override;
+  bool addOrUpdateCluster(const envoy::config::cluster::v3::Cluster& cluster,
+                          const std::string& version_info, uint64_t cluster_hash) override;
+  uint32_t configIngestionConcurrency() const override { return config_ingestion_concurrency_; }
+  void configIngestionParallelFor(size_t count, const std::function<void(size_t)>& fn) override;
 
   void setPrimaryClustersInitializedCb(PrimaryClustersReadyCallback callback) override {
     init_helper_.setPrimaryClustersInitializedCb(callback);
@@ -614,15 +618,25 @@ private:
       // Drain any connection pools associated with the hosts filtered by the predicate.
       void drainConnPools(DrainConnectionsHostPredicate predicate,
                           ConnectionPool::DrainBehavior behavior);
+      // Establishes the configured number of connections to each healthy host without connection
+      // pools ahead of traffic. Does nothing on the main thread.
+      void warmConnPools();
 
     private:
       Http::ConnectionPool::Instance*
       httpConnPoolImpl(ResourcePriority priority,
                        absl::optional<Http::Protocol> downstream_protocol,
                        LoadBalancerContext* context, bool peek);
+      Http::ConnectionPool::Instance*
+      httpConnPoolImpl(HostConstSharedPtr host, ResourcePriority priority,
+                       absl::optional<Http::Protocol> downstream_protocol,
+                       LoadBalancerContext* context);
 
       Tcp::ConnectionPool::Instance* tcpConnPoolImpl(ResourcePriority priority,
                                                      LoadBalancerContext* context, bool peek);
+      Tcp::ConnectionPool::Instance* tcpConnPoolImpl(HostConstSharedPtr host,
+                                                     ResourcePriority priority,
+                                                     LoadBalancerContext* context);
 
       HostConstSharedPtr chooseHost(LoadBalancerContext* context);
       HostConstSharedPtr peekAnotherHost(LoadBalancerContext* context);
@@ -889,6 +903,8 @@ private:
   Random::RandomGenerator& random_;
   ClusterMap warming_clusters_;
   const bool deferred_cluster_creation_;
+  const uint32_t config_ingestion_concurrency_;
+  Thread::ThreadFactory& thread_factory_;
   absl::optional<envoy::config::core::v3::BindConfig> bind_config_;
   Outlier::EventLoggerSharedPtr outlier_event_logger_;
   const LocalInfo::LocalInfo& local_info_;
@@ -1,7 +1,11 @@
 #pragma once
+#include <algorithm>
 #include <cstdint>
+#include <functional>
 #include <iostream>
+#include <list>
 #include <queue>
+#include <vector>
 
 #include "envoy/upstream/scheduler.h"
 
@@ -64,6 +68,24 @@ public:
 
   bool empty() const override { return queue_.empty(); }
 
+  /**
+   * Removes every entry for which keep returns false, along with expired entries. Remaining
+   * entries keep their deadlines, so the schedule carries on where it was. keep is called once
+   * per unexpired entry. Pending peeks are discarded. This is O(n), as opposed to the
+   * O(n * log n) of building a new scheduler from the remaining entries.
+   */
+  void retainIf(const std::function<bool(const C&)>& keep) {
+    auto& entries = queue_.entries();
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [&keep](const EdfEntry& edf_entry) {
+                                   std::shared_ptr<C> entry = edf_entry.entry_.lock();
+                                   return entry == nullptr || !keep(*entry);
+                                 }),
+                  entries.end());
+    queue_.reheap();
+    prepick_list_.clear();
+  }
+
 private:
   /**
    * Clears expired entries and pops the next unexpired entry in the queue.
@@ -113,8 +135,15 @@ private:
   // Offset used during addition to break ties when entries have the same weight but should reflect
   // FIFO insertion order in picks.
   uint64_t order_offset_{};
+  // std::priority_queue with access to the underlying container, for retainIf().
+  class Queue : public std::priority_queue<EdfEntry> {
+  public:
+    std::vector<EdfEntry>& entries() { return this->c; }
+    void reheap() { std::make_heap(this->c.begin(), this->c.end(), this->comp); }
+  };
+
   // Min priority queue for EDF.
-  std::priority_queue<EdfEntry> queue_;
+  Queue queue_;
   std::list<std::weak_ptr<C>> prepick_list_;
 };
 
@@ -0,0 +1,65 @@
+#include "source/common/upstream/host_intern_pool.h"
+
+#include <algorithm>
+
+#include "source/common/common/assert.h"
+#include "source/common/common/thread.h"
+
+namespace Envoy {
+namespace Upstream {
+namespace {
+
+// The address pool is not swept until it holds at least this many entries.
+constexpr size_t MinAddressPoolSweepSize = 1024;
+
+} // namespace
+
+SINGLETON_MANAGER_REGISTRATION(host_intern_pool);
+
+HostInternPool::HostInternPool(Event::Dispatcher& dispatcher)
+    : localities_(std::make_shared<SharedPool::ObjectSharedPool<
+                      const envoy::config::core::v3::Locality, MessageUtil, MessageUtil>>(
+          dispatcher)),
+      next_sweep_size_(MinAddressPoolSweepSize) {}
+
+HostInternPoolSharedPtr HostInternPool::get(Singleton::Manager& manager,
+                                            Event::Dispatcher& dispatcher) {
+  return manager.getTyped<HostInternPool>(
+      SINGLETON_MANAGER_REGISTERED_NAME(host_intern_pool),
+      [&dispatcher] { return std::make_shared<HostInternPool>(dispatcher); });
+}
+
+Network::Address::InstanceConstSharedPtr
+HostInternPool::internAddress(const Network::Address::InstanceConstSharedPtr& address) {
+  ASSERT_IS_MAIN_OR_TEST_THREAD();
+  if (address == nullptr || address->type() != Network::Address::Type::Ip) {
+    return address;
+  }
+
+  const Network::Address::Ipv6* ipv6 = address->ip()->ipv6();
+  AddressKey key{address->asString(), ipv6 != nullptr && ipv6->v6only(),
+                 &address->socketInterface()};
+  auto [it, inserted] = addresses_.try_emplace(std::move(key), address);
+  if (!inserted) {
+    if (auto interned = it->second.lock(); interned != nullptr) {
+      return interned;
+    }
+    it->second = address;
+  } else if (addresses_.size() >= next_sweep_size_) {
+    sweepExpiredAddresses();
+  }
+  return address;
+}
+
+LocalityConstSharedPtr
+HostInternPool::internLocality(const envoy::config::core::v3::Locality& locality) {
+  return localities_->getObject(locality);
+}
+
+void HostInternPool::sweepExpiredAddresses() {
+  absl::erase_if(addresses_, [](const auto& entry) { return entry.second.expired(); });
+  next_sweep_size_ = std::max(MinAddressPoolSweepSize, 2 * addresses_.size());
+}
+
+} // namespace Upstream
+} // namespace Envoy
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <tuple>
+
+#include "envoy/config/core/v3/base.pb.h"
+#include "envoy/event/dispatcher.h"
+#include "envoy/network/address.h"
+#include "envoy/singleton/instance.h"
+#include "envoy/singleton/manager.h"
+
+#include "source/common/protobuf/utility.h"
+#include "source/common/shared_pool/shared_pool.h"
+
+#include "absl/container/flat_hash_map.h"
+
+namespace Envoy {
+namespace Upstream {
+
+using LocalityConstSharedPtr = std::shared_ptr<const envoy::config::core::v3::Locality>;
+
+/**
+ * Interns the immutable parts of hosts, i.e. their addresses and localities, so that all clusters
+ * referencing the same endpoint share a single copy of them instead of one per host. The shared
+ * objects are reference counted by the hosts using them, and are released with the last of them.
+ *
+ * Like SharedPool::ObjectSharedPool, it must be created and used on the main thread. The hosts
+ * holding interned objects may be destroyed on any thread.
+ */
+class HostInternPool : public Singleton::Instance {
+public:
+  explicit HostInternPool(Event::Dispatcher& dispatcher);
+
+  /**
+   * @return the process wide pool, created on first use.
+   */
+  static std::shared_ptr<HostInternPool> get(Singleton::Manager& manager,
+                                             Event::Dispatcher& dispatcher);
+
+  /**
+   * @param address supplies a resolved address.
+   * @return an address equal to the given one, shared by all hosts interned with equal addresses.
+   *         Only IP addresses are interned, others are returned as is.
+   */
+  Network::Address::InstanceConstSharedPtr
+  internAddress(const Network::Address::InstanceConstSharedPtr& address);
+
+  /**
+   * @return a locality equal to the given one, shared by all hosts interned with equal localities.
+   */
+  LocalityConstSharedPtr internLocality(const envoy::config::core::v3::Locality& locality);
+
+  /**
+   * @return the number of entries in the address pool, some of which may have expired.
+   */
+  size_t addressPoolSize() const { return addresses_.size(); }
+
+private:
+  // Equal IP addresses with different IPv6 only settings or socket interfaces are distinct.
+  using AddressKey = std::tuple<std::string, bool, const Network::SocketInterface*>;
+
+  void sweepExpiredAddresses();
+
+  const std::shared_ptr<SharedPool::ObjectSharedPool<const envoy::config::core::v3::Locality,
+                                                     MessageUtil, MessageUtil>>
+      localities_;
+  // Addresses are created by the caller, so unlike localities they cannot be removed from the pool
+  // by their deleter. Expired entries are swept instead, whenever the pool doubled in size since
+  // the last sweep.
+  absl::flat_hash_map<AddressKey, std::weak_ptr<const Network::Address::Instance>> addresses_;
+  size_t next_sweep_size_;
+};
+
+using HostInternPoolSharedPtr = std::shared_ptr<HostInternPool>;
+
+} // namespace Upstream
+} // namespace Envoy
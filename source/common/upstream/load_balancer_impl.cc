@@ -20,6 +20,7 @@
 #include "source/common/runtime/runtime_features.h"
 
 #include "absl/container/fixed_array.h"
+#include "absl/container/flat_hash_set.h"
 
 namespace Envoy {
 namespace Upstream {
@@ -1023,11 +1024,10 @@ EdfLoadBalancerBase::EdfLoadBalancerBase(
                                                slow_start_config.value(), min_weight_percent, 10) /
                                                100.0
                                          : 0.1) {
-  // We fully recompute the schedulers for a given host set here on membership change, which is
-  // consistent with what other LB implementations do (e.g. thread aware).
-  // The downside of a full recompute is that time complexity is O(n * log n),
-  // so we will need to do better at delta tracking to scale (see
-  // https://github.com/envoyproxy/envoy/issues/2874).
+  // We recompute the schedulers for a given host set here on membership change. A full recompute
+  // is O(n * log n), which is consistent with what other LB implementations do (e.g. thread
+  // aware). With envoy.reloadable_features.edf_lb_incremental_refresh, existing weighted
+  // schedulers are instead updated in place in O(n), see updateScheduler().
   priority_update_cb_ = priority_set.addPriorityUpdateCb(
       [this](uint32_t priority, const HostVector&, const HostVector&) { refresh(priority); });
   member_update_cb_ = priority_set.addMemberUpdateCb(
@@ -1069,9 +1069,22 @@ void EdfLoadBalancerBase::recalculateHostsInSlowStart(const HostVector& hosts) {
 }
 
 void EdfLoadBalancerBase::refresh(uint32_t priority) {
-  const auto add_hosts_source = [this](HostsSource source, const HostVector& hosts) {
+  // Slow start weights change over time and are only applied when hosts are added to the
+  // scheduler, so slow start always rebuilds the schedulers.
+  const bool incremental =
+      !isSlowStartEnabled() &&
+      Runtime::runtimeFeatureEnabled("envoy.reloadable_features.edf_lb_incremental_refresh");
+  const auto add_hosts_source = [this, incremental](HostsSource source, const HostVector& hosts) {
+    auto& scheduler = scheduler_[source];
+    const bool weighted = alwaysUseEdfScheduler() || !hostWeightsAreEqual(hosts);
+    if (incremental && scheduler.edf_ != nullptr && weighted) {
+      refreshHostSource(source);
+      updateScheduler(*scheduler.edf_, hosts);
+      return;
+    }
+
     // Nuke existing scheduler if it exists.
-    auto& scheduler = scheduler_[source] = Scheduler{};
+    scheduler = Scheduler{};
     refreshHostSource(source);
     if (isSlowStartEnabled()) {
       recalculateHostsInSlowStart(hosts);
@@ -1081,7 +1094,7 @@ void EdfLoadBalancerBase::refresh(uint32_t priority) {
     // case EDF creation is skipped. When all original weights are equal and no hosts are in slow
     // start mode we can rely on unweighted host pick to do optimal round robin and least-loaded
     // host selection with lower memory and CPU overhead.
-    if (hostWeightsAreEqual(hosts) && noHostsAreInSlowStart()) {
+    if (!weighted && noHostsAreInSlowStart()) {
       // Skip edf creation.
       return;
     }
@@ -1131,6 +1144,23 @@ void EdfLoadBalancerBase::refresh(uint32_t priority) {
   }
 }
 
+void EdfLoadBalancerBase::updateScheduler(EdfScheduler<const Host>& scheduler,
+                                          const HostVector& hosts) {
+  // Hosts that are not in the scheduler yet. Hosts that are already scheduled are erased from the
+  // set as they are found, and keep their place in the schedule.
+  absl::flat_hash_set<const Host*> hosts_to_add;
+  hosts_to_add.reserve(hosts.size());
+  for (const auto& host : hosts) {
+    hosts_to_add.insert(host.get());
+  }
+  scheduler.retainIf([&hosts_to_add](const Host& host) { return hosts_to_add.erase(&host) > 0; });
+  for (const auto& host : hosts) {
+    if (hosts_to_add.contains(host.get())) {
+      scheduler.add(hostWeight(*host), host);
+    }
+  }
+}
+
 bool EdfLoadBalancerBase::isSlowStartEnabled() const {
   return slow_start_window_ > std::chrono::milliseconds(0);
 }
@@ -537,6 +537,10 @@ protected:
 
   virtual void recalculateHostsInSlowStart(const HostVector& hosts_added);
 
+  // Brings an existing scheduler in line with hosts: removes the hosts that are no longer in it
+  // and adds the new ones, leaving the schedule of the remaining hosts untouched.
+  void updateScheduler(EdfScheduler<const Host>& scheduler, const HostVector& hosts);
+
   // Seed to allow us to desynchronize load balancers across a fleet. If we don't
   // do this, multiple Envoys that receive an update at the same time (or even
   // multiple load balancers on the same host) will send requests to
@@ -550,6 +554,9 @@ private:
   friend class EdfLoadBalancerBasePeer;
   virtual void refreshHostSource(const HostsSource& source) PURE;
   virtual double hostWeight(const Host& host) const PURE;
+  // Whether to use an EDF scheduler even if all hosts have the same configured weight, for load
+  // balancers whose hostWeight() is not derived from the configured weights.
+  virtual bool alwaysUseEdfScheduler() const { return false; }
   virtual HostConstSharedPtr unweightedHostPeek(const HostVector& hosts_to_use,
                                                 const HostsSource& source) PURE;
   virtual HostConstSharedPtr unweightedHostPick(const HostVector& hosts_to_use,
@@ -40,14 +40,36 @@ public:
                    EventLoggerSharedPtr event_logger, Random::RandomGenerator& random);
 };
 
+class DetectorHostMonitorImpl;
+
 /**
- * Thin struct to facilitate calculations for success rate outlier detection.
+ * Struct of arrays view of the hosts taking part in a success rate or failure percentage detection
+ * pass. The success rates are kept contiguous so that the statistics over large clusters are
+ * computed without chasing pointers. The vectors are reused across intervals.
  */
-struct HostSuccessRatePair {
-  HostSuccessRatePair(HostSharedPtr host, double success_rate)
-      : host_(host), success_rate_(success_rate) {}
-  HostSharedPtr host_;
-  double success_rate_;
+struct SuccessRateSnapshot {
+  void clear() {
+    hosts_.clear();
+    monitors_.clear();
+    success_rates_.clear();
+  }
+  void reserve(size_t size) {
+    hosts_.reserve(size);
+    monitors_.reserve(size);
+    success_rates_.reserve(size);
+  }
+  void add(const HostSharedPtr& host, DetectorHostMonitorImpl& monitor, double success_rate) {
+    hosts_.push_back(&host);
+    monitors_.push_back(&monitor);
+    success_rates_.push_back(success_rate);
+  }
+  size_t size() const { return success_rates_.size(); }
+  bool empty() const { return success_rates_.empty(); }
+
+  // Keys of the detector's host monitor map, which is not modified during a pass.
+  std::vector<const HostSharedPtr*> hosts_;
+  std::vector<DetectorHostMonitorImpl*> monitors_;
+  std::vector<double> success_rates_;
 };
 
 struct SuccessRateAccumulatorBucket {
@@ -400,19 +422,17 @@ public:
    * This function returns pair of double values for success rate outlier detection. The pair
    * contains the average success rate of all valid hosts in the cluster and the ejection threshold.
    * If a host's success rate is under this threshold, the host is an outlier.
-   * @param success_rate_sum is the sum of the data in the success_rate_data vector.
-   * @param valid_success_rate_hosts is the vector containing the individual success rate data
-   *        points.
+   * @param success_rate_sum is the sum of the data in the success_rates vector.
+   * @param success_rates is the vector containing the individual success rate data points.
    * @return EjectionPair
    */
   struct EjectionPair {
     double success_rate_average_; // average success rate of all valid hosts in the cluster
     double ejection_threshold_;   // ejection threshold for the cluster
   };
-  static EjectionPair
-  successRateEjectionThreshold(double success_rate_sum,
-                               const std::vector<HostSuccessRatePair>& valid_success_rate_hosts,
-                               double success_rate_stdev_factor);
+  static EjectionPair successRateEjectionThreshold(double success_rate_sum,
+                                                   const std::vector<double>& success_rates,
+                                                   double success_rate_stdev_factor);
 
   const absl::node_hash_map<HostSharedPtr, DetectorHostMonitorImpl*>& getHostMonitors() {
     return host_monitors_;
@@ -425,7 +445,8 @@ private:
 
   void addHostMonitor(HostSharedPtr host);
   void armIntervalTimer();
-  void checkHostForUneject(HostSharedPtr host, DetectorHostMonitorImpl* monitor, MonotonicTime now);
+  void checkHostForUneject(const HostSharedPtr& host, DetectorHostMonitorImpl* monitor,
+                           MonotonicTime now);
   void ejectHost(HostSharedPtr host, envoy::data::cluster::v3::OutlierEjectionType type);
   static DetectionStats generateStats(Stats::Scope& scope);
   void initialize(Cluster& cluster);
@@ -478,6 +499,10 @@ private:
   EjectionPair external_origin_sr_num_;
   EjectionPair local_origin_sr_num_;
 
+  // Scratch space of processSuccessRateEjections(), kept to avoid reallocating it every interval.
+  SuccessRateSnapshot success_rate_snapshot_;
+  SuccessRateSnapshot failure_percentage_snapshot_;
+
   const EjectionPair& getSRNums(DetectorHostMonitor::SuccessRateMonitorType monitor_type) const {
     return (DetectorHostMonitor::SuccessRateMonitorType::ExternalOrigin == monitor_type)
                ? external_origin_sr_num_
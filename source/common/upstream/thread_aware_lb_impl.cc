@@ -3,6 +3,8 @@
 #include <memory>
 #include <random>
 
+#include "source/common/runtime/runtime_features.h"
+
 namespace Envoy {
 namespace Upstream {
 
@@ -97,12 +99,16 @@ void ThreadAwareLoadBalancerBase::initialize() {
   // complicated initialization as the load balancer would need its own initialized callback. I
   // think the synchronous/asynchronous split is probably the best option.
   priority_update_cb_ = priority_set_.addPriorityUpdateCb(
-      [this](uint32_t, const HostVector&, const HostVector&) -> void { refresh(); });
+      [this](uint32_t priority, const HostVector&, const HostVector&) -> void {
+        refresh(priority);
+      });
 
-  refresh();
+  refresh(absl::nullopt);
 }
 
-void ThreadAwareLoadBalancerBase::refresh() {
+void ThreadAwareLoadBalancerBase::refresh(absl::optional<uint32_t> updated_priority) {
+  const bool rebuild_updated_priority_only = Runtime::runtimeFeatureEnabled(
+      "envoy.reloadable_features.thread_aware_lb_rebuild_updated_priority_only");
   auto per_priority_state_vector = std::make_shared<std::vector<PerPriorityStatePtr>>(
       priority_set_.hostSetsPerPriority().size());
   auto healthy_per_priority_load =
@@ -118,6 +124,19 @@ void ThreadAwareLoadBalancerBase::refresh() {
     // in hosts set or hosts' health.
     per_priority_state->global_panic_ = per_priority_panic_[priority];
 
+    // A host set update only changes the hosts of its own priority, but it may move other
+    // priorities in or out of panic. Tables of priorities whose hosts and panic state are both
+    // unchanged are identical to the published ones, so those are shared rather than rebuilt.
+    if (rebuild_updated_priority_only && updated_priority.has_value() &&
+        updated_priority.value() != priority && per_priority_state_ != nullptr &&
+        priority < per_priority_state_->size()) {
+      const auto& previous_state = (*per_priority_state_)[priority];
+      if (previous_state->global_panic_ == per_priority_state->global_panic_) {
+        per_priority_state->current_lb_ = previous_state->current_lb_;
+        continue;
+      }
+    }
+
     // Normalize host and locality weights such that the sum of all normalized weights is 1.
     NormalizedHostWeightVector normalized_host_weights;
     double min_normalized_weight = 1.0;
@@ -134,6 +153,7 @@ void ThreadAwareLoadBalancerBase::refresh() {
     factory_->degraded_per_priority_load_ = degraded_per_priority_load;
     factory_->per_priority_state_ = per_priority_state_vector;
   }
+  per_priority_state_ = std::move(per_priority_state_vector);
 }
 
 HostConstSharedPtr
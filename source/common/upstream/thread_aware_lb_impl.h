@@ -165,9 +165,13 @@ private:
   virtual HashingLoadBalancerSharedPtr
   createLoadBalancer(const NormalizedHostWeightVector& normalized_host_weights,
                      double min_normalized_weight, double max_normalized_weight) PURE;
-  void refresh();
+  // Rebuilds the per priority hashing load balancers and publishes them to the workers. When
+  // updated_priority is set, only that priority's hosts are known to have changed.
+  void refresh(absl::optional<uint32_t> updated_priority);
 
   std::shared_ptr<LoadBalancerFactoryImpl> factory_;
+  // The state most recently published to factory_. Only accessed on the main thread.
+  std::shared_ptr<std::vector<PerPriorityStatePtr>> per_priority_state_;
   const bool locality_weighted_balancing_{};
   Common::CallbackHandlePtr priority_update_cb_;
 };
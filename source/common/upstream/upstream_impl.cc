@@ -1,5 +1,6 @@
 #include "source/common/upstream/upstream_impl.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <limits>
@@ -364,6 +365,25 @@ Envoy::Upstream::UpstreamLocalAddressSelectorConstSharedPtr createUpstreamLocalA
       cluster_name);
 }
 
+// Only health checkers sharing their probes with other clusters need the hash, so it is not
+// computed for clusters without them.
+uint64_t
+connectionConfigHash(const envoy::config::cluster::v3::Cluster& config,
+                     const absl::optional<envoy::config::core::v3::BindConfig>& bind_config) {
+  if (std::none_of(config.health_checks().begin(), config.health_checks().end(),
+                   [](const auto& health_check) { return health_check.share_probes(); })) {
+    return 0;
+  }
+  envoy::config::cluster::v3::Cluster connection_config;
+  *connection_config.mutable_transport_socket() = config.transport_socket();
+  *connection_config.mutable_transport_socket_matches() = config.transport_socket_matches();
+  *connection_config.mutable_upstream_connection_options() = config.upstream_connection_options();
+  if (bind_config.has_value()) {
+    *connection_config.mutable_upstream_bind_config() = bind_config.value();
+  }
+  return MessageUtil::hash(connection_config);
+}
+
 } // namespace
 
 // Allow disabling ALPN checks for transport sockets. See
@@ -398,14 +418,33 @@ HostDescriptionImpl::HostDescriptionImpl(
     const envoy::config::core::v3::Locality& locality,
     const envoy::config::endpoint::v3::Endpoint::HealthCheckConfig& health_check_config,
     uint32_t priority, TimeSource& time_source)
+    : HostDescriptionImpl(cluster, hostname, dest_address, metadata, LocalityStorage(locality),
+                          health_check_config, priority, time_source) {}
+
+HostDescriptionImpl::HostDescriptionImpl(
+    ClusterInfoConstSharedPtr cluster, const std::string& hostname,
+    Network::Address::InstanceConstSharedPtr dest_address, MetadataConstSharedPtr metadata,
+    LocalityConstSharedPtr locality,
+    const envoy::config::endpoint::v3::Endpoint::HealthCheckConfig& health_check_config,
+    uint32_t priority, TimeSource& time_source)
+    : HostDescriptionImpl(cluster, hostname, dest_address, metadata,
+                          LocalityStorage(std::move(locality)), health_check_config, priority,
+                          time_source) {}
+
+HostDescriptionImpl::HostDescriptionImpl(
+    ClusterInfoConstSharedPtr cluster, const std::string& hostname,
+    Network::Address::InstanceConstSharedPtr dest_address, MetadataConstSharedPtr metadata,
+    LocalityStorage&& locality,
+    const envoy::config::endpoint::v3::Endpoint::HealthCheckConfig& health_check_config,
+    uint32_t priority, TimeSource& time_source)
     : cluster_(cluster), hostname_(hostname),
       health_checks_hostname_(health_check_config.hostname()), address_(dest_address),
       canary_(Config::Metadata::metadataValue(metadata.get(),
                                               Config::MetadataFilters::get().ENVOY_LB,
                                               Config::MetadataEnvoyLbKeys::get().CANARY)
                   .bool_value()),
-      metadata_(metadata), locality_(locality),
-      locality_zone_stat_name_(locality.zone(), cluster->statsScope().symbolTable()),
+      metadata_(metadata), locality_(std::move(locality)),
+      locality_zone_stat_name_(locality().zone(), cluster->statsScope().symbolTable()),
       priority_(priority),
       socket_factory_(resolveTransportSocketFactory(dest_address, metadata_.get())),
       creation_time_(time_source.monotonicTime()) {
@@ -1020,6 +1059,9 @@ ClusterInfoImpl::ClusterInfoImpl(
           config.preconnect_policy(), per_upstream_preconnect_ratio, 1.0)),
       peekahead_ratio_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config.preconnect_policy(),
                                                        predictive_preconnect_ratio, 0)),
+      per_upstream_warm_connections_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+          config.preconnect_policy(), per_upstream_warm_connections, 0)),
+      warm_tcp_connection_pools_(config.preconnect_policy().warm_tcp_connection_pools()),
       socket_matcher_(std::move(socket_matcher)), stats_scope_(std::move(stats_scope)),
       traffic_stats_(generateStats(stats_scope_,
                                    factory_context.clusterManager().clusterStatNames(),
@@ -1047,6 +1089,7 @@ ClusterInfoImpl::ClusterInfoImpl(
                            ? std::make_unique<envoy::config::core::v3::TypedExtensionConfig>(
                                  config.upstream_config())
                            : nullptr),
+      connection_config_hash_(connectionConfigHash(config, bind_config)),
       lb_subset_(config.has_lb_subset_config()
                      ? std::make_unique<LoadBalancerSubsetInfoImpl>(config.lb_subset_config())
                      : nullptr),
@@ -1441,7 +1484,13 @@ ClusterImplBase::ClusterImplBase(const envoy::config::cluster::v3::Cluster& clus
                      cluster.name()),
       const_metadata_shared_pool_(Config::Metadata::getConstMetadataSharedPool(
           cluster_context.serverFactoryContext().singletonManager(),
-          cluster_context.serverFactoryContext().mainThreadDispatcher())) {
+          cluster_context.serverFactoryContext().mainThreadDispatcher())),
+      host_intern_pool_(Runtime::runtimeFeatureEnabled(
+                            "envoy.reloadable_features.intern_upstream_host_data")
+                            ? HostInternPool::get(
+                                  cluster_context.serverFactoryContext().singletonManager(),
+                                  cluster_context.serverFactoryContext().mainThreadDispatcher())
+                            : nullptr) {
 
   auto& server_context = cluster_context.serverFactoryContext();
 
@@ -1940,12 +1989,34 @@ void PriorityStateManager::registerHostForPriority(
   auto metadata = lb_endpoint.has_metadata()
                       ? parent_.constMetadataSharedPool()->getObject(lb_endpoint.metadata())
                       : nullptr;
+  HostInternPool* intern_pool = parent_.hostInternPool();
+  if (intern_pool == nullptr) {
+    const auto host = std::make_shared<HostImpl>(
+        parent_.info(), hostname, address, metadata, lb_endpoint.load_balancing_weight().value(),
+        locality_lb_endpoint.locality(), lb_endpoint.endpoint().health_check_config(),
+        locality_lb_endpoint.priority(), lb_endpoint.health_status(), time_source);
+    if (!address_list.empty()) {
+      host->setAddressList(address_list);
+    }
+    registerHostForPriority(host, locality_lb_endpoint);
+    return;
+  }
+
+  // The same endpoint is commonly a member of many clusters. Share its immutable data with the
+  // hosts of the other clusters instead of keeping a copy per cluster.
   const auto host = std::make_shared<HostImpl>(
-      parent_.info(), hostname, address, metadata, lb_endpoint.load_balancing_weight().value(),
-      locality_lb_endpoint.locality(), lb_endpoint.endpoint().health_check_config(),
-      locality_lb_endpoint.priority(), lb_endpoint.health_status(), time_source);
+      parent_.info(), hostname, intern_pool->internAddress(address), metadata,
+      lb_endpoint.load_balancing_weight().value(),
+      intern_pool->internLocality(locality_lb_endpoint.locality()),
+      lb_endpoint.endpoint().health_check_config(), locality_lb_endpoint.priority(),
+      lb_endpoint.health_status(), time_source);
   if (!address_list.empty()) {
-    host->setAddressList(address_list);
+    std::vector<Network::Address::InstanceConstSharedPtr> interned_address_list;
+    interned_address_list.reserve(address_list.size());
+    for (const auto& list_address : address_list) {
+      interned_address_list.push_back(intern_pool->internAddress(list_address));
+    }
+    host->setAddressList(interned_address_list);
   }
   registerHostForPriority(host, locality_lb_endpoint);
 }
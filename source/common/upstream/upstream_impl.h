@@ -57,6 +57,7 @@
 #include "source/common/network/utility.h"
 #include "source/common/shared_pool/shared_pool.h"
 #include "source/common/stats/isolated_store_impl.h"
+#include "source/common/upstream/host_intern_pool.h"
 #include "source/common/upstream/load_balancer_impl.h"
 #include "source/common/upstream/resource_manager_impl.h"
 #include "source/common/upstream/transport_socket_match_impl.h"
@@ -194,6 +195,13 @@ public:
       const envoy::config::core::v3::Locality& locality,
       const envoy::config::endpoint::v3::Endpoint::HealthCheckConfig& health_check_config,
       uint32_t priority, TimeSource& time_source);
+  // Same as above, for a locality that may be shared with other hosts, e.g. by a HostInternPool.
+  HostDescriptionImpl(
+      ClusterInfoConstSharedPtr cluster, const std::string& hostname,
+      Network::Address::InstanceConstSharedPtr dest_address, MetadataConstSharedPtr metadata,
+      LocalityConstSharedPtr locality,
+      const envoy::config::endpoint::v3::Endpoint::HealthCheckConfig& health_check_config,
+      uint32_t priority, TimeSource& time_source);
 
   Network::UpstreamTransportSocketFactory& transportSocketFactory() const override {
     absl::ReaderMutexLock lock(&metadata_mutex_);
@@ -249,6 +257,9 @@ public:
     static DetectorHostMonitorNullImpl* null_outlier_detector = new DetectorHostMonitorNullImpl();
     return *null_outlier_detector;
   }
+  OptRef<HostLbPolicyData> lbPolicyData() const override {
+    return makeOptRefFromPtr(lb_policy_data_.get());
+  }
   HostStats& stats() const override { return stats_; }
   LoadMetricStats& loadMetricStats() const override { return load_metric_stats_; }
   const std::string& hostnameForHealthChecks() const override { return health_checks_hostname_; }
@@ -260,7 +271,12 @@ public:
   Network::Address::InstanceConstSharedPtr healthCheckAddress() const override {
     return health_check_address_;
   }
-  const envoy::config::core::v3::Locality& locality() const override { return locality_; }
+  const envoy::config::core::v3::Locality& locality() const override {
+    if (const auto* shared_locality = std::get_if<LocalityConstSharedPtr>(&locality_)) {
+      return **shared_locality;
+    }
+    return std::get<envoy::config::core::v3::Locality>(locality_);
+  }
   Stats::StatName localityZoneStatName() const override {
     return locality_zone_stat_name_.statName();
   }
@@ -277,6 +293,17 @@ public:
   }
 
 protected:
+  // A host's locality is stored inline unless it was handed a locality shared with other hosts,
+  // so the default (non-interned) path pays neither an extra allocation nor refcounting.
+  using LocalityStorage = std::variant<envoy::config::core::v3::Locality, LocalityConstSharedPtr>;
+
+  HostDescriptionImpl(
+      ClusterInfoConstSharedPtr cluster, const std::string& hostname,
+      Network::Address::InstanceConstSharedPtr dest_address, MetadataConstSharedPtr metadata,
+      LocalityStorage&& locality,
+      const envoy::config::endpoint::v3::Endpoint::HealthCheckConfig& health_check_config,
+      uint32_t priority, TimeSource& time_source);
+
   void setAddress(Network::Address::InstanceConstSharedPtr address) { address_ = address; }
 
   void setHealthCheckAddress(Network::Address::InstanceConstSharedPtr address) {
@@ -291,6 +318,14 @@ protected:
     outlier_detector_ = std::move(outlier_detector);
   }
 
+  void setLbPolicyDataImpl(HostLbPolicyDataPtr&& lb_policy_data) {
+    // The workers read the data without synchronization, so it may only be set once before the
+    // host is published to them.
+    ASSERT_IS_MAIN_OR_TEST_THREAD();
+    ASSERT(lb_policy_data_ == nullptr);
+    lb_policy_data_ = std::move(lb_policy_data);
+  }
+
   void setLastHcPassTimeImpl(MonotonicTime last_hc_pass_time) {
     last_hc_pass_time_.emplace(std::move(last_hc_pass_time));
   }
@@ -306,12 +341,13 @@ private:
   std::atomic<bool> canary_;
   mutable absl::Mutex metadata_mutex_;
   MetadataConstSharedPtr metadata_ ABSL_GUARDED_BY(metadata_mutex_);
-  const envoy::config::core::v3::Locality locality_;
+  const LocalityStorage locality_;
   Stats::StatNameDynamicStorage locality_zone_stat_name_;
   mutable HostStats stats_;
   mutable LoadMetricStatsImpl load_metric_stats_;
   Outlier::DetectorHostMonitorPtr outlier_detector_;
   HealthCheckHostMonitorPtr health_checker_;
+  HostLbPolicyDataPtr lb_policy_data_;
   std::atomic<uint32_t> priority_;
   std::reference_wrapper<Network::UpstreamTransportSocketFactory>
       socket_factory_ ABSL_GUARDED_BY(metadata_mutex_);
@@ -332,14 +368,18 @@ public:
            const envoy::config::endpoint::v3::Endpoint::HealthCheckConfig& health_check_config,
            uint32_t priority, const envoy::config::core::v3::HealthStatus health_status,
            TimeSource& time_source)
-      : HostDescriptionImpl(cluster, hostname, address, metadata, locality, health_check_config,
-                            priority, time_source),
-        disable_active_health_check_(health_check_config.disable_active_health_check()) {
-    // This EDS flags setting is still necessary for stats, configuration dump, canonical
-    // coarseHealth() etc.
-    HostImpl::setEdsHealthStatus(health_status);
-    HostImpl::weight(initial_weight);
-  }
+      : HostImpl(cluster, hostname, address, metadata, initial_weight, LocalityStorage(locality),
+                 health_check_config, priority, health_status, time_source) {}
+  // Same as above, for a locality that may be shared with other hosts, e.g. by a HostInternPool.
+  HostImpl(ClusterInfoConstSharedPtr cluster, const std::string& hostname,
+           Network::Address::InstanceConstSharedPtr address, MetadataConstSharedPtr metadata,
+           uint32_t initial_weight, LocalityConstSharedPtr locality,
+           const envoy::config::endpoint::v3::Endpoint::HealthCheckConfig& health_check_config,
+           uint32_t priority, const envoy::config::core::v3::HealthStatus health_status,
+           TimeSource& time_source)
+      : HostImpl(cluster, hostname, address, metadata, initial_weight,
+                 LocalityStorage(std::move(locality)), health_check_config, priority,
+                 health_status, time_source) {}
 
   bool disableActiveHealthCheck() const override { return disable_active_health_check_; }
   void setDisableActiveHealthCheck(bool disable_active_health_check) override {
@@ -375,6 +415,9 @@ public:
   void setOutlierDetector(Outlier::DetectorHostMonitorPtr&& outlier_detector) override {
     setOutlierDetectorImpl(std::move(outlier_detector));
   }
+  void setLbPolicyData(HostLbPolicyDataPtr&& lb_policy_data) override {
+    setLbPolicyDataImpl(std::move(lb_policy_data));
+  }
 
   void setLastHcPassTime(MonotonicTime last_hc_pass_time) override {
     setLastHcPassTimeImpl(std::move(last_hc_pass_time));
@@ -450,6 +493,21 @@ protected:
                    HostDescriptionConstSharedPtr host);
 
 private:
+  HostImpl(ClusterInfoConstSharedPtr cluster, const std::string& hostname,
+           Network::Address::InstanceConstSharedPtr address, MetadataConstSharedPtr metadata,
+           uint32_t initial_weight, LocalityStorage&& locality,
+           const envoy::config::endpoint::v3::Endpoint::HealthCheckConfig& health_check_config,
+           uint32_t priority, const envoy::config::core::v3::HealthStatus health_status,
+           TimeSource& time_source)
+      : HostDescriptionImpl(cluster, hostname, address, metadata, std::move(locality),
+                            health_check_config, priority, time_source),
+        disable_active_health_check_(health_check_config.disable_active_health_check()) {
+    // This EDS flags setting is still necessary for stats, configuration dump, canonical
+    // coarseHealth() etc.
+    HostImpl::setEdsHealthStatus(health_status);
+    HostImpl::weight(initial_weight);
+  }
+
   // Helper function to check multiple health flags at once.
   bool healthFlagsGet(uint32_t flags) const { return health_flags_ & flags; }
 
@@ -864,6 +922,8 @@ public:
 
   float perUpstreamPreconnectRatio() const override { return per_upstream_preconnect_ratio_; }
   float peekaheadRatio() const override { return peekahead_ratio_; }
+  uint32_t perUpstreamWarmConnections() const override { return per_upstream_warm_connections_; }
+  bool warmTcpConnectionPools() const override { return warm_tcp_connection_pools_; }
   uint32_t perConnectionBufferLimitBytes() const override {
     return per_connection_buffer_limit_bytes_;
   }
@@ -940,6 +1000,7 @@ public:
     }
     return *upstream_config_;
   }
+  uint64_t connectionConfigHash() const override { return connection_config_hash_; }
   bool maintenanceMode() const override;
   uint64_t maxRequestsPerConnection() const override { return max_requests_per_connection_; }
   uint32_t maxResponseHeadersCount() const override { return max_response_headers_count_; }
@@ -1103,6 +1164,8 @@ private:
   OptionalTimeouts optional_timeouts_;
   const float per_upstream_preconnect_ratio_;
   const float peekahead_ratio_;
+  const uint32_t per_upstream_warm_connections_;
+  const bool warm_tcp_connection_pools_;
   TransportSocketMatcherPtr socket_matcher_;
   Stats::ScopeSharedPtr stats_scope_;
   mutable DeferredCreationCompatibleClusterTrafficStats traffic_stats_;
@@ -1118,6 +1181,7 @@ private:
   UpstreamLocalAddressSelectorConstSharedPtr upstream_local_address_selector_;
   std::unique_ptr<const LBPolicyConfig> lb_policy_config_;
   std::unique_ptr<envoy::config::core::v3::TypedExtensionConfig> upstream_config_;
+  const uint64_t connection_config_hash_;
   std::unique_ptr<LoadBalancerSubsetInfoImpl> lb_subset_;
   std::unique_ptr<const envoy::config::core::v3::Metadata> metadata_;
   std::unique_ptr<ClusterTypedMetadata> typed_metadata_;
@@ -1212,6 +1276,9 @@ public:
   Config::ConstMetadataSharedPoolSharedPtr constMetadataSharedPool() {
     return const_metadata_shared_pool_;
   }
+  // Returns the process wide pool that hosts' addresses and localities are interned in, or
+  // nullptr if host data interning is disabled.
+  HostInternPool* hostInternPool() { return host_intern_pool_.get(); }
 
   // Upstream::Cluster
   HealthChecker* healthChecker() override { return health_checker_.get(); }
@@ -1282,6 +1349,7 @@ private:
   uint64_t pending_initialize_health_checks_{};
   const bool local_cluster_;
   Config::ConstMetadataSharedPoolSharedPtr const_metadata_shared_pool_;
+  HostInternPoolSharedPtr host_intern_pool_;
   Common::CallbackHandlePtr priority_update_cb_;
 };
 
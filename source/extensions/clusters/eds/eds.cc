@@ -9,9 +9,16 @@
 #include "source/common/common/utility.h"
 #include "source/common/config/api_version.h"
 #include "source/common/config/decoded_resource_impl.h"
+#include "source/common/network/utility.h"
 
 namespace Envoy {
 namespace Upstream {
+namespace {
+
+// Smaller updates are not worth the cost of starting threads to parse their addresses.
+constexpr size_t MinAddressesToResolveInParallel = 64;
+
+} // namespace
 
 EdsClusterImpl::EdsClusterImpl(const envoy::config::cluster::v3::Cluster& cluster,
                                ClusterFactoryContext& cluster_context)
@@ -19,6 +26,7 @@ EdsClusterImpl::EdsClusterImpl(const envoy::config::cluster::v3::Cluster& cluste
       Envoy::Config::SubscriptionBase<envoy::config::endpoint::v3::ClusterLoadAssignment>(
           cluster_context.messageValidationVisitor(), "cluster_name"),
       local_info_(cluster_context.serverFactoryContext().localInfo()),
+      cm_(cluster_context.clusterManager()),
       eds_resources_cache_(
           Runtime::runtimeFeatureEnabled("envoy.restart_features.use_eds_cache_for_ads")
               ? cluster_context.clusterManager().edsResourcesCache()
@@ -49,6 +57,7 @@ EdsClusterImpl::~EdsClusterImpl() {
 void EdsClusterImpl::startPreInit() { subscription_->start({edsServiceName()}); }
 
 void EdsClusterImpl::BatchUpdateHelper::batchUpdate(PrioritySet::HostUpdateCb& host_update_cb) {
+  resolveAddressesInParallel();
   absl::flat_hash_set<std::string> all_new_hosts;
   PriorityStateManager priority_state_manager(parent_, parent_.local_info_, &host_update_cb);
   for (const auto& locality_lb_endpoint : cluster_load_assignment_.endpoints()) {
@@ -135,16 +144,78 @@ void EdsClusterImpl::BatchUpdateHelper::batchUpdate(PrioritySet::HostUpdateCb& h
   parent_.onPreInitComplete();
 }
 
+void EdsClusterImpl::BatchUpdateHelper::resolveAddressesInParallel() {
+  if (parent_.cm_.configIngestionConcurrency() <= 1) {
+    return;
+  }
+
+  // Only addresses handled by the built-in IP resolver are parsed in parallel, as other resolvers
+  // are not required to be thread safe. Addresses that fail to parse are left to the serial path,
+  // which reports the error.
+  std::vector<const envoy::config::core::v3::Address*> addresses;
+  const auto add_address = [&addresses](const envoy::config::core::v3::Address& address) {
+    if (address.has_socket_address() && address.socket_address().resolver_name().empty() &&
+        !address.socket_address().has_named_port()) {
+      addresses.push_back(&address);
+    }
+  };
+  const auto add_endpoint =
+      [&add_address](const envoy::config::endpoint::v3::LbEndpoint& lb_endpoint) {
+        add_address(lb_endpoint.endpoint().address());
+        for (const auto& additional_address : lb_endpoint.endpoint().additional_addresses()) {
+          add_address(additional_address.address());
+        }
+      };
+  for (const auto& locality_lb_endpoint : cluster_load_assignment_.endpoints()) {
+    if (locality_lb_endpoint.has_leds_cluster_locality_config()) {
+      const auto& leds_config = locality_lb_endpoint.leds_cluster_locality_config();
+      for (const auto& [_, lb_endpoint] :
+           parent_.leds_localities_[leds_config]->getEndpointsMap()) {
+        add_endpoint(lb_endpoint);
+      }
+    } else {
+      for (const auto& lb_endpoint : locality_lb_endpoint.lb_endpoints()) {
+        add_endpoint(lb_endpoint);
+      }
+    }
+  }
+  if (addresses.size() < MinAddressesToResolveInParallel) {
+    return;
+  }
+
+  std::vector<Network::Address::InstanceConstSharedPtr> resolved(addresses.size());
+  parent_.cm_.configIngestionParallelFor(addresses.size(), [&addresses, &resolved](size_t index) {
+    const auto& socket_address = addresses[index]->socket_address();
+    resolved[index] = Network::Utility::parseInternetAddressNoThrow(
+        socket_address.address(), socket_address.port_value(), !socket_address.ipv4_compat());
+  });
+  resolved_addresses_.reserve(addresses.size());
+  for (size_t i = 0; i < addresses.size(); ++i) {
+    if (resolved[i] != nullptr) {
+      resolved_addresses_.emplace(addresses[i], std::move(resolved[i]));
+    }
+  }
+}
+
+Network::Address::InstanceConstSharedPtr EdsClusterImpl::BatchUpdateHelper::resolveAddress(
+    const envoy::config::core::v3::Address& address) {
+  const auto it = resolved_addresses_.find(&address);
+  if (it != resolved_addresses_.end()) {
+    return it->second;
+  }
+  return parent_.resolveProtoAddress(address);
+}
+
 void EdsClusterImpl::BatchUpdateHelper::updateLocalityEndpoints(
     const envoy::config::endpoint::v3::LbEndpoint& lb_endpoint,
     const envoy::config::endpoint::v3::LocalityLbEndpoints& locality_lb_endpoint,
     PriorityStateManager& priority_state_manager, absl::flat_hash_set<std::string>& all_new_hosts) {
-  const auto address = parent_.resolveProtoAddress(lb_endpoint.endpoint().address());
+  const auto address = resolveAddress(lb_endpoint.endpoint().address());
   std::vector<Network::Address::InstanceConstSharedPtr> address_list;
   if (!lb_endpoint.endpoint().additional_addresses().empty()) {
     address_list.push_back(address);
     for (const auto& additional_address : lb_endpoint.endpoint().additional_addresses()) {
-      address_list.emplace_back(parent_.resolveProtoAddress(additional_address.address()));
+      address_list.emplace_back(resolveAddress(additional_address.address()));
     }
   }
 
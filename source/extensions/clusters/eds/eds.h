@@ -94,13 +94,22 @@ private:
         const envoy::config::endpoint::v3::LocalityLbEndpoints& locality_lb_endpoint,
         PriorityStateManager& priority_state_manager,
         absl::flat_hash_set<std::string>& all_new_hosts);
+    // Parses the IP addresses of all endpoints in parallel when config ingestion concurrency is
+    // enabled, ahead of the hosts being created in order on the main thread.
+    void resolveAddressesInParallel();
+    Network::Address::InstanceConstSharedPtr
+    resolveAddress(const envoy::config::core::v3::Address& address);
 
     EdsClusterImpl& parent_;
     const envoy::config::endpoint::v3::ClusterLoadAssignment& cluster_load_assignment_;
+    absl::flat_hash_map<const envoy::config::core::v3::Address*,
+                        Network::Address::InstanceConstSharedPtr>
+        resolved_addresses_;
   };
 
   Config::SubscriptionPtr subscription_;
   const LocalInfo::LocalInfo& local_info_;
+  ClusterManager& cm_;
   std::vector<LocalityWeightsMap> locality_weights_map_;
   Event::TimerPtr assignment_timeout_;
   InitializePhase initialize_phase_;
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "envoy/extensions/filters/http/adaptive_concurrency/v3/adaptive_concurrency.pb.h"
+#include "envoy/router/router.h"
 
 #include "source/common/common/assert.h"
 #include "source/common/protobuf/utility.h"
@@ -47,7 +48,17 @@ Http::FilterHeadersStatus AdaptiveConcurrencyFilter::decodeHeaders(Http::Request
     return Http::FilterHeadersStatus::Continue;
   }
 
-  if (controller_->forwardingDecision() == Controller::RequestForwardingAction::Block) {
+  request_controller_ = controller_.get();
+  if (controller_->limitsPerCluster()) {
+    const Router::RouteConstSharedPtr route = decoder_callbacks_->route();
+    if (route == nullptr || route->routeEntry() == nullptr) {
+      // The request is not forwarded to an upstream cluster.
+      return Http::FilterHeadersStatus::Continue;
+    }
+    request_controller_ = &controller_->clusterController(route->routeEntry()->clusterName());
+  }
+
+  if (request_controller_->forwardingDecision() == Controller::RequestForwardingAction::Block) {
     decoder_callbacks_->sendLocalReply(config_->concurrencyLimitExceededStatus(),
                                        "reached concurrency limit", nullptr, absl::nullopt,
                                        "reached_concurrency_limit");
@@ -57,8 +68,8 @@ Http::FilterHeadersStatus AdaptiveConcurrencyFilter::decodeHeaders(Http::Request
   // When the deferred_sample_task_ object is destroyed, the request start time is sampled. This
   // occurs either when encoding is complete or during destruction of this filter object.
   const auto now = config_->timeSource().monotonicTime();
-  deferred_sample_task_ =
-      std::make_unique<Cleanup>([this, now]() { controller_->recordLatencySample(now); });
+  deferred_sample_task_ = std::make_unique<Cleanup>(
+      [this, now]() { request_controller_->recordLatencySample(now); });
 
   return Http::FilterHeadersStatus::Continue;
 }
@@ -73,7 +84,7 @@ void AdaptiveConcurrencyFilter::onDestroy() {
     // TODO (tonya11en): Return some RAII handle from the concurrency controller that performs this
     // logic as part of its lifecycle.
     deferred_sample_task_->cancel();
-    controller_->cancelLatencySample();
+    request_controller_->cancelLatencySample();
   }
 }
 
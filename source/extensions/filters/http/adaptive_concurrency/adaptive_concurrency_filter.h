@@ -67,6 +67,9 @@ public:
 private:
   AdaptiveConcurrencyFilterConfigSharedPtr config_;
   const ConcurrencyControllerSharedPtr controller_;
+  // The controller that admitted the request. Either controller_, or the one it returned for the
+  // request's upstream cluster.
+  Controller::ConcurrencyController* request_controller_{};
   std::unique_ptr<Cleanup> deferred_sample_task_;
 };
 
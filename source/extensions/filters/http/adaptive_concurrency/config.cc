@@ -5,6 +5,7 @@
 #include "envoy/registry/registry.h"
 
 #include "source/extensions/filters/http/adaptive_concurrency/adaptive_concurrency_filter.h"
+#include "source/extensions/filters/http/adaptive_concurrency/controller/cluster_queueing_controller.h"
 #include "source/extensions/filters/http/adaptive_concurrency/controller/gradient_controller.h"
 
 namespace Envoy {
@@ -20,14 +21,21 @@ Http::FilterFactoryCb AdaptiveConcurrencyFilterFactory::createFilterFactoryFromP
 
   std::shared_ptr<Controller::ConcurrencyController> controller;
   using Proto = envoy::extensions::filters::http::adaptive_concurrency::v3::AdaptiveConcurrency;
-  ASSERT(config.concurrency_controller_config_case() ==
-         Proto::ConcurrencyControllerConfigCase::kGradientControllerConfig);
-  auto gradient_controller_config =
-      Controller::GradientControllerConfig(config.gradient_controller_config(), context.runtime());
-  controller = std::make_shared<Controller::GradientController>(
-      std::move(gradient_controller_config), context.mainThreadDispatcher(), context.runtime(),
-      acc_stats_prefix + "gradient_controller.", context.scope(), context.api().randomGenerator(),
-      context.timeSource());
+  if (config.concurrency_controller_config_case() ==
+      Proto::ConcurrencyControllerConfigCase::kClusterQueueingControllerConfig) {
+    controller = std::make_shared<Controller::ClusterQueueingController>(
+        Controller::ClusterQueueingControllerConfig(config.cluster_queueing_controller_config()),
+        acc_stats_prefix + "cluster_queueing_controller.", context.scope(), context.timeSource());
+  } else {
+    ASSERT(config.concurrency_controller_config_case() ==
+           Proto::ConcurrencyControllerConfigCase::kGradientControllerConfig);
+    auto gradient_controller_config = Controller::GradientControllerConfig(
+        config.gradient_controller_config(), context.runtime());
+    controller = std::make_shared<Controller::GradientController>(
+        std::move(gradient_controller_config), context.mainThreadDispatcher(), context.runtime(),
+        acc_stats_prefix + "gradient_controller.", context.scope(),
+        context.api().randomGenerator(), context.timeSource());
+  }
 
   AdaptiveConcurrencyFilterConfigSharedPtr filter_config(
       new AdaptiveConcurrencyFilterConfig(config, context.runtime(), std::move(acc_stats_prefix),
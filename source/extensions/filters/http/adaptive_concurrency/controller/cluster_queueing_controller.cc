@@ -0,0 +1,261 @@
+#include "source/extensions/filters/http/adaptive_concurrency/controller/cluster_queueing_controller.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+
+#include "envoy/common/exception.h"
+#include "envoy/extensions/filters/http/adaptive_concurrency/v3/adaptive_concurrency.pb.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/hash.h"
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace AdaptiveConcurrency {
+namespace Controller {
+
+namespace {
+
+int64_t toNanoseconds(MonotonicTime time) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+// Returns the smallest power of two that is at least twice the given number of clusters.
+size_t slotCount(uint32_t max_clusters) {
+  size_t count = 1;
+  while (count < 2 * static_cast<size_t>(max_clusters)) {
+    count <<= 1;
+  }
+  return count;
+}
+
+void storeMin(std::atomic<int64_t>& min, int64_t value) {
+  int64_t current = min.load(std::memory_order_relaxed);
+  while (value < current && !min.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+  }
+}
+
+} // namespace
+
+ClusterQueueingControllerConfig::ClusterQueueingControllerConfig(
+    const envoy::extensions::filters::http::adaptive_concurrency::v3::
+        ClusterQueueingControllerConfig& proto_config)
+    : min_rtt_window_(std::chrono::milliseconds(
+          PROTOBUF_GET_MS_OR_DEFAULT(proto_config, min_rtt_window, 30000))),
+      concurrency_update_interval_(std::chrono::milliseconds(
+          PROTOBUF_GET_MS_OR_DEFAULT(proto_config, concurrency_update_interval, 100))),
+      min_concurrency_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, min_concurrency, 3)),
+      max_concurrency_limit_(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, max_concurrency_limit, 1000)),
+      initial_concurrency_limit_(std::clamp<uint32_t>(
+          PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, initial_concurrency_limit, 20),
+          min_concurrency_, std::max(min_concurrency_, max_concurrency_limit_))),
+      min_queue_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, min_queue_size, 3)),
+      max_queue_size_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, max_queue_size, 6)),
+      max_clusters_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(proto_config, max_clusters, 64)) {
+  if (min_concurrency_ > max_concurrency_limit_) {
+    throwEnvoyExceptionOrPanic(
+        fmt::format("cluster queueing controller: min_concurrency ({}) must not be greater than "
+                    "max_concurrency_limit ({})",
+                    min_concurrency_, max_concurrency_limit_));
+  }
+  if (min_queue_size_ > max_queue_size_) {
+    throwEnvoyExceptionOrPanic(
+        fmt::format("cluster queueing controller: min_queue_size ({}) must not be greater than "
+                    "max_queue_size ({})",
+                    min_queue_size_, max_queue_size_));
+  }
+}
+
+void WindowedMinRTT::maybeRotate(int64_t now_ns) {
+  int64_t start = window_start_ns_.load(std::memory_order_acquire);
+  const int64_t elapsed = now_ns - start;
+  if (elapsed < window_.count()) {
+    return;
+  }
+  // Only the worker winning the race moves the current window into the previous one. Samples
+  // recorded by other workers meanwhile may end up in either window, which is harmless.
+  if (!window_start_ns_.compare_exchange_strong(start, now_ns, std::memory_order_acq_rel)) {
+    return;
+  }
+  const int64_t last_min = current_min_ns_.exchange(NoSample, std::memory_order_relaxed);
+  previous_min_ns_.store(elapsed < 2 * window_.count() ? last_min : NoSample,
+                         std::memory_order_relaxed);
+}
+
+void WindowedMinRTT::record(std::chrono::nanoseconds rtt, MonotonicTime now) {
+  maybeRotate(toNanoseconds(now));
+  storeMin(current_min_ns_, rtt.count());
+}
+
+absl::optional<std::chrono::nanoseconds> WindowedMinRTT::get(MonotonicTime now) const {
+  const int64_t elapsed = toNanoseconds(now) - window_start_ns_.load(std::memory_order_acquire);
+  int64_t min = NoSample;
+  if (elapsed < 2 * window_.count()) {
+    min = current_min_ns_.load(std::memory_order_relaxed);
+  }
+  if (elapsed < window_.count()) {
+    min = std::min(min, previous_min_ns_.load(std::memory_order_relaxed));
+  }
+  if (min == NoSample) {
+    return absl::nullopt;
+  }
+  return std::chrono::nanoseconds(min);
+}
+
+ClusterQueueingController::ClusterState::ClusterState(ClusterQueueingController& parent,
+                                                      absl::string_view name,
+                                                      const std::string& stats_prefix)
+    : parent_(parent), name_(name),
+      stats_({ALL_CLUSTER_QUEUEING_CONTROLLER_STATS(
+          POOL_COUNTER_PREFIX(parent.scope_, stats_prefix),
+          POOL_GAUGE_PREFIX(parent.scope_, stats_prefix))}),
+      min_rtt_(parent.config_.minRTTWindow()),
+      concurrency_limit_(parent.config_.initialConcurrencyLimit()),
+      next_update_ns_(toNanoseconds(parent.time_source_.monotonicTime()) +
+                      parent.config_.concurrencyUpdateInterval().count()) {
+  stats_.concurrency_limit_.set(concurrency_limit_.load());
+}
+
+RequestForwardingAction ClusterQueueingController::ClusterState::forwardingDecision() {
+  // Unlike the gradient controller, the limit is never exceeded by racing workers.
+  uint32_t outstanding = num_rq_outstanding_.load(std::memory_order_relaxed);
+  do {
+    if (outstanding >= concurrencyLimit()) {
+      stats_.rq_blocked_.inc();
+      return RequestForwardingAction::Block;
+    }
+  } while (!num_rq_outstanding_.compare_exchange_weak(outstanding, outstanding + 1,
+                                                       std::memory_order_relaxed));
+  return RequestForwardingAction::Forward;
+}
+
+void ClusterQueueingController::ClusterState::recordLatencySample(MonotonicTime rq_send_time) {
+  ASSERT(num_rq_outstanding_.load() > 0);
+  --num_rq_outstanding_;
+
+  const MonotonicTime now = parent_.time_source_.monotonicTime();
+  const auto rq_latency = std::chrono::duration_cast<std::chrono::nanoseconds>(now - rq_send_time);
+  min_rtt_.record(rq_latency, now);
+  sample_rtt_sum_us_.fetch_add(
+      std::chrono::duration_cast<std::chrono::microseconds>(rq_latency).count(),
+      std::memory_order_relaxed);
+  sample_count_.fetch_add(1, std::memory_order_relaxed);
+
+  maybeUpdateConcurrencyLimit(now);
+}
+
+void ClusterQueueingController::ClusterState::cancelLatencySample() {
+  ASSERT(num_rq_outstanding_.load() > 0);
+  --num_rq_outstanding_;
+}
+
+void ClusterQueueingController::ClusterState::maybeUpdateConcurrencyLimit(MonotonicTime now) {
+  const int64_t now_ns = toNanoseconds(now);
+  int64_t next_update_ns = next_update_ns_.load(std::memory_order_relaxed);
+  if (now_ns < next_update_ns ||
+      !next_update_ns_.compare_exchange_strong(
+          next_update_ns, now_ns + parent_.config_.concurrencyUpdateInterval().count(),
+          std::memory_order_relaxed)) {
+    return;
+  }
+
+  // Samples recorded by other workers while these are exchanged count towards the next update.
+  const uint32_t sample_count = sample_count_.exchange(0, std::memory_order_relaxed);
+  const uint64_t sample_rtt_sum_us = sample_rtt_sum_us_.exchange(0, std::memory_order_relaxed);
+  const absl::optional<std::chrono::nanoseconds> min_rtt = min_rtt_.get(now);
+  if (sample_count == 0 || !min_rtt.has_value()) {
+    return;
+  }
+
+  const double sample_rtt_us = static_cast<double>(sample_rtt_sum_us) / sample_count;
+  const double min_rtt_us = std::chrono::duration<double, std::micro>(min_rtt.value()).count();
+  const uint32_t limit = concurrencyLimit();
+  const uint32_t queue_size =
+      sample_rtt_us > min_rtt_us
+          ? static_cast<uint32_t>(std::ceil(limit * (1 - min_rtt_us / sample_rtt_us)))
+          : 0;
+  stats_.min_rtt_msecs_.set(
+      std::chrono::duration_cast<std::chrono::milliseconds>(min_rtt.value()).count());
+  stats_.sample_rtt_msecs_.set(sample_rtt_us / 1000);
+  stats_.queue_size_.set(queue_size);
+
+  const uint32_t step = std::max<uint32_t>(1, static_cast<uint32_t>(std::log10(limit)));
+  uint32_t new_limit = limit;
+  if (queue_size < parent_.config_.minQueueSize()) {
+    // Only grow the limit if it is being used. Otherwise it would grow without bound while the
+    // cluster sees little traffic, and not protect it once traffic picks up.
+    if (num_rq_outstanding_.load(std::memory_order_relaxed) * 2 >= limit) {
+      new_limit = limit + step;
+    }
+  } else if (queue_size > parent_.config_.maxQueueSize()) {
+    new_limit = limit > step ? limit - step : 0;
+  }
+  new_limit = std::clamp(new_limit, parent_.config_.minConcurrency(),
+                         parent_.config_.maxConcurrencyLimit());
+  concurrency_limit_.store(new_limit, std::memory_order_relaxed);
+  stats_.concurrency_limit_.set(new_limit);
+}
+
+ClusterQueueingController::ClusterQueueingController(ClusterQueueingControllerConfig config,
+                                                     const std::string& stats_prefix,
+                                                     Stats::Scope& scope, TimeSource& time_source)
+    : config_(std::move(config)), stats_prefix_(stats_prefix), scope_(scope),
+      time_source_(time_source),
+      overflow_(std::make_unique<ClusterState>(*this, "", stats_prefix_ + "overflow.")),
+      slots_(slotCount(config_.maxClusters())) {
+  for (auto& slot : slots_) {
+    slot.store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+ConcurrencyController&
+ClusterQueueingController::clusterController(absl::string_view cluster_name) {
+  const bool full = numClusters() >= config_.maxClusters();
+  const size_t mask = slots_.size() - 1;
+  for (size_t i = HashUtil::xxHash64(cluster_name) & mask;; i = (i + 1) & mask) {
+    ClusterState* state = slots_[i].load(std::memory_order_acquire);
+    if (state == nullptr) {
+      // Once the table is full, requests to further clusters do not need to take the lock.
+      return full ? static_cast<ConcurrencyController&>(*overflow_) : addCluster(cluster_name);
+    }
+    if (state->name() == cluster_name) {
+      return *state;
+    }
+  }
+}
+
+ClusterQueueingController::ClusterState&
+ClusterQueueingController::addCluster(absl::string_view cluster_name) {
+  absl::MutexLock lock(&mutex_);
+  // Another worker may have added the cluster since the table was probed.
+  const size_t mask = slots_.size() - 1;
+  size_t i = HashUtil::xxHash64(cluster_name) & mask;
+  for (ClusterState* state; (state = slots_[i].load(std::memory_order_relaxed)) != nullptr;
+       i = (i + 1) & mask) {
+    if (state->name() == cluster_name) {
+      return *state;
+    }
+  }
+  if (clusters_.size() >= config_.maxClusters()) {
+    return *overflow_;
+  }
+
+  clusters_.push_back(std::make_unique<ClusterState>(
+      *this, cluster_name, absl::StrCat(stats_prefix_, "cluster.", cluster_name, ".")));
+  slots_[i].store(clusters_.back().get(), std::memory_order_release);
+  num_clusters_.store(clusters_.size(), std::memory_order_relaxed);
+  return *clusters_.back();
+}
+
+} // namespace Controller
+} // namespace AdaptiveConcurrency
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
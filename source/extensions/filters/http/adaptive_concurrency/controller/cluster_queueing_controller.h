@@ -0,0 +1,198 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/filters/http/adaptive_concurrency/v3/adaptive_concurrency.pb.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+
+#include "source/extensions/filters/http/adaptive_concurrency/controller/controller.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/strings/string_view.h"
+#include "absl/synchronization/mutex.h"
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace AdaptiveConcurrency {
+namespace Controller {
+
+/**
+ * All stats kept for each upstream cluster by the cluster queueing controller.
+ */
+#define ALL_CLUSTER_QUEUEING_CONTROLLER_STATS(COUNTER, GAUGE)                                      \
+  COUNTER(rq_blocked)                                                                              \
+  GAUGE(concurrency_limit, NeverImport)                                                            \
+  GAUGE(min_rtt_msecs, NeverImport)                                                                \
+  GAUGE(queue_size, NeverImport)                                                                   \
+  GAUGE(sample_rtt_msecs, NeverImport)
+
+/**
+ * Wrapper struct for cluster queueing controller stats. @see stats_macros.h
+ */
+struct ClusterQueueingControllerStats {
+  ALL_CLUSTER_QUEUEING_CONTROLLER_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+};
+
+class ClusterQueueingControllerConfig {
+public:
+  ClusterQueueingControllerConfig(
+      const envoy::extensions::filters::http::adaptive_concurrency::v3::
+          ClusterQueueingControllerConfig& proto_config);
+
+  std::chrono::nanoseconds minRTTWindow() const { return min_rtt_window_; }
+  std::chrono::nanoseconds concurrencyUpdateInterval() const {
+    return concurrency_update_interval_;
+  }
+  uint32_t initialConcurrencyLimit() const { return initial_concurrency_limit_; }
+  uint32_t minConcurrency() const { return min_concurrency_; }
+  uint32_t maxConcurrencyLimit() const { return max_concurrency_limit_; }
+  uint32_t minQueueSize() const { return min_queue_size_; }
+  uint32_t maxQueueSize() const { return max_queue_size_; }
+  uint32_t maxClusters() const { return max_clusters_; }
+
+private:
+  const std::chrono::nanoseconds min_rtt_window_;
+  const std::chrono::nanoseconds concurrency_update_interval_;
+  const uint32_t min_concurrency_;
+  const uint32_t max_concurrency_limit_;
+  const uint32_t initial_concurrency_limit_;
+  const uint32_t min_queue_size_;
+  const uint32_t max_queue_size_;
+  const uint32_t max_clusters_;
+};
+
+/**
+ * Continuously tracks the minimum of latency samples over a sliding window without locking. The
+ * samples are kept in two buckets, the current and the previous window, so the minimum reflects the
+ * samples recorded during the last one to two windows.
+ */
+class WindowedMinRTT {
+public:
+  explicit WindowedMinRTT(std::chrono::nanoseconds window) : window_(window) {}
+
+  void record(std::chrono::nanoseconds rtt, MonotonicTime now);
+
+  // Returns absl::nullopt if no samples were recorded during the last two windows.
+  absl::optional<std::chrono::nanoseconds> get(MonotonicTime now) const;
+
+private:
+  static constexpr int64_t NoSample = std::numeric_limits<int64_t>::max();
+
+  void maybeRotate(int64_t now_ns);
+
+  const std::chrono::nanoseconds window_;
+  // Start of the current window, in nanoseconds since the monotonic clock's epoch.
+  std::atomic<int64_t> window_start_ns_{0};
+  std::atomic<int64_t> current_min_ns_{NoSample};
+  std::atomic<int64_t> previous_min_ns_{NoSample};
+};
+
+/**
+ * A concurrency controller that keeps a separate concurrency limit for every upstream cluster,
+ * adjusted by the number of requests estimated to be queued at the cluster. It is a variation of
+ * TCP Vegas congestion avoidance:
+ *
+ *     queue_size = limit * (1 - minRTT / sampleRTT)
+ *
+ * where minRTT is the minimum latency recently sampled for the cluster, and sampleRTT the average
+ * latency sampled since the limit was last calculated. If fewer than min_queue_size requests are
+ * queued and the limit is in use, the limit grows. If more than max_queue_size requests are queued,
+ * the limit shrinks. Both by log10(limit), but at least by one.
+ *
+ * Unlike the gradient controller, the minRTT is tracked continuously with a windowed minimum, so
+ * there are no minRTT measurement windows during which the concurrency limit is pinned low.
+ *
+ * Locking:
+ * ========
+ * All of the per cluster state is kept in atomics, so admitting requests and sampling their
+ * latencies is lock free. The limit of a cluster is recalculated at most once per update interval
+ * by the worker that wins the race to advance the cluster's next update time.
+ *
+ * The per cluster states are found in a fixed size open addressed table that is read without
+ * locking. States are only ever added, under a mutex, the first time a request is routed to a
+ * cluster. Clusters beyond max_clusters share a single overflow state.
+ */
+class ClusterQueueingController : public ConcurrencyController {
+public:
+  ClusterQueueingController(ClusterQueueingControllerConfig config,
+                            const std::string& stats_prefix, Stats::Scope& scope,
+                            TimeSource& time_source);
+
+  // ConcurrencyController. The controller itself admits requests whose cluster is not known.
+  RequestForwardingAction forwardingDecision() override {
+    return overflow_->forwardingDecision();
+  }
+  void recordLatencySample(MonotonicTime rq_send_time) override {
+    overflow_->recordLatencySample(rq_send_time);
+  }
+  void cancelLatencySample() override { overflow_->cancelLatencySample(); }
+  uint32_t concurrencyLimit() const override { return overflow_->concurrencyLimit(); }
+  bool limitsPerCluster() const override { return true; }
+  ConcurrencyController& clusterController(absl::string_view cluster_name) override;
+
+  // Returns the number of clusters with their own concurrency limit.
+  uint32_t numClusters() const { return num_clusters_.load(std::memory_order_relaxed); }
+
+private:
+  class ClusterState : public ConcurrencyController {
+  public:
+    ClusterState(ClusterQueueingController& parent, absl::string_view name,
+                 const std::string& stats_prefix);
+
+    const std::string& name() const { return name_; }
+
+    // ConcurrencyController
+    RequestForwardingAction forwardingDecision() override;
+    void recordLatencySample(MonotonicTime rq_send_time) override;
+    void cancelLatencySample() override;
+    uint32_t concurrencyLimit() const override {
+      return concurrency_limit_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    void maybeUpdateConcurrencyLimit(MonotonicTime now);
+
+    ClusterQueueingController& parent_;
+    const std::string name_;
+    ClusterQueueingControllerStats stats_;
+    WindowedMinRTT min_rtt_;
+    std::atomic<uint32_t> num_rq_outstanding_{0};
+    std::atomic<uint32_t> concurrency_limit_;
+    // Sum and count of the latencies sampled since the limit was last calculated.
+    std::atomic<uint64_t> sample_rtt_sum_us_{0};
+    std::atomic<uint32_t> sample_count_{0};
+    // Nanoseconds since the monotonic clock's epoch at which the limit is calculated next.
+    std::atomic<int64_t> next_update_ns_;
+  };
+
+  ClusterState& addCluster(absl::string_view cluster_name);
+
+  const ClusterQueueingControllerConfig config_;
+  const std::string stats_prefix_;
+  Stats::Scope& scope_;
+  TimeSource& time_source_;
+  const std::unique_ptr<ClusterState> overflow_;
+
+  // Open addressed table of the per cluster states, sized to a power of two at least twice
+  // max_clusters so that probing always ends at an empty slot. Written under mutex_, read without.
+  std::vector<std::atomic<ClusterState*>> slots_;
+  std::atomic<uint32_t> num_clusters_{0};
+  absl::Mutex mutex_;
+  std::vector<std::unique_ptr<ClusterState>> clusters_ ABSL_GUARDED_BY(mutex_);
+};
+using ClusterQueueingControllerSharedPtr = std::shared_ptr<ClusterQueueingController>;
+
+} // namespace Controller
+} // namespace AdaptiveConcurrency
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -5,6 +5,8 @@
 #include "envoy/common/pure.h"
 #include "envoy/common/time.h"
 
+#include "absl/strings/string_view.h"
+
 namespace Envoy {
 namespace Extensions {
 namespace HttpFilters {
@@ -56,6 +58,20 @@ public:
    * Returns the current concurrency limit.
    */
   virtual uint32_t concurrencyLimit() const PURE;
+
+  /**
+   * Returns true if requests should be admitted by the controller that clusterController() returns
+   * for their upstream cluster, rather than by this controller.
+   */
+  virtual bool limitsPerCluster() const { return false; }
+
+  /**
+   * Returns the controller admitting requests routed to the given upstream cluster. Only called if
+   * limitsPerCluster() returns true. The returned controller lives as long as this one.
+   *
+   * @param cluster_name the name of the upstream cluster the request is routed to
+   */
+  virtual ConcurrencyController& clusterController(absl::string_view) { return *this; }
 };
 
 } // namespace Controller
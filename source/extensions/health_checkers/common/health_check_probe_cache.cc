@@ -0,0 +1,85 @@
+#include "source/extensions/health_checkers/common/health_check_probe_cache.h"
+
+#include "envoy/upstream/upstream.h"
+
+#include "source/common/common/assert.h"
+#include "source/common/common/thread.h"
+#include "source/common/protobuf/utility.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Upstream {
+
+SINGLETON_MANAGER_REGISTRATION(health_check_probe_cache);
+
+HealthCheckProbeCacheSharedPtr HealthCheckProbeCache::get(Singleton::Manager& manager) {
+  return manager.getTyped<HealthCheckProbeCache>(
+      SINGLETON_MANAGER_REGISTERED_NAME(health_check_probe_cache),
+      [] { return std::make_shared<HealthCheckProbeCache>(); });
+}
+
+uint64_t HealthCheckProbeCache::configHash(const envoy::config::core::v3::HealthCheck& config) {
+  envoy::config::core::v3::HealthCheck probe_config = config;
+  // The timeout is kept, as it decides whether slow responses are failures.
+  probe_config.clear_interval();
+  probe_config.clear_initial_jitter();
+  probe_config.clear_interval_jitter();
+  probe_config.clear_interval_jitter_percent();
+  probe_config.clear_unhealthy_threshold();
+  probe_config.clear_healthy_threshold();
+  probe_config.clear_reuse_connection();
+  probe_config.clear_no_traffic_interval();
+  probe_config.clear_no_traffic_healthy_interval();
+  probe_config.clear_unhealthy_interval();
+  probe_config.clear_unhealthy_edge_interval();
+  probe_config.clear_healthy_edge_interval();
+  probe_config.clear_event_logger();
+  probe_config.clear_event_service();
+  probe_config.clear_always_log_health_check_failures();
+  probe_config.clear_share_probes();
+  return MessageUtil::hash(probe_config);
+}
+
+HealthCheckProbeCache::Key HealthCheckProbeCache::key(const HostDescription& host,
+                                                      absl::string_view hostname,
+                                                      uint64_t config_hash) {
+  return {absl::StrCat(host.healthCheckAddress()->asString(), "/", hostname), config_hash,
+          host.cluster().connectionConfigHash()};
+}
+
+void HealthCheckProbeCache::subscribe(const Key& key) {
+  ASSERT_IS_MAIN_OR_TEST_THREAD();
+  entries_[key].subscribers++;
+}
+
+void HealthCheckProbeCache::unsubscribe(const Key& key) {
+  ASSERT_IS_MAIN_OR_TEST_THREAD();
+  auto it = entries_.find(key);
+  ASSERT(it != entries_.end() && it->second.subscribers > 0);
+  if (--it->second.subscribers == 0) {
+    entries_.erase(it);
+  }
+}
+
+const HealthCheckProbeCache::ProbeResult* HealthCheckProbeCache::lookup(const Key& key) const {
+  ASSERT_IS_MAIN_OR_TEST_THREAD();
+  auto it = entries_.find(key);
+  if (it == entries_.end() || !it->second.has_result) {
+    return nullptr;
+  }
+  return &it->second.result;
+}
+
+void HealthCheckProbeCache::publish(const Key& key, const ProbeResult& result) {
+  ASSERT_IS_MAIN_OR_TEST_THREAD();
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return;
+  }
+  it->second.has_result = true;
+  it->second.result = result;
+}
+
+} // namespace Upstream
+} // namespace Envoy
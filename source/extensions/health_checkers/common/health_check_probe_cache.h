@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+
+#include "envoy/common/time.h"
+#include "envoy/config/core/v3/health_check.pb.h"
+#include "envoy/data/core/v3/health_check_event.pb.h"
+#include "envoy/singleton/instance.h"
+#include "envoy/singleton/manager.h"
+#include "envoy/upstream/host_description.h"
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+
+namespace Envoy {
+namespace Upstream {
+
+/**
+ * Keeps the latest result of active health checks that share their probes, keyed by the address
+ * probed, the host name sent, the parts of the health check configuration that affect the result,
+ * and the cluster configuration deciding how the probe connects. Health checkers
+ * of different clusters that probe the same endpoint with an equivalent configuration use each
+ * other's results instead of all sending their own probes.
+ *
+ * Results are kept for as long as a health check session is interested in them. Like the health
+ * checkers using it, the cache must only be used on the main thread.
+ */
+class HealthCheckProbeCache : public Singleton::Instance {
+public:
+  using Key = std::tuple<std::string, uint64_t, uint64_t>;
+
+  struct ProbeResult {
+    MonotonicTime time;
+    bool healthy;
+    bool degraded;
+    envoy::data::core::v3::HealthCheckFailureType failure_type;
+    bool retriable;
+  };
+
+  /**
+   * @return the process wide cache, created on first use.
+   */
+  static std::shared_ptr<HealthCheckProbeCache> get(Singleton::Manager& manager);
+
+  /**
+   * @return a hash of the health check configuration that ignores the fields which only affect
+   *         when probes are sent, or how their results are acted upon.
+   */
+  static uint64_t configHash(const envoy::config::core::v3::HealthCheck& config);
+
+  /**
+   * @return the key of the results of probing the given host, sending the given host name, with a
+   *         health check configuration of the given hash. Hosts of clusters that connect to them
+   *         differently, e.g. with another transport socket or SNI, never share a key.
+   */
+  static Key key(const HostDescription& host, absl::string_view hostname, uint64_t config_hash);
+
+  /**
+   * Registers interest in the results for a key. Each call must be matched by a call to
+   * unsubscribe(), after which the results are released if nobody else is interested in them.
+   */
+  void subscribe(const Key& key);
+  void unsubscribe(const Key& key);
+
+  /**
+   * @return the latest result published for the key, or nullptr if there is none.
+   */
+  const ProbeResult* lookup(const Key& key) const;
+
+  /**
+   * Publishes the result of a probe to everybody interested in the key.
+   */
+  void publish(const Key& key, const ProbeResult& result);
+
+  /**
+   * @return the number of keys somebody is interested in.
+   */
+  size_t size() const { return entries_.size(); }
+
+private:
+  struct Entry {
+    uint32_t subscribers{};
+    bool has_result{};
+    ProbeResult result;
+  };
+
+  absl::flat_hash_map<Key, Entry> entries_;
+};
+
+using HealthCheckProbeCacheSharedPtr = std::shared_ptr<HealthCheckProbeCache>;
+
+} // namespace Upstream
+} // namespace Envoy
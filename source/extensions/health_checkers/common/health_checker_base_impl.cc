@@ -7,6 +7,7 @@
 
 #include "source/common/network/utility.h"
 #include "source/common/router/router.h"
+#include "source/common/upstream/health_checker_impl.h"
 
 namespace Envoy {
 namespace Upstream {
@@ -39,6 +40,8 @@ HealthCheckerImplBase::HealthCheckerImplBase(const Cluster& cluster,
           PROTOBUF_GET_MS_OR_DEFAULT(config, healthy_edge_interval, interval_.count())),
       transport_socket_options_(initTransportSocketOptions(config)),
       transport_socket_match_metadata_(initTransportSocketMatchMetadata(config)),
+      probe_config_hash_(config.share_probes() ? HealthCheckProbeCache::configHash(config) : 0),
+      probe_hostname_(initProbeHostname(config)),
       member_update_cb_{cluster_.prioritySet().addMemberUpdateCb(
           [this](const HostVector& hosts_added, const HostVector& hosts_removed) -> void {
             onClusterMemberUpdate(hosts_added, hosts_removed);
@@ -71,6 +74,26 @@ MetadataConstSharedPtr HealthCheckerImplBase::initTransportSocketMatchMetadata(
   return nullptr;
 }
 
+absl::optional<std::string>
+HealthCheckerImplBase::initProbeHostname(const envoy::config::core::v3::HealthCheck& config) {
+  switch (config.health_checker_case()) {
+  case envoy::config::core::v3::HealthCheck::HealthCheckerCase::kHttpHealthCheck:
+    return config.http_health_check().host();
+  case envoy::config::core::v3::HealthCheck::HealthCheckerCase::kGrpcHealthCheck:
+    return config.grpc_health_check().authority();
+  default:
+    return absl::nullopt;
+  }
+}
+
+const std::string& HealthCheckerImplBase::probeHostname(const HostSharedPtr& host) const {
+  if (!probe_hostname_.has_value()) {
+    return host->hostnameForHealthChecks();
+  }
+  // Without a host name of their own, HTTP and gRPC probes are sent with the cluster name.
+  return HealthCheckerFactory::getHostname(host, probe_hostname_.value(), cluster_.info());
+}
+
 HealthCheckerImplBase::~HealthCheckerImplBase() {
   // First clear callbacks that otherwise will be run from
   // ActiveHealthCheckSession::onDeferredDeleteBase(). This prevents invoking a callback on a
@@ -249,6 +272,12 @@ HealthCheckerImplBase::ActiveHealthCheckSession::ActiveHealthCheckSession(
   if (host->healthFlagGet(Host::HealthFlag::DEGRADED_ACTIVE_HC)) {
     parent.incDegraded();
   }
+
+  if (parent.probe_cache_ != nullptr) {
+    probe_key_ =
+        HealthCheckProbeCache::key(*host, parent.probeHostname(host), parent.probe_config_hash_);
+    parent.probe_cache_->subscribe(probe_key_);
+  }
 }
 
 HealthCheckerImplBase::ActiveHealthCheckSession::~ActiveHealthCheckSession() {
@@ -268,6 +297,9 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::onDeferredDeleteBase() {
   if (host_->healthFlagGet(Host::HealthFlag::DEGRADED_ACTIVE_HC)) {
     parent_.decDegraded();
   }
+  if (parent_.probe_cache_ != nullptr) {
+    parent_.probe_cache_->unsubscribe(probe_key_);
+  }
   onDeferredDelete();
 
   // Run callbacks in case something is waiting for health checks to run which will now never run.
@@ -277,6 +309,9 @@ void HealthCheckerImplBase::ActiveHealthCheckSession::onDeferredDeleteBase() {
 }
 
 void HealthCheckerImplBase::ActiveHealthCheckSession::handleSuccess(bool degraded) {
+  publishResult(
+      {time_source_.monotonicTime(), true, degraded, envoy::data::core::v3::ACTIVE, false});
+
   // If we are healthy, reset the # of unhealthy to zero.
   num_unhealthy_ = 0;
 
@@ -395,6 +430,7 @@ HealthTransition HealthCheckerImplBase::ActiveHealthCheckSession::setUnhealthy(
 
 void HealthCheckerImplBase::ActiveHealthCheckSession::handleFailure(
     envoy::data::core::v3::HealthCheckFailureType type, bool retriable) {
+  publishResult({time_source_.monotonicTime(), false, false, type, retriable});
   HealthTransition changed_state = setUnhealthy(type, retriable);
   // It's possible that the previous call caused this session to be deferred deleted.
   if (timeout_timer_ != nullptr) {
@@ -418,7 +454,47 @@ HealthCheckerImplBase::ActiveHealthCheckSession::clearPendingFlag(HealthTransiti
   return changed_state;
 }
 
+void HealthCheckerImplBase::ActiveHealthCheckSession::publishResult(
+    const HealthCheckProbeCache::ProbeResult& result) {
+  // Results applied from the cache, and failures not caused by probes, are not published.
+  if (!probing_) {
+    return;
+  }
+  probing_ = false;
+  if (parent_.probe_cache_ != nullptr) {
+    last_result_time_ = result.time;
+    parent_.probe_cache_->publish(probe_key_, result);
+  }
+}
+
+bool HealthCheckerImplBase::ActiveHealthCheckSession::useSharedResult() {
+  if (parent_.probe_cache_ == nullptr) {
+    return false;
+  }
+  const HealthCheckProbeCache::ProbeResult* result = parent_.probe_cache_->lookup(probe_key_);
+  // Each result is only applied once, and only while it is more recent than one interval.
+  if (result == nullptr || (last_result_time_.has_value() && result->time <= *last_result_time_) ||
+      time_source_.monotonicTime() - result->time >= parent_.interval_) {
+    return false;
+  }
+
+  // Applying the result may remove the host, and with it the cached result.
+  const HealthCheckProbeCache::ProbeResult shared_result = *result;
+  last_result_time_ = shared_result.time;
+  parent_.stats_.shared_result_.inc();
+  if (shared_result.healthy) {
+    handleSuccess(shared_result.degraded);
+  } else {
+    handleFailure(shared_result.failure_type, shared_result.retriable);
+  }
+  return true;
+}
+
 void HealthCheckerImplBase::ActiveHealthCheckSession::onIntervalBase() {
+  if (useSharedResult()) {
+    return;
+  }
+  probing_ = true;
   onInterval();
   timeout_timer_->enableTimer(parent_.timeout_);
   parent_.stats_.attempt_.inc();
@@ -14,6 +14,9 @@
 #include "source/common/common/logger.h"
 #include "source/common/common/matchers.h"
 #include "source/common/network/transport_socket_options_impl.h"
+#include "source/extensions/health_checkers/common/health_check_probe_cache.h"
+
+#include "absl/types/optional.h"
 
 namespace Envoy {
 namespace Upstream {
@@ -26,6 +29,7 @@ namespace Upstream {
   COUNTER(failure)                                                                                 \
   COUNTER(network_failure)                                                                         \
   COUNTER(passive_failure)                                                                         \
+  COUNTER(shared_result)                                                                           \
   COUNTER(success)                                                                                 \
   COUNTER(verify_cluster)                                                                          \
   GAUGE(degraded, Accumulate)                                                                      \
@@ -55,6 +59,14 @@ public:
     return transport_socket_match_metadata_;
   }
 
+  /**
+   * Shares the results of probes with the health checkers of other clusters through the given
+   * cache. Must be called before start().
+   */
+  void shareProbes(HealthCheckProbeCacheSharedPtr probe_cache) {
+    probe_cache_ = std::move(probe_cache);
+  }
+
 protected:
   class ActiveHealthCheckSession : public Event::DeferredDeletable {
   public:
@@ -77,6 +89,10 @@ protected:
     // been health checked.
     // Returns the changed state to use following the flag update.
     HealthTransition clearPendingFlag(HealthTransition changed_state);
+    // Publishes the result of the probe in flight, if any, to the probe cache.
+    void publishResult(const HealthCheckProbeCache::ProbeResult& result);
+    // Applies a result shared by another cluster instead of probing, if a recent one exists.
+    bool useSharedResult();
     virtual void onInterval() PURE;
     void onIntervalBase();
     virtual void onTimeout() PURE;
@@ -91,6 +107,9 @@ protected:
     uint32_t num_healthy_{};
     bool first_check_{true};
     TimeSource& time_source_;
+    HealthCheckProbeCache::Key probe_key_;
+    absl::optional<MonotonicTime> last_result_time_;
+    bool probing_{};
   };
 
   using ActiveHealthCheckSessionPtr = std::unique_ptr<ActiveHealthCheckSession>;
@@ -145,6 +164,9 @@ private:
   initTransportSocketOptions(const envoy::config::core::v3::HealthCheck& config);
   static MetadataConstSharedPtr
   initTransportSocketMatchMetadata(const envoy::config::core::v3::HealthCheck& config);
+  static absl::optional<std::string>
+  initProbeHostname(const envoy::config::core::v3::HealthCheck& config);
+  const std::string& probeHostname(const HostSharedPtr& host) const;
 
   std::list<HostStatusCb> callbacks_;
   const std::chrono::milliseconds interval_;
@@ -159,6 +181,10 @@ private:
   absl::node_hash_map<HostSharedPtr, ActiveHealthCheckSessionPtr> active_sessions_;
   const std::shared_ptr<const Network::TransportSocketOptionsImpl> transport_socket_options_;
   const MetadataConstSharedPtr transport_socket_match_metadata_;
+  const uint64_t probe_config_hash_;
+  // The configured host name of HTTP and gRPC probes, unset for health checks not sending one.
+  const absl::optional<std::string> probe_hostname_;
+  HealthCheckProbeCacheSharedPtr probe_cache_;
   const Common::CallbackHandlePtr member_update_cb_;
 };
 
@@ -0,0 +1,86 @@
+#include <memory>
+#include <string>
+
+#include "envoy/common/exception.h"
+#include "envoy/extensions/http/cache/lru_http_cache/v3/lru_http_cache.pb.h"
+#include "envoy/extensions/http/cache/lru_http_cache/v3/lru_http_cache.pb.validate.h"
+#include "envoy/registry/registry.h"
+
+#include "source/extensions/filters/http/cache/http_cache.h"
+#include "source/extensions/http/cache/lru_http_cache/lru_http_cache.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace {
+
+/**
+ * A singleton that acts as a factory for generating and looking up LruHttpCaches.
+ * When given equivalent configs, the singleton returns pointers to the same cache.
+ * When given different configs, the singleton returns different cache instances.
+ */
+class CacheSingleton : public Envoy::Singleton::Instance {
+public:
+  std::shared_ptr<LruHttpCache> get(std::shared_ptr<CacheSingleton> singleton,
+                                    const LruHttpCacheConfig& config, Stats::Scope& stats_scope) {
+    std::shared_ptr<LruHttpCache> cache;
+    const uint64_t key = MessageUtil::hash(config);
+    absl::MutexLock lock(&mu_);
+    auto it = caches_.find(key);
+    if (it != caches_.end()) {
+      cache = it->second.lock();
+    }
+    if (!cache || !Protobuf::util::MessageDifferencer::Equals(cache->config(), config)) {
+      cache = std::make_shared<LruHttpCache>(singleton, config, stats_scope);
+      caches_[key] = cache;
+    }
+    return cache;
+  }
+
+private:
+  absl::Mutex mu_;
+  // We keep weak_ptr here so the caches can be destroyed if the config is updated to stop using
+  // that config of cache. The caches each keep shared_ptrs to this singleton, which keeps the
+  // singleton from being destroyed unless it's no longer keeping track of any caches.
+  absl::flat_hash_map<uint64_t, std::weak_ptr<LruHttpCache>> caches_ ABSL_GUARDED_BY(mu_);
+};
+
+SINGLETON_MANAGER_REGISTRATION(lru_http_cache_singleton);
+
+class LruHttpCacheFactory : public HttpCacheFactory {
+public:
+  // From UntypedFactory
+  std::string name() const override { return std::string{LruHttpCache::name()}; }
+  // From TypedFactory
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<LruHttpCacheConfig>();
+  }
+  // From HttpCacheFactory
+  std::shared_ptr<HttpCache>
+  getCache(const envoy::extensions::filters::http::cache::v3::CacheConfig& filter_config,
+           Server::Configuration::FactoryContext& context) override {
+    LruHttpCacheConfig config;
+    MessageUtil::anyConvertAndValidate(filter_config.typed_config(), config,
+                                       context.messageValidationVisitor());
+    if (config.max_size_bytes() < LruHttpCache::numShards(config)) {
+      throw EnvoyException(
+          fmt::format("lru_http_cache: max_size_bytes {} is less than the {} shards",
+                      config.max_size_bytes(), LruHttpCache::numShards(config)));
+    }
+    std::shared_ptr<CacheSingleton> caches = context.singletonManager().getTyped<CacheSingleton>(
+        SINGLETON_MANAGER_REGISTERED_NAME(lru_http_cache_singleton),
+        [] { return std::make_shared<CacheSingleton>(); });
+    // A cache may be shared by several listeners and outlive any one of them, so its stats are
+    // created in the server scope, under its own stat prefix.
+    return caches->get(caches, config, context.serverScope());
+  }
+};
+
+static Registry::RegisterFactory<LruHttpCacheFactory, HttpCacheFactory> register_;
+
+} // namespace
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,416 @@
+#include "source/extensions/http/cache/lru_http_cache/lru_http_cache.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/http/header_map_impl.h"
+
+#include "absl/strings/str_cat.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace {
+
+// Returns a Key with the vary header added to custom_fields.
+// It is an error to call this with headers that don't include vary.
+// Returns nullopt if the vary headers in the response are not
+// compatible with the VaryAllowList in the LookupRequest.
+absl::optional<Key> variedRequestKey(const LookupRequest& request,
+                                     const Http::ResponseHeaderMap& response_headers) {
+  absl::btree_set<absl::string_view> vary_header_values =
+      VaryHeaderUtils::getVaryValues(response_headers);
+  ASSERT(!vary_header_values.empty());
+  const absl::optional<std::string> vary_identifier = VaryHeaderUtils::createVaryIdentifier(
+      request.varyAllowList(), vary_header_values, request.requestHeaders());
+  if (!vary_identifier.has_value()) {
+    return absl::nullopt;
+  }
+  Key varied_request_key = request.key();
+  varied_request_key.add_custom_fields(vary_identifier.value());
+  return varied_request_key;
+}
+
+// A read-only view of part of a cached body, which keeps the body alive until the buffer it is
+// added to is done with it.
+class SharedBodyFragment : public Buffer::BufferFragment {
+public:
+  SharedBodyFragment(LruHttpCache::BodyPtr body, uint64_t offset, uint64_t length)
+      : body_(std::move(body)), offset_(offset), length_(length) {}
+
+  // Buffer::BufferFragment
+  const void* data() const override { return body_->data() + offset_; }
+  size_t size() const override { return length_; }
+  void done() override { delete this; }
+
+private:
+  const LruHttpCache::BodyPtr body_;
+  const uint64_t offset_;
+  const uint64_t length_;
+};
+
+class LruLookupContext : public LookupContext {
+public:
+  LruLookupContext(LruHttpCache& cache, LookupRequest&& request)
+      : cache_(cache), request_(std::move(request)) {}
+
+  void getHeaders(LookupHeadersCallback&& cb) override {
+    auto entry = cache_.lookup(request_);
+    body_ = std::move(entry.body_);
+    trailers_ = std::move(entry.trailers_);
+    cb(entry.response_headers_
+           ? request_.makeLookupResult(std::move(entry.response_headers_),
+                                       std::move(entry.metadata_), body_ ? body_->size() : 0,
+                                       trailers_ != nullptr)
+           : LookupResult{});
+  }
+
+  void getBody(const AdjustedByteRange& range, LookupBodyCallback&& cb) override {
+    ASSERT(body_ != nullptr);
+    ASSERT(range.end() <= body_->size(), "Attempt to read past end of body.");
+    auto buffer = std::make_unique<Buffer::OwnedImpl>();
+    if (range.length() > 0) {
+      buffer->addBufferFragment(*new SharedBodyFragment(body_, range.begin(), range.length()));
+    }
+    cb(std::move(buffer));
+  }
+
+  // The cache must call cb with the cached trailers.
+  void getTrailers(LookupTrailersCallback&& cb) override {
+    ASSERT(trailers_);
+    cb(std::move(trailers_));
+  }
+
+  const LookupRequest& request() const { return request_; }
+  void onDestroy() override {}
+
+private:
+  LruHttpCache& cache_;
+  const LookupRequest request_;
+  LruHttpCache::BodyPtr body_;
+  Http::ResponseTrailerMapPtr trailers_;
+};
+
+class LruInsertContext : public InsertContext {
+public:
+  LruInsertContext(LookupContext& lookup_context, LruHttpCache& cache)
+      : key_(dynamic_cast<LruLookupContext&>(lookup_context).request().key()),
+        request_headers_(
+            dynamic_cast<LruLookupContext&>(lookup_context).request().requestHeaders()),
+        vary_allow_list_(dynamic_cast<LruLookupContext&>(lookup_context).request().varyAllowList()),
+        cache_(cache) {}
+
+  void insertHeaders(const Http::ResponseHeaderMap& response_headers,
+                     const ResponseMetadata& metadata, InsertCallback insert_success,
+                     bool end_stream) override {
+    ASSERT(!committed_);
+    response_headers_ = Http::createHeaderMap<Http::ResponseHeaderMapImpl>(response_headers);
+    metadata_ = metadata;
+    if (end_stream) {
+      insert_success(commit());
+    } else {
+      insert_success(true);
+    }
+  }
+
+  void insertBody(const Buffer::Instance& chunk, InsertCallback ready_for_next_chunk,
+                  bool end_stream) override {
+    ASSERT(!committed_);
+    ASSERT(ready_for_next_chunk || end_stream);
+
+    body_.add(chunk);
+    if (body_.length() > cache_.maxEntrySizeBytes()) {
+      // The response can never fit in the cache, so stop buffering it.
+      committed_ = true;
+      cache_.stats().insert_rejected_.inc();
+      ready_for_next_chunk(false);
+      return;
+    }
+    if (end_stream) {
+      ready_for_next_chunk(commit());
+    } else {
+      ready_for_next_chunk(true);
+    }
+  }
+
+  void insertTrailers(const Http::ResponseTrailerMap& trailers,
+                      InsertCallback insert_complete) override {
+    ASSERT(!committed_);
+    trailers_ = Http::createHeaderMap<Http::ResponseTrailerMapImpl>(trailers);
+    insert_complete(commit());
+  }
+
+  void onDestroy() override {}
+
+private:
+  bool commit() {
+    committed_ = true;
+    auto body = std::make_shared<const std::string>(body_.toString());
+    body_.drain(body_.length());
+    if (VaryHeaderUtils::hasVary(*response_headers_)) {
+      return cache_.varyInsert(key_, std::move(response_headers_), std::move(metadata_),
+                               std::move(body), request_headers_, vary_allow_list_,
+                               std::move(trailers_));
+    } else {
+      return cache_.insert(key_, std::move(response_headers_), std::move(metadata_),
+                           std::move(body), std::move(trailers_));
+    }
+  }
+
+  Key key_;
+  const Http::RequestHeaderMap& request_headers_;
+  const VaryAllowList& vary_allow_list_;
+  Http::ResponseHeaderMapPtr response_headers_;
+  ResponseMetadata metadata_;
+  LruHttpCache& cache_;
+  Buffer::OwnedImpl body_;
+  bool committed_ = false;
+  Http::ResponseTrailerMapPtr trailers_;
+};
+
+LruHttpCacheStats generateStats(Stats::Scope& scope, absl::string_view stat_prefix) {
+  const std::string prefix = absl::StrCat("lru_http_cache.", stat_prefix);
+  return {ALL_LRU_HTTP_CACHE_STATS(POOL_COUNTER_PREFIX(scope, prefix),
+                                   POOL_GAUGE_PREFIX(scope, prefix))};
+}
+
+} // namespace
+
+uint32_t LruHttpCache::numShards(const LruHttpCacheConfig& config) {
+  return PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, num_shards, DefaultNumShards);
+}
+
+LruHttpCache::LruHttpCache(Singleton::InstanceSharedPtr owner, const LruHttpCacheConfig& config,
+                           Stats::Scope& scope)
+    : owner_(std::move(owner)), config_(config),
+      stats_(generateStats(scope, config_.stat_prefix())),
+      shard_size_limit_bytes_(config_.max_size_bytes() / numShards(config_)) {
+  ASSERT(shard_size_limit_bytes_ > 0);
+  const uint32_t num_shards = numShards(config_);
+  shards_.reserve(num_shards);
+  for (uint32_t i = 0; i < num_shards; i++) {
+    shards_.push_back(std::make_unique<Shard>());
+  }
+  stats_.size_limit_bytes_.add(shard_size_limit_bytes_ * num_shards);
+}
+
+LruHttpCache::~LruHttpCache() {
+  // The gauges may be shared with a cache that replaces this one, so only remove this cache's
+  // share.
+  for (auto& shard : shards_) {
+    absl::MutexLock lock(&shard->mutex_);
+    stats_.size_bytes_.sub(shard->size_bytes_);
+    stats_.size_count_.sub(shard->lru_.size());
+  }
+  stats_.size_limit_bytes_.sub(shard_size_limit_bytes_ * shards_.size());
+}
+
+LookupContextPtr LruHttpCache::makeLookupContext(LookupRequest&& request,
+                                                 Http::StreamDecoderFilterCallbacks&) {
+  return std::make_unique<LruLookupContext>(*this, std::move(request));
+}
+
+InsertContextPtr LruHttpCache::makeInsertContext(LookupContextPtr&& lookup_context,
+                                                 Http::StreamEncoderFilterCallbacks&) {
+  ASSERT(lookup_context != nullptr);
+  return std::make_unique<LruInsertContext>(*lookup_context, *this);
+}
+
+void LruHttpCache::updateHeaders(const LookupContext& lookup_context,
+                                 const Http::ResponseHeaderMap& response_headers,
+                                 const ResponseMetadata& metadata,
+                                 std::function<void(bool)> on_complete) {
+  const auto& lru_lookup_context = static_cast<const LruLookupContext&>(lookup_context);
+  const LookupRequest& request = lru_lookup_context.request();
+  Key key = request.key();
+  {
+    const Entry entry = copyEntry(key);
+    if (!entry.response_headers_) {
+      on_complete(false);
+      return;
+    }
+    if (VaryHeaderUtils::hasVary(*entry.response_headers_)) {
+      absl::optional<Key> varied_key = variedRequestKey(request, *entry.response_headers_);
+      if (!varied_key.has_value()) {
+        on_complete(false);
+        return;
+      }
+      key = std::move(varied_key.value());
+    }
+  }
+  on_complete(updateEntry(key, response_headers, metadata));
+}
+
+absl::string_view LruHttpCache::name() {
+  return "envoy.extensions.http.cache.lru_http_cache";
+}
+
+CacheInfo LruHttpCache::cacheInfo() const {
+  CacheInfo cache_info;
+  cache_info.name_ = name();
+  return cache_info;
+}
+
+LruHttpCache::Entry LruHttpCache::lookup(const LookupRequest& request) {
+  Entry entry = copyEntry(request.key());
+  if (entry.response_headers_ && VaryHeaderUtils::hasVary(*entry.response_headers_)) {
+    // This is the marker entry for a varied response. The response itself is stored under a key
+    // that includes the varied request headers, which may be in another shard.
+    absl::optional<Key> varied_key = variedRequestKey(request, *entry.response_headers_);
+    entry = varied_key.has_value() ? copyEntry(varied_key.value()) : Entry{};
+  }
+  if (entry.response_headers_) {
+    stats_.hits_.inc();
+  } else {
+    stats_.misses_.inc();
+  }
+  return entry;
+}
+
+bool LruHttpCache::insert(const Key& key, Http::ResponseHeaderMapPtr&& response_headers,
+                          ResponseMetadata&& metadata, BodyPtr&& body,
+                          Http::ResponseTrailerMapPtr&& trailers) {
+  return insertEntry(key, Entry{std::move(response_headers), std::move(metadata), std::move(body),
+                                std::move(trailers)});
+}
+
+bool LruHttpCache::varyInsert(const Key& request_key, Http::ResponseHeaderMapPtr&& response_headers,
+                              ResponseMetadata&& metadata, BodyPtr&& body,
+                              const Http::RequestHeaderMap& request_headers,
+                              const VaryAllowList& vary_allow_list,
+                              Http::ResponseTrailerMapPtr&& trailers) {
+  absl::btree_set<absl::string_view> vary_header_values =
+      VaryHeaderUtils::getVaryValues(*response_headers);
+  ASSERT(!vary_header_values.empty());
+
+  const absl::optional<std::string> vary_identifier =
+      VaryHeaderUtils::createVaryIdentifier(vary_allow_list, vary_header_values, request_headers);
+  if (!vary_identifier.has_value()) {
+    // Skip the insert if we are unable to create a vary key.
+    return false;
+  }
+  Http::ResponseHeaderMapPtr vary_only_map =
+      Http::createHeaderMap<Http::ResponseHeaderMapImpl>({});
+  vary_only_map->setCopy(Http::CustomHeaders::get().Vary, absl::StrJoin(vary_header_values, ","));
+
+  // Insert the varied response.
+  Key varied_request_key = request_key;
+  varied_request_key.add_custom_fields(vary_identifier.value());
+  if (!insertEntry(varied_request_key, Entry{std::move(response_headers), std::move(metadata),
+                                             std::move(body), std::move(trailers)})) {
+    return false;
+  }
+
+  // Add or refresh the marker entry that flags that this request generates varied responses.
+  // Refreshing it keeps it from being evicted ahead of the responses it leads to.
+  return insertEntry(request_key, Entry{std::move(vary_only_map), {}, nullptr, nullptr});
+}
+
+LruHttpCache::Shard& LruHttpCache::shardFor(const Key& key) {
+  return *shards_[stableHashKey(key) % shards_.size()];
+}
+
+LruHttpCache::Entry LruHttpCache::copyEntry(const Key& key) {
+  Shard& shard = shardFor(key);
+  absl::MutexLock lock(&shard.mutex_);
+  auto map_it = shard.map_.find(key);
+  if (map_it == shard.map_.end()) {
+    return Entry{};
+  }
+  LruList::iterator it = map_it->second;
+  shard.lru_.splice(shard.lru_.begin(), shard.lru_, it);
+
+  const Entry& entry = it->entry_;
+  ASSERT(entry.response_headers_);
+  Http::ResponseTrailerMapPtr trailers;
+  if (entry.trailers_) {
+    trailers = Http::createHeaderMap<Http::ResponseTrailerMapImpl>(*entry.trailers_);
+  }
+  return Entry{Http::createHeaderMap<Http::ResponseHeaderMapImpl>(*entry.response_headers_),
+               entry.metadata_, entry.body_, std::move(trailers)};
+}
+
+bool LruHttpCache::insertEntry(const Key& key, Entry&& entry) {
+  LruEntry lru_entry(key, std::move(entry));
+  lru_entry.size_bytes_ = entrySizeBytes(lru_entry);
+  if (lru_entry.size_bytes_ > shard_size_limit_bytes_) {
+    stats_.insert_rejected_.inc();
+    return false;
+  }
+
+  Shard& shard = shardFor(key);
+  absl::MutexLock lock(&shard.mutex_);
+  auto map_it = shard.map_.find(key);
+  if (map_it != shard.map_.end()) {
+    eraseEntry(shard, map_it->second);
+  }
+  shard.lru_.push_front(std::move(lru_entry));
+  shard.map_.emplace(key, shard.lru_.begin());
+  shard.size_bytes_ += shard.lru_.front().size_bytes_;
+  stats_.size_bytes_.add(shard.lru_.front().size_bytes_);
+  stats_.size_count_.inc();
+  stats_.inserts_.inc();
+  evictUntilFits(shard);
+  return true;
+}
+
+bool LruHttpCache::updateEntry(const Key& key, const Http::ResponseHeaderMap& response_headers,
+                               const ResponseMetadata& metadata) {
+  Shard& shard = shardFor(key);
+  absl::MutexLock lock(&shard.mutex_);
+  auto map_it = shard.map_.find(key);
+  if (map_it == shard.map_.end()) {
+    return false;
+  }
+  LruList::iterator it = map_it->second;
+  shard.lru_.splice(shard.lru_.begin(), shard.lru_, it);
+  applyHeaderUpdate(response_headers, *it->entry_.response_headers_);
+  it->entry_.metadata_ = metadata;
+
+  const uint64_t old_size_bytes = it->size_bytes_;
+  it->size_bytes_ = entrySizeBytes(*it);
+  if (it->size_bytes_ >= old_size_bytes) {
+    shard.size_bytes_ += it->size_bytes_ - old_size_bytes;
+    stats_.size_bytes_.add(it->size_bytes_ - old_size_bytes);
+    evictUntilFits(shard);
+  } else {
+    shard.size_bytes_ -= old_size_bytes - it->size_bytes_;
+    stats_.size_bytes_.sub(old_size_bytes - it->size_bytes_);
+  }
+  return true;
+}
+
+void LruHttpCache::evictUntilFits(Shard& shard) {
+  while (shard.size_bytes_ > shard_size_limit_bytes_) {
+    ASSERT(!shard.lru_.empty());
+    eraseEntry(shard, std::prev(shard.lru_.end()));
+    stats_.evictions_.inc();
+  }
+}
+
+void LruHttpCache::eraseEntry(Shard& shard, LruList::iterator it) {
+  shard.size_bytes_ -= it->size_bytes_;
+  stats_.size_bytes_.sub(it->size_bytes_);
+  stats_.size_count_.dec();
+  shard.map_.erase(it->key_);
+  shard.lru_.erase(it);
+}
+
+uint64_t LruHttpCache::entrySizeBytes(const LruEntry& entry) {
+  // The key is stored twice, in the map and in the LRU list. The fixed overhead approximates the
+  // list node, the map slot and the header map objects.
+  uint64_t size_bytes = sizeof(LruEntry) + 4 * sizeof(void*) + 2 * entry.key_.SpaceUsedLong() +
+                        entry.entry_.response_headers_->byteSize() +
+                        sizeof(Http::ResponseHeaderMapImpl);
+  if (entry.entry_.body_ != nullptr) {
+    size_bytes += entry.entry_.body_->size();
+  }
+  if (entry.entry_.trailers_ != nullptr) {
+    size_bytes += entry.entry_.trailers_->byteSize() + sizeof(Http::ResponseTrailerMapImpl);
+  }
+  return size_bytes;
+}
+
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "envoy/extensions/http/cache/lru_http_cache/v3/lru_http_cache.pb.h"
+#include "envoy/singleton/instance.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/filters/http/cache/http_cache.h"
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+
+using LruHttpCacheConfig = envoy::extensions::http::cache::lru_http_cache::v3::LruHttpCacheConfig;
+
+/**
+ * All LRU HTTP cache stats. The hit ratio is hits / (hits + misses). @see stats_macros.h
+ */
+#define ALL_LRU_HTTP_CACHE_STATS(COUNTER, GAUGE)                                                   \
+  COUNTER(evictions)                                                                               \
+  COUNTER(hits)                                                                                    \
+  COUNTER(inserts)                                                                                 \
+  COUNTER(insert_rejected)                                                                         \
+  COUNTER(misses)                                                                                  \
+  GAUGE(size_bytes, NeverImport)                                                                   \
+  GAUGE(size_count, NeverImport)                                                                   \
+  GAUGE(size_limit_bytes, NeverImport)
+
+/**
+ * Struct definition for all LRU HTTP cache stats. @see stats_macros.h
+ */
+struct LruHttpCacheStats {
+  ALL_LRU_HTTP_CACHE_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+};
+
+// In-memory cache backend with a size limit. Entries are spread over shards by key, and each
+// shard has its own lock and evicts its least recently used entries when it is over its share
+// of the size limit. Bodies are immutable once inserted and are shared, without copying, with
+// every lookup that reads them.
+//
+// Cache instances jointly own the singleton that shares them between filter configs.
+class LruHttpCache : public HttpCache {
+public:
+  // A cached body. Held by the cache entry and by the buffers handed out to lookups, so that an
+  // evicted or replaced body stays valid for as long as a lookup is still reading it.
+  using BodyPtr = std::shared_ptr<const std::string>;
+
+  struct Entry {
+    Http::ResponseHeaderMapPtr response_headers_;
+    ResponseMetadata metadata_;
+    BodyPtr body_;
+    Http::ResponseTrailerMapPtr trailers_;
+  };
+
+  LruHttpCache(Singleton::InstanceSharedPtr owner, const LruHttpCacheConfig& config,
+               Stats::Scope& scope);
+  ~LruHttpCache() override;
+
+  static absl::string_view name();
+
+  // The number of shards a cache with the given config is split into.
+  static uint32_t numShards(const LruHttpCacheConfig& config);
+
+  // HttpCache
+  LookupContextPtr makeLookupContext(LookupRequest&& request,
+                                     Http::StreamDecoderFilterCallbacks& callbacks) override;
+  InsertContextPtr makeInsertContext(LookupContextPtr&& lookup_context,
+                                     Http::StreamEncoderFilterCallbacks& callbacks) override;
+  void updateHeaders(const LookupContext& lookup_context,
+                     const Http::ResponseHeaderMap& response_headers,
+                     const ResponseMetadata& metadata,
+                     std::function<void(bool)> on_complete) override;
+  CacheInfo cacheInfo() const override;
+
+  // Returns a copy of the headers and trailers of the entry matching the request, sharing its
+  // body. Returns an empty Entry on a miss.
+  Entry lookup(const LookupRequest& request);
+
+  bool insert(const Key& key, Http::ResponseHeaderMapPtr&& response_headers,
+              ResponseMetadata&& metadata, BodyPtr&& body, Http::ResponseTrailerMapPtr&& trailers);
+
+  // Inserts a response that has been varied on certain headers.
+  bool varyInsert(const Key& request_key, Http::ResponseHeaderMapPtr&& response_headers,
+                  ResponseMetadata&& metadata, BodyPtr&& body,
+                  const Http::RequestHeaderMap& request_headers,
+                  const VaryAllowList& vary_allow_list, Http::ResponseTrailerMapPtr&& trailers);
+
+  // The largest entry a single shard can hold. Larger responses are not cached.
+  uint64_t maxEntrySizeBytes() const { return shard_size_limit_bytes_; }
+
+  const LruHttpCacheConfig& config() const { return config_; }
+  const LruHttpCacheStats& stats() const { return stats_; }
+
+private:
+  static constexpr uint32_t DefaultNumShards = 16;
+
+  struct LruEntry {
+    LruEntry(const Key& key, Entry&& entry) : key_(key), entry_(std::move(entry)) {}
+
+    Key key_;
+    Entry entry_;
+    uint64_t size_bytes_{0};
+  };
+  // Most recently used entries are at the front.
+  using LruList = std::list<LruEntry>;
+
+  struct Shard {
+    absl::Mutex mutex_;
+    LruList lru_ ABSL_GUARDED_BY(mutex_);
+    absl::flat_hash_map<Key, LruList::iterator, MessageUtil, MessageUtil>
+        map_ ABSL_GUARDED_BY(mutex_);
+    uint64_t size_bytes_ ABSL_GUARDED_BY(mutex_){0};
+  };
+
+  Shard& shardFor(const Key& key);
+
+  // Finds the entry for key, moving it to the front of its shard's LRU list, and copies it,
+  // sharing its body. Returns an empty Entry if there is no such entry.
+  Entry copyEntry(const Key& key);
+
+  // Inserts or replaces the entry for key. Returns false if the entry is too large to be cached.
+  bool insertEntry(const Key& key, Entry&& entry);
+
+  // Replaces the headers and metadata of the entry for key. Returns false if there is no such
+  // entry.
+  bool updateEntry(const Key& key, const Http::ResponseHeaderMap& response_headers,
+                   const ResponseMetadata& metadata);
+
+  void evictUntilFits(Shard& shard) ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex_);
+  void eraseEntry(Shard& shard, LruList::iterator it) ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard.mutex_);
+  static uint64_t entrySizeBytes(const LruEntry& entry);
+
+  const Singleton::InstanceSharedPtr owner_;
+  const LruHttpCacheConfig config_;
+  LruHttpCacheStats stats_;
+  const uint64_t shard_size_limit_bytes_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
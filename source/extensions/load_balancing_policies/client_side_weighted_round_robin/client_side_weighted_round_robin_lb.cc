@@ -0,0 +1,225 @@
+#include "source/extensions/load_balancing_policies/client_side_weighted_round_robin/client_side_weighted_round_robin_lb.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "source/common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace LoadBalancingPolices {
+namespace ClientSideWeightedRoundRobin {
+
+namespace {
+
+constexpr uint64_t DefaultBlackoutPeriodMs = 10000;
+constexpr uint64_t DefaultWeightExpirationPeriodMs = 180000;
+constexpr uint64_t DefaultWeightUpdatePeriodMs = 1000;
+constexpr uint64_t MinWeightUpdatePeriodMs = 100;
+
+int64_t toNanoseconds(MonotonicTime time) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+// The hosts of the cluster only carry the data this policy attaches to them.
+OrcaHostLbPolicyData* orcaHostLbPolicyData(const Upstream::Host& host) {
+  const OptRef<Upstream::HostLbPolicyData> lb_policy_data = host.lbPolicyData();
+  ASSERT(!lb_policy_data.has_value() ||
+         dynamic_cast<OrcaHostLbPolicyData*>(lb_policy_data.ptr()) != nullptr);
+  return static_cast<OrcaHostLbPolicyData*>(lb_policy_data.ptr());
+}
+
+} // namespace
+
+OrcaHostLbPolicyData::OrcaHostLbPolicyData(TimeSource& time_source,
+                                           double error_utilization_penalty)
+    : time_source_(time_source), error_utilization_penalty_(error_utilization_penalty),
+      last_report_ns_(NeverReported), reporting_since_ns_(NeverReported) {}
+
+void OrcaHostLbPolicyData::onOrcaLoadReport(const xds::data::orca::v3::OrcaLoadReport& report) {
+  double utilization = report.application_utilization() > 0 ? report.application_utilization()
+                                                            : report.cpu_utilization();
+  const double qps = report.rps_fractional();
+  if (utilization <= 0 || qps <= 0) {
+    // Nothing to derive a weight from.
+    return;
+  }
+  if (report.eps() > 0) {
+    utilization += report.eps() / qps * error_utilization_penalty_;
+  }
+
+  const int64_t now_ns = toNanoseconds(time_source_.monotonicTime());
+  reported_weight_.store(qps / utilization, std::memory_order_relaxed);
+  int64_t reporting_since_ns = NeverReported;
+  reporting_since_ns_.compare_exchange_strong(reporting_since_ns, now_ns,
+                                              std::memory_order_relaxed);
+  last_report_ns_.store(now_ns, std::memory_order_release);
+}
+
+absl::optional<double>
+OrcaHostLbPolicyData::reportedWeight(MonotonicTime now, std::chrono::nanoseconds blackout_period,
+                                     std::chrono::nanoseconds weight_expiration_period) {
+  const int64_t now_ns = toNanoseconds(now);
+  const int64_t last_report_ns = last_report_ns_.load(std::memory_order_acquire);
+  if (last_report_ns == NeverReported) {
+    return absl::nullopt;
+  }
+  if (now_ns - last_report_ns >= weight_expiration_period.count()) {
+    // Restart the blackout period when the host reports again.
+    reporting_since_ns_.store(NeverReported, std::memory_order_relaxed);
+    return absl::nullopt;
+  }
+  const int64_t reporting_since_ns = reporting_since_ns_.load(std::memory_order_relaxed);
+  if (reporting_since_ns == NeverReported ||
+      now_ns - reporting_since_ns < blackout_period.count()) {
+    return absl::nullopt;
+  }
+  return reported_weight_.load(std::memory_order_relaxed);
+}
+
+WeightUpdater::WeightUpdater(const ClientSideWeightedRoundRobinLbProto& config,
+                             TimeSource& time_source)
+    : time_source_(time_source), error_utilization_penalty_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(
+                                     config, error_utilization_penalty, 1.0)),
+      blackout_period_(std::chrono::milliseconds(
+          PROTOBUF_GET_MS_OR_DEFAULT(config, blackout_period, DefaultBlackoutPeriodMs))),
+      weight_expiration_period_(std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(
+          config, weight_expiration_period, DefaultWeightExpirationPeriodMs))),
+      weight_update_period_(std::chrono::milliseconds(
+          std::max(PROTOBUF_GET_MS_OR_DEFAULT(config, weight_update_period,
+                                              DefaultWeightUpdatePeriodMs),
+                   MinWeightUpdatePeriodMs))) {}
+
+Upstream::HostLbPolicyDataPtr WeightUpdater::createHostLbPolicyData() const {
+  return std::make_unique<OrcaHostLbPolicyData>(time_source_, error_utilization_penalty_);
+}
+
+void WeightUpdater::maybeUpdateWeights(const Upstream::PrioritySet& priority_set) {
+  const MonotonicTime now = time_source_.monotonicTime();
+  const int64_t now_ns = toNanoseconds(now);
+  int64_t next_update_ns = next_update_ns_.load(std::memory_order_relaxed);
+  if (now_ns < next_update_ns ||
+      !next_update_ns_.compare_exchange_strong(next_update_ns,
+                                               now_ns + weight_update_period_.count(),
+                                               std::memory_order_relaxed)) {
+    return;
+  }
+  updateDefaultWeight(priority_set, now);
+}
+
+void WeightUpdater::updateDefaultWeight(const Upstream::PrioritySet& priority_set,
+                                        MonotonicTime now) {
+  size_t num_hosts = 0;
+  for (const auto& host_set : priority_set.hostSetsPerPriority()) {
+    num_hosts += host_set->hosts().size();
+  }
+  // Sample every stride-th host of the cluster, so that the sample is spread over all priorities.
+  const size_t stride = std::max<size_t>(1, (num_hosts + MaxDefaultWeightSamples - 1) /
+                                                MaxDefaultWeightSamples);
+  std::vector<double> usable_weights;
+  usable_weights.reserve(std::min<size_t>(num_hosts, MaxDefaultWeightSamples));
+  size_t offset = 0;
+  for (const auto& host_set : priority_set.hostSetsPerPriority()) {
+    const Upstream::HostVector& hosts = host_set->hosts();
+    for (; offset < hosts.size(); offset += stride) {
+      OrcaHostLbPolicyData* data = orcaHostLbPolicyData(*hosts[offset]);
+      const absl::optional<double> weight =
+          data != nullptr ? data->reportedWeight(now, blackout_period_, weight_expiration_period_)
+                          : absl::nullopt;
+      if (weight.has_value()) {
+        usable_weights.push_back(weight.value());
+      }
+    }
+    offset -= hosts.size();
+  }
+
+  double default_weight = 1;
+  if (!usable_weights.empty()) {
+    auto median = usable_weights.begin() + usable_weights.size() / 2;
+    std::nth_element(usable_weights.begin(), median, usable_weights.end());
+    default_weight = *median;
+  }
+  default_weight_.store(default_weight, std::memory_order_relaxed);
+  update_ns_.store(toNanoseconds(now), std::memory_order_release);
+}
+
+double WeightUpdater::hostWeight(const Upstream::Host& host) const {
+  OrcaHostLbPolicyData* data = orcaHostLbPolicyData(host);
+  if (data == nullptr) {
+    return 1;
+  }
+  const int64_t update_ns = update_ns_.load(std::memory_order_acquire);
+  if (data->weightUpdateNs() != update_ns) {
+    // Workers racing to recompute the weight for the same update compute the same value.
+    const MonotonicTime update_time{std::chrono::nanoseconds(update_ns)};
+    data->weight(data->reportedWeight(update_time, blackout_period_, weight_expiration_period_)
+                     .value_or(default_weight_.load(std::memory_order_relaxed)),
+                 update_ns);
+  }
+  return data->weight();
+}
+
+ClientSideWeightedRoundRobinLoadBalancer::ClientSideWeightedRoundRobinLoadBalancer(
+    const Upstream::PrioritySet& priority_set, const Upstream::PrioritySet* local_priority_set,
+    Upstream::ClusterLbStats& stats, Runtime::Loader& runtime, Random::RandomGenerator& random,
+    uint32_t healthy_panic_threshold, WeightUpdaterSharedPtr weight_updater,
+    TimeSource& time_source)
+    : EdfLoadBalancerBase(priority_set, local_priority_set, stats, runtime, random,
+                          healthy_panic_threshold, absl::nullopt, absl::nullopt, time_source),
+      weight_updater_(std::move(weight_updater)) {
+  initialize();
+}
+
+Upstream::HostConstSharedPtr
+ClientSideWeightedRoundRobinLoadBalancer::chooseHostOnce(Upstream::LoadBalancerContext* context) {
+  weight_updater_->maybeUpdateWeights(priority_set_);
+  return EdfLoadBalancerBase::chooseHostOnce(context);
+}
+
+double ClientSideWeightedRoundRobinLoadBalancer::hostWeight(const Upstream::Host& host) const {
+  return weight_updater_->hostWeight(host);
+}
+
+ClientSideWeightedRoundRobinThreadAwareLoadBalancer::
+    ClientSideWeightedRoundRobinThreadAwareLoadBalancer(
+        const ClientSideWeightedRoundRobinLbProto& config,
+        const Upstream::ClusterInfo& cluster_info, const Upstream::PrioritySet& priority_set,
+        Runtime::Loader& runtime, Random::RandomGenerator& random, TimeSource& time_source)
+    : priority_set_(priority_set),
+      weight_updater_(std::make_shared<WeightUpdater>(config, time_source)),
+      factory_(std::make_shared<LbFactory>(weight_updater_, cluster_info, runtime, random,
+                                           time_source)) {}
+
+void ClientSideWeightedRoundRobinThreadAwareLoadBalancer::initialize() {
+  for (const auto& host_set : priority_set_.hostSetsPerPriority()) {
+    addLbPolicyData(host_set->hosts());
+  }
+  // This runs before the cluster manager hands the updated hosts to the workers.
+  priority_update_cb_ = priority_set_.addPriorityUpdateCb(
+      [this](uint32_t, const Upstream::HostVector& hosts_added, const Upstream::HostVector&) {
+        addLbPolicyData(hosts_added);
+      });
+}
+
+void ClientSideWeightedRoundRobinThreadAwareLoadBalancer::addLbPolicyData(
+    const Upstream::HostVector& hosts) {
+  for (const auto& host : hosts) {
+    if (!host->lbPolicyData().has_value()) {
+      host->setLbPolicyData(weight_updater_->createHostLbPolicyData());
+    }
+  }
+}
+
+Upstream::LoadBalancerPtr ClientSideWeightedRoundRobinThreadAwareLoadBalancer::LbFactory::create(
+    Upstream::LoadBalancerParams params) {
+  return std::make_unique<ClientSideWeightedRoundRobinLoadBalancer>(
+      params.priority_set, params.local_priority_set, cluster_info_.lbStats(), runtime_, random_,
+      PROTOBUF_PERCENT_TO_ROUNDED_INTEGER_OR_DEFAULT(cluster_info_.lbConfig(),
+                                                     healthy_panic_threshold, 100, 50),
+      weight_updater_, time_source_);
+}
+
+} // namespace ClientSideWeightedRoundRobin
+} // namespace LoadBalancingPolices
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/load_balancing_policies/client_side_weighted_round_robin/v3/client_side_weighted_round_robin.pb.h"
+#include "envoy/upstream/upstream.h"
+
+#include "source/common/upstream/load_balancer_impl.h"
+
+#include "absl/types/optional.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace LoadBalancingPolices {
+namespace ClientSideWeightedRoundRobin {
+
+using ClientSideWeightedRoundRobinLbProto = envoy::extensions::load_balancing_policies::
+    client_side_weighted_round_robin::v3::ClientSideWeightedRoundRobin;
+
+/**
+ * Weight of a single host derived from the ORCA load reports it attaches to its responses, shared
+ * by all workers. Reports update the reported weight, which only becomes the weight used for load
+ * balancing once the host has been reporting for blackout_period. The weight used for load
+ * balancing is recomputed by WeightUpdater::hostWeight() at most once per weight update. Updates
+ * and reads are lock free.
+ */
+class OrcaHostLbPolicyData : public Upstream::HostLbPolicyData {
+public:
+  OrcaHostLbPolicyData(TimeSource& time_source, double error_utilization_penalty);
+
+  // Upstream::HostLbPolicyData
+  void onOrcaLoadReport(const xds::data::orca::v3::OrcaLoadReport& report) override;
+  bool consumesOrcaLoadReports() const override { return true; }
+
+  /**
+   * @return the weight computed from the latest load report, or nullopt if the host has not been
+   *         reporting for at least blackout_period, or has not reported for
+   *         weight_expiration_period. An expired host has to report for blackout_period again
+   *         before its weight is used.
+   */
+  absl::optional<double> reportedWeight(MonotonicTime now, std::chrono::nanoseconds blackout_period,
+                                        std::chrono::nanoseconds weight_expiration_period);
+
+  /**
+   * @return the weight used for load balancing.
+   */
+  double weight() const { return weight_.load(std::memory_order_relaxed); }
+
+  /**
+   * @return the time of the weight update the weight was last computed for, in nanoseconds.
+   */
+  int64_t weightUpdateNs() const { return weight_update_ns_.load(std::memory_order_relaxed); }
+
+  void weight(double weight, int64_t weight_update_ns) {
+    weight_.store(weight, std::memory_order_relaxed);
+    weight_update_ns_.store(weight_update_ns, std::memory_order_relaxed);
+  }
+
+  static constexpr int64_t NeverReported = std::numeric_limits<int64_t>::min();
+
+private:
+  TimeSource& time_source_;
+  const double error_utilization_penalty_;
+  std::atomic<double> reported_weight_{0};
+  // Monotonic times in nanoseconds, or NeverReported.
+  std::atomic<int64_t> last_report_ns_;
+  std::atomic<int64_t> reporting_since_ns_;
+  std::atomic<double> weight_{1};
+  std::atomic<int64_t> weight_update_ns_{NeverReported};
+};
+
+/**
+ * Settings shared by the thread aware load balancer and the worker load balancers of a cluster,
+ * and the state deciding when host weights are next updated.
+ */
+class WeightUpdater {
+public:
+  WeightUpdater(const ClientSideWeightedRoundRobinLbProto& config, TimeSource& time_source);
+
+  Upstream::HostLbPolicyDataPtr createHostLbPolicyData() const;
+
+  /**
+   * Starts a new weight update if weight_update_period has passed since the last one. Called by
+   * workers on their own priority sets when picking a host. When several workers are due at the
+   * same time, only one of them starts the update. The update only computes the default weight,
+   * from at most MaxDefaultWeightSamples hosts, so its cost does not grow with the cluster.
+   */
+  void maybeUpdateWeights(const Upstream::PrioritySet& priority_set);
+
+  /**
+   * Computes the default weight for hosts without a usable reported weight: the median of the
+   * usable weights of a sample of the hosts, or 1 if there are none.
+   */
+  void updateDefaultWeight(const Upstream::PrioritySet& priority_set, MonotonicTime now);
+
+  /**
+   * @return the weight of a host for load balancing: its reported weight as of the latest weight
+   *         update, or the default weight if it has none. Recomputed at most once per update.
+   */
+  double hostWeight(const Upstream::Host& host) const;
+
+  // The maximum number of hosts the default weight is computed from.
+  static constexpr uint32_t MaxDefaultWeightSamples = 128;
+
+private:
+  TimeSource& time_source_;
+  const double error_utilization_penalty_;
+  const std::chrono::nanoseconds blackout_period_;
+  const std::chrono::nanoseconds weight_expiration_period_;
+  const std::chrono::nanoseconds weight_update_period_;
+  std::atomic<int64_t> next_update_ns_{std::numeric_limits<int64_t>::min()};
+  std::atomic<double> default_weight_{1};
+  // The time of the latest weight update, or NeverReported before the first one.
+  std::atomic<int64_t> update_ns_{OrcaHostLbPolicyData::NeverReported};
+};
+
+using WeightUpdaterSharedPtr = std::shared_ptr<WeightUpdater>;
+
+/**
+ * Worker load balancer which schedules hosts by the weights computed from their load reports. The
+ * weights are read again every time a host is rescheduled, so the schedule follows weight updates
+ * without being rebuilt.
+ */
+class ClientSideWeightedRoundRobinLoadBalancer : public Upstream::EdfLoadBalancerBase {
+public:
+  ClientSideWeightedRoundRobinLoadBalancer(const Upstream::PrioritySet& priority_set,
+                                           const Upstream::PrioritySet* local_priority_set,
+                                           Upstream::ClusterLbStats& stats,
+                                           Runtime::Loader& runtime,
+                                           Random::RandomGenerator& random,
+                                           uint32_t healthy_panic_threshold,
+                                           WeightUpdaterSharedPtr weight_updater,
+                                           TimeSource& time_source);
+
+  // Upstream::EdfLoadBalancerBase
+  Upstream::HostConstSharedPtr chooseHostOnce(Upstream::LoadBalancerContext* context) override;
+
+private:
+  void refreshHostSource(const HostsSource&) override {}
+  double hostWeight(const Upstream::Host& host) const override;
+  bool alwaysUseEdfScheduler() const override { return true; }
+  // The EDF scheduler is always used, so these are only reached if it has no hosts.
+  Upstream::HostConstSharedPtr unweightedHostPeek(const Upstream::HostVector&,
+                                                  const HostsSource&) override {
+    return nullptr;
+  }
+  Upstream::HostConstSharedPtr unweightedHostPick(const Upstream::HostVector&,
+                                                  const HostsSource&) override {
+    return nullptr;
+  }
+
+  const WeightUpdaterSharedPtr weight_updater_;
+};
+
+/**
+ * Thread aware part of the client side weighted round robin load balancer. It attaches an
+ * OrcaHostLbPolicyData to every host of the cluster on the main thread, before the host is handed
+ * to the workers, and creates a ClientSideWeightedRoundRobinLoadBalancer per worker.
+ */
+class ClientSideWeightedRoundRobinThreadAwareLoadBalancer
+    : public Upstream::ThreadAwareLoadBalancer {
+public:
+  ClientSideWeightedRoundRobinThreadAwareLoadBalancer(
+      const ClientSideWeightedRoundRobinLbProto& config, const Upstream::ClusterInfo& cluster_info,
+      const Upstream::PrioritySet& priority_set, Runtime::Loader& runtime,
+      Random::RandomGenerator& random, TimeSource& time_source);
+
+  // Upstream::ThreadAwareLoadBalancer
+  Upstream::LoadBalancerFactorySharedPtr factory() override { return factory_; }
+  void initialize() override;
+
+  const WeightUpdater& weightUpdater() const { return *weight_updater_; }
+
+private:
+  class LbFactory : public Upstream::LoadBalancerFactory {
+  public:
+    LbFactory(WeightUpdaterSharedPtr weight_updater, const Upstream::ClusterInfo& cluster_info,
+              Runtime::Loader& runtime, Random::RandomGenerator& random, TimeSource& time_source)
+        : weight_updater_(std::move(weight_updater)), cluster_info_(cluster_info),
+          runtime_(runtime), random_(random), time_source_(time_source) {}
+
+    // Upstream::LoadBalancerFactory
+    Upstream::LoadBalancerPtr create(Upstream::LoadBalancerParams params) override;
+    bool recreateOnHostChange() const override { return false; }
+
+  private:
+    const WeightUpdaterSharedPtr weight_updater_;
+    const Upstream::ClusterInfo& cluster_info_;
+    Runtime::Loader& runtime_;
+    Random::RandomGenerator& random_;
+    TimeSource& time_source_;
+  };
+
+  void addLbPolicyData(const Upstream::HostVector& hosts);
+
+  const Upstream::PrioritySet& priority_set_;
+  const WeightUpdaterSharedPtr weight_updater_;
+  std::shared_ptr<LbFactory> factory_;
+  Common::CallbackHandlePtr priority_update_cb_;
+};
+
+} // namespace ClientSideWeightedRoundRobin
+} // namespace LoadBalancingPolices
+} // namespace Extensions
+} // namespace Envoy
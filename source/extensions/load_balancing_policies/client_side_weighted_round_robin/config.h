@@ -0,0 +1,63 @@
+#pragma once
+
+#include "envoy/extensions/load_balancing_policies/client_side_weighted_round_robin/v3/client_side_weighted_round_robin.pb.h"
+#include "envoy/extensions/load_balancing_policies/client_side_weighted_round_robin/v3/client_side_weighted_round_robin.pb.validate.h"
+#include "envoy/common/exception.h"
+#include "envoy/upstream/load_balancer.h"
+
+#include "source/common/upstream/load_balancer_factory_base.h"
+#include "source/extensions/load_balancing_policies/client_side_weighted_round_robin/client_side_weighted_round_robin_lb.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace LoadBalancingPolices {
+namespace ClientSideWeightedRoundRobin {
+
+/**
+ * Load balancer config that used to wrap the client side weighted round robin config.
+ */
+class TypedClientSideWeightedRoundRobinLbConfig : public Upstream::LoadBalancerConfig {
+public:
+  TypedClientSideWeightedRoundRobinLbConfig(
+      const ClientSideWeightedRoundRobinLbProto& lb_config);
+
+  const ClientSideWeightedRoundRobinLbProto lb_config_;
+};
+
+class Factory
+    : public Upstream::TypedLoadBalancerFactoryBase<ClientSideWeightedRoundRobinLbProto> {
+public:
+  Factory()
+      : TypedLoadBalancerFactoryBase(
+            "envoy.load_balancing_policies.client_side_weighted_round_robin") {}
+
+  Upstream::ThreadAwareLoadBalancerPtr create(OptRef<const Upstream::LoadBalancerConfig> lb_config,
+                                              const Upstream::ClusterInfo& cluster_info,
+                                              const Upstream::PrioritySet& priority_set,
+                                              Runtime::Loader& runtime,
+                                              Envoy::Random::RandomGenerator& random,
+                                              TimeSource& time_source) override;
+
+  Upstream::LoadBalancerConfigPtr loadConfig(const Protobuf::Message& config,
+                                             ProtobufMessage::ValidationVisitor&) override {
+    auto typed_config = dynamic_cast<const ClientSideWeightedRoundRobinLbProto*>(&config);
+    if (typed_config == nullptr) {
+      return std::make_unique<TypedClientSideWeightedRoundRobinLbConfig>(
+          ClientSideWeightedRoundRobinLbProto());
+    }
+    // Out-of-band load reporting is not implemented, so reject configs that ask for it rather than
+    // silently using per-request reports.
+    if (typed_config->has_enable_oob_load_report() || typed_config->has_oob_reporting_period()) {
+      throw EnvoyException("client_side_weighted_round_robin: out-of-band load reporting "
+                           "(enable_oob_load_report, oob_reporting_period) is not supported");
+    }
+    return std::make_unique<TypedClientSideWeightedRoundRobinLbConfig>(*typed_config);
+  }
+};
+
+DECLARE_FACTORY(Factory);
+
+} // namespace ClientSideWeightedRoundRobin
+} // namespace LoadBalancingPolices
+} // namespace Extensions
+} // namespace Envoy
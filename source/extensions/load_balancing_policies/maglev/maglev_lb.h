@@ -83,19 +83,27 @@ public:
 protected:
   struct TableBuildEntry {
     TableBuildEntry(const HostConstSharedPtr& host, uint64_t offset, uint64_t skip, double weight)
-        : host_(host), offset_(offset), skip_(skip), weight_(weight) {}
+        : host_(host), offset_(offset), skip_(skip), weight_(weight), permutation_(offset) {}
+
+    // Moves permutation_ to the next slot of the host's preference list. This is
+    // (offset_ + skip_ * n) % table_size for increasing n, computed without a multiplication or
+    // division per probe since offset_ and skip_ are both below table_size.
+    void nextPermutation(uint64_t table_size) {
+      permutation_ += skip_;
+      if (permutation_ >= table_size) {
+        permutation_ -= table_size;
+      }
+    }
 
     HostConstSharedPtr host_;
     const uint64_t offset_;
     const uint64_t skip_;
     const double weight_;
     double target_weight_{};
-    uint64_t next_{};
+    uint64_t permutation_;
     uint64_t count_{};
   };
 
-  uint64_t permutation(const TableBuildEntry& entry);
-
   /**
    * Template method for constructing the Maglev table.
    */
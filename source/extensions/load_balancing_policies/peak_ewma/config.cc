@@ -0,0 +1,36 @@
+#include "source/extensions/load_balancing_policies/peak_ewma/config.h"
+
+#include "envoy/extensions/load_balancing_policies/peak_ewma/v3/peak_ewma.pb.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace LoadBalancingPolices {
+namespace PeakEwma {
+
+TypedPeakEwmaLbConfig::TypedPeakEwmaLbConfig(const PeakEwmaLbProto& lb_config)
+    : lb_config_(lb_config) {}
+
+Upstream::ThreadAwareLoadBalancerPtr
+Factory::create(OptRef<const Upstream::LoadBalancerConfig> lb_config,
+                const Upstream::ClusterInfo& cluster_info,
+                const Upstream::PrioritySet& priority_set, Runtime::Loader& runtime,
+                Envoy::Random::RandomGenerator& random, TimeSource& time_source) {
+  const auto typed_lb_config = dynamic_cast<const TypedPeakEwmaLbConfig*>(lb_config.ptr());
+  // The load balancing policy configuration will be loaded and validated in the main thread when we
+  // load the cluster configuration. So we can assume the configuration is valid here.
+  ASSERT(typed_lb_config != nullptr,
+         "Invalid load balancing policy configuration for peak EWMA load balancer");
+
+  return std::make_unique<PeakEwmaThreadAwareLoadBalancer>(
+      typed_lb_config->lb_config_, cluster_info, priority_set, runtime, random, time_source);
+}
+
+/**
+ * Static registration for the Factory. @see RegisterFactory.
+ */
+REGISTER_FACTORY(Factory, Upstream::TypedLoadBalancerFactory);
+
+} // namespace PeakEwma
+} // namespace LoadBalancingPolices
+} // namespace Extensions
+} // namespace Envoy
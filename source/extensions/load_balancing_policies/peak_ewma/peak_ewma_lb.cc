@@ -0,0 +1,157 @@
+#include "source/extensions/load_balancing_policies/peak_ewma/peak_ewma_lb.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "source/common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace LoadBalancingPolices {
+namespace PeakEwma {
+
+namespace {
+
+constexpr uint32_t DefaultChoiceCount = 2;
+constexpr uint64_t DefaultDecayTimeMs = 10000;
+constexpr uint64_t DefaultRttMs = 30;
+
+} // namespace
+
+PeakEwmaHostLbPolicyData::PeakEwmaHostLbPolicyData(TimeSource& time_source,
+                                                   std::chrono::nanoseconds decay_time,
+                                                   std::chrono::microseconds default_rtt)
+    : time_source_(time_source), decay_time_ns_(decay_time.count()),
+      default_rtt_us_(default_rtt.count()), latency_us_(default_rtt_us_),
+      last_update_ns_(NeverUpdated) {}
+
+int64_t PeakEwmaHostLbPolicyData::toNanoseconds(MonotonicTime time) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+double PeakEwmaHostLbPolicyData::decayFactor(int64_t elapsed_ns) const {
+  return std::exp(-static_cast<double>(std::max<int64_t>(elapsed_ns, 0)) / decay_time_ns_);
+}
+
+void PeakEwmaHostLbPolicyData::onUpstreamRequestComplete(std::chrono::microseconds latency) {
+  const int64_t now_ns = toNanoseconds(time_source_.monotonicTime());
+  const int64_t last_update_ns = last_update_ns_.load(std::memory_order_relaxed);
+  // The first sample replaces default_rtt entirely.
+  const double decay = last_update_ns == NeverUpdated ? 0 : decayFactor(now_ns - last_update_ns);
+  const double sample = latency.count();
+
+  double current = latency_us_.load(std::memory_order_relaxed);
+  double updated;
+  do {
+    updated = sample > current ? sample : current * decay + sample * (1 - decay);
+  } while (!latency_us_.compare_exchange_weak(current, updated, std::memory_order_relaxed));
+  last_update_ns_.store(now_ns, std::memory_order_release);
+}
+
+double PeakEwmaHostLbPolicyData::latency(MonotonicTime now) const {
+  const int64_t last_update_ns = last_update_ns_.load(std::memory_order_acquire);
+  const double latency_us = latency_us_.load(std::memory_order_relaxed);
+  if (last_update_ns == NeverUpdated) {
+    return latency_us;
+  }
+  return default_rtt_us_ +
+         (latency_us - default_rtt_us_) * decayFactor(toNanoseconds(now) - last_update_ns);
+}
+
+PeakEwmaLoadBalancer::PeakEwmaLoadBalancer(
+    const Upstream::PrioritySet& priority_set, const Upstream::PrioritySet* local_priority_set,
+    Upstream::ClusterLbStats& stats, Runtime::Loader& runtime, Random::RandomGenerator& random,
+    uint32_t healthy_panic_threshold, const PeakEwmaLbProto& config, TimeSource& time_source)
+    : ZoneAwareLoadBalancerBase(
+          priority_set, local_priority_set, stats, runtime, random, healthy_panic_threshold,
+          Upstream::LoadBalancerConfigHelper::localityLbConfigFromProto(config)),
+      choice_count_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, choice_count, DefaultChoiceCount)),
+      default_rtt_us_(PROTOBUF_GET_MS_OR_DEFAULT(config, default_rtt, DefaultRttMs) * 1000.0),
+      time_source_(time_source) {}
+
+double PeakEwmaLoadBalancer::cost(const Upstream::Host& host, MonotonicTime now) const {
+  // The hosts of the cluster only carry the data this policy attaches to them.
+  const OptRef<Upstream::HostLbPolicyData> lb_policy_data = host.lbPolicyData();
+  ASSERT(!lb_policy_data.has_value() ||
+         dynamic_cast<const PeakEwmaHostLbPolicyData*>(lb_policy_data.ptr()) != nullptr);
+  const auto* peak_ewma_data = static_cast<const PeakEwmaHostLbPolicyData*>(lb_policy_data.ptr());
+  const double latency_us =
+      peak_ewma_data != nullptr ? peak_ewma_data->latency(now) : default_rtt_us_;
+  // Weights are at least 1.
+  return latency_us * (host.stats().rq_active_.value() + 1) / host.weight();
+}
+
+Upstream::HostConstSharedPtr
+PeakEwmaLoadBalancer::chooseHostOnce(Upstream::LoadBalancerContext* context) {
+  const absl::optional<HostsSource> hosts_source = hostSourceToUse(context, random(false));
+  if (!hosts_source) {
+    return nullptr;
+  }
+
+  const Upstream::HostVector& hosts_to_use = hostSourceToHosts(*hosts_source);
+  if (hosts_to_use.empty()) {
+    return nullptr;
+  }
+  if (hosts_to_use.size() == 1) {
+    return hosts_to_use[0];
+  }
+
+  const MonotonicTime now = time_source_.monotonicTime();
+  Upstream::HostConstSharedPtr candidate_host;
+  double candidate_cost = 0;
+  for (uint32_t choice_idx = 0; choice_idx < choice_count_; ++choice_idx) {
+    const Upstream::HostSharedPtr& sampled_host =
+        hosts_to_use[random_.random() % hosts_to_use.size()];
+    const double sampled_cost = cost(*sampled_host, now);
+    if (candidate_host == nullptr || sampled_cost < candidate_cost) {
+      candidate_host = sampled_host;
+      candidate_cost = sampled_cost;
+    }
+  }
+  return candidate_host;
+}
+
+PeakEwmaThreadAwareLoadBalancer::PeakEwmaThreadAwareLoadBalancer(
+    const PeakEwmaLbProto& config, const Upstream::ClusterInfo& cluster_info,
+    const Upstream::PrioritySet& priority_set, Runtime::Loader& runtime,
+    Random::RandomGenerator& random, TimeSource& time_source)
+    : priority_set_(priority_set), time_source_(time_source),
+      decay_time_(std::chrono::milliseconds(
+          PROTOBUF_GET_MS_OR_DEFAULT(config, decay_time, DefaultDecayTimeMs))),
+      default_rtt_(
+          std::chrono::milliseconds(PROTOBUF_GET_MS_OR_DEFAULT(config, default_rtt, DefaultRttMs))),
+      factory_(std::make_shared<LbFactory>(config, cluster_info, runtime, random, time_source)) {}
+
+void PeakEwmaThreadAwareLoadBalancer::initialize() {
+  for (const auto& host_set : priority_set_.hostSetsPerPriority()) {
+    addLbPolicyData(host_set->hosts());
+  }
+  // This runs before the cluster manager hands the updated hosts to the workers.
+  priority_update_cb_ = priority_set_.addPriorityUpdateCb(
+      [this](uint32_t, const Upstream::HostVector& hosts_added, const Upstream::HostVector&) {
+        addLbPolicyData(hosts_added);
+      });
+}
+
+void PeakEwmaThreadAwareLoadBalancer::addLbPolicyData(const Upstream::HostVector& hosts) {
+  for (const auto& host : hosts) {
+    if (!host->lbPolicyData().has_value()) {
+      host->setLbPolicyData(
+          std::make_unique<PeakEwmaHostLbPolicyData>(time_source_, decay_time_, default_rtt_));
+    }
+  }
+}
+
+Upstream::LoadBalancerPtr
+PeakEwmaThreadAwareLoadBalancer::LbFactory::create(Upstream::LoadBalancerParams params) {
+  return std::make_unique<PeakEwmaLoadBalancer>(
+      params.priority_set, params.local_priority_set, cluster_info_.lbStats(), runtime_, random_,
+      PROTOBUF_PERCENT_TO_ROUNDED_INTEGER_OR_DEFAULT(cluster_info_.lbConfig(),
+                                                     healthy_panic_threshold, 100, 50),
+      config_, time_source_);
+}
+
+} // namespace PeakEwma
+} // namespace LoadBalancingPolices
+} // namespace Extensions
+} // namespace Envoy
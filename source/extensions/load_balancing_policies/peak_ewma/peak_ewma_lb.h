@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+#include "envoy/common/time.h"
+#include "envoy/extensions/load_balancing_policies/peak_ewma/v3/peak_ewma.pb.h"
+#include "envoy/upstream/upstream.h"
+
+#include "source/common/upstream/load_balancer_impl.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace LoadBalancingPolices {
+namespace PeakEwma {
+
+using PeakEwmaLbProto = envoy::extensions::load_balancing_policies::peak_ewma::v3::PeakEwma;
+
+/**
+ * Latency estimate of a single host, shared by all workers. The estimate is an exponentially
+ * weighted moving average of request latencies, except that a sample above the current estimate
+ * replaces it outright. A host that slows down is therefore avoided immediately, and is only
+ * trusted again as its faster samples accumulate. While the host completes no requests, the
+ * estimate relaxes back towards default_rtt, so that a host that was avoided is eventually retried.
+ *
+ * Updates and reads are lock free. Concurrent updates from several workers may each be applied
+ * against a slightly stale timestamp, which only affects how much the estimate has decayed.
+ */
+class PeakEwmaHostLbPolicyData : public Upstream::HostLbPolicyData {
+public:
+  PeakEwmaHostLbPolicyData(TimeSource& time_source, std::chrono::nanoseconds decay_time,
+                           std::chrono::microseconds default_rtt);
+
+  // Upstream::HostLbPolicyData
+  void onUpstreamRequestComplete(std::chrono::microseconds latency) override;
+
+  /**
+   * @return the latency estimate at the given time, in microseconds.
+   */
+  double latency(MonotonicTime now) const;
+
+private:
+  static int64_t toNanoseconds(MonotonicTime time);
+  double decayFactor(int64_t elapsed_ns) const;
+
+  TimeSource& time_source_;
+  const double decay_time_ns_;
+  const double default_rtt_us_;
+  std::atomic<double> latency_us_;
+  // Monotonic time of the last update in nanoseconds, or NeverUpdated. Written after latency_us_.
+  std::atomic<int64_t> last_update_ns_;
+  static constexpr int64_t NeverUpdated = std::numeric_limits<int64_t>::min();
+};
+
+/**
+ * Load balancer which picks, out of choice_count random hosts, the host with the lowest latency
+ * estimate multiplied by its number of active requests plus one, divided by its weight. The latency
+ * estimates are kept in PeakEwmaHostLbPolicyData attached to each host on the main thread.
+ */
+class PeakEwmaLoadBalancer : public Upstream::ZoneAwareLoadBalancerBase {
+public:
+  PeakEwmaLoadBalancer(const Upstream::PrioritySet& priority_set,
+                       const Upstream::PrioritySet* local_priority_set,
+                       Upstream::ClusterLbStats& stats, Runtime::Loader& runtime,
+                       Random::RandomGenerator& random, uint32_t healthy_panic_threshold,
+                       const PeakEwmaLbProto& config, TimeSource& time_source);
+
+  // Upstream::ZoneAwareLoadBalancerBase
+  Upstream::HostConstSharedPtr chooseHostOnce(Upstream::LoadBalancerContext* context) override;
+  // Preconnect is not supported, as the pick depends on the load at the time of the pick.
+  Upstream::HostConstSharedPtr peekAnotherHost(Upstream::LoadBalancerContext*) override {
+    return nullptr;
+  }
+
+private:
+  double cost(const Upstream::Host& host, MonotonicTime now) const;
+
+  const uint32_t choice_count_;
+  const double default_rtt_us_;
+  TimeSource& time_source_;
+};
+
+/**
+ * Thread aware part of the peak EWMA load balancer. It attaches a PeakEwmaHostLbPolicyData to
+ * every host of the cluster on the main thread, before the host is handed to the workers, and
+ * creates a PeakEwmaLoadBalancer per worker.
+ */
+class PeakEwmaThreadAwareLoadBalancer : public Upstream::ThreadAwareLoadBalancer {
+public:
+  PeakEwmaThreadAwareLoadBalancer(const PeakEwmaLbProto& config,
+                                  const Upstream::ClusterInfo& cluster_info,
+                                  const Upstream::PrioritySet& priority_set,
+                                  Runtime::Loader& runtime, Random::RandomGenerator& random,
+                                  TimeSource& time_source);
+
+  // Upstream::ThreadAwareLoadBalancer
+  Upstream::LoadBalancerFactorySharedPtr factory() override { return factory_; }
+  void initialize() override;
+
+private:
+  class LbFactory : public Upstream::LoadBalancerFactory {
+  public:
+    LbFactory(const PeakEwmaLbProto& config, const Upstream::ClusterInfo& cluster_info,
+              Runtime::Loader& runtime, Random::RandomGenerator& random, TimeSource& time_source)
+        : config_(config), cluster_info_(cluster_info), runtime_(runtime), random_(random),
+          time_source_(time_source) {}
+
+    // Upstream::LoadBalancerFactory
+    Upstream::LoadBalancerPtr create(Upstream::LoadBalancerParams params) override;
+    bool recreateOnHostChange() const override { return false; }
+
+  private:
+    const PeakEwmaLbProto config_;
+    const Upstream::ClusterInfo& cluster_info_;
+    Runtime::Loader& runtime_;
+    Random::RandomGenerator& random_;
+    TimeSource& time_source_;
+  };
+
+  void addLbPolicyData(const Upstream::HostVector& hosts);
+
+  const Upstream::PrioritySet& priority_set_;
+  TimeSource& time_source_;
+  const std::chrono::nanoseconds decay_time_;
+  const std::chrono::microseconds default_rtt_;
+  std::shared_ptr<LbFactory> factory_;
+  Common::CallbackHandlePtr priority_update_cb_;
+};
+
+} // namespace PeakEwma
+} // namespace LoadBalancingPolices
+} // namespace Extensions
+} // namespace Envoy
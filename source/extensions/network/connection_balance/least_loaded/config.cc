@@ -0,0 +1,50 @@
+#include <memory>
+#include <string>
+
+#include "envoy/config/core/v3/extension.pb.h"
+#include "envoy/extensions/network/connection_balance/least_loaded/v3/least_loaded.pb.h"
+#include "envoy/extensions/network/connection_balance/least_loaded/v3/least_loaded.pb.validate.h"
+#include "envoy/registry/registry.h"
+#include "envoy/server/factory_context.h"
+
+#include "source/common/network/connection_balancer_impl.h"
+#include "source/common/protobuf/utility.h"
+#include "source/extensions/network/connection_balance/least_loaded/least_loaded_connection_balancer.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Network {
+namespace ConnectionBalance {
+namespace {
+
+class LeastLoadedConnectionBalanceFactory : public Envoy::Network::ConnectionBalanceFactory {
+public:
+  // From UntypedFactory
+  std::string name() const override { return "envoy.network.connection_balance.least_loaded"; }
+  // From TypedFactory
+  ProtobufTypes::MessagePtr createEmptyConfigProto() override {
+    return std::make_unique<LeastLoadedConfig>();
+  }
+  // From ConnectionBalanceFactory
+  Envoy::Network::ConnectionBalancerSharedPtr
+  createConnectionBalancerFromProto(const Protobuf::Message& config,
+                                    Server::Configuration::FactoryContext& context) override {
+    const auto& typed_config =
+        dynamic_cast<const envoy::config::core::v3::TypedExtensionConfig&>(config);
+    LeastLoadedConfig least_loaded_config;
+    MessageUtil::anyConvertAndValidate(typed_config.typed_config(), least_loaded_config,
+                                       context.messageValidationVisitor());
+    return std::make_shared<LeastLoadedConnectionBalancerImpl>(
+        least_loaded_config, context.api().randomGenerator(), context.listenerScope());
+  }
+};
+
+static Registry::RegisterFactory<LeastLoadedConnectionBalanceFactory,
+                                 Envoy::Network::ConnectionBalanceFactory>
+    register_;
+
+} // namespace
+} // namespace ConnectionBalance
+} // namespace Network
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,91 @@
+#include "source/extensions/network/connection_balance/least_loaded/least_loaded_connection_balancer.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "source/common/protobuf/utility.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Network {
+namespace ConnectionBalance {
+
+LeastLoadedConnectionBalancerStats
+LeastLoadedConnectionBalancerImpl::generateStats(Stats::Scope& scope) {
+  const std::string prefix = "connection_balance.least_loaded.";
+  return {ALL_LEAST_LOADED_CONNECTION_BALANCER_STATS(POOL_COUNTER_PREFIX(scope, prefix),
+                                                     POOL_GAUGE_PREFIX(scope, prefix))};
+}
+
+LeastLoadedConnectionBalancerImpl::LeastLoadedConnectionBalancerImpl(
+    const LeastLoadedConfig& config, Random::RandomGenerator& random, Stats::Scope& scope)
+    : choice_count_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, choice_count, 2)),
+      imbalance_threshold_(PROTOBUF_GET_WRAPPED_OR_DEFAULT(config, imbalance_threshold, 1)),
+      random_(random), stats_(generateStats(scope)) {}
+
+void LeastLoadedConnectionBalancerImpl::registerHandler(
+    Envoy::Network::BalancedConnectionHandler& handler) {
+  absl::MutexLock lock(&lock_);
+  handlers_.push_back(&handler);
+}
+
+void LeastLoadedConnectionBalancerImpl::unregisterHandler(
+    Envoy::Network::BalancedConnectionHandler& handler) {
+  // Waits for the picks sampling the handler to finish, after which it is no longer referenced.
+  absl::MutexLock lock(&lock_);
+  handlers_.erase(std::find(handlers_.begin(), handlers_.end(), &handler));
+}
+
+Envoy::Network::BalancedConnectionHandler& LeastLoadedConnectionBalancerImpl::pickTargetHandler(
+    Envoy::Network::BalancedConnectionHandler& current_handler) {
+  Envoy::Network::BalancedConnectionHandler* target = &current_handler;
+  uint64_t target_connections = current_handler.numConnections();
+
+  // Picks only read the handlers, so concurrent accepts share the lock rather than queueing on it
+  // as with the exact balancer.
+  absl::ReaderMutexLock lock(&lock_);
+  const size_t num_handlers = handlers_.size();
+  if (num_handlers > 1) {
+    for (uint32_t i = 0; i < choice_count_; i++) {
+      Envoy::Network::BalancedConnectionHandler* candidate =
+          handlers_[random_.random() % num_handlers];
+      if (candidate == target) {
+        continue;
+      }
+      const uint64_t candidate_connections = candidate->numConnections();
+      // Only hand off to another handler when it is sufficiently less loaded than the accepting
+      // handler, so that nearly balanced handlers do not bounce connections between them.
+      const uint64_t threshold = target == &current_handler ? imbalance_threshold_ : 1;
+      if (candidate_connections + threshold <= target_connections) {
+        target = candidate;
+        target_connections = candidate_connections;
+      }
+    }
+  }
+
+  target->incNumConnections();
+  if (target != &current_handler) {
+    stats_.connections_rebalanced_.inc();
+  }
+  if (num_picks_.fetch_add(1, std::memory_order_relaxed) % SkewUpdateInterval == 0) {
+    updateSkew();
+  }
+  return *target;
+}
+
+void LeastLoadedConnectionBalancerImpl::updateSkew() {
+  uint64_t min_connections = std::numeric_limits<uint64_t>::max();
+  uint64_t max_connections = 0;
+  for (const Envoy::Network::BalancedConnectionHandler* handler : handlers_) {
+    const uint64_t connections = handler->numConnections();
+    min_connections = std::min(min_connections, connections);
+    max_connections = std::max(max_connections, connections);
+  }
+  stats_.connection_skew_.set(
+      max_connections >= min_connections ? max_connections - min_connections : 0);
+}
+
+} // namespace ConnectionBalance
+} // namespace Network
+} // namespace Extensions
+} // namespace Envoy
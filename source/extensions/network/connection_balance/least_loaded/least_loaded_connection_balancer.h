@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "envoy/common/random_generator.h"
+#include "envoy/extensions/network/connection_balance/least_loaded/v3/least_loaded.pb.h"
+#include "envoy/network/connection_balancer.h"
+#include "envoy/stats/scope.h"
+#include "envoy/stats/stats_macros.h"
+
+#include "absl/synchronization/mutex.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace Network {
+namespace ConnectionBalance {
+
+using LeastLoadedConfig =
+    envoy::extensions::network::connection_balance::least_loaded::v3::LeastLoaded;
+
+/**
+ * All least loaded connection balancer stats. @see stats_macros.h
+ */
+#define ALL_LEAST_LOADED_CONNECTION_BALANCER_STATS(COUNTER, GAUGE)                                 \
+  COUNTER(connections_rebalanced)                                                                  \
+  GAUGE(connection_skew, NeverImport)
+
+/**
+ * Struct definition for all least loaded connection balancer stats. @see stats_macros.h
+ */
+struct LeastLoadedConnectionBalancerStats {
+  ALL_LEAST_LOADED_CONNECTION_BALANCER_STATS(GENERATE_COUNTER_STRUCT, GENERATE_GAUGE_STRUCT)
+};
+
+/**
+ * Connection balancer that hands accepted connections off to less loaded handlers without
+ * serializing accepts. The accepting handler samples a few other handlers at random, and the
+ * connection goes to the least loaded of them if it has at least imbalance_threshold fewer
+ * connections than the accepting handler. Otherwise the accepting handler keeps it.
+ *
+ * The load of a handler is its number of connections, the only load the
+ * BalancedConnectionHandler interface exposes.
+ *
+ * pickTargetHandler() holds a shared lock on the handlers while sampling them, so that a handler
+ * cannot be unregistered and destroyed while it is being read. Registration is rare and takes the
+ * lock exclusively.
+ */
+class LeastLoadedConnectionBalancerImpl : public Envoy::Network::ConnectionBalancer {
+public:
+  LeastLoadedConnectionBalancerImpl(const LeastLoadedConfig& config,
+                                    Random::RandomGenerator& random, Stats::Scope& scope);
+
+  // Network::ConnectionBalancer
+  void registerHandler(Envoy::Network::BalancedConnectionHandler& handler) override;
+  void unregisterHandler(Envoy::Network::BalancedConnectionHandler& handler) override;
+  Envoy::Network::BalancedConnectionHandler&
+  pickTargetHandler(Envoy::Network::BalancedConnectionHandler& current_handler) override;
+
+  const LeastLoadedConnectionBalancerStats& stats() const { return stats_; }
+
+  // The connection_skew gauge is recomputed once every this many accepted connections.
+  static constexpr uint32_t SkewUpdateInterval = 64;
+
+private:
+  static LeastLoadedConnectionBalancerStats generateStats(Stats::Scope& scope);
+  void updateSkew() ABSL_SHARED_LOCKS_REQUIRED(lock_);
+
+  const uint32_t choice_count_;
+  const uint64_t imbalance_threshold_;
+  Random::RandomGenerator& random_;
+  LeastLoadedConnectionBalancerStats stats_;
+  std::atomic<uint32_t> num_picks_{0};
+  absl::Mutex lock_;
+  std::vector<Envoy::Network::BalancedConnectionHandler*> handlers_ ABSL_GUARDED_BY(lock_);
+};
+
+} // namespace ConnectionBalance
+} // namespace Network
+} // namespace Extensions
+} // namespace Envoy
@@ -274,6 +274,55 @@ uint64_t outputPrimitiveStatType(Buffer::Instance& response, const StatsParams&
   return result;
 }
 
+// Outputs the per-host metrics of all clusters.
+//
+// Note: This assumes that there is no overlap in stat name between per-endpoint stats and all
+// other stats. If this is not true, then the counters/gauges for per-endpoint need to be combined
+// with the counter/gauge output so that stats can be properly grouped.
+uint64_t outputHostMetrics(Buffer::Instance& response, const StatsParams& params,
+                           const Upstream::ClusterManager& cluster_manager,
+                           const Stats::CustomStatNamespaces& custom_namespaces) {
+  std::vector<Stats::PrimitiveCounterSnapshot> host_counters;
+  std::vector<Stats::PrimitiveGaugeSnapshot> host_gauges;
+  Upstream::HostUtility::forEachHostMetric(
+      cluster_manager,
+      [&](Stats::PrimitiveCounterSnapshot&& metric) {
+        host_counters.emplace_back(std::move(metric));
+      },
+      [&](Stats::PrimitiveGaugeSnapshot&& metric) { host_gauges.emplace_back(std::move(metric)); });
+
+  return outputPrimitiveStatType(response, params, host_counters, "counter", custom_namespaces) +
+         outputPrimitiveStatType(response, params, host_gauges, "gauge", custom_namespaces);
+}
+
+// Dispatches to the Store::forEach* method for StatType.
+template <class StatType>
+void forEachStat(const Stats::Store& store, Stats::SizeFn f_size, Stats::StatFn<StatType> f_stat);
+
+template <>
+void forEachStat<Stats::Counter>(const Stats::Store& store, Stats::SizeFn f_size,
+                                 Stats::StatFn<Stats::Counter> f_stat) {
+  store.forEachCounter(f_size, f_stat);
+}
+
+template <>
+void forEachStat<Stats::Gauge>(const Stats::Store& store, Stats::SizeFn f_size,
+                               Stats::StatFn<Stats::Gauge> f_stat) {
+  store.forEachGauge(f_size, f_stat);
+}
+
+template <>
+void forEachStat<Stats::TextReadout>(const Stats::Store& store, Stats::SizeFn f_size,
+                                     Stats::StatFn<Stats::TextReadout> f_stat) {
+  store.forEachTextReadout(f_size, f_stat);
+}
+
+template <>
+void forEachStat<Stats::ParentHistogram>(const Stats::Store& store, Stats::SizeFn f_size,
+                                         Stats::StatFn<Stats::ParentHistogram> f_stat) {
+  store.forEachHistogram(f_size, f_stat);
+}
+
 } // namespace
 
 std::string PrometheusStatsFormatter::formattedTags(const std::vector<Stats::Tag>& tags) {
@@ -335,25 +384,157 @@ uint64_t PrometheusStatsFormatter::statsAsPrometheus(
   metric_name_count += outputStatType<Stats::ParentHistogram>(
       response, params, histograms, generateHistogramOutput, "histogram", custom_namespaces);
 
-  // Note: This assumes that there is no overlap in stat name between per-endpoint stats and all
-  // other stats. If this is not true, then the counters/gauges for per-endpoint need to be combined
-  // with the above counter/gauge calls so that stats can be properly grouped.
-  std::vector<Stats::PrimitiveCounterSnapshot> host_counters;
-  std::vector<Stats::PrimitiveGaugeSnapshot> host_gauges;
-  Upstream::HostUtility::forEachHostMetric(
-      cluster_manager,
-      [&](Stats::PrimitiveCounterSnapshot&& metric) {
-        host_counters.emplace_back(std::move(metric));
-      },
-      [&](Stats::PrimitiveGaugeSnapshot&& metric) { host_gauges.emplace_back(std::move(metric)); });
+  metric_name_count += outputHostMetrics(response, params, cluster_manager, custom_namespaces);
 
-  metric_name_count +=
-      outputPrimitiveStatType(response, params, host_counters, "counter", custom_namespaces);
+  return metric_name_count;
+}
 
-  metric_name_count +=
-      outputPrimitiveStatType(response, params, host_gauges, "gauge", custom_namespaces);
+const absl::optional<std::string>&
+PrometheusMetricNameCache::metricName(Stats::StatName tag_extracted_name,
+                                      const Stats::CustomStatNamespaces& custom_namespaces) {
+  auto it = names_.find(tag_extracted_name);
+  if (it != names_.end()) {
+    return it->second.name_;
+  }
+  if (names_.size() >= MaxEntries) {
+    clear();
+  }
+  CachedName cached{Stats::StatNameStorage(tag_extracted_name, symbol_table_),
+                    PrometheusStatsFormatter::metricName(
+                        symbol_table_.toString(tag_extracted_name), custom_namespaces)};
+  const Stats::StatName key = cached.storage_.statName();
+  return names_.emplace(key, std::move(cached)).first->second.name_;
+}
 
-  return metric_name_count;
+void PrometheusMetricNameCache::clear() {
+  for (auto& entry : names_) {
+    entry.second.storage_.free(symbol_table_);
+  }
+  names_.clear();
+}
+
+PrometheusStatsRequest::PrometheusStatsRequest(
+    Stats::Store& stats, const StatsParams& params,
+    const Upstream::ClusterManager& cluster_manager,
+    const Stats::CustomStatNamespaces& custom_namespaces, PrometheusMetricNameCache& name_cache)
+    : stats_(stats), params_(params), cluster_manager_(cluster_manager),
+      custom_namespaces_(custom_namespaces), name_cache_(name_cache) {}
+
+Http::Code PrometheusStatsRequest::start(Http::ResponseHeaderMap&) { return Http::Code::OK; }
+
+bool PrometheusStatsRequest::nextChunk(Buffer::Instance& response) {
+  // As with StatsRequest, the contract is to add up to chunk_size_ additional bytes, without
+  // requiring the caller to drain the response between calls.
+  const uint64_t limit = response.length() + chunk_size_;
+  while (response.length() < limit) {
+    switch (phase_) {
+    case Phase::Counters:
+      renderPhase<Stats::Counter>(counters_, generateStatNumericOutput<Stats::Counter>, "counter",
+                                  Phase::Gauges, response, limit);
+      break;
+    case Phase::Gauges:
+      renderPhase<Stats::Gauge>(gauges_, generateStatNumericOutput<Stats::Gauge>, "gauge",
+                                params_.prometheus_text_readouts_ ? Phase::TextReadouts
+                                                                  : Phase::Histograms,
+                                response, limit);
+      break;
+    case Phase::TextReadouts:
+      // TextReadout stats are returned in gauge format, so "gauge" type is set intentionally.
+      renderPhase<Stats::TextReadout>(text_readouts_, generateTextReadoutOutput, "gauge",
+                                      Phase::Histograms, response, limit);
+      break;
+    case Phase::Histograms:
+      renderPhase<Stats::ParentHistogram>(histograms_, generateHistogramOutput, "histogram",
+                                          Phase::HostMetrics, response, limit);
+      break;
+    case Phase::HostMetrics:
+      // Per-host metrics are not backed by stats we can hold references to across chunks, so,
+      // as in StatsRequest, they are rendered in one batch.
+      outputHostMetrics(response, params_, cluster_manager_, custom_namespaces_);
+      return false;
+    }
+  }
+  return true;
+}
+
+template <class StatType>
+void PrometheusStatsRequest::renderPhase(StatVec<StatType>& stats,
+                                         const GenerateFn<StatType>& generate_output,
+                                         absl::string_view type, Phase next_phase,
+                                         Buffer::Instance& response, uint64_t limit) {
+  if (!phase_started_) {
+    collectStats(stats);
+    phase_started_ = true;
+  }
+  if (renderStats(stats, generate_output, type, response, limit)) {
+    phase_ = next_phase;
+    phase_started_ = false;
+  }
+}
+
+template <class StatType> void PrometheusStatsRequest::collectStats(StatVec<StatType>& stats) {
+  ASSERT(stats.empty() && next_stat_ == 0);
+  forEachStat<StatType>(
+      stats_, [&stats](size_t size) { stats.reserve(size); },
+      [this, &stats](StatType& metric) {
+        if (params_.shouldShowMetric(metric)) {
+          stats.emplace_back(&metric);
+        }
+      });
+
+  // Sort to satisfy the exposition format, which requires all the lines of a metric family to
+  // be in one group, and the "preferred" ordering within a group, by metric name.
+  const Stats::SymbolTable& symbol_table = stats_.constSymbolTable();
+  std::sort(stats.begin(), stats.end(),
+            [&symbol_table](const Stats::RefcountPtr<StatType>& a,
+                            const Stats::RefcountPtr<StatType>& b) {
+              const Stats::StatName a_family = a->tagExtractedStatName();
+              const Stats::StatName b_family = b->tagExtractedStatName();
+              if (a_family != b_family) {
+                if (symbol_table.lessThan(a_family, b_family)) {
+                  return true;
+                }
+                if (symbol_table.lessThan(b_family, a_family)) {
+                  return false;
+                }
+              }
+              return symbol_table.lessThan(a->statName(), b->statName());
+            });
+}
+
+template <class StatType>
+bool PrometheusStatsRequest::renderStats(StatVec<StatType>& stats,
+                                         const GenerateFn<StatType>& generate_output,
+                                         absl::string_view type, Buffer::Instance& response,
+                                         uint64_t limit) {
+  const Stats::SymbolTable& symbol_table = stats_.constSymbolTable();
+  for (; next_stat_ < stats.size(); ++next_stat_) {
+    if (response.length() >= limit) {
+      return false;
+    }
+    const StatType& metric = *stats[next_stat_];
+    const Stats::StatName family = metric.tagExtractedStatName();
+    bool new_family = next_stat_ == 0;
+    if (!new_family) {
+      // The stats are sorted, so a family ends where the tag-extracted name increases.
+      const Stats::StatName prev_family = stats[next_stat_ - 1]->tagExtractedStatName();
+      new_family = family != prev_family && symbol_table.lessThan(prev_family, family);
+    }
+    if (new_family) {
+      family_name_ = name_cache_.metricName(family, custom_namespaces_);
+      if (family_name_.has_value()) {
+        response.addFragments({"# TYPE ", family_name_.value(), " ", type, "\n"});
+      }
+    }
+    if (family_name_.has_value()) {
+      response.add(generate_output(metric, family_name_.value()));
+    }
+  }
+
+  // Drop the references as soon as the phase is complete.
+  stats.clear();
+  next_stat_ = 0;
+  return true;
 }
 
 } // namespace Server
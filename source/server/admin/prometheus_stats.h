@@ -1,13 +1,18 @@
 #pragma once
 
+#include <functional>
 #include <regex>
 #include <string>
+#include <vector>
 
 #include "envoy/buffer/buffer.h"
+#include "envoy/server/admin.h"
 #include "envoy/stats/custom_stat_namespaces.h"
 #include "envoy/stats/histogram.h"
 #include "envoy/stats/stats.h"
+#include "envoy/stats/store.h"
 
+#include "source/common/stats/symbol_table.h"
 #include "source/server/admin/stats_params.h"
 
 namespace Envoy {
@@ -48,5 +53,110 @@ public:
              const Stats::CustomStatNamespaces& custom_namespace_factory);
 };
 
+/**
+ * Caches the result of PrometheusStatsFormatter::metricName() for tag-extracted stat names, so
+ * that repeated scrapes neither serialize nor sanitize the name of every metric family again.
+ *
+ * Custom stat namespaces are registered by extensions before they create stats in them, so a
+ * cached result does not go stale as namespaces are added. Must only be used from the main thread.
+ */
+class PrometheusMetricNameCache {
+public:
+  // The cache is cleared when it reaches this many entries, bounding its memory when families
+  // keep coming and going, e.g. for stats without tag extraction.
+  static constexpr uint64_t MaxEntries = 64 * 1024;
+
+  explicit PrometheusMetricNameCache(Stats::SymbolTable& symbol_table)
+      : symbol_table_(symbol_table) {}
+  ~PrometheusMetricNameCache() { clear(); }
+
+  /**
+   * @param tag_extracted_name the tag-extracted name of a metric.
+   * @param custom_namespaces the registered custom stat namespaces.
+   * @return the Prometheus name for the metric family, or nullopt if it cannot be exported.
+   */
+  const absl::optional<std::string>&
+  metricName(Stats::StatName tag_extracted_name,
+             const Stats::CustomStatNamespaces& custom_namespaces);
+
+  void clear();
+  uint64_t size() const { return names_.size(); }
+
+private:
+  struct CachedName {
+    // Owns the key of the entry in names_. The encoded bytes are heap allocated, so the key
+    // remains valid when the entry is moved as the map grows.
+    Stats::StatNameStorage storage_;
+    absl::optional<std::string> name_;
+  };
+
+  Stats::SymbolTable& symbol_table_;
+  Stats::StatNameHashMap<CachedName> names_;
+};
+
+/**
+ * Streams the Prometheus exposition of a stats store in chunks. This produces the same output as
+ * PrometheusStatsFormatter::statsAsPrometheus(), but instead of building per-family maps of all
+ * the metrics up front, each stat type is collected as a vector of references that is sorted by
+ * tag-extracted name, and rendered into the response as the client consumes it.
+ */
+class PrometheusStatsRequest : public Admin::Request {
+public:
+  static constexpr uint64_t DefaultChunkSize = 2 * 1000 * 1000;
+
+  PrometheusStatsRequest(Stats::Store& stats, const StatsParams& params,
+                         const Upstream::ClusterManager& cluster_manager,
+                         const Stats::CustomStatNamespaces& custom_namespaces,
+                         PrometheusMetricNameCache& name_cache);
+
+  // Admin::Request
+  Http::Code start(Http::ResponseHeaderMap& response_headers) override;
+  bool nextChunk(Buffer::Instance& response) override;
+
+  // Sets the chunk size.
+  void setChunkSize(uint64_t chunk_size) { chunk_size_ = chunk_size; }
+
+private:
+  // Ordered to match the output of PrometheusStatsFormatter::statsAsPrometheus().
+  enum class Phase { Counters, Gauges, TextReadouts, Histograms, HostMetrics };
+
+  template <class StatType> using StatVec = std::vector<Stats::RefcountPtr<StatType>>;
+  template <class StatType>
+  using GenerateFn = std::function<std::string(const StatType& metric,
+                                               const std::string& prefixed_tag_extracted_name)>;
+
+  // Collects the stats of a type that pass the filters in params_, ordered by tag-extracted
+  // name and then by name.
+  template <class StatType> void collectStats(StatVec<StatType>& stats);
+
+  // Renders collected stats from next_stat_ on, until the response reaches limit. Returns true
+  // once all of them have been rendered.
+  template <class StatType>
+  bool renderStats(StatVec<StatType>& stats, const GenerateFn<StatType>& generate_output,
+                   absl::string_view type, Buffer::Instance& response, uint64_t limit);
+
+  // Collects the stats of a type when the phase starts and renders them, advancing to next_phase
+  // when they are all rendered.
+  template <class StatType>
+  void renderPhase(StatVec<StatType>& stats, const GenerateFn<StatType>& generate_output,
+                   absl::string_view type, Phase next_phase, Buffer::Instance& response,
+                   uint64_t limit);
+
+  Stats::Store& stats_;
+  const StatsParams params_;
+  const Upstream::ClusterManager& cluster_manager_;
+  const Stats::CustomStatNamespaces& custom_namespaces_;
+  PrometheusMetricNameCache& name_cache_;
+  uint64_t chunk_size_{DefaultChunkSize};
+  Phase phase_{Phase::Counters};
+  bool phase_started_{false};
+  size_t next_stat_{0};
+  absl::optional<std::string> family_name_;
+  StatVec<Stats::Counter> counters_;
+  StatVec<Stats::Gauge> gauges_;
+  StatVec<Stats::TextReadout> text_readouts_;
+  StatVec<Stats::ParentHistogram> histograms_;
+};
+
 } // namespace Server
 } // namespace Envoy
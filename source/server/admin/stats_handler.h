@@ -10,6 +10,7 @@
 #include "envoy/server/instance.h"
 
 #include "source/server/admin/handler_ctx.h"
+#include "source/server/admin/prometheus_stats.h"
 #include "source/server/admin/stats_request.h"
 #include "source/server/admin/utils.h"
 
@@ -33,32 +34,24 @@ public:
                                               Buffer::Instance& response, AdminStream&);
   Http::Code handlerStatsRecentLookupsEnable(Http::ResponseHeaderMap& response_headers,
                                              Buffer::Instance& response, AdminStream&);
-  Http::Code handlerPrometheusStats(Http::ResponseHeaderMap& response_headers,
-                                    Buffer::Instance& response, AdminStream&);
 
   /**
-   * Parses and executes a prometheus stats request.
-   *
-   * @param path_and_query the URL path and query
-   * @param response buffer into which to write response
-   * @return http response code
+   * @return a URL handler for /stats/prometheus, which streams its response.
    */
-  Http::Code prometheusStats(absl::string_view path_and_query, Buffer::Instance& response);
+  Admin::UrlHandler prometheusStatsHandler();
 
   /**
-   * Checks the server_ to see if a flush is needed, and then renders the
-   * prometheus stats request.
-   *
-   * @params params the already-parsed parameters.
-   * @param response buffer into which to write response
+   * Parses a /stats/prometheus request, rendering the response in Prometheus
+   * format regardless of any format parameter.
    */
-  void prometheusFlushAndRender(const StatsParams& params, Buffer::Instance& response);
+  Admin::RequestPtr makePrometheusRequest(AdminStream& admin_stream);
 
   /**
-   * Renders the stats as prometheus. This is broken out as a separately
+   * Renders the stats as prometheus into a single buffer. This is the
+   * non-streaming equivalent of PrometheusStatsRequest, kept as a separately
    * callable API to facilitate the benchmark
-   * (test/server/admin/stats_handler_speed_test.cc) which does not have a
-   * server object.
+   * (test/server/admin/stats_handler_speed_test.cc), which does not have a
+   * server object, and comparisons against the streamed output.
    *
    * @params stats the stats store to read
    * @param custom_namespaces namespace mappings used for prometheus
@@ -93,9 +86,16 @@ public:
   Admin::RequestPtr makeRequest(AdminStream&);
 
 private:
-  static Http::Code prometheusStats(absl::string_view path_and_query, Buffer::Instance& response,
-                                    Stats::Store& stats,
-                                    Stats::CustomStatNamespaces& custom_namespaces);
+  /**
+   * Checks the server_ to see if a flush is needed, and then creates a
+   * streaming prometheus stats request.
+   *
+   * @params params the already-parsed parameters.
+   */
+  Admin::RequestPtr makePrometheusRequest(const StatsParams& params);
+
+  // Tag-extracted names of metric families are resolved once and reused across scrapes.
+  std::unique_ptr<PrometheusMetricNameCache> prometheus_name_cache_;
 };
 
 } // namespace Server
@@ -95,8 +95,8 @@ InstanceBase::InstanceBase(Init::Manager& init_manager, const Options& options,
           process_context ? ProcessContextOptRef(std::ref(*process_context)) : absl::nullopt,
           watermark_factory)),
       dispatcher_(api_->allocateDispatcher("main_thread")),
-      access_log_manager_(options.fileFlushIntervalMsec(), *api_, *dispatcher_, access_log_lock,
-                          store),
+      access_log_manager_(options.fileFlushIntervalMsec(), options.fileFlushSharedThread(), *api_,
+                          *dispatcher_, access_log_lock, store),
       singleton_manager_(new Singleton::ManagerImpl(api_->threadFactory())),
       handler_(getHandler(*dispatcher_)), worker_factory_(thread_local_, *api_, hooks),
       mutex_tracer_(options.mutexTracingEnabled() ? &Envoy::MutexTracerImpl::getOrCreateTracer()
@@ -260,6 +260,13 @@ void InstanceBase::updateServerStats() {
                                        parent_stats.parent_memory_allocated_);
   server_stats_->memory_heap_size_.set(Memory::Stats::totalCurrentlyReserved());
   server_stats_->memory_physical_size_.set(Memory::Stats::totalPhysicalBytes());
+  const Buffer::SliceStoragePool::Stats slice_pool_stats = Buffer::SliceStoragePool::stats();
+  server_stats_->memory_slice_pool_hits_.add(slice_pool_stats.hits_ -
+                                             last_slice_pool_stats_.hits_);
+  server_stats_->memory_slice_pool_misses_.add(slice_pool_stats.misses_ -
+                                               last_slice_pool_stats_.misses_);
+  server_stats_->memory_slice_pool_resident_bytes_.set(slice_pool_stats.resident_bytes_);
+  last_slice_pool_stats_ = slice_pool_stats;
   server_stats_->parent_connections_.set(parent_stats.parent_connections_);
   server_stats_->total_connections_.set(listener_manager_->numConnections() +
                                         parent_stats.parent_connections_);
@@ -1,4 +1,6 @@
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "source/common/access_log/access_log_manager_impl.h"
 #include "source/common/filesystem/file_shared_impl.h"
@@ -11,6 +13,7 @@
 #include "test/test_common/test_time.h"
 #include "test/test_common/utility.h"
 
+#include "absl/synchronization/notification.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -27,11 +30,12 @@ namespace Envoy {
 namespace AccessLog {
 namespace {
 
-class AccessLogManagerImplTest : public testing::Test {
+class AccessLogManagerImplTestBase : public testing::Test {
 protected:
-  AccessLogManagerImplTest()
+  explicit AccessLogManagerImplTestBase(bool file_flush_shared_thread)
       : file_(new NiceMock<Filesystem::MockFile>), thread_factory_(Thread::threadFactoryForTest()),
-        access_log_manager_(timeout_40ms_, api_, dispatcher_, lock_, store_) {
+        access_log_manager_(timeout_40ms_, file_flush_shared_thread, api_, dispatcher_, lock_,
+                            store_) {
     EXPECT_CALL(file_system_,
                 createFile(testing::Matcher<const Envoy::Filesystem::FilePathAndType&>(
                     Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"})))
@@ -67,6 +71,11 @@ protected:
   Event::TestRealTimeSystem time_system_;
 };
 
+class AccessLogManagerImplTest : public AccessLogManagerImplTestBase {
+protected:
+  AccessLogManagerImplTest() : AccessLogManagerImplTestBase(false) {}
+};
+
 TEST_F(AccessLogManagerImplTest, BadFile) {
   EXPECT_CALL(dispatcher_, createTimer_(_));
   EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultFailure<bool>(false, 0))));
@@ -501,6 +510,267 @@ TEST_F(AccessLogManagerImplTest, ReopenAllFiles) {
       .WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
 }
 
+class AccessLogManagerSharedFlushThreadTest : public AccessLogManagerImplTestBase {
+protected:
+  AccessLogManagerSharedFlushThreadTest() : AccessLogManagerImplTestBase(true) {}
+};
+
+TEST_F(AccessLogManagerSharedFlushThreadTest, FlushToLogFilePeriodically) {
+  NiceMock<Event::MockTimer>* timer = new NiceMock<Event::MockTimer>(&dispatcher_);
+
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  EXPECT_CALL(*timer, enableTimer(timeout_40ms_, _));
+  AccessLogFileSharedPtr log_file = access_log_manager_.createAccessLog(
+      Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"});
+
+  // Writes are only flushed by the timer, in a single write.
+  log_file->write("test");
+  log_file->write("test2");
+  EXPECT_EQ(2UL, store_.counter("filesystem.write_buffered").value());
+  EXPECT_EQ(9UL,
+            store_.gauge("filesystem.write_total_buffered", Stats::Gauge::ImportMode::Accumulate)
+                .value());
+  {
+    absl::MutexLock lock(&file_->mutex_);
+    EXPECT_EQ(0UL, file_->num_writes_);
+  }
+
+  EXPECT_CALL(*file_, write_(_))
+      .WillOnce(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
+        EXPECT_EQ(0, data.compare("testtest2"));
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+  EXPECT_CALL(*timer, enableTimer(timeout_40ms_, _));
+  timer->invokeCallback();
+
+  EXPECT_TRUE(file_->waitForEventCount(file_->num_writes_, 1));
+  waitForCounterEq("filesystem.write_completed", 1);
+  waitForGaugeEq("filesystem.write_total_buffered", 0);
+  EXPECT_EQ(1UL, store_.counter("filesystem.flushed_by_timer").value());
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
+TEST_F(AccessLogManagerSharedFlushThreadTest, FlushToLogFileOnDemand) {
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file = access_log_manager_.createAccessLog(
+      Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"});
+
+  EXPECT_CALL(*file_, write_(_))
+      .WillOnce(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
+        EXPECT_EQ(0, data.compare("test"));
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+  log_file->write("test");
+  log_file->flush();
+
+  // flush() writes synchronously.
+  {
+    absl::MutexLock lock(&file_->mutex_);
+    EXPECT_EQ(1UL, file_->num_writes_);
+  }
+  EXPECT_EQ(1UL, store_.counter("filesystem.write_completed").value());
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
+TEST_F(AccessLogManagerSharedFlushThreadTest, BigDataChunkShouldBeFlushedWithoutTimer) {
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file = access_log_manager_.createAccessLog(
+      Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"});
+
+  uint64_t bytes_written = 0;
+  EXPECT_CALL(*file_, write_(_))
+      .WillRepeatedly(Invoke([&bytes_written](absl::string_view data) -> Api::IoCallSizeResult {
+        bytes_written += data.length();
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+
+  log_file->write(std::string(1024 * 64 + 1, 'b'));
+  waitForGaugeEq("filesystem.write_total_buffered", 0);
+  {
+    absl::MutexLock lock(&file_->mutex_);
+    EXPECT_EQ(1024 * 64 + 1UL, bytes_written);
+  }
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
+TEST_F(AccessLogManagerSharedFlushThreadTest, DropsWritesWhenBufferIsFull) {
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file = access_log_manager_.createAccessLog(
+      Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"});
+
+  // Block the flush thread in its first write to the file.
+  absl::Notification write_started;
+  absl::Notification write_unblocked;
+  EXPECT_CALL(*file_, write_(_))
+      .WillOnce(Invoke([&](absl::string_view data) -> Api::IoCallSizeResult {
+        write_started.Notify();
+        write_unblocked.WaitForNotification();
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }))
+      .WillRepeatedly(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+  log_file->write(std::string(1024 * 64 + 1, 'a'));
+  write_started.WaitForNotification();
+
+  // Fill the buffer while the flush thread is blocked.
+  log_file->write(std::string(1024 * 1024 - 1, 'b'));
+  EXPECT_EQ(0UL, store_.counter("filesystem.write_backlogged").value());
+  log_file->write("c");
+  EXPECT_EQ(1UL, store_.counter("filesystem.write_backlogged").value());
+  log_file->write("d");
+  EXPECT_EQ(1UL, store_.counter("filesystem.write_dropped").value());
+  EXPECT_EQ(3UL, store_.counter("filesystem.write_buffered").value());
+
+  write_unblocked.Notify();
+  waitForGaugeEq("filesystem.write_total_buffered", 0);
+  EXPECT_EQ(0UL, store_.counter("filesystem.write_failed").value());
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
+TEST_F(AccessLogManagerSharedFlushThreadTest, ConcurrentWritesAreAllFlushed) {
+  EXPECT_CALL(*file_, open_(_)).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file = access_log_manager_.createAccessLog(
+      Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"});
+
+  uint64_t bytes_written = 0;
+  EXPECT_CALL(*file_, write_(_))
+      .WillRepeatedly(Invoke([&bytes_written](absl::string_view data) -> Api::IoCallSizeResult {
+        bytes_written += data.length();
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+
+  // Few enough writes that threads sharing a write shard cannot fill it.
+  constexpr uint64_t num_threads = 8;
+  constexpr uint64_t num_writes = 1000;
+  const std::string line = "a log line that is long enough to fill the buffers\n";
+  std::vector<Thread::ThreadPtr> threads;
+  for (uint64_t i = 0; i < num_threads; ++i) {
+    threads.push_back(thread_factory_.createThread([&log_file, &line]() {
+      for (uint64_t j = 0; j < num_writes; ++j) {
+        log_file->write(line);
+      }
+    }));
+  }
+  for (Thread::ThreadPtr& thread : threads) {
+    thread->join();
+  }
+  log_file->flush();
+
+  EXPECT_EQ(num_threads * num_writes, store_.counter("filesystem.write_buffered").value());
+  EXPECT_EQ(0UL, store_.counter("filesystem.write_dropped").value());
+  waitForGaugeEq("filesystem.write_total_buffered", 0);
+  {
+    absl::MutexLock lock(&file_->mutex_);
+    EXPECT_EQ(num_threads * num_writes * line.size(), bytes_written);
+  }
+
+  EXPECT_CALL(*file_, close_()).WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
+// A failed reopen is retried on the next tick of the flush timer, without waiting for a write.
+TEST_F(AccessLogManagerSharedFlushThreadTest, ReopenRetry) {
+  NiceMock<Event::MockTimer>* timer = new NiceMock<Event::MockTimer>(&dispatcher_);
+
+  Sequence sq;
+  EXPECT_CALL(*file_, open_(_))
+      .InSequence(sq)
+      .WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log_file = access_log_manager_.createAccessLog(
+      Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"});
+
+  EXPECT_CALL(*file_, close_())
+      .InSequence(sq)
+      .WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  EXPECT_CALL(*file_, open_(_))
+      .Times(2)
+      .InSequence(sq)
+      .WillOnce(Return(ByMove(Filesystem::resultFailure<bool>(false, 0))))
+      .WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+
+  log_file->reopen();
+  EXPECT_TRUE(file_->waitForEventCount(file_->num_opens_, 2));
+  waitForCounterEq("filesystem.reopen_failed", 1);
+
+  // The timer re-arms itself and its next tick retries the reopen.
+  EXPECT_CALL(*timer, enableTimer(timeout_40ms_, _));
+  timer->invokeCallback();
+  EXPECT_TRUE(file_->waitForEventCount(file_->num_opens_, 3));
+
+  EXPECT_CALL(*file_, close_())
+      .InSequence(sq)
+      .WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
+TEST_F(AccessLogManagerSharedFlushThreadTest, ReopenAllFiles) {
+  EXPECT_CALL(dispatcher_, createTimer_(_)).WillRepeatedly(ReturnNew<NiceMock<Event::MockTimer>>());
+
+  Sequence sq;
+  EXPECT_CALL(*file_, open_(_))
+      .InSequence(sq)
+      .WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log = access_log_manager_.createAccessLog(
+      Filesystem::FilePathAndType{Filesystem::DestinationType::File, "foo"});
+
+  NiceMock<Filesystem::MockFile>* file2 = new NiceMock<Filesystem::MockFile>;
+  EXPECT_CALL(*file2, path()).WillRepeatedly(Return("bar"));
+  EXPECT_CALL(file_system_,
+              createFile(testing::Matcher<const Envoy::Filesystem::FilePathAndType&>(
+                  Filesystem::FilePathAndType{Filesystem::DestinationType::File, "bar"})))
+      .WillOnce(Return(ByMove(std::unique_ptr<NiceMock<Filesystem::MockFile>>(file2))));
+
+  Sequence sq2;
+  EXPECT_CALL(*file2, open_(_))
+      .InSequence(sq2)
+      .WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  AccessLogFileSharedPtr log2 = access_log_manager_.createAccessLog(
+      Filesystem::FilePathAndType{Filesystem::DestinationType::File, "bar"});
+
+  EXPECT_CALL(*file_, close_())
+      .InSequence(sq)
+      .WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  EXPECT_CALL(*file2, close_())
+      .InSequence(sq2)
+      .WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  EXPECT_CALL(*file_, open_(_))
+      .InSequence(sq)
+      .WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  EXPECT_CALL(*file2, open_(_))
+      .InSequence(sq2)
+      .WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+
+  // The shared flush thread reopens both files without waiting for a write.
+  access_log_manager_.reopen();
+
+  EXPECT_TRUE(file_->waitForEventCount(file_->num_opens_, 2));
+  EXPECT_TRUE(file2->waitForEventCount(file2->num_opens_, 2));
+
+  // The remaining data is flushed when the files are destroyed.
+  EXPECT_CALL(*file_, write_(_))
+      .WillOnce(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
+        EXPECT_EQ(0, data.compare("foo"));
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+  EXPECT_CALL(*file2, write_(_))
+      .WillOnce(Invoke([](absl::string_view data) -> Api::IoCallSizeResult {
+        EXPECT_EQ(0, data.compare("bar"));
+        return Filesystem::resultSuccess<ssize_t>(static_cast<ssize_t>(data.length()));
+      }));
+  log->write("foo");
+  log2->write("bar");
+
+  EXPECT_CALL(*file_, close_())
+      .InSequence(sq)
+      .WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+  EXPECT_CALL(*file2, close_())
+      .InSequence(sq2)
+      .WillOnce(Return(ByMove(Filesystem::resultSuccess<bool>(true))));
+}
+
 } // namespace
 } // namespace AccessLog
 } // namespace Envoy
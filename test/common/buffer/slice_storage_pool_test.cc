@@ -0,0 +1,142 @@
+#include <thread>
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/buffer/slice_storage_pool.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Buffer {
+namespace {
+
+class SliceStoragePoolTest : public testing::Test {
+protected:
+  // Start every test from an empty cache on this thread.
+  void SetUp() override { SliceStoragePool::releaseIdleMemory(); }
+};
+
+TEST_F(SliceStoragePoolTest, ReusesReleasedBlocks) {
+  const SliceStoragePool::Stats before = SliceStoragePool::stats();
+
+  uint8_t* first = SliceStoragePool::allocate(16384);
+  SliceStoragePool::deallocate(first, 16384);
+  EXPECT_EQ(before.resident_bytes_ + 16384, SliceStoragePool::stats().resident_bytes_);
+
+  uint8_t* second = SliceStoragePool::allocate(16384);
+  EXPECT_EQ(first, second);
+
+  const SliceStoragePool::Stats after = SliceStoragePool::stats();
+  EXPECT_EQ(before.hits_ + 1, after.hits_);
+  EXPECT_EQ(before.misses_ + 1, after.misses_);
+  EXPECT_EQ(before.resident_bytes_, after.resident_bytes_);
+  SliceStoragePool::deallocate(second, 16384);
+}
+
+TEST_F(SliceStoragePoolTest, SizeClassesAreSeparate) {
+  uint8_t* small = SliceStoragePool::allocate(4096);
+  SliceStoragePool::deallocate(small, 4096);
+
+  const SliceStoragePool::Stats before = SliceStoragePool::stats();
+  uint8_t* large = SliceStoragePool::allocate(8192);
+  EXPECT_EQ(before.misses_ + 1, SliceStoragePool::stats().misses_);
+  SliceStoragePool::deallocate(large, 8192);
+}
+
+TEST_F(SliceStoragePoolTest, UnpooledSizesBypassThePool) {
+  const SliceStoragePool::Stats before = SliceStoragePool::stats();
+
+  // Zero sized storage must still be non-null, as slices use it to tell whether they are mutable.
+  uint8_t* empty = SliceStoragePool::allocate(0);
+  EXPECT_NE(nullptr, empty);
+  SliceStoragePool::deallocate(empty, 0);
+
+  const uint64_t large_size = SliceStoragePool::MaxSizeClassSize + 4096;
+  uint8_t* large = SliceStoragePool::allocate(large_size);
+  SliceStoragePool::deallocate(large, large_size);
+
+  const SliceStoragePool::Stats after = SliceStoragePool::stats();
+  EXPECT_EQ(before.hits_, after.hits_);
+  EXPECT_EQ(before.misses_, after.misses_);
+  EXPECT_EQ(before.resident_bytes_, after.resident_bytes_);
+}
+
+TEST_F(SliceStoragePoolTest, CachedBytesAreBounded) {
+  constexpr uint64_t size = 16384;
+  constexpr uint64_t max_blocks = SliceStoragePool::MaxCachedBytesPerSizeClass / size;
+
+  std::vector<uint8_t*> blocks;
+  for (uint64_t i = 0; i < max_blocks + 4; i++) {
+    blocks.push_back(SliceStoragePool::allocate(size));
+  }
+  const SliceStoragePool::Stats before = SliceStoragePool::stats();
+  for (uint8_t* block : blocks) {
+    SliceStoragePool::deallocate(block, size);
+  }
+  EXPECT_EQ(before.resident_bytes_ + SliceStoragePool::MaxCachedBytesPerSizeClass,
+            SliceStoragePool::stats().resident_bytes_);
+}
+
+TEST_F(SliceStoragePoolTest, ReleaseIdleMemory) {
+  uint8_t* block = SliceStoragePool::allocate(16384);
+  SliceStoragePool::deallocate(block, 16384);
+  EXPECT_LE(16384U, SliceStoragePool::stats().resident_bytes_);
+
+  SliceStoragePool::releaseIdleMemory();
+  EXPECT_EQ(0, SliceStoragePool::stats().resident_bytes_);
+
+  const SliceStoragePool::Stats before = SliceStoragePool::stats();
+  block = SliceStoragePool::allocate(16384);
+  EXPECT_EQ(before.misses_ + 1, SliceStoragePool::stats().misses_);
+  SliceStoragePool::deallocate(block, 16384);
+}
+
+// Other threads drain their caches lazily, the next time they touch the pool.
+TEST_F(SliceStoragePoolTest, ReleaseIdleMemoryOnOtherThread) {
+  uint8_t* block = nullptr;
+  std::thread([&block]() {
+    block = SliceStoragePool::allocate(16384);
+    SliceStoragePool::deallocate(block, 16384);
+    EXPECT_LE(16384U, SliceStoragePool::stats().resident_bytes_);
+
+    SliceStoragePool::releaseIdleMemory();
+    EXPECT_EQ(0, SliceStoragePool::stats().resident_bytes_);
+  }).join();
+
+  // The exited thread's counters are retained.
+  const SliceStoragePool::Stats stats = SliceStoragePool::stats();
+  EXPECT_LE(1U, stats.misses_);
+  EXPECT_EQ(0, stats.resident_bytes_);
+}
+
+// Memory released on a thread other than the one that allocated it is cached on the releasing
+// thread.
+TEST_F(SliceStoragePoolTest, CrossThreadRelease) {
+  uint8_t* block = SliceStoragePool::allocate(8192);
+  std::thread([block]() { SliceStoragePool::deallocate(block, 8192); }).join();
+
+  // The releasing thread has exited and freed its cache.
+  EXPECT_EQ(0, SliceStoragePool::stats().resident_bytes_);
+}
+
+TEST_F(SliceStoragePoolTest, SlicesUseThePool) {
+  {
+    Slice slice(100, nullptr);
+    EXPECT_EQ(4096, slice.reservableSize());
+  }
+  EXPECT_EQ(4096, SliceStoragePool::stats().resident_bytes_);
+
+  const SliceStoragePool::Stats before = SliceStoragePool::stats();
+  {
+    OwnedImpl buffer;
+    buffer.add(std::string(200, 'a'));
+  }
+  EXPECT_EQ(before.hits_ + 1, SliceStoragePool::stats().hits_);
+  EXPECT_EQ(4096, SliceStoragePool::stats().resident_bytes_);
+
+  SliceStoragePool::releaseIdleMemory();
+  EXPECT_EQ(0, SliceStoragePool::stats().resident_bytes_);
+}
+
+} // namespace
+} // namespace Buffer
+} // namespace Envoy
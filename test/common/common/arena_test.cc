@@ -0,0 +1,110 @@
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+#include "source/common/common/arena.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace {
+
+bool isAligned(void* ptr, size_t alignment) {
+  return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+}
+
+TEST(ArenaTest, SmallAllocationsShareABlock) {
+  Arena arena;
+  EXPECT_EQ(0, arena.blocks());
+
+  void* first = arena.allocate(24);
+  void* second = arena.allocate(24);
+  EXPECT_NE(first, second);
+  EXPECT_TRUE(isAligned(first, alignof(std::max_align_t)));
+  EXPECT_TRUE(isAligned(second, alignof(std::max_align_t)));
+  EXPECT_EQ(1, arena.blocks());
+
+  EXPECT_TRUE(isAligned(arena.allocate(1, 1), 1));
+  EXPECT_TRUE(isAligned(arena.allocate(8, 64), 64));
+  EXPECT_EQ(1, arena.blocks());
+}
+
+TEST(ArenaTest, NewBlockWhenFull) {
+  Arena arena;
+  for (size_t i = 0; i < Arena::BlockSize / 512; i++) {
+    arena.allocate(512);
+  }
+  EXPECT_EQ(2, arena.blocks());
+}
+
+TEST(ArenaTest, LargeAllocationsGetTheirOwnBlock) {
+  Arena arena;
+  void* small = arena.allocate(16);
+  void* large = arena.allocate(2 * Arena::BlockSize, 128);
+  EXPECT_TRUE(isAligned(large, 128));
+  EXPECT_EQ(2, arena.blocks());
+
+  // Small allocations are still served from the first block.
+  void* next = arena.allocate(16);
+  EXPECT_EQ(static_cast<char*>(small) + 16, next);
+  EXPECT_EQ(2, arena.blocks());
+
+  // Only blocks of the regular size are recycled.
+  const size_t cached = Arena::cachedBlocks();
+  arena.reset();
+  EXPECT_EQ(0, arena.blocks());
+  EXPECT_EQ(std::min(cached + 1, Arena::MaxCachedBlocks), Arena::cachedBlocks());
+}
+
+TEST(ArenaTest, BlocksAreRecycled) {
+  void* block_memory;
+  {
+    Arena arena;
+    block_memory = arena.allocate(16);
+  }
+  const size_t cached = Arena::cachedBlocks();
+  ASSERT_GT(cached, 0);
+
+  Arena arena;
+  EXPECT_EQ(block_memory, arena.allocate(16));
+  EXPECT_EQ(cached - 1, Arena::cachedBlocks());
+}
+
+TEST(ArenaTest, CachedBlocksAreBounded) {
+  {
+    Arena arena;
+    for (size_t i = 0; i < 2 * Arena::MaxCachedBlocks; i++) {
+      arena.allocate(Arena::BlockSize / 2);
+    }
+  }
+  EXPECT_EQ(Arena::MaxCachedBlocks, Arena::cachedBlocks());
+}
+
+TEST(ArenaTest, Create) {
+  Arena arena;
+  auto* value = arena.create<std::string>("arena");
+  EXPECT_EQ("arena", *value);
+  // Objects in the arena are destroyed by their owner.
+  value->~basic_string();
+}
+
+// ArenaPtr destroys objects in the arena in place, and deletes the others.
+TEST(ArenaTest, ArenaPtr) {
+  struct Counted {
+    explicit Counted(int& destroyed) : destroyed_(destroyed) {}
+    ~Counted() { destroyed_++; }
+    int& destroyed_;
+  };
+
+  int destroyed = 0;
+  Arena arena;
+  {
+    ArenaPtr<Counted> in_arena(arena.create<Counted>(destroyed), ArenaDeleter(true));
+    ArenaPtr<Counted> on_heap(new Counted(destroyed));
+  }
+  EXPECT_EQ(2, destroyed);
+  EXPECT_EQ(1, arena.blocks());
+}
+
+} // namespace
+} // namespace Envoy
@@ -1,4 +1,7 @@
+#include <atomic>
 #include <functional>
+#include <thread>
+#include <vector>
 
 #include "source/common/common/thread.h"
 #include "source/common/common/thread_synchronizer.h"
@@ -246,6 +249,49 @@ TEST_F(ThreadAsyncPtrTest, NameNotSpecifiedWait) {
   thread->join();
 }
 
+class ParallelForTest : public testing::Test {
+protected:
+  ThreadFactory& thread_factory_{threadFactoryForTest()};
+};
+
+TEST_F(ParallelForTest, CallsEveryIndexOnce) {
+  constexpr size_t count = 1000;
+  std::vector<std::atomic<uint32_t>> calls(count);
+  parallelFor(thread_factory_, 4, count, [&calls](size_t index) { calls[index]++; });
+  for (size_t i = 0; i < count; ++i) {
+    EXPECT_EQ(1, calls[i].load()) << i;
+  }
+
+  // Nothing is called for an empty range.
+  parallelFor(thread_factory_, 4, 0, [](size_t) { FAIL(); });
+}
+
+TEST_F(ParallelForTest, RunsInlineWithoutConcurrency) {
+  const std::thread::id caller = std::this_thread::get_id();
+  std::vector<size_t> indexes;
+  parallelFor(thread_factory_, 1, 3, [&](size_t index) {
+    EXPECT_EQ(caller, std::this_thread::get_id());
+    indexes.push_back(index);
+  });
+  EXPECT_THAT(indexes, testing::ElementsAre(0, 1, 2));
+
+  // A single index does not need another thread either.
+  parallelFor(thread_factory_, 8, 1,
+              [&](size_t) { EXPECT_EQ(caller, std::this_thread::get_id()); });
+}
+
+TEST_F(ParallelForTest, UsesMultipleThreads) {
+  // Every call blocks until two calls are running at once, which requires a second thread.
+  absl::Mutex mutex;
+  uint32_t running = 0;
+  parallelFor(thread_factory_, 2, 2, [&](size_t) {
+    absl::MutexLock lock(&mutex);
+    running++;
+    mutex.Await(absl::Condition(+[](uint32_t* running) { return *running >= 2; }, &running));
+  });
+  EXPECT_EQ(2, running);
+}
+
 } // namespace
 } // namespace Thread
 } // namespace Envoy
@@ -88,6 +88,30 @@ TEST(FilterChainUtilityTest, CreateFilterChainForFactoriesWithRouteDisabledAndDe
   }
 }
 
+// Filters of static providers are created with the context built when the chain was configured.
+TEST(FilterChainUtilityTest, CreateFilterChainForFactoriesWithSharedContext) {
+  NiceMock<MockFilterChainManager> manager;
+  FilterChainUtility::FilterFactoriesList filter_factories;
+
+  auto provider =
+      std::make_unique<Filter::StaticFilterConfigProviderImpl<Filter::NamedHttpFilterFactoryCb>>(
+          Filter::NamedHttpFilterFactoryCb{"filter_type_name", [](FilterChainFactoryCallbacks&) {}},
+          "filter_0");
+  filter_factories.push_back(
+      {std::move(provider), false, FilterContext{"filter_0", "filter_type_name"}});
+  const FilterContext& context = *filter_factories.front().context;
+
+  // The same context is used for every stream.
+  EXPECT_CALL(manager, applySharedFilterFactoryCb(testing::Ref(context), _))
+      .Times(2)
+      .WillRepeatedly(Return());
+  EXPECT_CALL(manager, applyFilterFactoryCb(_, _)).Times(0);
+  for (int i = 0; i < 2; i++) {
+    FilterChainUtility::createFilterChainForFactories(manager, Http::EmptyFilterChainOptions{},
+                                                      filter_factories);
+  }
+}
+
 } // namespace
 } // namespace Http
 } // namespace Envoy
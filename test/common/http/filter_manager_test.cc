@@ -871,6 +871,118 @@ TEST_F(FilterManagerTest, IdleTimerResets) {
   filter_1->decoder_callbacks_->encodeTrailers(std::move(basic_resp_trailers));
   filter_manager_->destroyFilters();
 }
+
+// Decoder filters run in configuration order and encoder filters in reverse order, and iteration
+// resumes after the filter that continues it.
+TEST_F(FilterManagerTest, FilterChainOrderAndContinuation) {
+  initialize();
+
+  std::shared_ptr<MockStreamFilter> filter_1(new NiceMock<MockStreamFilter>());
+  std::shared_ptr<MockStreamFilter> filter_2(new NiceMock<MockStreamFilter>());
+  std::shared_ptr<MockStreamFilter> filter_3(new NiceMock<MockStreamFilter>());
+  EXPECT_CALL(filter_factory_, createFilterChain(_))
+      .WillOnce(Invoke([&](FilterChainManager& manager) -> bool {
+        for (const auto& filter : {filter_1, filter_2, filter_3}) {
+          auto factory = createStreamFilterFactoryCb(filter);
+          manager.applyFilterFactoryCb({}, factory);
+        }
+        return true;
+      }));
+  filter_manager_->createFilterChain();
+
+  RequestHeaderMapPtr request_headers{
+      new TestRequestHeaderMapImpl{{":authority", "host"}, {":path", "/"}, {":method", "GET"}}};
+  ON_CALL(filter_manager_callbacks_, requestHeaders())
+      .WillByDefault(Return(makeOptRef(*request_headers)));
+  filter_manager_->requestHeadersInitialized();
+
+  ResponseHeaderMapPtr response_headers{new TestResponseHeaderMapImpl{{":status", "200"}}};
+  ON_CALL(filter_manager_callbacks_, responseHeaders())
+      .WillByDefault(Return(makeOptRef(*response_headers)));
+
+  InSequence s;
+  EXPECT_CALL(*filter_1, decodeHeaders(_, false)).WillOnce(Return(FilterHeadersStatus::Continue));
+  EXPECT_CALL(*filter_2, decodeHeaders(_, false))
+      .WillOnce(Return(FilterHeadersStatus::StopIteration));
+  filter_manager_->decodeHeaders(*request_headers, false);
+
+  EXPECT_CALL(*filter_3, decodeHeaders(_, false))
+      .WillOnce(Return(FilterHeadersStatus::StopIteration));
+  filter_2->decoder_callbacks_->continueDecoding();
+
+  EXPECT_CALL(*filter_3, encodeHeaders(_, true)).WillOnce(Return(FilterHeadersStatus::Continue));
+  EXPECT_CALL(*filter_2, encodeHeaders(_, true))
+      .WillOnce(Return(FilterHeadersStatus::StopIteration));
+  filter_3->decoder_callbacks_->encodeHeaders(
+      std::make_unique<TestResponseHeaderMapImpl>(*response_headers), true, "details");
+
+  EXPECT_CALL(*filter_1, encodeHeaders(_, true)).WillOnce(Return(FilterHeadersStatus::Continue));
+  EXPECT_CALL(filter_manager_callbacks_, encodeHeaders(_, true));
+  filter_2->encoder_callbacks_->continueEncoding();
+
+  filter_manager_->destroyFilters();
+}
+
+TEST_F(FilterManagerTest, SharedFilterContext) {
+  initialize();
+
+  auto decoder_filter = std::make_shared<NiceMock<MockStreamDecoderFilter>>();
+  const FilterContext context{"configName1", "filterName1"};
+  EXPECT_CALL(filter_factory_, createFilterChain(_))
+      .WillOnce(Invoke([&](FilterChainManager& manager) -> bool {
+        auto factory = createDecoderFilterFactoryCb(decoder_filter);
+        manager.applySharedFilterFactoryCb(context, factory);
+        return true;
+      }));
+  filter_manager_->createFilterChain();
+
+  EXPECT_EQ("configName1", decoder_filter->callbacks_->filterConfigName());
+  // The filter refers to the shared context instead of a copy of it.
+  EXPECT_EQ(context.config_name.data(), decoder_filter->callbacks_->filterConfigName().data());
+
+  filter_manager_->destroyFilters();
+}
+
+TEST_F(FilterManagerTest, FiltersInStreamArena) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.http_stream_arena", "true"}});
+
+  initialize();
+
+  auto decoder_filter = std::make_shared<NiceMock<MockStreamDecoderFilter>>();
+  auto stream_filter = std::make_shared<NiceMock<MockStreamFilter>>();
+  EXPECT_CALL(filter_factory_, createFilterChain(_))
+      .WillOnce(Invoke([&](FilterChainManager& manager) -> bool {
+        auto decoder_factory = createDecoderFilterFactoryCb(decoder_filter);
+        manager.applyFilterFactoryCb({}, decoder_factory);
+        auto stream_factory = createStreamFilterFactoryCb(stream_filter);
+        manager.applyFilterFactoryCb({}, stream_factory);
+        return true;
+      }));
+  filter_manager_->createFilterChain();
+
+  RequestHeaderMapPtr headers{
+      new TestRequestHeaderMapImpl{{":authority", "host"}, {":path", "/"}, {":method", "GET"}}};
+  ON_CALL(filter_manager_callbacks_, requestHeaders()).WillByDefault(Return(makeOptRef(*headers)));
+  filter_manager_->requestHeadersInitialized();
+
+  InSequence s;
+  EXPECT_CALL(*decoder_filter, decodeHeaders(_, true))
+      .WillOnce(Return(FilterHeadersStatus::Continue));
+  EXPECT_CALL(*stream_filter, decodeHeaders(_, true))
+      .WillOnce(Return(FilterHeadersStatus::StopIteration));
+  filter_manager_->decodeHeaders(*headers, true);
+  EXPECT_EQ(headers.get(), stream_filter->encoder_callbacks_->requestHeaders().ptr());
+
+  EXPECT_CALL(*decoder_filter, onDestroy());
+  EXPECT_CALL(*stream_filter, onDestroy());
+  filter_manager_->destroyFilters();
+
+  // The wrappers in the arena release the filters when the filter manager is destroyed.
+  filter_manager_.reset();
+  EXPECT_EQ(1, decoder_filter.use_count());
+  EXPECT_EQ(1, stream_filter.use_count());
+}
 } // namespace
 } // namespace Http
 } // namespace Envoy
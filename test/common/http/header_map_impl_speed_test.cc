@@ -208,6 +208,34 @@ static void headerMapImplPopulate(benchmark::State& state) {
 }
 BENCHMARK(headerMapImplPopulate);
 
+/**
+ * Measure the speed of getting headers by name from a request header map, which looks up each
+ * name in the table of inline headers first, with a realistic mix of inline and non-inline names.
+ */
+static void headerMapImplGetMixedNames(benchmark::State& state) {
+  const LowerCaseString names[] = {
+      LowerCaseString(":authority"),      LowerCaseString(":method"),
+      LowerCaseString(":path"),           LowerCaseString("accept"),
+      LowerCaseString("accept-encoding"), LowerCaseString("accept-language"),
+      LowerCaseString("content-length"),  LowerCaseString("content-type"),
+      LowerCaseString("cookie"),          LowerCaseString("referer"),
+      LowerCaseString("user-agent"),      LowerCaseString("x-custom-header"),
+      LowerCaseString("x-forwarded-for"), LowerCaseString("x-request-id"),
+  };
+  auto headers = Http::RequestHeaderMapImpl::create();
+  for (const LowerCaseString& name : names) {
+    headers->addCopy(name, "value");
+  }
+  size_t successes = 0;
+  for (auto _ : state) { // NOLINT
+    for (const LowerCaseString& name : names) {
+      successes += !headers->get(name).empty();
+    }
+  }
+  benchmark::DoNotOptimize(successes);
+}
+BENCHMARK(headerMapImplGetMixedNames);
+
 /**
  * Measure the speed of encoding headers as part of upgraded requests (HTTP/1 to HTTP/2)
  * @note The measured time for each iteration includes the time needed to add
@@ -83,6 +83,30 @@ TEST(HeaderMapImplTest, CustomRegisteredHeaders) {
             headers.getInline(custom_header_1.handle())->key().getStringView());
 }
 
+// Same length and first 8 bytes as foo_custom_header.
+Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::RequestHeaders>
+    custom_header_2(Http::LowerCaseString{"foo_custom_headex"});
+// Longer than the names that the static lookup table buckets by length.
+Http::RegisterCustomInlineHeader<Http::CustomInlineHeaderRegistry::Type::RequestHeaders>
+    custom_header_long(Http::LowerCaseString{std::string(100, 'x')});
+
+// Make sure that headers added by name are found in the static lookup table, including names that
+// only differ after their first 8 bytes and names too long to be bucketed by length.
+TEST(HeaderMapImplTest, CustomRegisteredHeadersStaticLookup) {
+  TestRequestHeaderMapImpl headers;
+  headers.addCopy(LowerCaseString("foo_custom_header"), "1");
+  headers.addCopy(LowerCaseString("foo_custom_headex"), "2");
+  headers.addCopy(LowerCaseString(std::string(100, 'x')), "3");
+  headers.addCopy(LowerCaseString("foo_custom_heade"), "4");
+  headers.addCopy(LowerCaseString(std::string(99, 'x')), "5");
+  EXPECT_EQ("1", headers.getInlineValue(custom_header_1.handle()));
+  EXPECT_EQ("2", headers.getInlineValue(custom_header_2.handle()));
+  EXPECT_EQ("3", headers.getInlineValue(custom_header_long.handle()));
+  EXPECT_EQ("4", headers.get_("foo_custom_heade"));
+  EXPECT_EQ("5", headers.get_(std::string(99, 'x')));
+  EXPECT_EQ(5, headers.size());
+}
+
 #define TEST_INLINE_HEADER_FUNCS(name)                                                             \
   header_map->addCopy(Headers::get().name, #name);                                                 \
   EXPECT_EQ(header_map->name()->value().getStringView(), #name);                                   \
@@ -1739,6 +1739,36 @@ TEST_P(Http1ServerConnectionImplTest, HeaderOnlyResponseTrainProperHeaders) {
             output);
 }
 
+TEST_P(Http1ServerConnectionImplTest, BatchedHeaderSerialization) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.http1_batch_header_serialization", "true"}});
+  initialize();
+
+  NiceMock<MockRequestDecoder> decoder;
+  Http::ResponseEncoder* response_encoder = nullptr;
+  EXPECT_CALL(callbacks_, newStream(_, _))
+      .WillOnce(Invoke([&](ResponseEncoder& encoder, bool) -> RequestDecoder& {
+        response_encoder = &encoder;
+        return decoder;
+      }));
+
+  Buffer::OwnedImpl buffer("GET / HTTP/1.1\r\n\r\n");
+  auto status = codec_->dispatch(buffer);
+  EXPECT_TRUE(status.ok());
+  EXPECT_EQ(0U, buffer.length());
+
+  std::string output;
+  ON_CALL(connection_, write(_, _)).WillByDefault(AddBufferToString(&output));
+
+  TestResponseHeaderMapImpl headers{{":status", "404"}, {"foo", "bar"}, {"baz", ""}};
+  response_encoder->encodeHeaders(headers, false);
+  EXPECT_EQ("HTTP/1.1 404 Not Found\r\nfoo: bar\r\nbaz: \r\ntransfer-encoding: chunked\r\n\r\n",
+            output);
+  // Only the header lines are accounted as header bytes, like when encoding them one by one.
+  EXPECT_EQ(10 + 7 + 28, response_encoder->getStream().bytesMeter()->headerBytesSent());
+}
+
 TEST_P(Http1ServerConnectionImplTest, 304ResponseTransferEncodingNotAddedWhenContentLengthPresent) {
   initialize();
 
@@ -2617,6 +2647,24 @@ TEST_P(Http1ClientConnectionImplTest, SimpleGet) {
   EXPECT_EQ("GET / HTTP/1.1\r\n\r\n", output);
 }
 
+TEST_P(Http1ClientConnectionImplTest, BatchedHeaderSerialization) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.http1_batch_header_serialization", "true"}});
+  initialize();
+
+  MockResponseDecoder response_decoder;
+  Http::RequestEncoder& request_encoder = codec_->newStream(response_decoder);
+
+  std::string output;
+  ON_CALL(connection_, write(_, _)).WillByDefault(AddBufferToString(&output));
+
+  TestRequestHeaderMapImpl headers{
+      {":method", "POST"}, {":path", "/"}, {":authority", "host"}, {"foo", "bar"}};
+  EXPECT_TRUE(request_encoder.encodeHeaders(headers, true).ok());
+  EXPECT_EQ("POST / HTTP/1.1\r\nhost: host\r\nfoo: bar\r\ncontent-length: 0\r\n\r\n", output);
+}
+
 TEST_P(Http1ClientConnectionImplTest, SimpleGetWithHeaderCasing) {
   codec_settings_.header_key_format_ = Http1Settings::HeaderKeyFormat::ProperCase;
 
@@ -3198,6 +3198,162 @@ TEST_P(Http2CodecImplTest, ResponseHeadersFlood) {
   EXPECT_EQ(1, server_stats_store_.counter("http2.outbound_flood").value());
 }
 
+// Verify that DATA frames end at slice boundaries of the body when that avoids copying.
+TEST_P(Http2CodecImplTest, DataFramesAlignedToSlices) {
+  scoped_runtime_.mergeValues(
+      {{"envoy.reloadable_features.http2_align_data_frames_to_slices", "true"}});
+  initialize();
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, true));
+  EXPECT_TRUE(request_encoder_->encodeHeaders(request_headers, true).ok());
+  driveToCompletion();
+
+  TestResponseHeaderMapImpl response_headers{{":status", "200"}};
+  EXPECT_CALL(response_decoder_, decodeHeaders_(_, false));
+  response_encoder_->encodeHeaders(response_headers, false);
+  driveToCompletion();
+
+  std::vector<uint64_t> write_lengths;
+  ON_CALL(server_connection_, write(_, _))
+      .WillByDefault(Invoke([&](Buffer::Instance& data, bool) -> void {
+        write_lengths.push_back(data.length());
+        client_wrapper_->buffer_.add(data);
+      }));
+
+  // Both slices fit in the window, but not in a single frame of the default maximum size.
+  Buffer::OwnedImpl body;
+  body.appendSliceForTest(std::string(10000, 'a'));
+  body.appendSliceForTest(std::string(10000, 'b'));
+  EXPECT_CALL(response_decoder_, decodeData(_, _)).Times(AnyNumber());
+  response_encoder_->encodeData(body, true);
+  driveToCompletion();
+
+  // Each write is a 9 byte frame header followed by one whole slice.
+  EXPECT_THAT(write_lengths, ElementsAre(10009, 10009));
+}
+
+// Verify that DATA frames end at the last slice boundary that fits in a frame when the slices do
+// not line up with the frame size, and are not shortened if that would more than halve them.
+TEST_P(Http2CodecImplTest, DataFramesAlignedToUnevenSlices) {
+  scoped_runtime_.mergeValues(
+      {{"envoy.reloadable_features.http2_align_data_frames_to_slices", "true"}});
+  initialize();
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, true));
+  EXPECT_TRUE(request_encoder_->encodeHeaders(request_headers, true).ok());
+  driveToCompletion();
+
+  TestResponseHeaderMapImpl response_headers{{":status", "200"}};
+  EXPECT_CALL(response_decoder_, decodeHeaders_(_, false));
+  response_encoder_->encodeHeaders(response_headers, false);
+  driveToCompletion();
+
+  std::vector<uint64_t> write_lengths;
+  ON_CALL(server_connection_, write(_, _))
+      .WillByDefault(Invoke([&](Buffer::Instance& data, bool) -> void {
+        write_lengths.push_back(data.length());
+        client_wrapper_->buffer_.add(data);
+      }));
+  EXPECT_CALL(response_decoder_, decodeData(_, _)).Times(AnyNumber());
+
+  // Two slices fit in a frame of the default maximum size, the third one does not.
+  Buffer::OwnedImpl body;
+  for (int i = 0; i < 5; ++i) {
+    body.appendSliceForTest(std::string(6000, 'a'));
+  }
+  response_encoder_->encodeData(body, false);
+  driveToCompletion();
+  EXPECT_THAT(write_lengths, ElementsAre(12009, 12009, 6009));
+
+  // Ending the first frame after the first slice would more than halve it.
+  write_lengths.clear();
+  body.appendSliceForTest(std::string(5000, 'b'));
+  body.appendSliceForTest(std::string(15000, 'b'));
+  response_encoder_->encodeData(body, true);
+  driveToCompletion();
+  EXPECT_THAT(write_lengths, ElementsAre(16393, 3625));
+}
+
+// Verify that only the first slices of a body of many small slices are looked at when aligning a
+// DATA frame.
+TEST_P(Http2CodecImplTest, DataFramesAlignedToManySmallSlices) {
+  scoped_runtime_.mergeValues(
+      {{"envoy.reloadable_features.http2_align_data_frames_to_slices", "true"}});
+  initialize();
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, true));
+  EXPECT_TRUE(request_encoder_->encodeHeaders(request_headers, true).ok());
+  driveToCompletion();
+
+  TestResponseHeaderMapImpl response_headers{{":status", "200"}};
+  EXPECT_CALL(response_decoder_, decodeHeaders_(_, false));
+  response_encoder_->encodeHeaders(response_headers, false);
+  driveToCompletion();
+
+  std::vector<uint64_t> write_lengths;
+  ON_CALL(server_connection_, write(_, _))
+      .WillByDefault(Invoke([&](Buffer::Instance& data, bool) -> void {
+        write_lengths.push_back(data.length());
+        client_wrapper_->buffer_.add(data);
+      }));
+  EXPECT_CALL(response_decoder_, decodeData(_, _)).Times(AnyNumber());
+
+  // The slices are large enough not to be coalesced when the body is moved.
+  Buffer::OwnedImpl body;
+  for (int i = 0; i < 40; ++i) {
+    body.appendSliceForTest(std::string(600, 'a'));
+  }
+  response_encoder_->encodeData(body, true);
+  driveToCompletion();
+
+  // The first frame ends after the first 16 slices, the rest of the body fits in the second one.
+  EXPECT_THAT(write_lengths, ElementsAre(9609, 14409));
+}
+
+// Verify that DATA frames shortened to end at slice boundaries only count as half a frame against
+// the outbound frame limit, so that aligning does not trip the flood detection sooner.
+TEST_P(Http2CodecImplTest, DataFramesAlignedToSlicesDoNotTripOutboundFlood) {
+  scoped_runtime_.mergeValues(
+      {{"envoy.reloadable_features.http2_align_data_frames_to_slices", "true"}});
+  // Without aligning, the body is sent in 7 DATA frames after the HEADERS frame.
+  max_outbound_frames_ = 8;
+  initialize();
+
+  TestRequestHeaderMapImpl request_headers;
+  HttpTestUtility::addDefaultHeaders(request_headers);
+  EXPECT_CALL(request_decoder_, decodeHeaders_(_, true));
+  EXPECT_TRUE(request_encoder_->encodeHeaders(request_headers, true).ok());
+  driveToCompletion();
+
+  // Keep the frames in the outbound queue.
+  int frame_count = 0;
+  Buffer::OwnedImpl buffer;
+  ON_CALL(server_connection_, write(_, _))
+      .WillByDefault(Invoke([&buffer, &frame_count](Buffer::Instance& frame, bool) {
+        ++frame_count;
+        buffer.move(frame);
+      }));
+
+  TestResponseHeaderMapImpl response_headers{{":status", "200"}};
+  response_encoder_->encodeHeaders(response_headers, false);
+  Buffer::OwnedImpl body;
+  for (int i = 0; i < 10; ++i) {
+    body.appendSliceForTest(std::string(10000, 'a'));
+  }
+  response_encoder_->encodeData(body, true);
+  EXPECT_NO_THROW(driveToCompletion());
+
+  // The HEADERS frame, 9 shortened DATA frames and the final DATA frame.
+  EXPECT_EQ(11, frame_count);
+  EXPECT_EQ(0, server_stats_store_.counter("http2.outbound_flood").value());
+}
+
 // Verify that codec detects flood of outbound DATA frames
 TEST_P(Http2CodecImplTest, ResponseDataFlood) {
   initialize();
@@ -0,0 +1,133 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <cstdint>
+#include <string>
+
+#include "envoy/config/core/v3/protocol.pb.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/http/http2/codec_impl.h"
+#include "source/common/http/utility.h"
+#include "source/common/stats/isolated_store_impl.h"
+
+#include "test/benchmark/main.h"
+#include "test/common/http/http2/codec_impl_test_util.h"
+#include "test/mocks/http/mocks.h"
+#include "test/mocks/network/mocks.h"
+#include "test/test_common/test_runtime.h"
+#include "test/test_common/utility.h"
+
+#include "benchmark/benchmark.h"
+
+using Envoy::benchmark::skipExpensiveBenchmarks;
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Http {
+namespace Http2 {
+namespace {
+
+// A client and a server codec, connected back to back through in memory buffers.
+class CodecPair {
+public:
+  CodecPair()
+      : options_(::Envoy::Http2::Utility::initializeAndValidateOptions(
+            envoy::config::core::v3::Http2ProtocolOptions())),
+        client_(client_connection_, client_callbacks_, *stats_store_.rootScope(), options_,
+                random_, DEFAULT_MAX_REQUEST_HEADERS_KB, DEFAULT_MAX_HEADERS_COUNT,
+                ProdNghttp2SessionFactory::get()),
+        server_(server_connection_, server_callbacks_, *stats_store_.rootScope(), options_,
+                random_, DEFAULT_MAX_REQUEST_HEADERS_KB, DEFAULT_MAX_HEADERS_COUNT,
+                envoy::config::core::v3::HttpProtocolOptions::ALLOW) {
+    ON_CALL(client_connection_, write(_, _))
+        .WillByDefault(Invoke([this](Buffer::Instance& data, bool) { to_server_.move(data); }));
+    ON_CALL(server_connection_, write(_, _))
+        .WillByDefault(Invoke([this](Buffer::Instance& data, bool) { to_client_.move(data); }));
+    ON_CALL(server_callbacks_, newStream(_, _))
+        .WillByDefault(Invoke([this](ResponseEncoder& encoder, bool) -> RequestDecoder& {
+          response_encoder_ = &encoder;
+          return request_decoder_;
+        }));
+  }
+
+  // Dispatches what each codec sent to the other, until neither has anything left to send.
+  void driveToCompletion() {
+    while (to_server_.length() > 0 || to_client_.length() > 0 || client_.wantsToWrite() ||
+           server_.wantsToWrite()) {
+      if (to_server_.length() > 0 || server_.wantsToWrite()) {
+        RELEASE_ASSERT(server_.dispatch(to_server_).ok(), "");
+      }
+      if (to_client_.length() > 0 || client_.wantsToWrite()) {
+        RELEASE_ASSERT(client_.dispatch(to_client_).ok(), "");
+      }
+    }
+  }
+
+  void clearDeferredDeleteLists() {
+    client_connection_.dispatcher_.clearDeferredDeleteList();
+    server_connection_.dispatcher_.clearDeferredDeleteList();
+  }
+
+  Stats::IsolatedStoreImpl stats_store_;
+  NiceMock<Random::MockRandomGenerator> random_;
+  NiceMock<Network::MockConnection> client_connection_;
+  NiceMock<Network::MockConnection> server_connection_;
+  NiceMock<MockConnectionCallbacks> client_callbacks_;
+  NiceMock<MockServerConnectionCallbacks> server_callbacks_;
+  NiceMock<MockRequestDecoder> request_decoder_;
+  const envoy::config::core::v3::Http2ProtocolOptions options_;
+  TestClientConnectionImpl client_;
+  TestServerConnectionImpl server_;
+  Buffer::OwnedImpl to_server_;
+  Buffer::OwnedImpl to_client_;
+  ResponseEncoder* response_encoder_{};
+};
+
+// Sends responses with a body of the given size, made of slices of the given size, from a server
+// codec to a client codec. With a slice size that is not a multiple of the maximum frame size,
+// DATA frames that are not aligned to the slices of the body copy part of a slice each.
+void responseThroughput(::benchmark::State& state) {
+  const uint64_t body_size = skipExpensiveBenchmarks() ? 64 * 1024 : state.range(0);
+  const uint64_t slice_size = state.range(1);
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.http2_align_data_frames_to_slices",
+                               state.range(2) != 0 ? "true" : "false"}});
+
+  CodecPair codecs;
+  NiceMock<MockResponseDecoder> response_decoder;
+  TestRequestHeaderMapImpl request_headers{
+      {":method", "GET"}, {":path", "/"}, {":scheme", "http"}, {":authority", "host"}};
+  TestResponseHeaderMapImpl response_headers{{":status", "200"}};
+  const std::string slice(slice_size, 'a');
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    state.PauseTiming();
+    Buffer::OwnedImpl body;
+    for (uint64_t size = 0; size < body_size; size += slice_size) {
+      body.appendSliceForTest(slice.data(), std::min(slice_size, body_size - size));
+    }
+    state.ResumeTiming();
+
+    RELEASE_ASSERT(codecs.client_.newStream(response_decoder)
+                       .encodeHeaders(request_headers, true)
+                       .ok(),
+                   "");
+    codecs.driveToCompletion();
+    codecs.response_encoder_->encodeHeaders(response_headers, false);
+    codecs.response_encoder_->encodeData(body, true);
+    codecs.driveToCompletion();
+    codecs.clearDeferredDeleteLists();
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * body_size);
+}
+BENCHMARK(responseThroughput)
+    ->ArgsProduct({{1 << 20, 16 << 20}, {10000, 16384}, {0, 1}})
+    ->Unit(::benchmark::kMillisecond);
+
+} // namespace
+} // namespace Http2
+} // namespace Http
+} // namespace Envoy
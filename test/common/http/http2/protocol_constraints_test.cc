@@ -67,6 +67,34 @@ TEST_F(ProtocolConstraintsTest, OutboundFrameFlood) {
                 .value());
 }
 
+// DATA frames shortened to end at a slice boundary count as half a frame against the limit.
+TEST_F(ProtocolConstraintsTest, OutboundShortenedDataFrames) {
+  options_.mutable_max_outbound_frames()->set_value(5);
+  options_.mutable_max_outbound_control_frames()->set_value(2);
+  ProtocolConstraints constraints(http2CodecStats(), options_);
+  constraints.incrementOutboundFrameCount(false);
+  constraints.incrementOutboundFrameCount(false);
+  constraints.incrementOutboundFrameCount(false);
+  for (int i = 0; i < 4; ++i) {
+    constraints.incrementOutboundShortenedDataFrameCount();
+  }
+  EXPECT_TRUE(constraints.checkOutboundFrameLimits().ok());
+  EXPECT_EQ(7,
+            stats_store_.gauge("http2.outbound_frames_active", Stats::Gauge::ImportMode::Accumulate)
+                .value());
+
+  // Releasing a shortened frame releases it from both counters.
+  ProtocolConstraints::ReleasorProc releasor =
+      constraints.incrementOutboundShortenedDataFrameCount();
+  releasor();
+  EXPECT_TRUE(constraints.checkOutboundFrameLimits().ok());
+
+  constraints.incrementOutboundShortenedDataFrameCount();
+  EXPECT_FALSE(constraints.checkOutboundFrameLimits().ok());
+  EXPECT_EQ("Too many frames in the outbound queue.", constraints.status().message());
+  EXPECT_EQ(1, stats_store_.counter("http2.outbound_flood").value());
+}
+
 // Verify that the `status()` method reflects the first violation and is not modified by subsequent
 // violations of outbound flood limits
 TEST_F(ProtocolConstraintsTest, OutboundFrameFloodStatusIsIdempotent) {
@@ -3,6 +3,7 @@
 #include <queue>
 
 #include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/io/io_uring_worker_impl.h"
 #include "source/common/network/address_impl.h"
 
@@ -19,6 +20,16 @@ class IoUringSocketTestImpl : public IoUringSocketEntry {
 public:
   IoUringSocketTestImpl(os_fd_t fd, IoUringWorkerImpl& parent) : IoUringSocketEntry(fd, parent) {}
 
+  // IoUringSocket
+  void enableRead() override {}
+  void disableRead() override {}
+  void enableCloseEvent(bool) override {}
+  void connect(const Network::Address::InstanceConstSharedPtr&) override {}
+  uint64_t write(Buffer::Instance&) override { return 0; }
+  uint64_t write(const Buffer::RawSlice*, uint64_t) override { return 0; }
+  void shutdown(int) override {}
+  void close() override {}
+
   void onAccept(Request* req, int32_t result, bool injected) override {
     IoUringSocketEntry::onAccept(req, result, injected);
     accept_result_ = result;
@@ -268,6 +279,53 @@ TEST_F(IoUringWorkerIntegrationTest, MergeInjection) {
   socket.cleanupForTest();
 }
 
+TEST_F(IoUringWorkerIntegrationTest, ServerSocketReadWriteAndClose) {
+  initialize();
+  createServerListenerAndClientSocket();
+
+  Buffer::OwnedImpl read_data;
+  IoUringSocket* socket = nullptr;
+  socket = &io_uring_worker_->addServerSocket(server_socket_, [&](uint32_t events) {
+    EXPECT_EQ(events, Event::FileReadyType::Read);
+    OptRef<ReadParam> read_param = socket->getReadParam();
+    ASSERT_TRUE(read_param.has_value());
+    read_data.move(read_param->buf_);
+  });
+  EXPECT_EQ(io_uring_worker_->getNumOfSockets(), 1);
+
+  // The data sent by the client is delivered by the read event.
+  std::string request = "hello";
+  EXPECT_EQ(Api::OsSysCallsSingleton::get()
+                .write(client_socket_, request.data(), request.size())
+                .return_value_,
+            static_cast<ssize_t>(request.size()));
+  while (read_data.length() < request.size()) {
+    dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  }
+  EXPECT_EQ(read_data.toString(), request);
+
+  // The data written to the socket is received by the client.
+  Buffer::OwnedImpl response("world");
+  socket->write(response);
+  EXPECT_EQ(response.length(), 0);
+  char buf[5];
+  Api::SysCallSizeResult result;
+  do {
+    dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+    result = Api::OsSysCallsSingleton::get().recv(client_socket_, buf, sizeof(buf), 0);
+  } while (result.return_value_ == -1 && result.errno_ == EAGAIN);
+  EXPECT_EQ(result.return_value_, static_cast<ssize_t>(sizeof(buf)));
+  EXPECT_EQ(absl::string_view(buf, sizeof(buf)), "world");
+
+  // The close cancels the pending read and then closes the fd.
+  socket->close();
+  runToClose(server_socket_);
+  dispatcher_->run(Event::Dispatcher::RunType::NonBlock);
+  EXPECT_EQ(io_uring_worker_->getNumOfSockets(), 0);
+  server_socket_ = INVALID_SOCKET;
+  cleanup();
+}
+
 } // namespace
 } // namespace Io
 } // namespace Envoy
@@ -1,3 +1,4 @@
+#include "source/common/buffer/buffer_impl.h"
 #include "source/common/io/io_uring_worker_impl.h"
 #include "source/common/network/address_impl.h"
 
@@ -10,6 +11,7 @@
 using testing::DoAll;
 using testing::Invoke;
 using testing::NiceMock;
+using testing::Return;
 using testing::ReturnNew;
 using testing::SaveArg;
 
@@ -20,6 +22,17 @@ namespace {
 class IoUringSocketTestImpl : public IoUringSocketEntry {
 public:
   IoUringSocketTestImpl(os_fd_t fd, IoUringWorkerImpl& parent) : IoUringSocketEntry(fd, parent) {}
+
+  // IoUringSocket
+  void enableRead() override {}
+  void disableRead() override {}
+  void enableCloseEvent(bool) override {}
+  void connect(const Network::Address::InstanceConstSharedPtr&) override {}
+  uint64_t write(Buffer::Instance&) override { return 0; }
+  uint64_t write(const Buffer::RawSlice*, uint64_t) override { return 0; }
+  void shutdown(int) override {}
+  void close() override {}
+
   void cleanupForTest() { cleanup(); }
 };
 
@@ -93,6 +106,199 @@ TEST(IoUringWorkerImplTest, DelaySubmit) {
   EXPECT_CALL(dispatcher, clearDeferredDeleteList());
 }
 
+class IoUringServerSocketTest : public testing::Test {
+protected:
+  IoUringServerSocketTest() {
+    IoUringPtr io_uring_instance = std::make_unique<MockIoUring>();
+    mock_io_uring_ = dynamic_cast<MockIoUring*>(io_uring_instance.get());
+    EXPECT_CALL(*mock_io_uring_, registerEventfd());
+    EXPECT_CALL(dispatcher_, createFileEvent_(_, _, Event::PlatformDefaultTriggerType,
+                                              Event::FileReadyType::Read))
+        .WillOnce(
+            DoAll(SaveArg<1>(&file_event_callback_), ReturnNew<NiceMock<Event::MockFileEvent>>()));
+    worker_ = std::make_unique<IoUringWorkerTestImpl>(std::move(io_uring_instance), dispatcher_);
+  }
+
+  ~IoUringServerSocketTest() override {
+    EXPECT_CALL(dispatcher_, clearDeferredDeleteList());
+    worker_.reset();
+  }
+
+  // Deliver the completions to the worker as if they came from the kernel.
+  void complete(std::vector<std::pair<Request*, int32_t>> completions) {
+    EXPECT_CALL(*mock_io_uring_, forEveryCompletion(_))
+        .WillOnce(Invoke([completions](const CompletionCb& cb) {
+          for (const auto& completion : completions) {
+            cb(completion.first, completion.second, false);
+          }
+        }));
+    file_event_callback_(Event::FileReadyType::Read);
+  }
+
+  Event::MockDispatcher dispatcher_;
+  MockIoUring* mock_io_uring_;
+  Event::FileReadyCb file_event_callback_;
+  std::unique_ptr<IoUringWorkerTestImpl> worker_;
+  os_fd_t fd_{11};
+};
+
+TEST_F(IoUringServerSocketTest, ReadAndCloseWithPendingRead) {
+  Request* read_req = nullptr;
+  EXPECT_CALL(*mock_io_uring_, prepareReadv(fd_, _, 1, 0, _))
+      .WillOnce(DoAll(SaveArg<4>(&read_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(*mock_io_uring_, submit());
+  Buffer::OwnedImpl read_data;
+  IoUringSocket* socket = nullptr;
+  socket = &worker_->addServerSocket(fd_, [&](uint32_t events) {
+    EXPECT_EQ(Event::FileReadyType::Read, events);
+    OptRef<ReadParam> read_param = socket->getReadParam();
+    ASSERT_TRUE(read_param.has_value());
+    EXPECT_EQ(-EAGAIN, read_param->result_);
+    read_data.move(read_param->buf_);
+  });
+  ASSERT_NE(nullptr, read_req);
+
+  // The data is delivered and the next read is submitted.
+  memcpy(static_cast<ReadRequest*>(read_req)->buf_.get(), "hello", 5);
+  Request* next_read_req = nullptr;
+  EXPECT_CALL(*mock_io_uring_, prepareReadv(fd_, _, 1, 0, _))
+      .WillOnce(DoAll(SaveArg<4>(&next_read_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(*mock_io_uring_, submit());
+  complete({{read_req, 5}});
+  EXPECT_EQ("hello", read_data.toString());
+
+  // The close cancels the pending read first.
+  Request* cancel_req = nullptr;
+  EXPECT_CALL(*mock_io_uring_, prepareCancel(next_read_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(*mock_io_uring_, submit());
+  socket->close();
+  EXPECT_EQ(IoUringSocketStatus::Closed, socket->getStatus());
+
+  Request* close_req = nullptr;
+  EXPECT_CALL(*mock_io_uring_, prepareClose(fd_, _))
+      .WillOnce(DoAll(SaveArg<1>(&close_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(*mock_io_uring_, submit());
+  complete({{next_read_req, -ECANCELED}, {cancel_req, 0}});
+
+  EXPECT_CALL(*mock_io_uring_, submit());
+  EXPECT_CALL(*mock_io_uring_, removeInjectedCompletion(fd_));
+  EXPECT_CALL(dispatcher_, deferredDelete_);
+  complete({{close_req, 0}});
+  EXPECT_EQ(0, worker_->getNumOfSockets());
+}
+
+TEST_F(IoUringServerSocketTest, PartialWriteAndFlushOnClose) {
+  Request* read_req = nullptr;
+  EXPECT_CALL(*mock_io_uring_, prepareReadv(fd_, _, 1, 0, _))
+      .WillOnce(DoAll(SaveArg<4>(&read_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(*mock_io_uring_, submit()).Times(2);
+  IoUringSocket& socket = worker_->addServerSocket(fd_, [](uint32_t) {});
+
+  Request* write_req = nullptr;
+  EXPECT_CALL(*mock_io_uring_, prepareWritev(fd_, _, 1, 0, _))
+      .WillOnce(DoAll(SaveArg<4>(&write_req), Return<IoUringResult>(IoUringResult::Ok)));
+  Buffer::OwnedImpl data("hello world");
+  socket.write(data);
+  EXPECT_EQ(0, data.length());
+  // Only one write is in flight at a time.
+  Buffer::OwnedImpl more_data("!");
+  socket.write(more_data);
+
+  // The rest of the data is written after the partial write completes.
+  Request* next_write_req = nullptr;
+  EXPECT_CALL(*mock_io_uring_, prepareWritev(fd_, _, _, 0, _))
+      .WillOnce(Invoke([&](os_fd_t, const struct iovec* iovecs, unsigned nr_vecs, off_t,
+                           Request* user_data) {
+        uint64_t length = 0;
+        for (unsigned i = 0; i < nr_vecs; i++) {
+          length += iovecs[i].iov_len;
+        }
+        EXPECT_EQ(7, length);
+        next_write_req = user_data;
+        return IoUringResult::Ok;
+      }));
+  EXPECT_CALL(*mock_io_uring_, submit());
+  complete({{write_req, 5}});
+
+  // The close waits for the pending write, the pending read is cancelled meanwhile.
+  Request* cancel_req = nullptr;
+  EXPECT_CALL(*mock_io_uring_, prepareCancel(read_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(*mock_io_uring_, submit());
+  socket.close();
+  EXPECT_CALL(*mock_io_uring_, prepareClose(fd_, _)).Times(0);
+  EXPECT_CALL(*mock_io_uring_, submit());
+  complete({{next_write_req, 7}});
+  EXPECT_EQ(1, worker_->getNumOfSockets());
+
+  // All the data has been written, the fd is closed once the read is cancelled.
+  Request* close_req = nullptr;
+  EXPECT_CALL(*mock_io_uring_, prepareClose(fd_, _))
+      .WillOnce(DoAll(SaveArg<1>(&close_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(*mock_io_uring_, submit());
+  complete({{read_req, -ECANCELED}, {cancel_req, 0}});
+
+  EXPECT_CALL(*mock_io_uring_, submit());
+  EXPECT_CALL(*mock_io_uring_, removeInjectedCompletion(fd_));
+  EXPECT_CALL(dispatcher_, deferredDelete_);
+  complete({{close_req, 0}});
+  EXPECT_EQ(0, worker_->getNumOfSockets());
+}
+
+TEST_F(IoUringServerSocketTest, WriteBufferLimit) {
+  Request* read_req = nullptr;
+  EXPECT_CALL(*mock_io_uring_, prepareReadv(fd_, _, 1, 0, _))
+      .WillOnce(DoAll(SaveArg<4>(&read_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(*mock_io_uring_, submit()).Times(2);
+  uint32_t write_events = 0;
+  IoUringSocket& socket = worker_->addServerSocket(fd_, [&write_events](uint32_t events) {
+    if (events & Event::FileReadyType::Write) {
+      write_events++;
+    }
+  });
+
+  // The socket takes data up to its limit, and none once it is full.
+  Request* write_req = nullptr;
+  EXPECT_CALL(*mock_io_uring_, prepareWritev(fd_, _, _, 0, _))
+      .WillOnce(DoAll(SaveArg<4>(&write_req), Return<IoUringResult>(IoUringResult::Ok)));
+  Buffer::OwnedImpl data(std::string(IoUringServerSocket::WriteBufferLimit + 5, 'a'));
+  EXPECT_EQ(IoUringServerSocket::WriteBufferLimit, socket.write(data));
+  EXPECT_EQ(5, data.length());
+  EXPECT_EQ(0, socket.write(data));
+  EXPECT_EQ(0, write_events);
+
+  // The connection is told to write again once some of the data has been written.
+  Request* next_write_req = nullptr;
+  EXPECT_CALL(*mock_io_uring_, prepareWritev(fd_, _, _, 0, _))
+      .WillOnce(DoAll(SaveArg<4>(&next_write_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(*mock_io_uring_, submit());
+  complete({{write_req, 1024}});
+  EXPECT_EQ(1, write_events);
+  EXPECT_EQ(5, socket.write(data));
+  EXPECT_EQ(0, data.length());
+
+  Request* cancel_req = nullptr;
+  EXPECT_CALL(*mock_io_uring_, prepareCancel(read_req, _))
+      .WillOnce(DoAll(SaveArg<1>(&cancel_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(*mock_io_uring_, submit());
+  socket.close();
+  EXPECT_CALL(*mock_io_uring_, submit());
+  complete({{next_write_req, IoUringServerSocket::WriteBufferLimit - 1024 + 5}});
+
+  Request* close_req = nullptr;
+  EXPECT_CALL(*mock_io_uring_, prepareClose(fd_, _))
+      .WillOnce(DoAll(SaveArg<1>(&close_req), Return<IoUringResult>(IoUringResult::Ok)));
+  EXPECT_CALL(*mock_io_uring_, submit());
+  complete({{read_req, -ECANCELED}, {cancel_req, 0}});
+
+  EXPECT_CALL(*mock_io_uring_, submit());
+  EXPECT_CALL(*mock_io_uring_, removeInjectedCompletion(fd_));
+  EXPECT_CALL(dispatcher_, deferredDelete_);
+  complete({{close_req, 0}});
+  EXPECT_EQ(0, worker_->getNumOfSockets());
+}
+
 } // namespace
 } // namespace Io
 } // namespace Envoy
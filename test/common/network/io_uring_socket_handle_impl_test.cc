@@ -0,0 +1,189 @@
+#include "source/common/api/os_sys_calls_impl.h"
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/network/address_impl.h"
+#include "source/common/network/io_uring_socket_handle_impl.h"
+
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/io/mocks.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::_;
+using testing::DoAll;
+using testing::NiceMock;
+using testing::Return;
+using testing::ReturnRef;
+using testing::SaveArg;
+
+namespace Envoy {
+namespace Network {
+namespace {
+
+class IoUringSocketHandleImplTest : public testing::Test {
+protected:
+  IoUringSocketHandleImplTest() {
+    ON_CALL(*factory_, getIoUringWorker())
+        .WillByDefault(Return(OptRef<Io::IoUringWorker>(worker_)));
+    ON_CALL(worker_, dispatcher()).WillByDefault(ReturnRef(dispatcher_));
+    // Let the base class close the fd when the handle is destroyed.
+    ON_CALL(*factory_, currentThreadRegistered()).WillByDefault(Return(false));
+  }
+
+  os_fd_t createSocket() {
+    const os_fd_t fd =
+        Api::OsSysCallsSingleton::get().socket(AF_INET, SOCK_STREAM, 0).return_value_;
+    EXPECT_TRUE(SOCKET_VALID(fd));
+    return fd;
+  }
+
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  NiceMock<Io::MockIoUringWorker> worker_;
+  std::shared_ptr<NiceMock<Io::MockIoUringWorkerFactory>> factory_{
+      std::make_shared<NiceMock<Io::MockIoUringWorkerFactory>>()};
+  NiceMock<Io::MockIoUringSocket> socket_;
+};
+
+TEST_F(IoUringSocketHandleImplTest, ReadFromIoUringSocket) {
+  IoUringSocketHandleImpl handle(factory_, createSocket(), false, absl::nullopt,
+                                 IoUringSocketType::Server);
+  Event::FileReadyCb io_uring_cb;
+  EXPECT_CALL(worker_, addServerSocket(_, _))
+      .WillOnce(DoAll(SaveArg<1>(&io_uring_cb), ReturnRef(socket_)));
+  EXPECT_CALL(socket_, enableRead());
+  EXPECT_CALL(socket_, enableCloseEvent(false));
+  uint32_t ready_events = 0;
+  handle.initializeFileEvent(
+      dispatcher_, [&ready_events](uint32_t events) { ready_events = events; },
+      Event::PlatformDefaultTriggerType, Event::FileReadyType::Read);
+
+  // Nothing can be read outside of the read event.
+  Buffer::OwnedImpl buffer;
+  EXPECT_EQ(Api::IoError::IoErrorCode::Again,
+            handle.read(buffer, absl::nullopt).err_->getErrorCode());
+
+  Buffer::OwnedImpl read_buf("hello");
+  Io::ReadParam read_param{read_buf, -EAGAIN};
+  EXPECT_CALL(socket_, getReadParam()).WillRepeatedly(Return(OptRef<Io::ReadParam>(read_param)));
+  io_uring_cb(Event::FileReadyType::Read);
+  EXPECT_EQ(Event::FileReadyType::Read, ready_events);
+
+  // The peek doesn't consume the data.
+  char peek_buf[5];
+  EXPECT_EQ(5, handle.recv(peek_buf, sizeof(peek_buf), MSG_PEEK).return_value_);
+  EXPECT_EQ("hello", absl::string_view(peek_buf, sizeof(peek_buf)));
+
+  EXPECT_EQ(3, handle.read(buffer, 3).return_value_);
+  EXPECT_EQ(2, handle.read(buffer, absl::nullopt).return_value_);
+  EXPECT_EQ("hello", buffer.toString());
+  EXPECT_EQ(Api::IoError::IoErrorCode::Again,
+            handle.read(buffer, absl::nullopt).err_->getErrorCode());
+
+  // The remote close is reported once the data is drained.
+  read_param.result_ = 0;
+  auto result = handle.read(buffer, absl::nullopt);
+  EXPECT_TRUE(result.ok());
+  EXPECT_EQ(0, result.return_value_);
+}
+
+TEST_F(IoUringSocketHandleImplTest, WriteAndClose) {
+  IoUringSocketHandleImpl handle(factory_, createSocket(), false, absl::nullopt,
+                                 IoUringSocketType::Server);
+  Event::FileReadyCb io_uring_cb;
+  EXPECT_CALL(worker_, addServerSocket(_, _))
+      .WillOnce(DoAll(SaveArg<1>(&io_uring_cb), ReturnRef(socket_)));
+  handle.initializeFileEvent(
+      dispatcher_, [](uint32_t) {}, Event::PlatformDefaultTriggerType,
+      Event::FileReadyType::Read | Event::FileReadyType::Write);
+
+  // The io_uring socket takes all the data.
+  Buffer::OwnedImpl data("hello");
+  EXPECT_CALL(socket_, write(testing::An<Buffer::Instance&>()))
+      .WillOnce(testing::Invoke([](Buffer::Instance& data) -> uint64_t {
+        const uint64_t length = data.length();
+        data.drain(length);
+        return length;
+      }));
+  EXPECT_EQ(5, handle.write(data).return_value_);
+  EXPECT_EQ(0, data.length());
+
+  // The io_uring socket refuses the data while its write buffer is full.
+  Buffer::OwnedImpl blocked_data("full");
+  EXPECT_CALL(socket_, write(testing::An<Buffer::Instance&>())).WillOnce(Return(0));
+  auto blocked_result = handle.write(blocked_data);
+  EXPECT_EQ(Api::IoError::IoErrorCode::Again, blocked_result.err_->getErrorCode());
+  EXPECT_EQ(4, blocked_data.length());
+
+  // The write error is reported by the following writes.
+  Io::WriteParam write_param{-EPIPE};
+  EXPECT_CALL(socket_, getWriteParam()).WillOnce(Return(OptRef<Io::WriteParam>(write_param)));
+  io_uring_cb(Event::FileReadyType::Write);
+  Buffer::OwnedImpl more_data("world");
+  auto result = handle.write(more_data);
+  EXPECT_FALSE(result.ok());
+  EXPECT_EQ(5, more_data.length());
+
+  // The io_uring socket closes the fd.
+  EXPECT_CALL(socket_, close());
+  const os_fd_t fd = handle.fdDoNotUse();
+  handle.close();
+  EXPECT_FALSE(handle.isOpen());
+  Api::OsSysCallsSingleton::get().close(fd);
+}
+
+TEST_F(IoUringSocketHandleImplTest, ConnectError) {
+  IoUringSocketHandleImpl handle(factory_, createSocket());
+  Event::FileReadyCb io_uring_cb;
+  EXPECT_CALL(worker_, addClientSocket(_, _))
+      .WillOnce(DoAll(SaveArg<1>(&io_uring_cb), ReturnRef(socket_)));
+  uint32_t ready_events = 0;
+  handle.initializeFileEvent(
+      dispatcher_, [&ready_events](uint32_t events) { ready_events = events; },
+      Event::PlatformDefaultTriggerType, Event::FileReadyType::Read | Event::FileReadyType::Write);
+  EXPECT_EQ(IoUringSocketType::Client, handle.type());
+
+  auto address = std::make_shared<Address::Ipv4Instance>("127.0.0.1", 1234);
+  EXPECT_CALL(socket_, connect(_));
+  auto connect_result = handle.connect(address);
+  EXPECT_EQ(-1, connect_result.return_value_);
+  EXPECT_EQ(SOCKET_ERROR_IN_PROGRESS, connect_result.errno_);
+
+  // The connect error is reported as SO_ERROR.
+  Io::WriteParam write_param{-ECONNREFUSED};
+  EXPECT_CALL(socket_, getWriteParam()).WillOnce(Return(OptRef<Io::WriteParam>(write_param)));
+  io_uring_cb(Event::FileReadyType::Write);
+  EXPECT_EQ(Event::FileReadyType::Write, ready_events);
+  int error = 0;
+  socklen_t error_size = sizeof(error);
+  EXPECT_EQ(0, handle.getOption(SOL_SOCKET, SO_ERROR, &error, &error_size).return_value_);
+  EXPECT_EQ(ECONNREFUSED, error);
+}
+
+TEST_F(IoUringSocketHandleImplTest, FallbackWithoutIoUringWorker) {
+  IoUringSocketHandleImpl handle(factory_, createSocket());
+  EXPECT_CALL(*factory_, getIoUringWorker()).WillOnce(Return(OptRef<Io::IoUringWorker>()));
+  EXPECT_CALL(worker_, addClientSocket(_, _)).Times(0);
+  EXPECT_CALL(dispatcher_, createFileEvent_(_, _, _, _));
+  handle.initializeFileEvent(
+      dispatcher_, [](uint32_t) {}, Event::PlatformDefaultTriggerType,
+      Event::FileReadyType::Read);
+}
+
+TEST_F(IoUringSocketHandleImplTest, ListenerAcceptsWithFileEvents) {
+  IoUringSocketHandleImpl handle(factory_, createSocket());
+  auto address = std::make_shared<Address::Ipv4Instance>("127.0.0.1", 0);
+  EXPECT_EQ(0, handle.bind(address).return_value_);
+  EXPECT_EQ(0, handle.listen(5).return_value_);
+  EXPECT_EQ(IoUringSocketType::Accept, handle.type());
+
+  EXPECT_CALL(worker_, addServerSocket(_, _)).Times(0);
+  EXPECT_CALL(dispatcher_, createFileEvent_(_, _, _, _));
+  handle.initializeFileEvent(
+      dispatcher_, [](uint32_t) {}, Event::PlatformDefaultTriggerType,
+      Event::FileReadyType::Read);
+}
+
+} // namespace
+} // namespace Network
+} // namespace Envoy
@@ -0,0 +1,70 @@
+#include <string>
+
+#include "source/common/common/base64.h"
+#include "source/common/orca/orca_parser.h"
+
+#include "test/test_common/status_utility.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+#include "xds/data/orca/v3/orca_load_report.pb.h"
+
+namespace Envoy {
+namespace Orca {
+namespace {
+
+std::string encodeReport(const OrcaLoadReport& report) {
+  const std::string serialized = report.SerializeAsString();
+  return Base64::encode(serialized.data(), serialized.size());
+}
+
+TEST(OrcaParserTest, NoReport) {
+  Http::TestResponseHeaderMapImpl headers{{":status", "200"}};
+  EXPECT_THAT(parseOrcaLoadReportHeaders(headers),
+              StatusHelpers::HasStatusCode(absl::StatusCode::kNotFound));
+}
+
+TEST(OrcaParserTest, ParsesBinaryReport) {
+  OrcaLoadReport report;
+  report.set_cpu_utilization(0.7);
+  report.set_application_utilization(0.5);
+  report.set_rps_fractional(1000);
+  report.set_eps(2);
+  (*report.mutable_named_metrics())["foo"] = 1;
+
+  Http::TestResponseTrailerMapImpl trailers{
+      {std::string(endpointLoadMetricsHeaderBin()), encodeReport(report)}};
+  absl::StatusOr<OrcaLoadReport> parsed = parseOrcaLoadReportHeaders(trailers);
+  ASSERT_TRUE(parsed.ok());
+  EXPECT_THAT(*parsed, ProtoEq(report));
+}
+
+TEST(OrcaParserTest, ParsesUnpaddedReport) {
+  OrcaLoadReport report;
+  report.set_cpu_utilization(0.25);
+  std::string encoded = encodeReport(report);
+  while (!encoded.empty() && encoded.back() == '=') {
+    encoded.pop_back();
+  }
+
+  Http::TestResponseHeaderMapImpl headers{{std::string(endpointLoadMetricsHeaderBin()), encoded}};
+  absl::StatusOr<OrcaLoadReport> parsed = parseOrcaLoadReportHeaders(headers);
+  ASSERT_TRUE(parsed.ok());
+  EXPECT_THAT(*parsed, ProtoEq(report));
+}
+
+TEST(OrcaParserTest, MalformedReport) {
+  Http::TestResponseHeaderMapImpl headers{
+      {std::string(endpointLoadMetricsHeaderBin()), "not base64!"}};
+  EXPECT_THAT(parseOrcaLoadReportHeaders(headers),
+              StatusHelpers::HasStatusCode(absl::StatusCode::kInvalidArgument));
+
+  // Valid base64 which is not a serialized report.
+  headers.setCopy(endpointLoadMetricsHeaderBin(), Base64::encode("\xff\xff\xff", 3));
+  EXPECT_THAT(parseOrcaLoadReportHeaders(headers),
+              StatusHelpers::HasStatusCode(absl::StatusCode::kInvalidArgument));
+}
+
+} // namespace
+} // namespace Orca
+} // namespace Envoy
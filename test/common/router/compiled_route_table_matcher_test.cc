@@ -0,0 +1,89 @@
+#include "source/common/router/compiled_route_table_matcher.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Router {
+namespace {
+
+using testing::ElementsAre;
+using testing::IsEmpty;
+
+CompiledRouteTableMatcher::Candidates candidatesFor(const CompiledRouteTableMatcher& matcher,
+                                                    absl::string_view path) {
+  CompiledRouteTableMatcher::Candidates candidates;
+  matcher.candidates(path, candidates);
+  return candidates;
+}
+
+TEST(CompiledRouteTableMatcherTest, Prefixes) {
+  CompiledRouteTableMatcher matcher;
+  matcher.addPrefix(0, "/foo/bar");
+  matcher.addPrefix(1, "/foo");
+  matcher.addPrefix(2, "/foo");
+  matcher.addPrefix(3, "");
+  matcher.compile();
+
+  EXPECT_THAT(candidatesFor(matcher, "/foo/bar/baz"), ElementsAre(0, 1, 2, 3));
+  EXPECT_THAT(candidatesFor(matcher, "/foo/ba"), ElementsAre(1, 2, 3));
+  EXPECT_THAT(candidatesFor(matcher, "/fo"), ElementsAre(3));
+  EXPECT_THAT(candidatesFor(matcher, ""), ElementsAre(3));
+}
+
+TEST(CompiledRouteTableMatcherTest, ExactPaths) {
+  CompiledRouteTableMatcher matcher;
+  matcher.addExact(0, "/foo/bar");
+  matcher.addExact(1, "/foo");
+  matcher.addPrefix(2, "/foo");
+  matcher.compile();
+
+  EXPECT_THAT(candidatesFor(matcher, "/foo"), ElementsAre(1, 2));
+  EXPECT_THAT(candidatesFor(matcher, "/foo/bar"), ElementsAre(0, 2));
+  EXPECT_THAT(candidatesFor(matcher, "/foo/ba"), ElementsAre(2));
+  EXPECT_THAT(candidatesFor(matcher, "/fo"), IsEmpty());
+}
+
+TEST(CompiledRouteTableMatcherTest, Regexes) {
+  CompiledRouteTableMatcher matcher;
+  matcher.addRegex(0, "/users/[0-9]+");
+  matcher.addPrefix(1, "/users");
+  matcher.addRegex(2, ".*");
+  matcher.compile();
+
+  EXPECT_EQ(0, matcher.numUnindexed());
+  EXPECT_THAT(candidatesFor(matcher, "/users/12"), ElementsAre(0, 1, 2));
+  // Regexes must match the whole path.
+  EXPECT_THAT(candidatesFor(matcher, "/users/12/profile"), ElementsAre(1, 2));
+  EXPECT_THAT(candidatesFor(matcher, "/other"), ElementsAre(2));
+}
+
+TEST(CompiledRouteTableMatcherTest, InvalidRegexesAreUnindexed) {
+  CompiledRouteTableMatcher matcher;
+  matcher.addRegex(0, "/users/[0-9]+");
+  matcher.addRegex(1, "(");
+  matcher.addPrefix(2, "/users");
+  matcher.compile();
+
+  EXPECT_EQ(2, matcher.numUnindexed());
+  EXPECT_THAT(candidatesFor(matcher, "/other"), ElementsAre(0, 1));
+  EXPECT_THAT(candidatesFor(matcher, "/users/1"), ElementsAre(0, 1, 2));
+}
+
+TEST(CompiledRouteTableMatcherTest, UnindexedRoutesAreAlwaysCandidates) {
+  CompiledRouteTableMatcher matcher;
+  matcher.addPrefix(0, "/foo");
+  matcher.addUnindexed(3);
+  matcher.addExact(2, "/bar");
+  matcher.addUnindexed(1);
+  matcher.compile();
+
+  EXPECT_EQ(2, matcher.numUnindexed());
+  EXPECT_THAT(candidatesFor(matcher, "/foo"), ElementsAre(0, 1, 3));
+  EXPECT_THAT(candidatesFor(matcher, "/bar"), ElementsAre(1, 2, 3));
+  EXPECT_THAT(candidatesFor(matcher, "/baz"), ElementsAre(1, 3));
+}
+
+} // namespace
+} // namespace Router
+} // namespace Envoy
@@ -8924,6 +8924,172 @@ virtual_hosts:
   }
 }
 
+// The compiled route table matcher must select exactly the routes that the linear scan selects.
+TEST_F(RouteMatcherTest, CompiledRouteTableMatchesLinearScan) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+  - name: mixed
+    domains: ["*"]
+    routes:
+      - match: { path: "/exact" }
+        route: { cluster: exact }
+      - match: { path: "/EXACT", case_sensitive: false }
+        route: { cluster: exact-insensitive }
+      - match:
+          prefix: "/api/v1"
+          headers:
+          - name: x-version
+            string_match: { exact: "1" }
+        route: { cluster: api-v1-header }
+      - match: { safe_regex: { regex: "/api/v[0-9]+/users/[0-9]+" } }
+        route: { cluster: users-regex }
+      - match: { path_separated_prefix: "/api/v1" }
+        route: { cluster: api-v1-separated }
+      - match: { prefix: "/API/V2", case_sensitive: false }
+        route: { cluster: api-v2-insensitive }
+      - match: { prefix: "/api" }
+        route: { cluster: api }
+      - match: { safe_regex: { regex: ".*\\.png" } }
+        route: { cluster: png }
+      - match: { prefix: "/" }
+        route: { cluster: default }
+  )EOF";
+
+  factory_context_.cluster_manager_.initializeClusters(
+      {"exact", "exact-insensitive", "api-v1-header", "users-regex", "api-v1-separated",
+       "api-v2-insensitive", "api", "png", "default"},
+      {});
+  TestConfigImpl linear_config(parseRouteConfigurationFromYaml(yaml), factory_context_, true);
+  mergeValues({{"envoy.reloadable_features.compiled_route_table_matcher", "true"}});
+  TestConfigImpl compiled_config(parseRouteConfigurationFromYaml(yaml), factory_context_, true);
+
+  const std::vector<std::pair<std::string, std::string>> expectations{
+      {"/exact", "exact"},
+      {"/exact?query", "exact"},
+      {"/Exact", "exact-insensitive"},
+      {"/exactly", "default"},
+      {"/api/v1/users/12", "users-regex"},
+      {"/api/v1/users/12#fragment", "users-regex"},
+      {"/api/v1/things", "api-v1-separated"},
+      {"/api/v1", "api-v1-separated"},
+      {"/api/v12", "api"},
+      {"/Api/V2/things", "api-v2-insensitive"},
+      {"/api/v3/users/7", "users-regex"},
+      {"/apis", "api"},
+      {"/image.png", "png"},
+      {"/image.png?size=2", "png"},
+      {"/", "default"},
+      {"/other", "default"},
+  };
+  for (const auto& [path, cluster] : expectations) {
+    SCOPED_TRACE(path);
+    EXPECT_EQ(cluster, linear_config.route(genHeaders("www.lyft.com", path, "GET"), 0)
+                           ->routeEntry()
+                           ->clusterName());
+    EXPECT_EQ(cluster, compiled_config.route(genHeaders("www.lyft.com", path, "GET"), 0)
+                           ->routeEntry()
+                           ->clusterName());
+  }
+
+  // Header matching is still evaluated for indexed routes.
+  Http::TestRequestHeaderMapImpl headers = genHeaders("www.lyft.com", "/api/v1/things", "GET");
+  headers.addCopy("x-version", "1");
+  EXPECT_EQ("api-v1-header", compiled_config.route(headers, 0)->routeEntry()->clusterName());
+
+  // The route callback sees the same candidates and evaluation status as with the linear scan.
+  std::vector<std::pair<std::string, RouteEvalStatus>> linear_evaluations;
+  std::vector<std::pair<std::string, RouteEvalStatus>> compiled_evaluations;
+  auto record = [](std::vector<std::pair<std::string, RouteEvalStatus>>& evaluations) {
+    return [&evaluations](RouteConstSharedPtr route, RouteEvalStatus status) -> RouteMatchStatus {
+      evaluations.emplace_back(route->routeEntry()->clusterName(), status);
+      return RouteMatchStatus::Continue;
+    };
+  };
+  EXPECT_EQ(nullptr, linear_config.route(record(linear_evaluations),
+                                         genHeaders("www.lyft.com", "/api/v1/users/1", "GET")));
+  EXPECT_EQ(nullptr, compiled_config.route(record(compiled_evaluations),
+                                           genHeaders("www.lyft.com", "/api/v1/users/1", "GET")));
+  EXPECT_EQ(4, compiled_evaluations.size());
+  EXPECT_EQ(linear_evaluations, compiled_evaluations);
+  EXPECT_EQ(RouteEvalStatus::NoMoreRoutes, compiled_evaluations.back().second);
+}
+
+// Path parameters are ignored by the compiled matcher when the route configuration asks for it.
+TEST_F(RouteMatcherTest, CompiledRouteTableIgnoresPathParameters) {
+  const std::string yaml = R"EOF(
+ignore_path_parameters_in_path_matching: true
+virtual_hosts:
+  - name: path_parameters
+    domains: ["*"]
+    routes:
+      - match: { path: "/exact" }
+        route: { cluster: exact }
+      - match: { prefix: "/" }
+        route: { cluster: default }
+  )EOF";
+
+  mergeValues({{"envoy.reloadable_features.compiled_route_table_matcher", "true"}});
+  factory_context_.cluster_manager_.initializeClusters({"exact", "default"}, {});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true);
+
+  EXPECT_EQ("exact", config.route(genHeaders("www.lyft.com", "/exact;param=1?query", "GET"), 0)
+                         ->routeEntry()
+                         ->clusterName());
+  EXPECT_EQ("default", config.route(genHeaders("www.lyft.com", "/exacts;param=1", "GET"), 0)
+                           ->routeEntry()
+                           ->clusterName());
+}
+
+// A regex engine which is not RE2 based: its regexes only match themselves literally.
+class LiteralRegexEngine : public Regex::Engine {
+public:
+  Regex::CompiledMatcherPtr matcher(const std::string& regex) const override {
+    return std::make_unique<LiteralMatcher>(regex);
+  }
+
+private:
+  class LiteralMatcher : public Regex::CompiledMatcher {
+  public:
+    explicit LiteralMatcher(const std::string& literal) : literal_(literal) {}
+
+    bool match(absl::string_view value) const override { return value == literal_; }
+    std::string replaceAll(absl::string_view value, absl::string_view) const override {
+      return std::string(value);
+    }
+
+  private:
+    const std::string literal_;
+  };
+};
+
+// Regex routes are not indexed with an RE2::Set when the regex engine is not RE2, as the set
+// could then select different routes than the engine does.
+TEST_F(RouteMatcherTest, CompiledRouteTableDoesNotIndexNonRe2Regexes) {
+  const std::string yaml = R"EOF(
+virtual_hosts:
+  - name: regex
+    domains: ["*"]
+    routes:
+      - match: { safe_regex: { regex: "/users/[0-9]+" } }
+        route: { cluster: users }
+      - match: { prefix: "/" }
+        route: { cluster: default }
+  )EOF";
+
+  StackedScopedInjectableLoader<Regex::Engine> literal_engine(
+      std::make_unique<LiteralRegexEngine>());
+  mergeValues({{"envoy.reloadable_features.compiled_route_table_matcher", "true"}});
+  factory_context_.cluster_manager_.initializeClusters({"users", "default"}, {});
+  TestConfigImpl config(parseRouteConfigurationFromYaml(yaml), factory_context_, true);
+
+  EXPECT_EQ("users", config.route(genHeaders("www.lyft.com", "/users/[0-9]+", "GET"), 0)
+                         ->routeEntry()
+                         ->clusterName());
+  EXPECT_EQ("default", config.route(genHeaders("www.lyft.com", "/users/12", "GET"), 0)
+                           ->routeEntry()
+                           ->clusterName());
+}
+
 TEST_F(RouteConfigurationV2, RegexPrefixWithNoRewriteWorksWhenPathChanged) {
 
   // Setup regex route entry. the regex is trivial, that's ok as we only want to test that
@@ -1,11 +1,15 @@
+#include "source/common/common/base64.h"
 #include "source/common/common/utility.h"
 #include "source/common/network/utility.h"
+#include "source/common/orca/orca_parser.h"
 #include "source/common/router/upstream_codec_filter.h"
 #include "source/common/router/upstream_request.h"
 
 #include "test/common/http/common.h"
 #include "test/mocks/router/router_filter_interface.h"
+#include "test/mocks/upstream/host.h"
 #include "test/test_common/test_runtime.h"
+#include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -209,6 +213,128 @@ TEST_F(UpstreamRequestTest, ConnectionPoolLatencyTime) {
   EXPECT_EQ(timing.connectionPoolCallbackLatency().value(), latency_to_add);
 }
 
+class MockHostLbPolicyData : public Upstream::HostLbPolicyData {
+public:
+  MOCK_METHOD(void, onUpstreamRequestComplete, (std::chrono::microseconds latency));
+  MOCK_METHOD(void, onOrcaLoadReport, (const xds::data::orca::v3::OrcaLoadReport& report));
+  MOCK_METHOD(bool, consumesOrcaLoadReports, (), (const));
+};
+
+// The latency of a request is reported to the host's load balancing policy data when the request
+// is done.
+TEST_F(UpstreamRequestTest, ReportsLatencyToHostLbPolicyData) {
+  initialize();
+
+  MockHostLbPolicyData lb_policy_data;
+  auto host = std::make_shared<NiceMock<Upstream::MockHostDescription>>();
+  ON_CALL(*host, lbPolicyData())
+      .WillByDefault(Return(makeOptRef<Upstream::HostLbPolicyData>(lb_policy_data)));
+  upstream_request_->upstreamHost() = host;
+
+  StreamInfo::UpstreamTiming& timing =
+      upstream_request_->streamInfo().upstreamInfo()->upstreamTiming();
+  timing.first_upstream_tx_byte_sent_ = MonotonicTime(std::chrono::milliseconds(10));
+  timing.last_upstream_rx_byte_received_ = MonotonicTime(std::chrono::milliseconds(25));
+
+  EXPECT_CALL(lb_policy_data, onUpstreamRequestComplete(std::chrono::microseconds(15000)));
+  upstream_request_.reset();
+}
+
+// A request which never sent anything upstream is not reported.
+TEST_F(UpstreamRequestTest, DoesNotReportLatencyWithoutUpstreamTraffic) {
+  initialize();
+
+  MockHostLbPolicyData lb_policy_data;
+  auto host = std::make_shared<NiceMock<Upstream::MockHostDescription>>();
+  ON_CALL(*host, lbPolicyData())
+      .WillByDefault(Return(makeOptRef<Upstream::HostLbPolicyData>(lb_policy_data)));
+  upstream_request_->upstreamHost() = host;
+
+  EXPECT_CALL(lb_policy_data, onUpstreamRequestComplete(_)).Times(0);
+  upstream_request_.reset();
+}
+
+// ORCA load reports in response headers and trailers are handed to the host's load balancing policy
+// data.
+TEST_F(UpstreamRequestTest, ReportsOrcaLoadToHostLbPolicyData) {
+  initialize();
+
+  NiceMock<MockHostLbPolicyData> lb_policy_data;
+  ON_CALL(lb_policy_data, consumesOrcaLoadReports()).WillByDefault(Return(true));
+  auto host = std::make_shared<NiceMock<Upstream::MockHostDescription>>();
+  ON_CALL(*host, lbPolicyData())
+      .WillByDefault(Return(makeOptRef<Upstream::HostLbPolicyData>(lb_policy_data)));
+  upstream_request_->upstreamHost() = host;
+
+  xds::data::orca::v3::OrcaLoadReport report;
+  report.set_cpu_utilization(0.5);
+  report.set_rps_fractional(100);
+  const std::string serialized = report.SerializeAsString();
+  const std::string encoded = Base64::encode(serialized.data(), serialized.size());
+
+  EXPECT_CALL(lb_policy_data, onOrcaLoadReport(ProtoEq(report)));
+  EXPECT_CALL(router_filter_interface_, onUpstreamHeaders(_, _, _, _));
+  upstream_request_->decodeHeaders(
+      std::make_unique<Http::TestResponseHeaderMapImpl>(Http::TestResponseHeaderMapImpl(
+          {{":status", "200"}, {std::string(Orca::endpointLoadMetricsHeaderBin()), encoded}})),
+      false);
+
+  EXPECT_CALL(lb_policy_data, onOrcaLoadReport(ProtoEq(report)));
+  EXPECT_CALL(router_filter_interface_, onUpstreamTrailers(_, _));
+  upstream_request_->decodeTrailers(
+      std::make_unique<Http::TestResponseTrailerMapImpl>(Http::TestResponseTrailerMapImpl(
+          {{std::string(Orca::endpointLoadMetricsHeaderBin()), encoded}})));
+}
+
+// Responses without a valid load report are not reported.
+TEST_F(UpstreamRequestTest, DoesNotReportMissingOrMalformedOrcaLoad) {
+  initialize();
+
+  NiceMock<MockHostLbPolicyData> lb_policy_data;
+  ON_CALL(lb_policy_data, consumesOrcaLoadReports()).WillByDefault(Return(true));
+  auto host = std::make_shared<NiceMock<Upstream::MockHostDescription>>();
+  ON_CALL(*host, lbPolicyData())
+      .WillByDefault(Return(makeOptRef<Upstream::HostLbPolicyData>(lb_policy_data)));
+  upstream_request_->upstreamHost() = host;
+
+  EXPECT_CALL(lb_policy_data, onOrcaLoadReport(_)).Times(0);
+  EXPECT_CALL(router_filter_interface_, onUpstreamHeaders(_, _, _, _));
+  upstream_request_->decodeHeaders(std::make_unique<Http::TestResponseHeaderMapImpl>(
+                                       Http::TestResponseHeaderMapImpl({{":status", "200"}})),
+                                   false);
+
+  EXPECT_CALL(router_filter_interface_, onUpstreamTrailers(_, _));
+  upstream_request_->decodeTrailers(
+      std::make_unique<Http::TestResponseTrailerMapImpl>(Http::TestResponseTrailerMapImpl(
+          {{std::string(Orca::endpointLoadMetricsHeaderBin()), "not base64!"}})));
+}
+
+// Load reports are not parsed for the hosts of policies which do not consume them.
+TEST_F(UpstreamRequestTest, DoesNotReportOrcaLoadToOtherPolicies) {
+  initialize();
+
+  NiceMock<MockHostLbPolicyData> lb_policy_data;
+  auto host = std::make_shared<NiceMock<Upstream::MockHostDescription>>();
+  ON_CALL(*host, lbPolicyData())
+      .WillByDefault(Return(makeOptRef<Upstream::HostLbPolicyData>(lb_policy_data)));
+  upstream_request_->upstreamHost() = host;
+
+  xds::data::orca::v3::OrcaLoadReport report;
+  report.set_cpu_utilization(0.5);
+  report.set_rps_fractional(100);
+  const std::string serialized = report.SerializeAsString();
+
+  EXPECT_CALL(lb_policy_data, consumesOrcaLoadReports()).WillOnce(Return(false));
+  EXPECT_CALL(lb_policy_data, onOrcaLoadReport(_)).Times(0);
+  EXPECT_CALL(router_filter_interface_, onUpstreamHeaders(_, _, _, _));
+  upstream_request_->decodeHeaders(
+      std::make_unique<Http::TestResponseHeaderMapImpl>(Http::TestResponseHeaderMapImpl(
+          {{":status", "200"},
+           {std::string(Orca::endpointLoadMetricsHeaderBin()),
+            Base64::encode(serialized.data(), serialized.size())}})),
+      false);
+}
+
 // UpstreamRequest dumpState without allocating memory.
 TEST_F(UpstreamRequestTest, DumpsStateWithoutAllocatingMemory) {
   initialize();
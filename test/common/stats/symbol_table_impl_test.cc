@@ -231,7 +231,6 @@ TEST_F(StatNameTest, TestSuccessfulDecode) {
 class StatNameDeathTest : public StatNameTest {
 public:
   void decodeSymbolVec(const SymbolVec& symbol_vec) {
-    Thread::LockGuard lock(table_.lock_);
     for (Symbol symbol : symbol_vec) {
       table_.fromSymbol(symbol);
     }
@@ -531,21 +530,15 @@ TEST_F(StatNameTest, RacingSymbolCreation) {
   access.setReady();
   accesses.Wait();
 
-  // In a perfect world, we could use reader-locks in the SymbolTable
-  // implementation, and there should be zero additional contentions
-  // after latching 'create_contentions' above. And we can definitely
-  // have this world, but this slows down BM_CreateRace in
-  // symbol_table_speed_test.cc, even on a 72-core machine.
+  // Lookups of existing symbols only take a shared lock on the symbol's
+  // shard, but the first lookup of a token, and the release of the last
+  // reference to it, take the shard exclusively. Thus we cannot expect zero
+  // additional contentions after latching 'create_contentions' above.
   //
-  // Thus it is better to avoid symbol-table contention by refactoring
+  // It is still better to avoid symbol-table contention by refactoring
   // all stat-creation code to symbolize all stat string elements at
   // construction, as composition does not require a lock.
   //
-  // See this commit
-  // https://github.com/envoyproxy/envoy/pull/5321/commits/ef712d0f5a11ff49831c1935e8a2ef8a0a935bc9
-  // for a working reader-lock implementation, which would pass this EXPECT:
-  //     EXPECT_EQ(create_contentions, mutex_tracer.numContentions());
-  //
   // Note also that we cannot guarantee there *will* be contentions
   // as a machine or OS is free to run all threads serially.
 
@@ -599,21 +592,15 @@ TEST_F(StatNameTest, MutexContentionOnExistingSymbols) {
   access.setReady();
   accesses.Wait();
 
-  // In a perfect world, we could use reader-locks in the SymbolTable
-  // implementation, and there should be zero additional contentions
-  // after latching 'create_contentions' above. And we can definitely
-  // have this world, but this slows down BM_CreateRace in
-  // symbol_table_speed_test.cc, even on a 72-core machine.
+  // Lookups of existing symbols only take a shared lock on the symbol's
+  // shard, but the first lookup of a token, and the release of the last
+  // reference to it, take the shard exclusively. Thus we cannot expect zero
+  // additional contentions after latching 'create_contentions' above.
   //
-  // Thus it is better to avoid symbol-table contention by refactoring
+  // It is still better to avoid symbol-table contention by refactoring
   // all stat-creation code to symbolize all stat string elements at
   // construction, as composition does not require a lock.
   //
-  // See this commit
-  // https://github.com/envoyproxy/envoy/pull/5321/commits/ef712d0f5a11ff49831c1935e8a2ef8a0a935bc9
-  // for a working reader-lock implementation, which would pass this EXPECT:
-  //     EXPECT_EQ(create_contentions, mutex_tracer.numContentions());
-  //
   // Note also that we cannot guarantee there *will* be contentions
   // as a machine or OS is free to run all threads serially.
 
@@ -63,6 +63,46 @@ static void bmCreateRace(benchmark::State& state) {
 }
 BENCHMARK(bmCreateRace)->Unit(::benchmark::kMillisecond);
 
+// Models workers concurrently creating stats for distinct dynamic clusters. The
+// names share most of their tokens, so threads contend on looking up existing
+// symbols while also adding a few new ones of their own.
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void bmCreateDistinctRace(benchmark::State& state) {
+  const int num_threads = state.range(0);
+  for (auto _ : state) {
+    UNREFERENCED_PARAMETER(_);
+    Envoy::Thread::ThreadFactory& thread_factory = Envoy::Thread::threadFactoryForTest();
+
+    std::vector<Envoy::Thread::ThreadPtr> threads;
+    threads.reserve(num_threads);
+    Envoy::ConditionalInitializer access;
+    absl::BlockingCounter accesses(num_threads);
+    Envoy::Stats::SymbolTableImpl table;
+
+    for (int i = 0; i < num_threads; ++i) {
+      threads.push_back(thread_factory.createThread([&access, &accesses, &table, i]() {
+        access.wait();
+
+        for (int count = 0; count < 1000; ++count) {
+          // NOLINTNEXTLINE(clang-analyzer-unix.Malloc)
+          Envoy::Stats::StatNameStorage name(
+              absl::StrCat("cluster.c_", i, "_", count % 100, ".upstream_rq_total"), table);
+          name.free(table);
+        }
+        accesses.DecrementCount();
+      }));
+    }
+
+    access.setReady();
+    accesses.Wait();
+
+    for (auto& thread : threads) {
+      thread->join();
+    }
+  }
+}
+BENCHMARK(bmCreateDistinctRace)->Arg(1)->Arg(4)->Arg(16)->Unit(::benchmark::kMillisecond);
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 static void bmJoinStatNames(benchmark::State& state) {
   Envoy::Stats::SymbolTableImpl symbol_table;
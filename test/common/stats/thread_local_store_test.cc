@@ -1668,6 +1668,27 @@ TEST_F(HistogramTest, MultiHistogramMultipleMerges) {
   EXPECT_EQ(2, validateMerge());
 }
 
+// Merges with nothing recorded since the previous merge empty the interval statistics and leave
+// the cumulative statistics unchanged, including several such merges in a row.
+TEST_F(HistogramTest, MergesWithoutNewValues) {
+  Histogram& h1 = scope_.histogramFromString("h1", Histogram::Unit::Unspecified);
+
+  expectCallAndAccumulate(h1, 10);
+  EXPECT_EQ(1, validateMerge());
+  EXPECT_EQ(1, validateMerge());
+  EXPECT_EQ(1, validateMerge());
+
+  ParentHistogramSharedPtr parent_histogram = store_->histograms()[0];
+  EXPECT_THAT(parent_histogram->detailedIntervalBuckets(), testing::IsEmpty());
+  EXPECT_THAT(parent_histogram->detailedTotalBuckets(), UnorderedElementsAre(Bucket{10, 1, 1}));
+
+  expectCallAndAccumulate(h1, 20);
+  EXPECT_EQ(1, validateMerge());
+  EXPECT_THAT(parent_histogram->detailedIntervalBuckets(), UnorderedElementsAre(Bucket{20, 1, 1}));
+  EXPECT_THAT(parent_histogram->detailedTotalBuckets(),
+              UnorderedElementsAre(Bucket{10, 1, 1}, Bucket{20, 1, 1}));
+}
+
 TEST_F(HistogramTest, BasicScopeHistogramMerge) {
   ScopeSharedPtr scope1 = store_->createScope("scope1.");
 
@@ -0,0 +1,101 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <vector>
+
+#include "envoy/config/cluster/v3/cluster.pb.h"
+#include "envoy/extensions/upstreams/http/v3/http_protocol_options.pb.h"
+
+#include "source/common/common/thread.h"
+#include "source/common/protobuf/utility.h"
+#include "source/common/upstream/cds_api_helper.h"
+
+#include "test/benchmark/main.h"
+#include "test/mocks/upstream/cluster_manager.h"
+#include "test/test_common/thread_factory_for_test.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+using Envoy::benchmark::skipExpensiveBenchmarks;
+using testing::_;
+using testing::Invoke;
+using testing::NiceMock;
+using testing::Return;
+
+namespace Envoy {
+namespace Upstream {
+namespace {
+
+envoy::config::cluster::v3::Cluster makeCluster(uint32_t index) {
+  auto cluster = TestUtility::parseYaml<envoy::config::cluster::v3::Cluster>(R"EOF(
+    connect_timeout: 0.25s
+    type: EDS
+    lb_policy: LEAST_REQUEST
+    eds_cluster_config:
+      eds_config:
+        ads: {}
+        resource_api_version: V3
+    circuit_breakers:
+      thresholds:
+      - max_connections: 1024
+        max_pending_requests: 1024
+        max_requests: 1024
+        max_retries: 3
+    outlier_detection:
+      consecutive_5xx: 5
+      interval: 10s
+      base_ejection_time: 30s
+    typed_extension_protocol_options:
+      envoy.extensions.upstreams.http.v3.HttpProtocolOptions:
+        "@type": type.googleapis.com/envoy.extensions.upstreams.http.v3.HttpProtocolOptions
+        explicit_http_config:
+          http2_protocol_options:
+            max_concurrent_streams: 100
+  )EOF");
+  cluster.set_name(absl::StrCat("cluster_", index));
+  return cluster;
+}
+
+// Ingestion of a large CDS update, as received at startup, with the cluster configurations hashed
+// on the given number of threads. Only the cost of the CDS handling itself is measured, as the
+// cluster manager is mocked out.
+void cdsIngestion(::benchmark::State& state) {
+  const uint32_t num_clusters = skipExpensiveBenchmarks() ? 1 : state.range(0);
+  const uint32_t concurrency = state.range(1);
+  std::vector<envoy::config::cluster::v3::Cluster> clusters;
+  clusters.reserve(num_clusters);
+  for (uint32_t i = 0; i < num_clusters; ++i) {
+    clusters.push_back(makeCluster(i));
+  }
+  const auto decoded_resources = TestUtility::decodeResources(clusters);
+
+  NiceMock<MockClusterManager> cm;
+  ON_CALL(cm, configIngestionConcurrency()).WillByDefault(Return(concurrency));
+  ON_CALL(cm, configIngestionParallelFor(_, _))
+      .WillByDefault(Invoke([concurrency](size_t count, const std::function<void(size_t)>& fn) {
+        Thread::parallelFor(Thread::threadFactoryForTest(), concurrency, count, fn);
+      }));
+  // Without a precomputed hash the cluster manager hashes each cluster on the main thread.
+  ON_CALL(cm, addOrUpdateCluster(_, _))
+      .WillByDefault(Invoke([](const envoy::config::cluster::v3::Cluster& cluster,
+                               const std::string&) {
+        ::benchmark::DoNotOptimize(MessageUtil::hash(cluster));
+        return true;
+      }));
+  ON_CALL(cm, addOrUpdateCluster(_, _, _)).WillByDefault(Return(true));
+
+  CdsApiHelper helper(cm, "cds");
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    helper.onConfigUpdate(decoded_resources.refvec_, {}, "v1");
+  }
+}
+
+BENCHMARK(cdsIngestion)
+    ->ArgsProduct({{1000, 8000}, {1, 2, 4, 8}})
+    ->Unit(::benchmark::kMillisecond);
+
+} // namespace
+} // namespace Upstream
+} // namespace Envoy
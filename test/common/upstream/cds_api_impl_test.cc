@@ -18,6 +18,7 @@
 #include "test/test_common/printers.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
@@ -173,6 +174,50 @@ TEST_F(CdsApiImplTest, ConfigUpdateWith2ValidClusters) {
   EXPECT_TRUE(cds_callbacks_->onConfigUpdate(decoded_resources.refvec_, "").ok());
 }
 
+TEST_F(CdsApiImplTest, ConfigUpdateHashesClustersInParallel) {
+  {
+    InSequence s;
+    setup();
+  }
+
+  EXPECT_CALL(cm_, clusters()).WillOnce(Return(makeClusterInfoMaps({})));
+  EXPECT_CALL(initialized_, ready());
+  EXPECT_CALL(cm_, configIngestionConcurrency()).WillRepeatedly(Return(4));
+  EXPECT_CALL(cm_, configIngestionParallelFor(32, _));
+
+  // The clusters are still applied in order, with the hashes computed up front.
+  std::vector<envoy::config::cluster::v3::Cluster> clusters(32);
+  InSequence s;
+  for (size_t i = 0; i < clusters.size(); ++i) {
+    clusters[i].set_name(absl::StrCat("cluster_", i));
+    EXPECT_CALL(cm_, addOrUpdateCluster(WithName(clusters[i].name()), "",
+                                        MessageUtil::hash(clusters[i])))
+        .WillOnce(Return(true));
+  }
+
+  const auto decoded_resources = TestUtility::decodeResources(clusters);
+  EXPECT_TRUE(cds_callbacks_->onConfigUpdate(decoded_resources.refvec_, "").ok());
+}
+
+TEST_F(CdsApiImplTest, ConfigUpdateHashesSmallUpdatesSerially) {
+  {
+    InSequence s;
+    setup();
+  }
+
+  EXPECT_CALL(cm_, clusters()).WillOnce(Return(makeClusterInfoMaps({})));
+  EXPECT_CALL(initialized_, ready());
+  EXPECT_CALL(cm_, configIngestionConcurrency()).WillRepeatedly(Return(4));
+  EXPECT_CALL(cm_, configIngestionParallelFor(_, _)).Times(0);
+
+  envoy::config::cluster::v3::Cluster cluster_1;
+  cluster_1.set_name("cluster_1");
+  expectAdd("cluster_1");
+
+  const auto decoded_resources = TestUtility::decodeResources({cluster_1});
+  EXPECT_TRUE(cds_callbacks_->onConfigUpdate(decoded_resources.refvec_, "").ok());
+}
+
 TEST_F(CdsApiImplTest, DeltaConfigUpdate) {
   {
     InSequence s;
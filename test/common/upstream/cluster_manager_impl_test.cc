@@ -1,3 +1,6 @@
+#include <atomic>
+#include <vector>
+
 #include "envoy/admin/v3/config_dump.pb.h"
 #include "envoy/config/bootstrap/v3/bootstrap.pb.h"
 #include "envoy/config/cluster/v3/cluster.pb.h"
@@ -731,6 +734,23 @@ TEST_F(ClusterManagerImplTest, OutlierEventLog) {
   create(parseBootstrapFromV3Json(json));
 }
 
+TEST_F(ClusterManagerImplTest, ConfigIngestionConcurrency) {
+  create(parseBootstrapFromV3Yaml(R"EOF(
+  cluster_manager:
+    config_ingestion_concurrency: 4
+  static_resources:
+    clusters: []
+  )EOF"));
+  EXPECT_EQ(4, cluster_manager_->configIngestionConcurrency());
+
+  std::vector<std::atomic<uint32_t>> calls(100);
+  cluster_manager_->configIngestionParallelFor(calls.size(),
+                                               [&calls](size_t index) { calls[index]++; });
+  for (const auto& count : calls) {
+    EXPECT_EQ(1, count.load());
+  }
+}
+
 TEST_F(ClusterManagerImplTest, AdsCluster) {
   MockGrpcMuxFactory factory;
   Registry::InjectFactory<Config::MuxFactory> registry(factory);
@@ -6563,6 +6583,165 @@ TEST_F(PreconnectTest, PreconnectCappedByMaybePreconnect) {
   EXPECT_EQ(1, http_preconnect_calls);
 }
 
+class WarmConnPoolsTest : public ClusterManagerImplTest {
+public:
+  void initialize(bool warm_tcp_connection_pools,
+                  bool connection_pool_per_downstream_connection = false) {
+    const std::string yaml = fmt::format(R"EOF(
+  static_resources:
+    clusters:
+    - name: cluster_1
+      connect_timeout: 0.250s
+      lb_policy: ROUND_ROBIN
+      type: STATIC
+      connection_pool_per_downstream_connection: {}
+      preconnect_policy:
+        per_upstream_warm_connections: 2
+        warm_tcp_connection_pools: {}
+      load_assignment:
+        cluster_name: cluster_1
+        endpoints:
+        - lb_endpoints:
+          - endpoint:
+              address:
+                socket_address:
+                  address: 127.0.0.1
+                  port_value: 11001
+          - endpoint:
+              address:
+                socket_address:
+                  address: 127.0.0.1
+                  port_value: 11002
+  )EOF",
+                                         connection_pool_per_downstream_connection,
+                                         warm_tcp_connection_pools);
+    create(parseBootstrapFromV3Yaml(yaml));
+  }
+
+  int preconnects_{};
+};
+
+// Every healthy host gets an HTTP pool with the configured number of connections when the cluster
+// is added.
+TEST_F(WarmConnPoolsTest, WarmHttpConnPools) {
+  EXPECT_CALL(factory_, allocateConnPool_(_, _, _, _, _))
+      .Times(2)
+      .WillRepeatedly(InvokeWithoutArgs([&]() -> Http::ConnectionPool::Instance* {
+        auto* ret = new NiceMock<Http::ConnectionPool::MockInstance>();
+        ON_CALL(*ret, maybePreconnect(2)).WillByDefault(InvokeWithoutArgs([&]() -> bool {
+          ++preconnects_;
+          return true;
+        }));
+        return ret;
+      }));
+  EXPECT_CALL(factory_, allocateTcpConnPool_(_)).Times(0);
+  initialize(false);
+  EXPECT_EQ(4, preconnects_);
+}
+
+TEST_F(WarmConnPoolsTest, WarmTcpConnPools) {
+  EXPECT_CALL(factory_, allocateConnPool_(_, _, _, _, _)).Times(0);
+  EXPECT_CALL(factory_, allocateTcpConnPool_(_))
+      .Times(2)
+      .WillRepeatedly(InvokeWithoutArgs([&]() -> Tcp::ConnectionPool::Instance* {
+        auto* ret = new NiceMock<Tcp::ConnectionPool::MockInstance>();
+        ON_CALL(*ret, maybePreconnect(2)).WillByDefault(InvokeWithoutArgs([&]() -> bool {
+          ++preconnects_;
+          return true;
+        }));
+        return ret;
+      }));
+  initialize(true);
+  EXPECT_EQ(4, preconnects_);
+}
+
+// Streams without a downstream protocol, socket options or transport socket options use the warmed
+// pools.
+TEST_F(WarmConnPoolsTest, StreamsUseWarmedHttpConnPools) {
+  std::vector<Http::ConnectionPool::MockInstance*> pools;
+  EXPECT_CALL(factory_, allocateConnPool_(_, _, _, _, _))
+      .Times(2)
+      .WillRepeatedly(InvokeWithoutArgs([&]() -> Http::ConnectionPool::Instance* {
+        auto* ret = new NiceMock<Http::ConnectionPool::MockInstance>();
+        ON_CALL(*ret, maybePreconnect(2)).WillByDefault(Return(true));
+        pools.push_back(ret);
+        return ret;
+      }));
+  initialize(false);
+  ASSERT_EQ(2, pools.size());
+
+  // Round robin picks each host once.
+  EXPECT_CALL(*pools[0], newStream(_, _, _)).WillOnce(Return(nullptr));
+  EXPECT_CALL(*pools[1], newStream(_, _, _)).WillOnce(Return(nullptr));
+  for (int i = 0; i < 2; ++i) {
+    auto http_handle =
+        cluster_manager_->getThreadLocalCluster("cluster_1")
+            ->httpConnPool(ResourcePriority::Default, Http::Protocol::Http11, nullptr);
+    ASSERT_TRUE(http_handle.has_value());
+    http_handle.value().newStream(decoder_, http_callbacks_, {false, true});
+  }
+}
+
+// Streams of clusters with a pool per downstream connection never use a pool warmed without one,
+// so the pools are not warmed.
+TEST_F(WarmConnPoolsTest, PoolPerDownstreamConnectionDoesNotWarm) {
+  EXPECT_CALL(factory_, allocateConnPool_(_, _, _, _, _)).Times(0);
+  initialize(false, true);
+}
+
+// Warming stops once a pool refuses to preconnect, e.g. because of its circuit breakers.
+TEST_F(WarmConnPoolsTest, WarmingStopsWhenPreconnectFails) {
+  EXPECT_CALL(factory_, allocateConnPool_(_, _, _, _, _))
+      .Times(2)
+      .WillRepeatedly(InvokeWithoutArgs([&]() -> Http::ConnectionPool::Instance* {
+        auto* ret = new NiceMock<Http::ConnectionPool::MockInstance>();
+        ON_CALL(*ret, maybePreconnect(_)).WillByDefault(InvokeWithoutArgs([&]() -> bool {
+          ++preconnects_;
+          return false;
+        }));
+        return ret;
+      }));
+  initialize(false);
+  EXPECT_EQ(2, preconnects_);
+}
+
+// Hosts added after the cluster, e.g. by EDS, are warmed by the update adding them. Hosts that
+// already have connection pools are not warmed again.
+TEST_F(WarmConnPoolsTest, WarmAddedHosts) {
+  EXPECT_CALL(factory_, allocateConnPool_(_, _, _, _, _))
+      .Times(3)
+      .WillRepeatedly(InvokeWithoutArgs([&]() -> Http::ConnectionPool::Instance* {
+        auto* ret = new NiceMock<Http::ConnectionPool::MockInstance>();
+        ON_CALL(*ret, maybePreconnect(2)).WillByDefault(InvokeWithoutArgs([&]() -> bool {
+          ++preconnects_;
+          return true;
+        }));
+        return ret;
+      }));
+  initialize(false);
+  EXPECT_EQ(4, preconnects_);
+
+  Cluster& cluster = cluster_manager_->activeClusters().begin()->second;
+  HostVectorSharedPtr hosts(
+      new HostVector(cluster.prioritySet().hostSetsPerPriority()[0]->hosts()));
+  HostSharedPtr added_host = makeTestHost(cluster.info(), "tcp://127.0.0.1:11003", time_system_);
+  hosts->push_back(added_host);
+  HostsPerLocalitySharedPtr hosts_per_locality = std::make_shared<HostsPerLocalityImpl>();
+  cluster.prioritySet().updateHosts(
+      0,
+      updateHostsParams(hosts, hosts_per_locality,
+                        std::make_shared<const HealthyHostVector>(*hosts), hosts_per_locality),
+      {}, {added_host}, {}, absl::nullopt, absl::nullopt);
+  EXPECT_EQ(6, preconnects_);
+}
+
+// The main thread does not proxy traffic and never warms connection pools.
+TEST_F(WarmConnPoolsTest, MainThreadDoesNotWarm) {
+  Thread::MainThread main_thread;
+  EXPECT_CALL(factory_, allocateConnPool_(_, _, _, _, _)).Times(0);
+  initialize(false);
+}
+
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
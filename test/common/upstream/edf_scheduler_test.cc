@@ -134,6 +134,37 @@ TEST(EdfSchedulerTest, ManyPeekahead) {
   }
 }
 
+// Validate that retainIf() removes entries, including peeked ones, and that the remaining entries
+// keep their place in the schedule.
+TEST(EdfSchedulerTest, RetainIf) {
+  EdfScheduler<uint32_t> sched;
+  constexpr uint32_t num_entries = 4;
+  std::shared_ptr<uint32_t> entries[num_entries];
+
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    entries[i] = std::make_shared<uint32_t>(i);
+    sched.add(1, entries[i]);
+  }
+  EXPECT_EQ(0, *sched.pickAndAdd([](const double&) { return 1; }));
+  EXPECT_EQ(1, *sched.pickAndAdd([](const double&) { return 1; }));
+  EXPECT_EQ(2, *sched.peekAgain([](const double&) { return 1; }));
+
+  uint32_t calls = 0;
+  sched.retainIf([&calls](const uint32_t& entry) {
+    ++calls;
+    return entry % 2 == 1;
+  });
+  EXPECT_EQ(num_entries, calls);
+
+  for (uint32_t rounds = 0; rounds < 2; ++rounds) {
+    EXPECT_EQ(3, *sched.pickAndAdd([](const double&) { return 1; }));
+    EXPECT_EQ(1, *sched.pickAndAdd([](const double&) { return 1; }));
+  }
+
+  sched.retainIf([](const uint32_t&) { return false; });
+  EXPECT_TRUE(sched.empty());
+}
+
 } // namespace
 } // namespace Upstream
 } // namespace Envoy
@@ -4678,6 +4678,146 @@ TEST_F(TcpHealthCheckerImplTest, ConnectionLocalFailure) {
   EXPECT_EQ(0UL, cluster_->info_->stats_store_.counter("health_check.passive_failure").value());
 }
 
+// Tests that the health checker of another cluster uses the result of a shared probe of the same
+// endpoint instead of probing it, until the result is older than its interval.
+TEST_F(TcpHealthCheckerImplTest, SharedProbeResult) {
+  InSequence s;
+
+  auto probe_cache = std::make_shared<HealthCheckProbeCache>();
+  allocHealthChecker(R"EOF(
+    timeout: 1s
+    interval: 1s
+    unhealthy_threshold: 2
+    healthy_threshold: 2
+    share_probes: true
+    tcp_health_check:
+      send:
+        text: "01"
+      receive:
+      - text: "02"
+    )EOF");
+  health_checker_->shareProbes(probe_cache);
+  cluster_->prioritySet().getMockHostSet(0)->hosts_ = {
+      makeTestHost(cluster_->info_, "tcp://127.0.0.1:80", simTime())};
+  expectSessionCreate();
+  expectClientCreate();
+  EXPECT_CALL(*connection_, write(_, _));
+  EXPECT_CALL(*timeout_timer_, enableTimer(_, _));
+  health_checker_->start();
+
+  connection_->raiseEvent(Network::ConnectionEvent::Connected);
+  EXPECT_CALL(*timeout_timer_, disableTimer());
+  EXPECT_CALL(*interval_timer_, enableTimer(_, _));
+  Buffer::OwnedImpl response;
+  addUint8(response, 2);
+  read_filter_->onData(response, false);
+
+  // The health check of the other cluster only differs in its interval and thresholds.
+  auto other_cluster = std::make_shared<NiceMock<MockClusterMockPrioritySet>>();
+  auto other_health_checker = std::make_shared<TcpHealthCheckerImpl>(
+      *other_cluster, parseHealthCheckFromV3Yaml(R"EOF(
+    timeout: 1s
+    interval: 5s
+    unhealthy_threshold: 3
+    healthy_threshold: 1
+    share_probes: true
+    tcp_health_check:
+      send:
+        text: "01"
+      receive:
+      - text: "02"
+    )EOF"),
+      dispatcher_, runtime_, random_, nullptr);
+  other_health_checker->shareProbes(probe_cache);
+  other_cluster->prioritySet().getMockHostSet(0)->hosts_ = {
+      makeTestHost(other_cluster->info_, "tcp://127.0.0.1:80", simTime())};
+  auto* other_interval_timer = new Event::MockTimer(&dispatcher_);
+  auto* other_timeout_timer = new Event::MockTimer(&dispatcher_);
+  EXPECT_CALL(*other_timeout_timer, disableTimer());
+  EXPECT_CALL(*other_interval_timer, enableTimer(_, _));
+  other_health_checker->start();
+
+  auto& other_stats = other_cluster->info_->stats_store_;
+  EXPECT_EQ(0UL, other_stats.counter("health_check.attempt").value());
+  EXPECT_EQ(1UL, other_stats.counter("health_check.shared_result").value());
+  EXPECT_EQ(1UL, other_stats.counter("health_check.success").value());
+  EXPECT_EQ(1UL, probe_cache->size());
+
+  // Once the shared result is as old as its interval, the other cluster probes on its own.
+  simTime().advanceTimeWait(std::chrono::seconds(5));
+  expectClientCreate();
+  EXPECT_CALL(*connection_, write(_, _));
+  EXPECT_CALL(*other_timeout_timer, enableTimer(_, _));
+  other_interval_timer->invokeCallback();
+  EXPECT_EQ(1UL, other_stats.counter("health_check.attempt").value());
+  EXPECT_EQ(1UL, other_stats.counter("health_check.shared_result").value());
+}
+
+TEST(HealthCheckProbeCacheTest, ConfigHashIgnoresScheduling) {
+  const auto config = parseHealthCheckFromV3Yaml(R"EOF(
+    timeout: 1s
+    interval: 1s
+    unhealthy_threshold: 2
+    healthy_threshold: 2
+    tcp_health_check: {}
+    )EOF");
+  auto scheduling = config;
+  scheduling.mutable_interval()->set_seconds(10);
+  scheduling.mutable_unhealthy_threshold()->set_value(5);
+  scheduling.set_share_probes(true);
+  EXPECT_EQ(HealthCheckProbeCache::configHash(config),
+            HealthCheckProbeCache::configHash(scheduling));
+
+  auto probing = config;
+  probing.mutable_timeout()->set_seconds(2);
+  EXPECT_NE(HealthCheckProbeCache::configHash(config), HealthCheckProbeCache::configHash(probing));
+}
+
+TEST(HealthCheckProbeCacheTest, ResultsAreReleasedWithLastSubscriber) {
+  HealthCheckProbeCache cache;
+  const HealthCheckProbeCache::Key key{"127.0.0.1:80/", 1, 0};
+
+  // Results nobody is interested in are dropped.
+  cache.publish(key, {MonotonicTime(), true, false, envoy::data::core::v3::ACTIVE, false});
+  EXPECT_EQ(nullptr, cache.lookup(key));
+
+  cache.subscribe(key);
+  cache.subscribe(key);
+  EXPECT_EQ(nullptr, cache.lookup(key));
+  cache.publish(key, {MonotonicTime(), false, false, envoy::data::core::v3::NETWORK, true});
+  ASSERT_NE(nullptr, cache.lookup(key));
+  EXPECT_FALSE(cache.lookup(key)->healthy);
+  EXPECT_EQ(envoy::data::core::v3::NETWORK, cache.lookup(key)->failure_type);
+
+  cache.unsubscribe(key);
+  EXPECT_NE(nullptr, cache.lookup(key));
+  cache.unsubscribe(key);
+  EXPECT_EQ(nullptr, cache.lookup(key));
+  EXPECT_EQ(0, cache.size());
+}
+
+// Probes sending another host name, or made by clusters connecting to the endpoint differently,
+// e.g. over TLS instead of plaintext, must not share their results.
+TEST(HealthCheckProbeCacheTest, KeySeparatesEffectiveProbes) {
+  Event::SimulatedTimeSystem time_system;
+  auto tls_cluster = std::make_shared<NiceMock<MockClusterInfo>>();
+  auto plaintext_cluster = std::make_shared<NiceMock<MockClusterInfo>>();
+  ON_CALL(*tls_cluster, connectionConfigHash()).WillByDefault(Return(1));
+  ON_CALL(*plaintext_cluster, connectionConfigHash()).WillByDefault(Return(2));
+  const HostSharedPtr tls_host = makeTestHost(tls_cluster, "tcp://127.0.0.1:80", time_system);
+  const HostSharedPtr other_tls_host =
+      makeTestHost(tls_cluster, "tcp://127.0.0.1:80", time_system);
+  const HostSharedPtr plaintext_host =
+      makeTestHost(plaintext_cluster, "tcp://127.0.0.1:80", time_system);
+
+  EXPECT_EQ(HealthCheckProbeCache::key(*tls_host, "foo", 1),
+            HealthCheckProbeCache::key(*other_tls_host, "foo", 1));
+  EXPECT_NE(HealthCheckProbeCache::key(*tls_host, "foo", 1),
+            HealthCheckProbeCache::key(*tls_host, "bar", 1));
+  EXPECT_NE(HealthCheckProbeCache::key(*tls_host, "foo", 1),
+            HealthCheckProbeCache::key(*plaintext_host, "foo", 1));
+}
+
 class TestGrpcHealthCheckerImpl : public GrpcHealthCheckerImpl {
 public:
   using GrpcHealthCheckerImpl::GrpcHealthCheckerImpl;
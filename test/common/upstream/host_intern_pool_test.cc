@@ -0,0 +1,107 @@
+#include "envoy/config/core/v3/base.pb.h"
+
+#include "source/common/network/address_impl.h"
+#include "source/common/network/utility.h"
+#include "source/common/singleton/manager_impl.h"
+#include "source/common/upstream/host_intern_pool.h"
+
+#include "test/mocks/event/mocks.h"
+#include "test/test_common/thread_factory_for_test.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Upstream {
+namespace {
+
+class HostInternPoolTest : public testing::Test {
+protected:
+  NiceMock<Event::MockDispatcher> dispatcher_;
+  HostInternPoolSharedPtr pool_ = std::make_shared<HostInternPool>(dispatcher_);
+};
+
+TEST_F(HostInternPoolTest, SingletonIsShared) {
+  Singleton::ManagerImpl manager(Thread::threadFactoryForTest());
+  HostInternPoolSharedPtr pool = HostInternPool::get(manager, dispatcher_);
+  EXPECT_EQ(pool, HostInternPool::get(manager, dispatcher_));
+}
+
+TEST_F(HostInternPoolTest, EqualAddressesAreShared) {
+  auto first = Network::Utility::parseInternetAddressNoThrow("10.0.0.1", 443);
+  auto second = Network::Utility::parseInternetAddressNoThrow("10.0.0.1", 443);
+  ASSERT_NE(first, second);
+
+  EXPECT_EQ(first, pool_->internAddress(first));
+  EXPECT_EQ(first, pool_->internAddress(second));
+
+  auto other_port = Network::Utility::parseInternetAddressNoThrow("10.0.0.1", 80);
+  EXPECT_EQ(other_port, pool_->internAddress(other_port));
+  EXPECT_EQ(2, pool_->addressPoolSize());
+}
+
+TEST_F(HostInternPoolTest, V6OnlyAddressesAreDistinct) {
+  auto v6only = Network::Utility::parseInternetAddressNoThrow("::1", 443, true);
+  auto dual_stack = Network::Utility::parseInternetAddressNoThrow("::1", 443, false);
+
+  EXPECT_EQ(v6only, pool_->internAddress(v6only));
+  EXPECT_EQ(dual_stack, pool_->internAddress(dual_stack));
+  EXPECT_EQ(2, pool_->addressPoolSize());
+}
+
+TEST_F(HostInternPoolTest, NonIpAddressesAreNotInterned) {
+  Network::Address::InstanceConstSharedPtr pipe =
+      std::make_shared<Network::Address::PipeInstance>("/tmp/host_intern_pool_test");
+  EXPECT_EQ(pipe, pool_->internAddress(pipe));
+  EXPECT_EQ(nullptr, pool_->internAddress(nullptr));
+  EXPECT_EQ(0, pool_->addressPoolSize());
+}
+
+TEST_F(HostInternPoolTest, ExpiredAddressIsReplaced) {
+  auto first = Network::Utility::parseInternetAddressNoThrow("10.0.0.1", 443);
+  pool_->internAddress(first);
+  first.reset();
+
+  auto second = Network::Utility::parseInternetAddressNoThrow("10.0.0.1", 443);
+  EXPECT_EQ(second, pool_->internAddress(second));
+  EXPECT_EQ(1, pool_->addressPoolSize());
+}
+
+TEST_F(HostInternPoolTest, ExpiredAddressesAreSwept) {
+  std::vector<Network::Address::InstanceConstSharedPtr> addresses;
+  for (uint32_t port = 1; port <= 1024; port++) {
+    addresses.push_back(pool_->internAddress(
+        Network::Utility::parseInternetAddressNoThrow("10.0.0.1", port)));
+  }
+  // The pool reached its first sweep size while all of its addresses were alive.
+  EXPECT_EQ(1024, pool_->addressPoolSize());
+
+  addresses.resize(1);
+  for (uint32_t port = 1025; port <= 2048; port++) {
+    pool_->internAddress(Network::Utility::parseInternetAddressNoThrow("10.0.0.1", port));
+  }
+  // Doubling the pool sweeps all but the address that is still in use, and the one just added.
+  EXPECT_EQ(2, pool_->addressPoolSize());
+  EXPECT_EQ(addresses[0], pool_->internAddress(
+                              Network::Utility::parseInternetAddressNoThrow("10.0.0.1", 1)));
+}
+
+TEST_F(HostInternPoolTest, EqualLocalitiesAreShared) {
+  envoy::config::core::v3::Locality locality;
+  locality.set_region("region");
+  locality.set_zone("zone");
+
+  LocalityConstSharedPtr first = pool_->internLocality(locality);
+  EXPECT_EQ(first, pool_->internLocality(locality));
+  EXPECT_TRUE(TestUtility::protoEqual(locality, *first));
+
+  locality.set_sub_zone("sub_zone");
+  EXPECT_NE(first, pool_->internLocality(locality));
+}
+
+} // namespace
+} // namespace Upstream
+} // namespace Envoy
@@ -57,6 +57,38 @@ public:
                                     {}, hosts, {}, absl::nullopt);
   }
 
+  // Adds num_failover_hosts hosts at priority 1.
+  void addFailoverHosts(uint64_t num_failover_hosts) {
+    HostVector hosts;
+    ASSERT(num_failover_hosts < 65536);
+    for (uint64_t i = 0; i < num_failover_hosts; i++) {
+      const std::string url = fmt::format("tcp://10.1.{}.{}:6379", i / 256, i % 256);
+      hosts.push_back(makeTestHost(info_, url, simTime()));
+    }
+    updateHostSet(1, hosts, hosts);
+  }
+
+  // Fails or recovers the health check of one host, as a flapping host would, and publishes the
+  // resulting host set update.
+  void flapHost(uint32_t priority, uint64_t index) {
+    const HostVector hosts = priority_set_.hostSetsPerPriority()[priority]->hosts();
+    Host& host = *hosts[index % hosts.size()];
+    if (host.healthFlagGet(Host::HealthFlag::FAILED_ACTIVE_HC)) {
+      host.healthFlagClear(Host::HealthFlag::FAILED_ACTIVE_HC);
+    } else {
+      host.healthFlagSet(Host::HealthFlag::FAILED_ACTIVE_HC);
+    }
+    updateHostSet(priority, hosts, {});
+  }
+
+  void updateHostSet(uint32_t priority, const HostVector& hosts, const HostVector& hosts_added) {
+    HostVectorConstSharedPtr updated_hosts = std::make_shared<HostVector>(hosts);
+    HostsPerLocalityConstSharedPtr hosts_per_locality = makeHostsPerLocality({hosts});
+    priority_set_.updateHosts(priority,
+                              HostSetImpl::partitionHosts(updated_hosts, hosts_per_locality), {},
+                              hosts_added, {}, absl::nullopt);
+  }
+
   Envoy::Thread::MutexBasicLockable lock_;
   // Reduce default log level to warn while running this benchmark to avoid problems due to
   // excessive debug logging in upstream_impl.cc
@@ -441,6 +473,53 @@ BENCHMARK(benchmarkRingHashLoadBalancerHostLoss)
     ->Args({500, 256000, 3, 10000})
     ->Unit(::benchmark::kMillisecond);
 
+// Measures the table rebuilds caused by host set churn. The first argument is the number of hosts
+// at priority 0. The second is the number of failover hosts at priority 1, and the third is the
+// priority of the flapping host.
+void benchmarkRingHashLoadBalancerHostFlap(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint64_t num_failover_hosts = state.range(1);
+  const uint32_t flapping_priority = state.range(2);
+  RingHashTester tester(num_hosts, 65536);
+  if (num_failover_hosts > 0) {
+    tester.addFailoverHosts(num_failover_hosts);
+  }
+  tester.ring_hash_lb_->initialize();
+
+  uint64_t index = 0;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    tester.flapHost(flapping_priority, index++);
+  }
+}
+BENCHMARK(benchmarkRingHashLoadBalancerHostFlap)
+    ->Args({1000, 0, 0})
+    ->Args({10000, 0, 0})
+    ->Args({10000, 10, 0})
+    ->Args({10000, 10, 1})
+    ->Unit(::benchmark::kMillisecond);
+
+void benchmarkMaglevLoadBalancerHostFlap(::benchmark::State& state) {
+  const uint64_t num_hosts = state.range(0);
+  const uint64_t num_failover_hosts = state.range(1);
+  const uint32_t flapping_priority = state.range(2);
+  MaglevTester tester(num_hosts);
+  if (num_failover_hosts > 0) {
+    tester.addFailoverHosts(num_failover_hosts);
+  }
+  tester.maglev_lb_->initialize();
+
+  uint64_t index = 0;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    tester.flapHost(flapping_priority, index++);
+  }
+}
+BENCHMARK(benchmarkMaglevLoadBalancerHostFlap)
+    ->Args({1000, 0, 0})
+    ->Args({10000, 0, 0})
+    ->Args({10000, 10, 0})
+    ->Args({10000, 10, 1})
+    ->Unit(::benchmark::kMillisecond);
+
 void benchmarkMaglevLoadBalancerHostLoss(::benchmark::State& state) {
   for (auto _ : state) { // NOLINT: Silences warning about dead store
     const uint64_t num_hosts = state.range(0);
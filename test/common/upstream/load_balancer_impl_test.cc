@@ -1156,6 +1156,36 @@ TEST_P(RoundRobinLoadBalancerTest, WeightedSeed) {
   EXPECT_EQ(hostSet().healthy_hosts_[1], lb_->chooseHost(nullptr));
 }
 
+// Validate that incremental refresh drops removed hosts from the schedule, even while they are
+// still referenced, and weights added hosts in with the remaining ones.
+TEST_P(RoundRobinLoadBalancerTest, WeightedIncrementalRefresh) {
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.edf_lb_incremental_refresh", "true"}});
+  hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", simTime(), 1),
+                              makeTestHost(info_, "tcp://127.0.0.1:81", simTime(), 2)};
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  init(false);
+  for (uint32_t i = 0; i < 5; ++i) {
+    lb_->chooseHost(nullptr);
+  }
+
+  HostVector removed_hosts = {hostSet().hosts_[1]};
+  hostSet().healthy_hosts_[1] = makeTestHost(info_, "tcp://127.0.0.1:82", simTime(), 3);
+  hostSet().hosts_ = hostSet().healthy_hosts_;
+  hostSet().runCallbacks({hostSet().healthy_hosts_[1]}, removed_hosts);
+
+  uint32_t first_picks = 0;
+  uint32_t added_picks = 0;
+  for (uint32_t i = 0; i < 400; ++i) {
+    HostConstSharedPtr host = lb_->chooseHost(nullptr);
+    EXPECT_NE(removed_hosts[0], host);
+    first_picks += host == hostSet().healthy_hosts_[0];
+    added_picks += host == hostSet().healthy_hosts_[1];
+  }
+  EXPECT_NEAR(100, first_picks, 1);
+  EXPECT_NEAR(300, added_picks, 1);
+}
+
 TEST_P(RoundRobinLoadBalancerTest, MaxUnhealthyPanic) {
   hostSet().healthy_hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", simTime()),
                               makeTestHost(info_, "tcp://127.0.0.1:81", simTime())};
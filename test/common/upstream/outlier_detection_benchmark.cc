@@ -0,0 +1,79 @@
+// Note: this should be run with --compilation_mode=opt, and would benefit from a
+// quiescent system with disabled cstate power management.
+
+#include <string>
+
+#include "envoy/config/cluster/v3/outlier_detection.pb.h"
+
+#include "source/common/upstream/outlier_detection_impl.h"
+
+#include "test/benchmark/main.h"
+#include "test/common/upstream/utility.h"
+#include "test/mocks/common.h"
+#include "test/mocks/event/mocks.h"
+#include "test/mocks/runtime/mocks.h"
+#include "test/mocks/upstream/cluster_info.h"
+#include "test/mocks/upstream/cluster_priority_set.h"
+#include "test/mocks/upstream/host_set.h"
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "absl/strings/str_cat.h"
+#include "benchmark/benchmark.h"
+
+using Envoy::benchmark::skipExpensiveBenchmarks;
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Upstream {
+namespace Outlier {
+namespace {
+
+// The interval callback of an outlier detector with success rate and failure percentage detection,
+// over a cluster of the given number of hosts. One percent of the hosts fail half of their
+// requests. Ejections are detected but not enforced, so every interval sees the same hosts.
+void successRateInterval(::benchmark::State& state) {
+  const uint32_t num_hosts = skipExpensiveBenchmarks() ? 100 : state.range(0);
+  Event::SimulatedTimeSystem time_system;
+  NiceMock<MockClusterMockPrioritySet> cluster;
+  NiceMock<Event::MockDispatcher> dispatcher;
+  NiceMock<Runtime::MockLoader> runtime;
+  NiceMock<Random::MockRandomGenerator> random;
+
+  HostVector& hosts = cluster.prioritySet().getMockHostSet(0)->hosts_;
+  hosts.reserve(num_hosts);
+  for (uint32_t i = 0; i < num_hosts; ++i) {
+    hosts.push_back(makeTestHost(
+        cluster.info_, absl::StrCat("tcp://10.0.", i / 256, ".", i % 256, ":80"), time_system));
+  }
+
+  const auto config = TestUtility::parseYaml<envoy::config::cluster::v3::OutlierDetection>(R"EOF(
+    interval: 10s
+    success_rate_minimum_hosts: 5
+    success_rate_request_volume: 10
+    failure_percentage_minimum_hosts: 5
+    failure_percentage_request_volume: 10
+  )EOF");
+  auto* interval_timer = new Event::MockTimer(&dispatcher);
+  std::shared_ptr<DetectorImpl> detector =
+      DetectorImpl::create(cluster, config, dispatcher, runtime, time_system, nullptr, random);
+
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    state.PauseTiming();
+    for (uint32_t i = 0; i < num_hosts; ++i) {
+      for (uint32_t rq = 0; rq < 10; ++rq) {
+        // Alternating failures never trip the consecutive 5xx detection.
+        hosts[i]->outlierDetector().putHttpResponseCode(i % 100 == 0 && rq % 2 == 0 ? 500 : 200);
+      }
+    }
+    state.ResumeTiming();
+
+    interval_timer->invokeCallback();
+  }
+}
+BENCHMARK(successRateInterval)->Arg(1000)->Arg(20000)->Unit(::benchmark::kMillisecond);
+
+} // namespace
+} // namespace Outlier
+} // namespace Upstream
+} // namespace Envoy
@@ -50,6 +50,7 @@
 #include "test/mocks/upstream/typed_load_balancer_factory.h"
 #include "test/test_common/environment.h"
 #include "test/test_common/registry.h"
+#include "test/test_common/test_runtime.h"
 #include "test/test_common/utility.h"
 
 #include "gmock/gmock.h"
@@ -1682,6 +1683,55 @@ TEST_F(StaticClusterImplTest, InitialHosts) {
   EXPECT_FALSE(cluster->info()->addedViaApi());
 }
 
+TEST_F(StaticClusterImplTest, InternsHostDataAcrossClusters) {
+  const std::string yaml = R"EOF(
+    name: {}
+    connect_timeout: 0.25s
+    type: STATIC
+    lb_policy: ROUND_ROBIN
+    load_assignment:
+        endpoints:
+          - locality:
+              region: region
+              zone: zone
+            lb_endpoints:
+            - endpoint:
+                address:
+                  socket_address:
+                    address: 10.0.0.1
+                    port_value: 443
+  )EOF";
+
+  std::vector<std::shared_ptr<StaticClusterImpl>> clusters;
+  auto create_host = [this, &yaml, &clusters](const std::string& name) {
+    Envoy::Upstream::ClusterFactoryContextImpl factory_context(
+        server_context_, server_context_.cluster_manager_, nullptr, ssl_context_manager_, nullptr,
+        false);
+    clusters.push_back(
+        createCluster(parseClusterFromV3Yaml(fmt::format(yaml, name)), factory_context));
+    clusters.back()->initialize([] {});
+    return clusters.back()->prioritySet().hostSetsPerPriority()[0]->hosts()[0];
+  };
+
+  {
+    HostSharedPtr first = create_host("first");
+    HostSharedPtr second = create_host("second");
+    EXPECT_NE(first->address(), second->address());
+    EXPECT_NE(&first->locality(), &second->locality());
+    EXPECT_EQ("zone", first->locality().zone());
+  }
+  clusters.clear();
+
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.intern_upstream_host_data", "true"}});
+  HostSharedPtr first = create_host("first");
+  HostSharedPtr second = create_host("second");
+  EXPECT_EQ(first->address(), second->address());
+  EXPECT_EQ(&first->locality(), &second->locality());
+  EXPECT_EQ("zone", second->locality().zone());
+  EXPECT_NE(first->cluster().name(), second->cluster().name());
+}
+
 TEST_F(StaticClusterImplTest, LoadAssignmentEmptyHostname) {
   const std::string yaml = R"EOF(
     name: staticcluster
@@ -3640,6 +3690,44 @@ TEST_F(ClusterInfoImplTest, Metadata) {
   EXPECT_EQ("envoy.load_balancing_policies.maglev", cluster->info()->loadBalancerFactory()->name());
 }
 
+// The connection config hash is only computed for clusters sharing health check probes, and tells
+// apart clusters connecting to the same endpoints differently.
+TEST_F(ClusterInfoImplTest, ConnectionConfigHash) {
+  const std::string yaml = R"EOF(
+    name: {}
+    connect_timeout: 0.25s
+    type: STRICT_DNS
+    load_assignment:
+        endpoints:
+          - lb_endpoints:
+            - endpoint:
+                address:
+                  socket_address:
+                    address: foo.bar.com
+                    port_value: 443
+    health_checks:
+    - timeout: 1s
+      interval: 1s
+      unhealthy_threshold: 2
+      healthy_threshold: 2
+      share_probes: {}
+      tcp_health_check: {{}}
+    upstream_connection_options:
+      tcp_keepalive:
+        keepalive_probes: {}
+  )EOF";
+
+  EXPECT_EQ(0, makeCluster(fmt::format(yaml, "first", false, 3))->info()->connectionConfigHash());
+
+  const uint64_t hash =
+      makeCluster(fmt::format(yaml, "first", true, 3))->info()->connectionConfigHash();
+  EXPECT_NE(0, hash);
+  EXPECT_EQ(hash,
+            makeCluster(fmt::format(yaml, "second", true, 3))->info()->connectionConfigHash());
+  EXPECT_NE(hash,
+            makeCluster(fmt::format(yaml, "second", true, 5))->info()->connectionConfigHash());
+}
+
 // Verify retry budget default values are honored.
 TEST_F(ClusterInfoImplTest, RetryBudgetDefaultPopulation) {
   std::string yaml = R"EOF(
@@ -10,9 +10,11 @@
 #include "envoy/service/discovery/v3/discovery.pb.h"
 #include "envoy/stats/scope.h"
 
+#include "source/common/common/thread.h"
 #include "source/common/config/protobuf_link_hacks.h"
 #include "source/common/config/utility.h"
 #include "source/common/singleton/manager_impl.h"
+#include "source/common/upstream/load_balancer_impl.h"
 #include "source/extensions/clusters/eds/eds.h"
 #include "source/extensions/config_subscription/grpc/grpc_mux_impl.h"
 #include "source/extensions/config_subscription/grpc/grpc_subscription_impl.h"
@@ -31,6 +33,7 @@
 #include "test/mocks/ssl/mocks.h"
 #include "test/mocks/upstream/cluster_manager.h"
 #include "test/test_common/test_runtime.h"
+#include "test/test_common/thread_factory_for_test.h"
 #include "test/test_common/utility.h"
 
 #include "benchmark/benchmark.h"
@@ -111,9 +114,14 @@ public:
 
   // Set up an EDS config with multiple priorities, localities, weights and make sure
   // they are loaded as expected.
+  // If weighted, endpoints get weights 1 to 4 by port. port_offset shifts the ports of all
+  // endpoints, so that an update with a different offset removes and adds that many endpoints.
   void priorityAndLocalityWeightedHelper(bool ignore_unknown_dynamic_fields, size_t num_hosts,
-                                         bool healthy) {
-    state_.PauseTiming();
+                                         bool healthy, bool weighted = false,
+                                         uint32_t port_offset = 0) {
+    if (pause_timing_) {
+      state_.PauseTiming();
+    }
 
     envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment;
     cluster_load_assignment.set_cluster_name("fare");
@@ -127,9 +135,12 @@ public:
     locality->set_sub_zone("sub_zone");
     endpoints->mutable_load_balancing_weight()->set_value(1);
 
-    uint32_t port = 1000;
+    uint32_t port = 1000 + port_offset;
     for (size_t i = 0; i < num_hosts; ++i) {
       auto* lb_endpoint = endpoints->add_lb_endpoints();
+      if (weighted) {
+        lb_endpoint->mutable_load_balancing_weight()->set_value(1 + (port + i) % 4);
+      }
       if (healthy) {
         lb_endpoint->set_health_status(envoy::config::core::v3::HEALTHY);
       } else {
@@ -149,7 +160,9 @@ public:
     response->set_version_info(fmt::format("version-{}", version_++));
     auto* resource = response->mutable_resources()->Add();
     resource->PackFrom(cluster_load_assignment);
-    state_.ResumeTiming();
+    if (pause_timing_) {
+      state_.ResumeTiming();
+    }
     if (use_unified_mux_) {
       dynamic_cast<Config::XdsMux::GrpcMuxSotw&>(*grpc_mux_)
           .grpcStreamForTest()
@@ -163,6 +176,28 @@ public:
            num_hosts);
   }
 
+  // Processes the thread safe parts of updates on up to concurrency threads, as configured with
+  // the bootstrap's config_ingestion_concurrency.
+  void setConfigIngestionConcurrency(uint32_t concurrency) {
+    auto& cm = server_context_.cluster_manager_;
+    ON_CALL(cm, configIngestionConcurrency()).WillByDefault(testing::Return(concurrency));
+    ON_CALL(cm, configIngestionParallelFor(_, _))
+        .WillByDefault(
+            testing::Invoke([concurrency](size_t count, const std::function<void(size_t)>& fn) {
+              Thread::parallelFor(Thread::threadFactoryForTest(), concurrency, count, fn);
+            }));
+  }
+
+  // Attaches a round robin load balancer to the cluster's priority set, standing in for the load
+  // balancer of a worker, so that updates include the cost of refreshing it.
+  void addRoundRobinLoadBalancer() {
+    lb_ = std::make_unique<RoundRobinLoadBalancer>(
+        cluster_->prioritySet(), nullptr, cluster_->info()->lbStats(),
+        server_context_.runtime_loader_, random_,
+        envoy::config::cluster::v3::Cluster::CommonLbConfig(), absl::nullopt,
+        server_context_.time_system_);
+  }
+
   NiceMock<Server::Configuration::MockServerFactoryContext> server_context_;
   Stats::TestUtil::TestStore& stats_ = server_context_.store_;
 
@@ -171,6 +206,8 @@ public:
   const std::string type_url_;
   uint64_t version_{};
   bool initialized_{};
+  // Cleared to deliver updates outside of the benchmark loop, where timing cannot be paused.
+  bool pause_timing_{true};
   Stats::Scope& scope_{*stats_.rootScope()};
   Config::SubscriptionStats subscription_stats_;
   Ssl::MockContextManager ssl_context_manager_;
@@ -189,6 +226,7 @@ public:
   Config::GrpcMuxSharedPtr grpc_mux_;
   Config::GrpcSubscriptionImplPtr subscription_;
   NiceMock<AccessLog::MockAccessLogManager> access_log_manager_;
+  std::unique_ptr<RoundRobinLoadBalancer> lb_;
 };
 
 } // namespace Upstream
@@ -241,3 +279,49 @@ static void healthOnlyUpdate(State& state) {
 }
 
 BENCHMARK(healthOnlyUpdate)->Ranges({{1, 100000}, {false, true}})->Unit(benchmark::kMillisecond);
+
+// Updates that move one endpoint of a large weighted cluster, with a round robin load balancer
+// refreshing its schedule on each update. The second argument enables incremental refresh.
+static void weightedLoadBalancerUpdate(State& state) {
+  Envoy::Thread::MutexBasicLockable lock;
+  Envoy::Logger::Context logging_state(spdlog::level::warn,
+                                       Envoy::Logger::Logger::DEFAULT_LOG_FORMAT, lock, false);
+  Envoy::TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues({{"envoy.reloadable_features.edf_lb_incremental_refresh",
+                               state.range(1) ? "true" : "false"}});
+  Envoy::Upstream::EdsSpeedTest speed_test(state, false);
+  uint32_t endpoints = skipExpensiveBenchmarks() ? 1 : state.range(0);
+  speed_test.pause_timing_ = false;
+  speed_test.priorityAndLocalityWeightedHelper(true, endpoints, true, true);
+  speed_test.addRoundRobinLoadBalancer();
+  speed_test.pause_timing_ = true;
+
+  uint32_t port_offset = 0;
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    port_offset ^= 1;
+    speed_test.priorityAndLocalityWeightedHelper(true, endpoints, true, true, port_offset);
+  }
+}
+
+BENCHMARK(weightedLoadBalancerUpdate)
+    ->Ranges({{1, 100000}, {false, true}})
+    ->Unit(benchmark::kMillisecond);
+
+// The first update of a large cluster, as ingested at startup, with the thread safe parts of the
+// update processed on the given number of threads.
+static void coldStartIngestion(State& state) {
+  Envoy::Thread::MutexBasicLockable lock;
+  Envoy::Logger::Context logging_state(spdlog::level::warn,
+                                       Envoy::Logger::Logger::DEFAULT_LOG_FORMAT, lock, false);
+  for (auto _ : state) { // NOLINT: Silences warning about dead store
+    Envoy::Upstream::EdsSpeedTest speed_test(state, false);
+    speed_test.setConfigIngestionConcurrency(state.range(1));
+    uint32_t endpoints = skipExpensiveBenchmarks() ? 1 : state.range(0);
+
+    speed_test.priorityAndLocalityWeightedHelper(true, endpoints, true);
+  }
+}
+
+BENCHMARK(coldStartIngestion)
+    ->ArgsProduct({{1000, 10000, 100000}, {1, 2, 4, 8}})
+    ->Unit(benchmark::kMillisecond);
@@ -7,6 +7,7 @@
 #include "envoy/service/discovery/v3/discovery.pb.h"
 #include "envoy/stats/scope.h"
 
+#include "source/common/common/thread.h"
 #include "source/common/config/utility.h"
 #include "source/common/singleton/manager_impl.h"
 #include "source/extensions/clusters/eds/eds.h"
@@ -25,13 +26,16 @@
 #include "test/mocks/upstream/health_checker.h"
 #include "test/test_common/simulated_time_system.h"
 #include "test/test_common/test_runtime.h"
+#include "test/test_common/thread_factory_for_test.h"
 #include "test/test_common/utility.h"
 
+#include "absl/strings/str_cat.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
 using testing::_;
 using testing::DoAll;
+using testing::Invoke;
 using testing::Return;
 using testing::SaveArg;
 
@@ -435,6 +439,56 @@ TEST_F(EdsTest, DualStackEndpoint) {
   EXPECT_NE(connection, connection_data.connection_.get());
 }
 
+// Validate that endpoint addresses parsed in parallel create the same hosts, in the same order, as
+// the serial path.
+TEST_F(EdsTest, ParallelAddressResolution) {
+  auto& cm = server_context_.cluster_manager_;
+  EXPECT_CALL(cm, configIngestionConcurrency()).WillRepeatedly(Return(4));
+  EXPECT_CALL(cm, configIngestionParallelFor(_, _))
+      .WillOnce(Invoke([](size_t count, const std::function<void(size_t)>& fn) {
+        Thread::parallelFor(Thread::threadFactoryForTest(), 4, count, fn);
+      }));
+
+  envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment;
+  cluster_load_assignment.set_cluster_name("fare");
+  auto* endpoints = cluster_load_assignment.add_endpoints();
+  const auto add_endpoint = [endpoints](const std::string& address, uint32_t port) {
+    auto* socket_address = endpoints->add_lb_endpoints()
+                               ->mutable_endpoint()
+                               ->mutable_address()
+                               ->mutable_socket_address();
+    socket_address->set_address(address);
+    socket_address->set_port_value(port);
+    return endpoints->mutable_lb_endpoints(endpoints->lb_endpoints_size() - 1);
+  };
+  for (uint32_t i = 0; i < 100; ++i) {
+    add_endpoint("10.0.0.1", 1000 + i);
+  }
+  // Duplicates still keep the first endpoint only.
+  add_endpoint("10.0.0.1", 1000);
+  auto* dual_stack = add_endpoint("::1", 80);
+  auto* additional_address = dual_stack->mutable_endpoint()
+                                 ->mutable_additional_addresses()
+                                 ->Add()
+                                 ->mutable_address()
+                                 ->mutable_socket_address();
+  additional_address->set_address("1.2.3.5");
+  additional_address->set_port_value(80);
+
+  initialize();
+  doOnConfigUpdateVerifyNoThrow(cluster_load_assignment);
+  EXPECT_TRUE(initialized_);
+
+  auto& hosts = cluster_->prioritySet().hostSetsPerPriority()[0]->hosts();
+  ASSERT_EQ(101, hosts.size());
+  for (uint32_t i = 0; i < 100; ++i) {
+    EXPECT_EQ(absl::StrCat("10.0.0.1:", 1000 + i), hosts[i]->address()->asString());
+  }
+  EXPECT_EQ("[::1]:80", hosts[100]->address()->asString());
+  ASSERT_EQ(2, hosts[100]->addressList().size());
+  EXPECT_EQ("1.2.3.5:80", hosts[100]->addressList()[1]->asString());
+}
+
 // Validate that onConfigUpdate() updates the endpoint metadata.
 TEST_F(EdsTest, EndpointMetadata) {
   envoy::config::endpoint::v3::ClusterLoadAssignment cluster_load_assignment;
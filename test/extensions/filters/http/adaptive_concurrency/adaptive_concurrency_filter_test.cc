@@ -34,6 +34,13 @@ public:
   uint32_t concurrencyLimit() const override { return 0; }
 };
 
+class MockPerClusterConcurrencyController : public MockConcurrencyController {
+public:
+  MOCK_METHOD(Controller::ConcurrencyController&, clusterController, (absl::string_view));
+
+  bool limitsPerCluster() const override { return true; }
+};
+
 class AdaptiveConcurrencyFilterTest : public testing::Test {
 public:
   AdaptiveConcurrencyFilterTest() = default;
@@ -452,6 +459,56 @@ concurrency_limit_exceeded_status:
             filter_->decodeHeaders(request_headers, true));
 }
 
+TEST_F(AdaptiveConcurrencyFilterTest, PerClusterControllerAdmitsRequestsByRoute) {
+  auto controller = std::make_shared<MockPerClusterConcurrencyController>();
+  MockConcurrencyController cluster_controller;
+  const envoy::extensions::filters::http::adaptive_concurrency::v3::AdaptiveConcurrency config;
+  auto config_ptr = std::make_shared<AdaptiveConcurrencyFilterConfig>(
+      config, runtime_, "testprefix.", stats_, time_system_);
+  filter_ = std::make_unique<AdaptiveConcurrencyFilter>(config_ptr, controller);
+  filter_->setDecoderFilterCallbacks(decoder_callbacks_);
+  filter_->setEncoderFilterCallbacks(encoder_callbacks_);
+  decoder_callbacks_.route_->route_entry_.cluster_name_ = "upstream";
+
+  Http::TestRequestHeaderMapImpl request_headers;
+  EXPECT_CALL(*controller, clusterController(absl::string_view("upstream")))
+      .WillRepeatedly(ReturnRef(cluster_controller));
+  EXPECT_CALL(*controller, forwardingDecision()).Times(0);
+  EXPECT_CALL(cluster_controller, forwardingDecision())
+      .WillOnce(Return(RequestForwardingAction::Forward));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers, true));
+
+  EXPECT_CALL(cluster_controller, recordLatencySample(_));
+  filter_->encodeComplete();
+
+  // Requests that are not routed to a cluster are not limited.
+  EXPECT_CALL(decoder_callbacks_, route()).WillOnce(Return(nullptr));
+  EXPECT_CALL(cluster_controller, forwardingDecision()).Times(0);
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers, true));
+  filter_->onDestroy();
+}
+
+TEST_F(AdaptiveConcurrencyFilterTest, PerClusterControllerCancelsSampleOfClusterController) {
+  auto controller = std::make_shared<MockPerClusterConcurrencyController>();
+  MockConcurrencyController cluster_controller;
+  const envoy::extensions::filters::http::adaptive_concurrency::v3::AdaptiveConcurrency config;
+  auto config_ptr = std::make_shared<AdaptiveConcurrencyFilterConfig>(
+      config, runtime_, "testprefix.", stats_, time_system_);
+  filter_ = std::make_unique<AdaptiveConcurrencyFilter>(config_ptr, controller);
+  filter_->setDecoderFilterCallbacks(decoder_callbacks_);
+  filter_->setEncoderFilterCallbacks(encoder_callbacks_);
+
+  Http::TestRequestHeaderMapImpl request_headers;
+  EXPECT_CALL(*controller, clusterController(_)).WillOnce(ReturnRef(cluster_controller));
+  EXPECT_CALL(cluster_controller, forwardingDecision())
+      .WillOnce(Return(RequestForwardingAction::Forward));
+  EXPECT_EQ(Http::FilterHeadersStatus::Continue, filter_->decodeHeaders(request_headers, true));
+
+  EXPECT_CALL(*controller, cancelLatencySample()).Times(0);
+  EXPECT_CALL(cluster_controller, cancelLatencySample());
+  filter_->onDestroy();
+}
+
 } // namespace
 } // namespace AdaptiveConcurrency
 } // namespace HttpFilters
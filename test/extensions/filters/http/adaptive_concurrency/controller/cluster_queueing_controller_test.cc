@@ -0,0 +1,274 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "envoy/extensions/filters/http/adaptive_concurrency/v3/adaptive_concurrency.pb.h"
+#include "envoy/extensions/filters/http/adaptive_concurrency/v3/adaptive_concurrency.pb.validate.h"
+
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/filters/http/adaptive_concurrency/controller/cluster_queueing_controller.h"
+
+#include "test/test_common/simulated_time_system.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace AdaptiveConcurrency {
+namespace Controller {
+namespace {
+
+ClusterQueueingControllerConfig makeConfig(const std::string& yaml_config) {
+  envoy::extensions::filters::http::adaptive_concurrency::v3::ClusterQueueingControllerConfig proto;
+  TestUtility::loadFromYamlAndValidate(yaml_config, proto);
+  return ClusterQueueingControllerConfig{proto};
+}
+
+TEST(ClusterQueueingControllerConfigTest, Defaults) {
+  const ClusterQueueingControllerConfig config = makeConfig("{}");
+  EXPECT_EQ(std::chrono::seconds(30), config.minRTTWindow());
+  EXPECT_EQ(std::chrono::milliseconds(100), config.concurrencyUpdateInterval());
+  EXPECT_EQ(20, config.initialConcurrencyLimit());
+  EXPECT_EQ(3, config.minConcurrency());
+  EXPECT_EQ(1000, config.maxConcurrencyLimit());
+  EXPECT_EQ(3, config.minQueueSize());
+  EXPECT_EQ(6, config.maxQueueSize());
+  EXPECT_EQ(64, config.maxClusters());
+}
+
+TEST(ClusterQueueingControllerConfigTest, InitialLimitIsClamped) {
+  const std::string above_max = R"EOF(
+initial_concurrency_limit: 50
+max_concurrency_limit: 10
+)EOF";
+  EXPECT_EQ(10, makeConfig(above_max).initialConcurrencyLimit());
+
+  const std::string below_min = R"EOF(
+initial_concurrency_limit: 1
+min_concurrency: 5
+)EOF";
+  EXPECT_EQ(5, makeConfig(below_min).initialConcurrencyLimit());
+}
+
+TEST(ClusterQueueingControllerConfigTest, InvalidBounds) {
+  EXPECT_THROW_WITH_MESSAGE(makeConfig(R"EOF(
+min_concurrency: 11
+max_concurrency_limit: 10
+)EOF"),
+                            EnvoyException,
+                            "cluster queueing controller: min_concurrency (11) must not be greater "
+                            "than max_concurrency_limit (10)");
+  EXPECT_THROW_WITH_MESSAGE(makeConfig(R"EOF(
+min_queue_size: 7
+)EOF"),
+                            EnvoyException,
+                            "cluster queueing controller: min_queue_size (7) must not be greater "
+                            "than max_queue_size (6)");
+}
+
+TEST(WindowedMinRTTTest, TracksMinimumOverLastTwoWindows) {
+  Event::SimulatedTimeSystem time_system;
+  time_system.advanceTimeWait(std::chrono::hours(1));
+  WindowedMinRTT min_rtt(std::chrono::seconds(10));
+  EXPECT_FALSE(min_rtt.get(time_system.monotonicTime()).has_value());
+
+  min_rtt.record(std::chrono::milliseconds(20), time_system.monotonicTime());
+  min_rtt.record(std::chrono::milliseconds(10), time_system.monotonicTime());
+  min_rtt.record(std::chrono::milliseconds(30), time_system.monotonicTime());
+  EXPECT_EQ(std::chrono::milliseconds(10), min_rtt.get(time_system.monotonicTime()));
+
+  // The minimum of the previous window still counts after a new window started.
+  time_system.advanceTimeWait(std::chrono::seconds(10));
+  min_rtt.record(std::chrono::milliseconds(50), time_system.monotonicTime());
+  EXPECT_EQ(std::chrono::milliseconds(10), min_rtt.get(time_system.monotonicTime()));
+
+  // Once another window passes, only the samples of the last window count.
+  time_system.advanceTimeWait(std::chrono::seconds(10));
+  EXPECT_EQ(std::chrono::milliseconds(50), min_rtt.get(time_system.monotonicTime()));
+  min_rtt.record(std::chrono::milliseconds(40), time_system.monotonicTime());
+  EXPECT_EQ(std::chrono::milliseconds(40), min_rtt.get(time_system.monotonicTime()));
+
+  // Samples older than two windows are forgotten, even if no new ones were recorded.
+  time_system.advanceTimeWait(std::chrono::seconds(20));
+  EXPECT_FALSE(min_rtt.get(time_system.monotonicTime()).has_value());
+  time_system.advanceTimeWait(std::chrono::seconds(20));
+  min_rtt.record(std::chrono::milliseconds(60), time_system.monotonicTime());
+  EXPECT_EQ(std::chrono::milliseconds(60), min_rtt.get(time_system.monotonicTime()));
+}
+
+class ClusterQueueingControllerTest : public testing::Test {
+protected:
+  ClusterQueueingControllerTest() { time_system_.advanceTimeWait(std::chrono::hours(42)); }
+
+  ClusterQueueingControllerSharedPtr makeController(const std::string& yaml_config) {
+    return std::make_shared<ClusterQueueingController>(makeConfig(yaml_config), "test_prefix.",
+                                                       *stats_.rootScope(), time_system_);
+  }
+
+  void forward(ConcurrencyController& controller, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+      EXPECT_EQ(RequestForwardingAction::Forward, controller.forwardingDecision());
+    }
+  }
+
+  void sampleLatency(ConcurrencyController& controller, std::chrono::milliseconds latency) {
+    controller.recordLatencySample(time_system_.monotonicTime() - latency);
+  }
+
+  uint64_t gauge(const std::string& name) {
+    return TestUtility::findGauge(stats_, "test_prefix." + name)->value();
+  }
+
+  Event::SimulatedTimeSystem time_system_;
+  Stats::IsolatedStoreImpl stats_;
+};
+
+TEST_F(ClusterQueueingControllerTest, ClustersHaveSeparateLimits) {
+  auto controller = makeController("initial_concurrency_limit: 2");
+  EXPECT_TRUE(controller->limitsPerCluster());
+
+  ConcurrencyController& first = controller->clusterController("first");
+  ConcurrencyController& second = controller->clusterController("second");
+  EXPECT_NE(&first, &second);
+  EXPECT_EQ(&first, &controller->clusterController("first"));
+  EXPECT_EQ(2, controller->numClusters());
+
+  forward(first, 2);
+  EXPECT_EQ(RequestForwardingAction::Block, first.forwardingDecision());
+  forward(second, 2);
+  EXPECT_EQ(RequestForwardingAction::Block, second.forwardingDecision());
+  EXPECT_EQ(1, TestUtility::findCounter(stats_, "test_prefix.cluster.first.rq_blocked")->value());
+  EXPECT_EQ(2, gauge("cluster.second.concurrency_limit"));
+
+  // Completed and cancelled requests make room for new ones.
+  sampleLatency(first, std::chrono::milliseconds(5));
+  first.cancelLatencySample();
+  forward(first, 2);
+}
+
+TEST_F(ClusterQueueingControllerTest, ClustersBeyondMaxShareOverflowLimit) {
+  auto controller = makeController(R"EOF(
+initial_concurrency_limit: 1
+max_clusters: 2
+)EOF");
+
+  ConcurrencyController& first = controller->clusterController("first");
+  ConcurrencyController& second = controller->clusterController("second");
+  ConcurrencyController& third = controller->clusterController("third");
+  EXPECT_EQ(&third, &controller->clusterController("fourth"));
+  EXPECT_NE(&third, &first);
+  EXPECT_NE(&third, &second);
+  EXPECT_EQ(2, controller->numClusters());
+
+  forward(third, 1);
+  EXPECT_EQ(RequestForwardingAction::Block,
+            controller->clusterController("fourth").forwardingDecision());
+  EXPECT_EQ(1, TestUtility::findCounter(stats_, "test_prefix.overflow.rq_blocked")->value());
+
+  // Requests whose cluster is not known are admitted by the overflow limit as well.
+  EXPECT_EQ(RequestForwardingAction::Block, controller->forwardingDecision());
+}
+
+TEST_F(ClusterQueueingControllerTest, LimitGrowsWithoutQueueing) {
+  auto controller = makeController("initial_concurrency_limit: 20");
+  ConcurrencyController& cluster = controller->clusterController("cluster");
+
+  forward(cluster, 20);
+  sampleLatency(cluster, std::chrono::milliseconds(10));
+  EXPECT_EQ(20, cluster.concurrencyLimit());
+
+  // Latencies do not exceed the minRTT, so nothing is queued and the limit grows.
+  time_system_.advanceTimeWait(std::chrono::milliseconds(100));
+  sampleLatency(cluster, std::chrono::milliseconds(10));
+  EXPECT_EQ(21, cluster.concurrencyLimit());
+  EXPECT_EQ(0, gauge("cluster.cluster.queue_size"));
+  EXPECT_EQ(10, gauge("cluster.cluster.min_rtt_msecs"));
+  EXPECT_EQ(10, gauge("cluster.cluster.sample_rtt_msecs"));
+  EXPECT_EQ(21, gauge("cluster.cluster.concurrency_limit"));
+
+  // The limit is recalculated at most once per update interval.
+  sampleLatency(cluster, std::chrono::milliseconds(10));
+  EXPECT_EQ(21, cluster.concurrencyLimit());
+}
+
+TEST_F(ClusterQueueingControllerTest, LimitDoesNotGrowUnlessUsed) {
+  auto controller = makeController("initial_concurrency_limit: 20");
+  ConcurrencyController& cluster = controller->clusterController("cluster");
+
+  forward(cluster, 2);
+  time_system_.advanceTimeWait(std::chrono::milliseconds(100));
+  sampleLatency(cluster, std::chrono::milliseconds(10));
+  EXPECT_EQ(20, cluster.concurrencyLimit());
+}
+
+TEST_F(ClusterQueueingControllerTest, LimitShrinksWhenQueueing) {
+  auto controller = makeController("initial_concurrency_limit: 20");
+  ConcurrencyController& cluster = controller->clusterController("cluster");
+
+  forward(cluster, 4);
+  sampleLatency(cluster, std::chrono::milliseconds(10));
+  sampleLatency(cluster, std::chrono::milliseconds(100));
+  sampleLatency(cluster, std::chrono::milliseconds(100));
+  time_system_.advanceTimeWait(std::chrono::milliseconds(100));
+  sampleLatency(cluster, std::chrono::milliseconds(100));
+
+  // The average latency is 77.5ms, so 20 * (1 - 10 / 77.5) ~= 18 requests are queued.
+  EXPECT_EQ(18, gauge("cluster.cluster.queue_size"));
+  EXPECT_EQ(19, cluster.concurrencyLimit());
+}
+
+TEST_F(ClusterQueueingControllerTest, LimitIsKeptWithinBounds) {
+  auto controller = makeController(R"EOF(
+initial_concurrency_limit: 4
+min_concurrency: 4
+max_concurrency_limit: 4
+min_queue_size: 1
+max_queue_size: 1
+)EOF");
+  ConcurrencyController& cluster = controller->clusterController("cluster");
+
+  forward(cluster, 4);
+  sampleLatency(cluster, std::chrono::milliseconds(10));
+  time_system_.advanceTimeWait(std::chrono::milliseconds(100));
+  sampleLatency(cluster, std::chrono::milliseconds(1000));
+  EXPECT_EQ(4, cluster.concurrencyLimit());
+
+  forward(cluster, 2);
+  time_system_.advanceTimeWait(std::chrono::milliseconds(100));
+  sampleLatency(cluster, std::chrono::milliseconds(10));
+  EXPECT_EQ(4, cluster.concurrencyLimit());
+}
+
+TEST_F(ClusterQueueingControllerTest, LimitIsNotExceededByConcurrentWorkers) {
+  auto controller = makeController("initial_concurrency_limit: 100");
+  ConcurrencyController& cluster = controller->clusterController("cluster");
+
+  std::atomic<uint32_t> forwarded{0};
+  std::vector<std::thread> workers;
+  for (uint32_t i = 0; i < 4; i++) {
+    workers.emplace_back([&controller, &forwarded]() {
+      ConcurrencyController& cluster = controller->clusterController("cluster");
+      for (uint32_t j = 0; j < 100; j++) {
+        if (cluster.forwardingDecision() == RequestForwardingAction::Forward) {
+          ++forwarded;
+        }
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  EXPECT_EQ(100, forwarded.load());
+  EXPECT_EQ(RequestForwardingAction::Block, cluster.forwardingDecision());
+}
+
+} // namespace
+} // namespace Controller
+} // namespace AdaptiveConcurrency
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,239 @@
+#include "envoy/extensions/http/cache/lru_http_cache/v3/lru_http_cache.pb.h"
+#include "envoy/registry/registry.h"
+
+#include "source/common/buffer/buffer_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/filters/http/cache/cache_headers_utils.h"
+#include "source/extensions/http/cache/lru_http_cache/lru_http_cache.h"
+
+#include "test/extensions/filters/http/cache/common.h"
+#include "test/extensions/filters/http/cache/http_cache_implementation_test_common.h"
+#include "test/mocks/server/factory_context.h"
+#include "test/test_common/status_utility.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace HttpFilters {
+namespace Cache {
+namespace {
+
+LruHttpCacheConfig makeConfig(uint64_t max_size_bytes, uint32_t num_shards) {
+  LruHttpCacheConfig config;
+  config.set_max_size_bytes(max_size_bytes);
+  config.mutable_num_shards()->set_value(num_shards);
+  config.set_stat_prefix("test");
+  return config;
+}
+
+class LruHttpCacheTestDelegate : public HttpCacheTestDelegate {
+public:
+  LruHttpCacheTestDelegate() { setConfig(makeConfig(1024 * 1024, 16)); }
+
+  std::shared_ptr<HttpCache> cache() override { return cache_; }
+  bool validationEnabled() const override { return true; }
+
+  // Replaces the cache with an empty one using the given config.
+  void setConfig(const LruHttpCacheConfig& config) {
+    cache_.reset();
+    cache_ = std::make_shared<LruHttpCache>(nullptr, config, *store_.rootScope());
+  }
+  LruHttpCache& lruCache() { return *cache_; }
+
+private:
+  Stats::IsolatedStoreImpl store_;
+  std::shared_ptr<LruHttpCache> cache_;
+};
+
+// For the standard cache tests from http_cache_implementation_test_common.cc
+INSTANTIATE_TEST_SUITE_P(LruHttpCacheTest, HttpCacheImplementationTest,
+                         testing::Values(std::make_unique<LruHttpCacheTestDelegate>),
+                         [](const testing::TestParamInfo<HttpCacheImplementationTest::ParamType>&) {
+                           return "LruHttpCache";
+                         });
+
+class LruHttpCacheTest : public HttpCacheImplementationTest {
+protected:
+  LruHttpCacheTestDelegate& lruDelegate() {
+    return dynamic_cast<LruHttpCacheTestDelegate&>(*delegate_);
+  }
+  LruHttpCache& lruCache() { return lruDelegate().lruCache(); }
+  const LruHttpCacheStats& stats() { return lruCache().stats(); }
+
+  Http::TestResponseHeaderMapImpl responseHeaders() {
+    return {{"date", formatter_.fromTime(time_system_.systemTime())},
+            {"cache-control", "public,max-age=3600"}};
+  }
+
+  // Returns the accounted size of a cached response to the given path with the given body.
+  uint64_t entrySize(absl::string_view request_path, absl::string_view body) {
+    lruDelegate().setConfig(makeConfig(1024 * 1024, 1));
+    EXPECT_OK(insert(request_path, responseHeaders(), body));
+    return stats().size_bytes_.value();
+  }
+
+  // Returns the data backing the first slice of a body read from the cache.
+  const void* bodyData(LookupContext& context, uint64_t length) {
+    const void* data = nullptr;
+    context.getBody(AdjustedByteRange(0, length), [&data](Buffer::InstancePtr&& body) {
+      ASSERT_NE(body, nullptr);
+      data = body->frontSlice().mem_;
+    });
+    return data;
+  }
+};
+
+INSTANTIATE_TEST_SUITE_P(LruHttpCacheTest, LruHttpCacheTest,
+                         testing::Values(std::make_unique<LruHttpCacheTestDelegate>));
+
+TEST_P(LruHttpCacheTest, EvictsLeastRecentlyUsed) {
+  const std::string body(100, 'x');
+  const uint64_t entry_size = entrySize("/a", body);
+  lruDelegate().setConfig(makeConfig(3 * entry_size, 1));
+
+  EXPECT_OK(insert("/a", responseHeaders(), body));
+  EXPECT_OK(insert("/b", responseHeaders(), body));
+  EXPECT_OK(insert("/c", responseHeaders(), body));
+  EXPECT_EQ(3 * entry_size, stats().size_bytes_.value());
+  EXPECT_EQ(0, stats().evictions_.value());
+
+  // Use /a so that /b becomes the least recently used entry.
+  lookup("/a");
+  EXPECT_EQ(CacheEntryStatus::Ok, lookup_result_.cache_entry_status_);
+
+  EXPECT_OK(insert("/d", responseHeaders(), body));
+  EXPECT_EQ(1, stats().evictions_.value());
+  EXPECT_EQ(3, stats().size_count_.value());
+  EXPECT_EQ(3 * entry_size, stats().size_bytes_.value());
+
+  lookup("/b");
+  EXPECT_EQ(CacheEntryStatus::Unusable, lookup_result_.cache_entry_status_);
+  for (absl::string_view path : {"/a", "/c", "/d"}) {
+    lookup(path);
+    EXPECT_EQ(CacheEntryStatus::Ok, lookup_result_.cache_entry_status_) << path;
+  }
+}
+
+TEST_P(LruHttpCacheTest, ReplacingAnEntryIsNotAnEviction) {
+  const uint64_t entry_size = entrySize("/a", "body");
+  EXPECT_OK(insert("/a", responseHeaders(), "body"));
+  EXPECT_EQ(0, stats().evictions_.value());
+  EXPECT_EQ(1, stats().size_count_.value());
+  EXPECT_EQ(entry_size, stats().size_bytes_.value());
+  EXPECT_EQ(2, stats().inserts_.value());
+}
+
+TEST_P(LruHttpCacheTest, ResponsesLargerThanAShardAreNotCached) {
+  lruDelegate().setConfig(makeConfig(16 * 1024, 4));
+  EXPECT_EQ(4 * 1024, lruCache().maxEntrySizeBytes());
+  EXPECT_EQ(16 * 1024, stats().size_limit_bytes_.value());
+
+  EXPECT_FALSE(insert("/a", responseHeaders(), std::string(8 * 1024, 'x')).ok());
+  EXPECT_EQ(1, stats().insert_rejected_.value());
+  EXPECT_EQ(0, stats().size_count_.value());
+  EXPECT_EQ(0, stats().size_bytes_.value());
+
+  lookup("/a");
+  EXPECT_EQ(CacheEntryStatus::Unusable, lookup_result_.cache_entry_status_);
+}
+
+TEST_P(LruHttpCacheTest, HitAndMissStats) {
+  lookup("/a");
+  EXPECT_EQ(0, stats().hits_.value());
+  EXPECT_EQ(1, stats().misses_.value());
+
+  // Inserting looks up the entry first, which is another miss.
+  EXPECT_OK(insert("/a", responseHeaders(), "body"));
+  EXPECT_EQ(2, stats().misses_.value());
+
+  lookup("/a");
+  lookup("/a");
+  EXPECT_EQ(2, stats().hits_.value());
+  EXPECT_EQ(2, stats().misses_.value());
+}
+
+TEST_P(LruHttpCacheTest, LookupsShareTheBody) {
+  const std::string body = "the cached body";
+  EXPECT_OK(insert("/a", responseHeaders(), body));
+
+  LookupContextPtr first = lookup("/a");
+  EXPECT_TRUE(expectLookupSuccessWithBodyAndTrailers(first.get(), body));
+  LookupContextPtr second = lookup("/a");
+  EXPECT_TRUE(expectLookupSuccessWithBodyAndTrailers(second.get(), body));
+
+  EXPECT_EQ(bodyData(*first, body.size()), bodyData(*second, body.size()));
+}
+
+TEST_P(LruHttpCacheTest, BodyOutlivesEviction) {
+  const std::string body(100, 'x');
+  const uint64_t entry_size = entrySize("/a", body);
+  lruDelegate().setConfig(makeConfig(entry_size, 1));
+  EXPECT_OK(insert("/a", responseHeaders(), body));
+
+  LookupContextPtr context = lookup("/a");
+  ASSERT_EQ(CacheEntryStatus::Ok, lookup_result_.cache_entry_status_);
+
+  EXPECT_OK(insert("/b", responseHeaders(), std::string(100, 'y')));
+  EXPECT_EQ(1, stats().evictions_.value());
+  EXPECT_EQ(body, getBody(*context, 0, body.size()));
+}
+
+TEST(Registration, GetFactory) {
+  HttpCacheFactory* factory = Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(
+      "envoy.extensions.http.cache.lru_http_cache.v3.LruHttpCacheConfig");
+  ASSERT_NE(factory, nullptr);
+  testing::NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  envoy::extensions::filters::http::cache::v3::CacheConfig config;
+  config.mutable_typed_config()->PackFrom(makeConfig(1024, 2));
+  std::shared_ptr<HttpCache> cache = factory->getCache(config, factory_context);
+  EXPECT_EQ(cache->cacheInfo().name_, "envoy.extensions.http.cache.lru_http_cache");
+
+  // Identical configs share a cache, and different configs do not.
+  EXPECT_EQ(cache, factory->getCache(config, factory_context));
+  envoy::extensions::filters::http::cache::v3::CacheConfig other_config;
+  other_config.mutable_typed_config()->PackFrom(makeConfig(2048, 2));
+  EXPECT_NE(cache, factory->getCache(other_config, factory_context));
+}
+
+TEST(Registration, InvalidConfigIsRejected) {
+  HttpCacheFactory* factory = Registry::FactoryRegistry<HttpCacheFactory>::getFactoryByType(
+      "envoy.extensions.http.cache.lru_http_cache.v3.LruHttpCacheConfig");
+  ASSERT_NE(factory, nullptr);
+  testing::NiceMock<Server::Configuration::MockFactoryContext> factory_context;
+  envoy::extensions::filters::http::cache::v3::CacheConfig config;
+  config.mutable_typed_config()->PackFrom(makeConfig(0, 2));
+  EXPECT_THROW(factory->getCache(config, factory_context), ProtoValidationException);
+
+  // Every shard must be able to hold at least one byte.
+  config.mutable_typed_config()->PackFrom(makeConfig(1, 2));
+  EXPECT_THROW_WITH_MESSAGE(factory->getCache(config, factory_context), EnvoyException,
+                            "lru_http_cache: max_size_bytes 1 is less than the 2 shards");
+
+  LruHttpCacheConfig no_stat_prefix = makeConfig(1024, 2);
+  no_stat_prefix.clear_stat_prefix();
+  config.mutable_typed_config()->PackFrom(no_stat_prefix);
+  EXPECT_THROW(factory->getCache(config, factory_context), ProtoValidationException);
+}
+
+// Each cache emits its stats under its own prefix.
+TEST(LruHttpCacheStatsTest, StatsArePrefixed) {
+  Stats::IsolatedStoreImpl store;
+  LruHttpCacheConfig config = makeConfig(1024, 2);
+  config.set_stat_prefix("first");
+  LruHttpCache first(nullptr, config, *store.rootScope());
+  config.set_stat_prefix("second");
+  config.set_max_size_bytes(2048);
+  LruHttpCache second(nullptr, config, *store.rootScope());
+
+  EXPECT_EQ(1024, TestUtility::findGauge(store, "lru_http_cache.first.size_limit_bytes")->value());
+  EXPECT_EQ(2048, TestUtility::findGauge(store, "lru_http_cache.second.size_limit_bytes")->value());
+  EXPECT_EQ(nullptr, TestUtility::findGauge(store, "lru_http_cache.size_limit_bytes"));
+}
+
+} // namespace
+} // namespace Cache
+} // namespace HttpFilters
+} // namespace Extensions
+} // namespace Envoy
@@ -0,0 +1,229 @@
+#include <chrono>
+#include <memory>
+
+#include "source/extensions/load_balancing_policies/client_side_weighted_round_robin/client_side_weighted_round_robin_lb.h"
+
+#include "test/common/upstream/utility.h"
+#include "test/mocks/common.h"
+#include "test/mocks/runtime/mocks.h"
+#include "test/mocks/upstream/cluster_info.h"
+#include "test/mocks/upstream/host_set.h"
+#include "test/mocks/upstream/priority_set.h"
+#include "test/test_common/simulated_time_system.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "xds/data/orca/v3/orca_load_report.pb.h"
+
+using testing::NiceMock;
+
+namespace Envoy {
+namespace Extensions {
+namespace LoadBalancingPolices {
+namespace ClientSideWeightedRoundRobin {
+namespace {
+
+using OrcaLoadReport = xds::data::orca::v3::OrcaLoadReport;
+
+constexpr std::chrono::seconds BlackoutPeriod{10};
+constexpr std::chrono::seconds WeightExpirationPeriod{180};
+
+OrcaLoadReport makeReport(double qps, double cpu_utilization, double eps = 0,
+                          double application_utilization = 0) {
+  OrcaLoadReport report;
+  report.set_rps_fractional(qps);
+  report.set_cpu_utilization(cpu_utilization);
+  report.set_eps(eps);
+  report.set_application_utilization(application_utilization);
+  return report;
+}
+
+class OrcaHostLbPolicyDataTest : public Event::TestUsingSimulatedTime, public testing::Test {
+protected:
+  absl::optional<double> reportedWeight() {
+    return data_.reportedWeight(simTime().monotonicTime(), BlackoutPeriod, WeightExpirationPeriod);
+  }
+
+  OrcaHostLbPolicyData data_{simTime(), 1.0};
+};
+
+TEST_F(OrcaHostLbPolicyDataTest, NoWeightWithoutReports) {
+  EXPECT_EQ(absl::nullopt, reportedWeight());
+  EXPECT_EQ(1, data_.weight());
+}
+
+TEST_F(OrcaHostLbPolicyDataTest, WeightIsUsedAfterBlackoutPeriod) {
+  data_.onOrcaLoadReport(makeReport(100, 0.5));
+  EXPECT_EQ(absl::nullopt, reportedWeight());
+
+  simTime().advanceTimeWait(BlackoutPeriod);
+  EXPECT_EQ(200, reportedWeight());
+
+  // The latest report wins.
+  data_.onOrcaLoadReport(makeReport(100, 0.25));
+  EXPECT_EQ(400, reportedWeight());
+}
+
+TEST_F(OrcaHostLbPolicyDataTest, ReportsWithoutQpsOrUtilizationAreIgnored) {
+  data_.onOrcaLoadReport(makeReport(0, 0.5));
+  data_.onOrcaLoadReport(makeReport(100, 0));
+  simTime().advanceTimeWait(BlackoutPeriod);
+  EXPECT_EQ(absl::nullopt, reportedWeight());
+}
+
+TEST_F(OrcaHostLbPolicyDataTest, ApplicationUtilizationAndErrorPenalty) {
+  // The application utilization takes precedence over the CPU utilization, and 10 errors for 100
+  // queries add 0.1 to it.
+  data_.onOrcaLoadReport(makeReport(100, 0.9, 10, 0.4));
+  simTime().advanceTimeWait(BlackoutPeriod);
+  ASSERT_TRUE(reportedWeight().has_value());
+  EXPECT_DOUBLE_EQ(200, reportedWeight().value());
+}
+
+TEST_F(OrcaHostLbPolicyDataTest, WeightExpires) {
+  data_.onOrcaLoadReport(makeReport(100, 0.5));
+  simTime().advanceTimeWait(WeightExpirationPeriod);
+  EXPECT_EQ(absl::nullopt, reportedWeight());
+
+  // After expiring, the host has to go through the blackout period again.
+  data_.onOrcaLoadReport(makeReport(100, 0.5));
+  EXPECT_EQ(absl::nullopt, reportedWeight());
+  simTime().advanceTimeWait(BlackoutPeriod);
+  EXPECT_EQ(200, reportedWeight());
+}
+
+class ClientSideWeightedRoundRobinLoadBalancerTest : public Event::TestUsingSimulatedTime,
+                                                    public testing::Test {
+protected:
+  void initialize() {
+    thread_aware_lb_ = std::make_unique<ClientSideWeightedRoundRobinThreadAwareLoadBalancer>(
+        config_, *info_, priority_set_, runtime_, random_, simTime());
+    thread_aware_lb_->initialize();
+    lb_ = thread_aware_lb_->factory()->create({priority_set_, nullptr});
+  }
+
+  void addHosts(uint32_t num_hosts) {
+    Upstream::HostVector added;
+    for (uint32_t i = 0; i < num_hosts; ++i) {
+      added.push_back(Upstream::makeTestHost(
+          info_, fmt::format("tcp://127.0.0.1:{}", 80 + host_set_.hosts_.size()), simTime()));
+      host_set_.hosts_.push_back(added.back());
+    }
+    host_set_.healthy_hosts_ = host_set_.hosts_;
+    host_set_.runCallbacks(added, {});
+  }
+
+  void report(uint32_t host_index, double qps, double cpu_utilization) {
+    host_set_.hosts_[host_index]->lbPolicyData()->onOrcaLoadReport(
+        makeReport(qps, cpu_utilization));
+  }
+
+  double weight(uint32_t host_index) {
+    return thread_aware_lb_->weightUpdater().hostWeight(*host_set_.hosts_[host_index]);
+  }
+
+  NiceMock<Runtime::MockLoader> runtime_;
+  NiceMock<Random::MockRandomGenerator> random_;
+  NiceMock<Upstream::MockPrioritySet> priority_set_;
+  Upstream::MockHostSet& host_set_ = *priority_set_.getMockHostSet(0);
+  std::shared_ptr<Upstream::MockClusterInfo> info_{new NiceMock<Upstream::MockClusterInfo>()};
+  ClientSideWeightedRoundRobinLbProto config_;
+  std::unique_ptr<ClientSideWeightedRoundRobinThreadAwareLoadBalancer> thread_aware_lb_;
+  Upstream::LoadBalancerPtr lb_;
+};
+
+TEST_F(ClientSideWeightedRoundRobinLoadBalancerTest, NoHosts) {
+  initialize();
+  EXPECT_EQ(nullptr, lb_->chooseHost(nullptr));
+}
+
+TEST_F(ClientSideWeightedRoundRobinLoadBalancerTest, AttachesLbPolicyDataToHosts) {
+  addHosts(2);
+  initialize();
+  for (const auto& host : host_set_.hosts_) {
+    EXPECT_NE(nullptr, dynamic_cast<OrcaHostLbPolicyData*>(host->lbPolicyData().ptr()));
+  }
+
+  // Hosts added later get the data before they are used.
+  addHosts(1);
+  EXPECT_NE(nullptr,
+            dynamic_cast<OrcaHostLbPolicyData*>(host_set_.hosts_[2]->lbPolicyData().ptr()));
+}
+
+TEST_F(ClientSideWeightedRoundRobinLoadBalancerTest, UnknownWeightsUseMedian) {
+  addHosts(4);
+  initialize();
+  report(0, 100, 1);
+  report(1, 200, 1);
+  report(2, 400, 1);
+  simTime().advanceTimeWait(std::chrono::seconds(10));
+
+  lb_->chooseHost(nullptr);
+  EXPECT_EQ(100, weight(0));
+  EXPECT_EQ(200, weight(1));
+  EXPECT_EQ(400, weight(2));
+  EXPECT_EQ(200, weight(3));
+}
+
+TEST_F(ClientSideWeightedRoundRobinLoadBalancerTest, WeightsAreUpdatedPeriodically) {
+  config_.mutable_blackout_period()->set_seconds(0);
+  config_.mutable_weight_update_period()->set_seconds(1);
+  addHosts(2);
+  initialize();
+
+  // Without reports all hosts have the same weight.
+  lb_->chooseHost(nullptr);
+  EXPECT_EQ(1, weight(0));
+  EXPECT_EQ(1, weight(1));
+
+  report(0, 100, 1);
+  report(1, 300, 1);
+  lb_->chooseHost(nullptr);
+  EXPECT_EQ(1, weight(0));
+
+  simTime().advanceTimeWait(std::chrono::seconds(1));
+  lb_->chooseHost(nullptr);
+  EXPECT_EQ(100, weight(0));
+  EXPECT_EQ(300, weight(1));
+}
+
+// The default weight is computed from a bounded sample of the hosts rather than from all of them.
+TEST_F(ClientSideWeightedRoundRobinLoadBalancerTest, DefaultWeightIsSampled) {
+  config_.mutable_blackout_period()->set_seconds(0);
+  addHosts(2 * WeightUpdater::MaxDefaultWeightSamples);
+  initialize();
+  // Only every other host is sampled, and none of those report.
+  for (uint32_t i = 3; i < host_set_.hosts_.size(); i += 2) {
+    report(i, 100, 1);
+  }
+
+  lb_->chooseHost(nullptr);
+  EXPECT_EQ(100, weight(3));
+  EXPECT_EQ(1, weight(0));
+  EXPECT_EQ(1, weight(1));
+}
+
+TEST_F(ClientSideWeightedRoundRobinLoadBalancerTest, PicksHostsByReportedWeight) {
+  config_.mutable_blackout_period()->set_seconds(0);
+  addHosts(2);
+  initialize();
+  report(0, 100, 1);
+  report(1, 300, 1);
+
+  // The first pick updates the weights, which the schedule follows from then on.
+  lb_->chooseHost(nullptr);
+  lb_->chooseHost(nullptr);
+
+  uint32_t picks[2] = {0, 0};
+  for (uint32_t i = 0; i < 400; ++i) {
+    picks[lb_->chooseHost(nullptr) == host_set_.hosts_[0] ? 0 : 1]++;
+  }
+  EXPECT_NEAR(100, picks[0], 2);
+  EXPECT_NEAR(300, picks[1], 2);
+}
+
+} // namespace
+} // namespace ClientSideWeightedRoundRobin
+} // namespace LoadBalancingPolices
+} // namespace Extensions
+} // namespace Envoy
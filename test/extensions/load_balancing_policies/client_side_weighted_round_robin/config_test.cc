@@ -0,0 +1,71 @@
+#include "envoy/config/core/v3/extension.pb.h"
+#include "envoy/registry/registry.h"
+
+#include "source/extensions/load_balancing_policies/client_side_weighted_round_robin/config.h"
+
+#include "test/mocks/server/factory_context.h"
+#include "test/mocks/upstream/cluster_info.h"
+#include "test/mocks/upstream/priority_set.h"
+#include "test/test_common/utility.h"
+
+#include "gtest/gtest.h"
+
+namespace Envoy {
+namespace Extensions {
+namespace LoadBalancingPolices {
+namespace ClientSideWeightedRoundRobin {
+namespace {
+
+TEST(ClientSideWeightedRoundRobinConfigTest, ValidateFail) {
+  NiceMock<Server::Configuration::MockFactoryContext> context;
+  NiceMock<Upstream::MockClusterInfo> cluster_info;
+  NiceMock<Upstream::MockPrioritySet> main_thread_priority_set;
+  NiceMock<Upstream::MockPrioritySet> thread_local_priority_set;
+
+  envoy::config::core::v3::TypedExtensionConfig config;
+  config.set_name("envoy.load_balancing_policies.client_side_weighted_round_robin");
+  ClientSideWeightedRoundRobinLbProto config_msg;
+  config.mutable_typed_config()->PackFrom(config_msg);
+
+  auto& factory = Config::Utility::getAndCheckFactory<Upstream::TypedLoadBalancerFactory>(config);
+  EXPECT_EQ("envoy.load_balancing_policies.client_side_weighted_round_robin", factory.name());
+
+  auto lb_config =
+      factory.loadConfig(*factory.createEmptyConfigProto(), context.messageValidationVisitor());
+  auto thread_aware_lb =
+      factory.create(*lb_config, cluster_info, main_thread_priority_set, context.runtime_loader_,
+                     context.api_.random_, context.time_system_);
+  EXPECT_NE(nullptr, thread_aware_lb);
+
+  thread_aware_lb->initialize();
+
+  auto thread_local_lb_factory = thread_aware_lb->factory();
+  EXPECT_NE(nullptr, thread_local_lb_factory);
+
+  auto thread_local_lb = thread_local_lb_factory->create({thread_local_priority_set, nullptr});
+  EXPECT_NE(nullptr, thread_local_lb);
+}
+
+TEST(ClientSideWeightedRoundRobinConfigTest, OobLoadReportingIsRejected) {
+  NiceMock<Server::Configuration::MockFactoryContext> context;
+  auto* factory = Registry::FactoryRegistry<Upstream::TypedLoadBalancerFactory>::getFactory(
+      "envoy.load_balancing_policies.client_side_weighted_round_robin");
+  ASSERT_NE(nullptr, factory);
+
+  ClientSideWeightedRoundRobinLbProto config;
+  config.mutable_enable_oob_load_report()->set_value(false);
+  EXPECT_THROW_WITH_MESSAGE(factory->loadConfig(config, context.messageValidationVisitor()),
+                            EnvoyException,
+                            "client_side_weighted_round_robin: out-of-band load reporting "
+                            "(enable_oob_load_report, oob_reporting_period) is not supported");
+
+  config.clear_enable_oob_load_report();
+  config.mutable_oob_reporting_period()->set_seconds(1);
+  EXPECT_THROW(factory->loadConfig(config, context.messageValidationVisitor()), EnvoyException);
+}
+
+} // namespace
+} // namespace ClientSideWeightedRoundRobin
+} // namespace LoadBalancingPolices
+} // namespace Extensions
+} // namespace Envoy
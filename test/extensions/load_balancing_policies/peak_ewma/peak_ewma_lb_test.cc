@@ -0,0 +1,182 @@
+#include <chrono>
+#include <cmath>
+#include <memory>
+
+#include "source/extensions/load_balancing_policies/peak_ewma/peak_ewma_lb.h"
+
+#include "test/common/upstream/utility.h"
+#include "test/mocks/common.h"
+#include "test/mocks/runtime/mocks.h"
+#include "test/mocks/upstream/cluster_info.h"
+#include "test/mocks/upstream/host_set.h"
+#include "test/mocks/upstream/priority_set.h"
+#include "test/test_common/simulated_time_system.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::NiceMock;
+using testing::Return;
+
+namespace Envoy {
+namespace Extensions {
+namespace LoadBalancingPolices {
+namespace PeakEwma {
+namespace {
+
+constexpr std::chrono::seconds DecayTime{10};
+constexpr std::chrono::milliseconds DefaultRtt{30};
+
+class PeakEwmaHostLbPolicyDataTest : public Event::TestUsingSimulatedTime, public testing::Test {
+protected:
+  double latency() { return data_.latency(simTime().monotonicTime()); }
+
+  PeakEwmaHostLbPolicyData data_{simTime(), DecayTime, DefaultRtt};
+};
+
+TEST_F(PeakEwmaHostLbPolicyDataTest, DefaultRttBeforeFirstSample) {
+  EXPECT_DOUBLE_EQ(30000, latency());
+  simTime().advanceTimeWait(DecayTime);
+  EXPECT_DOUBLE_EQ(30000, latency());
+}
+
+TEST_F(PeakEwmaHostLbPolicyDataTest, FirstSampleReplacesDefaultRtt) {
+  data_.onUpstreamRequestComplete(std::chrono::milliseconds(10));
+  EXPECT_DOUBLE_EQ(10000, latency());
+}
+
+TEST_F(PeakEwmaHostLbPolicyDataTest, PeakSampleReplacesEstimate) {
+  data_.onUpstreamRequestComplete(std::chrono::milliseconds(10));
+  data_.onUpstreamRequestComplete(std::chrono::milliseconds(50));
+  EXPECT_DOUBLE_EQ(50000, latency());
+}
+
+TEST_F(PeakEwmaHostLbPolicyDataTest, LowerSampleIsAveraged) {
+  data_.onUpstreamRequestComplete(std::chrono::milliseconds(50));
+
+  // A sample right after the previous one barely moves the estimate.
+  data_.onUpstreamRequestComplete(std::chrono::milliseconds(10));
+  EXPECT_DOUBLE_EQ(50000, latency());
+
+  // After decay_time the previous estimate has a weight of 1/e.
+  simTime().advanceTimeWait(DecayTime);
+  data_.onUpstreamRequestComplete(std::chrono::milliseconds(10));
+  EXPECT_NEAR(50000 * std::exp(-1) + 10000 * (1 - std::exp(-1)), latency(), 1);
+}
+
+TEST_F(PeakEwmaHostLbPolicyDataTest, EstimateRelaxesTowardsDefaultRtt) {
+  data_.onUpstreamRequestComplete(std::chrono::milliseconds(100));
+  simTime().advanceTimeWait(DecayTime);
+  EXPECT_NEAR(30000 + 70000 * std::exp(-1), latency(), 1);
+
+  data_.onUpstreamRequestComplete(std::chrono::milliseconds(1));
+  simTime().advanceTimeWait(DecayTime * 10);
+  EXPECT_NEAR(30000, latency(), 1);
+}
+
+class PeakEwmaLoadBalancerTest : public Event::TestUsingSimulatedTime, public testing::Test {
+protected:
+  void initialize() {
+    thread_aware_lb_ = std::make_unique<PeakEwmaThreadAwareLoadBalancer>(
+        config_, *info_, priority_set_, runtime_, random_, simTime());
+    thread_aware_lb_->initialize();
+    lb_ = thread_aware_lb_->factory()->create({priority_set_, nullptr});
+  }
+
+  void addHosts(uint32_t num_hosts) {
+    Upstream::HostVector added;
+    for (uint32_t i = 0; i < num_hosts; ++i) {
+      added.push_back(Upstream::makeTestHost(
+          info_, fmt::format("tcp://127.0.0.1:{}", 80 + host_set_.hosts_.size()), simTime()));
+      host_set_.hosts_.push_back(added.back());
+    }
+    host_set_.healthy_hosts_ = host_set_.hosts_;
+    host_set_.runCallbacks(added, {});
+  }
+
+  void recordLatency(uint32_t host_index, std::chrono::milliseconds latency) {
+    host_set_.hosts_[host_index]->lbPolicyData()->onUpstreamRequestComplete(latency);
+  }
+
+  NiceMock<Runtime::MockLoader> runtime_;
+  NiceMock<Random::MockRandomGenerator> random_;
+  NiceMock<Upstream::MockPrioritySet> priority_set_;
+  Upstream::MockHostSet& host_set_ = *priority_set_.getMockHostSet(0);
+  std::shared_ptr<Upstream::MockClusterInfo> info_{new NiceMock<Upstream::MockClusterInfo>()};
+  PeakEwmaLbProto config_;
+  std::unique_ptr<PeakEwmaThreadAwareLoadBalancer> thread_aware_lb_;
+  Upstream::LoadBalancerPtr lb_;
+};
+
+TEST_F(PeakEwmaLoadBalancerTest, NoHosts) {
+  initialize();
+  EXPECT_EQ(nullptr, lb_->chooseHost(nullptr));
+  EXPECT_EQ(nullptr, lb_->peekAnotherHost(nullptr));
+}
+
+TEST_F(PeakEwmaLoadBalancerTest, AttachesLbPolicyDataToHosts) {
+  addHosts(2);
+  initialize();
+  for (const auto& host : host_set_.hosts_) {
+    EXPECT_NE(nullptr, dynamic_cast<PeakEwmaHostLbPolicyData*>(host->lbPolicyData().ptr()));
+  }
+
+  // Hosts added later get the data before they are used.
+  addHosts(1);
+  EXPECT_NE(nullptr,
+            dynamic_cast<PeakEwmaHostLbPolicyData*>(host_set_.hosts_[2]->lbPolicyData().ptr()));
+}
+
+TEST_F(PeakEwmaLoadBalancerTest, PicksLowerLatencyHost) {
+  addHosts(2);
+  initialize();
+  recordLatency(0, std::chrono::milliseconds(50));
+  recordLatency(1, std::chrono::milliseconds(10));
+
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(nullptr));
+
+  // A latency spike makes the host lose the comparison right away.
+  recordLatency(1, std::chrono::milliseconds(100));
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(nullptr));
+}
+
+TEST_F(PeakEwmaLoadBalancerTest, CostAccountsForActiveRequests) {
+  addHosts(2);
+  initialize();
+  recordLatency(0, std::chrono::milliseconds(10));
+  recordLatency(1, std::chrono::milliseconds(30));
+
+  // 10ms * (5 + 1) is costlier than 30ms * (0 + 1).
+  host_set_.hosts_[0]->stats().rq_active_.set(5);
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(host_set_.hosts_[1], lb_->chooseHost(nullptr));
+
+  // 10ms * (1 + 1) is cheaper.
+  host_set_.hosts_[0]->stats().rq_active_.set(1);
+  EXPECT_CALL(random_, random()).WillOnce(Return(0)).WillOnce(Return(0)).WillOnce(Return(1));
+  EXPECT_EQ(host_set_.hosts_[0], lb_->chooseHost(nullptr));
+}
+
+TEST_F(PeakEwmaLoadBalancerTest, ChoiceCount) {
+  config_.mutable_choice_count()->set_value(3);
+  addHosts(3);
+  initialize();
+  recordLatency(0, std::chrono::milliseconds(30));
+  recordLatency(1, std::chrono::milliseconds(20));
+  recordLatency(2, std::chrono::milliseconds(10));
+
+  EXPECT_CALL(random_, random())
+      .WillOnce(Return(0))
+      .WillOnce(Return(0))
+      .WillOnce(Return(1))
+      .WillOnce(Return(2));
+  EXPECT_EQ(host_set_.hosts_[2], lb_->chooseHost(nullptr));
+}
+
+} // namespace
+} // namespace PeakEwma
+} // namespace LoadBalancingPolices
+} // namespace Extensions
+} // namespace Envoy
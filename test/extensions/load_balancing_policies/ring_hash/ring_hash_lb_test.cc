@@ -19,6 +19,7 @@
 #include "test/mocks/upstream/load_balancer_context.h"
 #include "test/mocks/upstream/priority_set.h"
 #include "test/test_common/simulated_time_system.h"
+#include "test/test_common/test_runtime.h"
 
 #include "absl/container/node_hash_map.h"
 #include "absl/types/optional.h"
@@ -262,6 +263,45 @@ TEST_P(RingHashFailoverTest, BasicFailover) {
   EXPECT_EQ(failover_host_set_.healthy_hosts_[0], lb->chooseHost(nullptr));
 }
 
+// Ensure a host set update only rebuilds the ring of its own priority. The ring stats are those of
+// the most recently built ring, which tells which priorities were rebuilt.
+TEST_P(RingHashFailoverTest, OnlyUpdatedPriorityIsRebuilt) {
+  host_set_.hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", simTime()),
+                      makeTestHost(info_, "tcp://127.0.0.1:81", simTime())};
+  host_set_.healthy_hosts_ = host_set_.hosts_;
+  failover_host_set_.hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:82", simTime()),
+                               makeTestHost(info_, "tcp://127.0.0.1:83", simTime()),
+                               makeTestHost(info_, "tcp://127.0.0.1:84", simTime())};
+  failover_host_set_.healthy_hosts_ = failover_host_set_.hosts_;
+
+  config_ = envoy::config::cluster::v3::Cluster::RingHashLbConfig();
+  config_.value().mutable_minimum_ring_size()->set_value(12);
+  init();
+  EXPECT_EQ(4, lb_->stats().min_hashes_per_host_.value());
+
+  host_set_.runCallbacks({}, {});
+  EXPECT_EQ(6, lb_->stats().min_hashes_per_host_.value());
+  LoadBalancerPtr lb = lb_->factory()->create(lb_params_);
+  EXPECT_THAT(host_set_.hosts_, testing::Contains(lb->chooseHost(nullptr)));
+
+  failover_host_set_.runCallbacks({}, {});
+  EXPECT_EQ(4, lb_->stats().min_hashes_per_host_.value());
+  host_set_.runCallbacks({}, {});
+  EXPECT_EQ(6, lb_->stats().min_hashes_per_host_.value());
+
+  // The failover ring is still in use after being shared across updates.
+  host_set_.healthy_hosts_ = {};
+  host_set_.runCallbacks({}, {});
+  lb = lb_->factory()->create(lb_params_);
+  EXPECT_THAT(failover_host_set_.hosts_, testing::Contains(lb->chooseHost(nullptr)));
+
+  TestScopedRuntime scoped_runtime;
+  scoped_runtime.mergeValues(
+      {{"envoy.reloadable_features.thread_aware_lb_rebuild_updated_priority_only", "false"}});
+  host_set_.runCallbacks({}, {});
+  EXPECT_EQ(4, lb_->stats().min_hashes_per_host_.value());
+}
+
 // Expect reasonable results with Murmur2 hash.
 TEST_P(RingHashLoadBalancerTest, BasicWithMurmur2) {
   hostSet().hosts_ = {makeTestHost(info_, "tcp://127.0.0.1:80", simTime()),
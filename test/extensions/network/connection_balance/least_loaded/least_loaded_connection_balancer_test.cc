@@ -0,0 +1,202 @@
+#include "envoy/config/core/v3/extension.pb.h"
+#include "envoy/extensions/network/connection_balance/least_loaded/v3/least_loaded.pb.h"
+#include "envoy/registry/registry.h"
+
+#include "source/common/network/connection_balancer_impl.h"
+#include "source/common/stats/isolated_store_impl.h"
+#include "source/extensions/network/connection_balance/least_loaded/least_loaded_connection_balancer.h"
+
+#include "test/mocks/common.h"
+#include "test/mocks/server/factory_context.h"
+#include "test/test_common/utility.h"
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using testing::NiceMock;
+using testing::Return;
+
+namespace Envoy {
+namespace Extensions {
+namespace Network {
+namespace ConnectionBalance {
+namespace {
+
+class TestHandler : public Envoy::Network::BalancedConnectionHandler {
+public:
+  explicit TestHandler(uint64_t num_connections) : num_connections_(num_connections) {}
+
+  // Network::BalancedConnectionHandler
+  uint64_t numConnections() const override { return num_connections_; }
+  void incNumConnections() override { num_connections_++; }
+  void post(Envoy::Network::ConnectionSocketPtr&&) override {}
+  void onAcceptWorker(Envoy::Network::ConnectionSocketPtr&&, bool, bool) override {}
+
+  uint64_t num_connections_;
+};
+
+class LeastLoadedConnectionBalancerTest : public testing::Test {
+protected:
+  void initialize(uint32_t choice_count = 2, uint32_t imbalance_threshold = 1) {
+    LeastLoadedConfig config;
+    config.mutable_choice_count()->set_value(choice_count);
+    config.mutable_imbalance_threshold()->set_value(imbalance_threshold);
+    balancer_ =
+        std::make_unique<LeastLoadedConnectionBalancerImpl>(config, random_, *store_.rootScope());
+  }
+
+  uint64_t rebalanced() {
+    return TestUtility::findCounter(store_,
+                                    "connection_balance.least_loaded.connections_rebalanced")
+        ->value();
+  }
+  uint64_t skew() {
+    return TestUtility::findGauge(store_, "connection_balance.least_loaded.connection_skew")
+        ->value();
+  }
+
+  Stats::IsolatedStoreImpl store_;
+  NiceMock<Random::MockRandomGenerator> random_;
+  std::unique_ptr<LeastLoadedConnectionBalancerImpl> balancer_;
+};
+
+TEST_F(LeastLoadedConnectionBalancerTest, SingleHandlerKeepsConnections) {
+  initialize();
+  TestHandler handler(10);
+  balancer_->registerHandler(handler);
+
+  EXPECT_CALL(random_, random()).Times(0);
+  EXPECT_EQ(&handler, &balancer_->pickTargetHandler(handler));
+  EXPECT_EQ(11, handler.num_connections_);
+  EXPECT_EQ(0, rebalanced());
+}
+
+TEST_F(LeastLoadedConnectionBalancerTest, HandsOffToLessLoadedHandler) {
+  initialize();
+  TestHandler busy(10);
+  TestHandler idle(2);
+  balancer_->registerHandler(busy);
+  balancer_->registerHandler(idle);
+
+  EXPECT_CALL(random_, random()).WillOnce(Return(1)).WillOnce(Return(0));
+  EXPECT_EQ(&idle, &balancer_->pickTargetHandler(busy));
+  EXPECT_EQ(10, busy.num_connections_);
+  EXPECT_EQ(3, idle.num_connections_);
+  EXPECT_EQ(1, rebalanced());
+
+  // The skew is sampled on the first accepted connection.
+  EXPECT_EQ(7, skew());
+}
+
+TEST_F(LeastLoadedConnectionBalancerTest, PicksLeastLoadedOfSampledHandlers) {
+  initialize(3);
+  TestHandler current(10);
+  TestHandler less_loaded(5);
+  TestHandler least_loaded(1);
+  balancer_->registerHandler(current);
+  balancer_->registerHandler(less_loaded);
+  balancer_->registerHandler(least_loaded);
+
+  EXPECT_CALL(random_, random()).WillOnce(Return(1)).WillOnce(Return(2)).WillOnce(Return(1));
+  EXPECT_EQ(&least_loaded, &balancer_->pickTargetHandler(current));
+  EXPECT_EQ(2, least_loaded.num_connections_);
+}
+
+TEST_F(LeastLoadedConnectionBalancerTest, KeepsConnectionBelowImbalanceThreshold) {
+  initialize(1, 5);
+  TestHandler current(10);
+  TestHandler other(6);
+  balancer_->registerHandler(current);
+  balancer_->registerHandler(other);
+
+  EXPECT_CALL(random_, random()).WillRepeatedly(Return(1));
+  EXPECT_EQ(&current, &balancer_->pickTargetHandler(current));
+  EXPECT_EQ(11, current.num_connections_);
+  EXPECT_EQ(0, rebalanced());
+
+  other.num_connections_ = 5;
+  // current now has 11 connections.
+  EXPECT_EQ(&other, &balancer_->pickTargetHandler(current));
+  EXPECT_EQ(1, rebalanced());
+}
+
+TEST_F(LeastLoadedConnectionBalancerTest, UnregisteredHandlerIsNotPicked) {
+  initialize(1);
+  TestHandler current(10);
+  TestHandler removed(0);
+  balancer_->registerHandler(current);
+  balancer_->registerHandler(removed);
+  balancer_->unregisterHandler(removed);
+
+  EXPECT_CALL(random_, random()).Times(0);
+  EXPECT_EQ(&current, &balancer_->pickTargetHandler(current));
+
+  // Handlers registered later are targets.
+  TestHandler added(0);
+  balancer_->registerHandler(added);
+  EXPECT_CALL(random_, random()).WillOnce(Return(1));
+  EXPECT_EQ(&added, &balancer_->pickTargetHandler(current));
+}
+
+// Any number of handlers can be registered, and all of them are targets.
+TEST_F(LeastLoadedConnectionBalancerTest, AllRegisteredHandlersAreTargets) {
+  initialize(1);
+  std::vector<std::unique_ptr<TestHandler>> handlers;
+  for (uint32_t i = 0; i < 64; i++) {
+    handlers.push_back(std::make_unique<TestHandler>(10));
+    balancer_->registerHandler(*handlers.back());
+  }
+  handlers.back()->num_connections_ = 0;
+
+  EXPECT_CALL(random_, random()).WillOnce(Return(63));
+  EXPECT_EQ(handlers.back().get(), &balancer_->pickTargetHandler(*handlers.front()));
+  for (auto& handler : handlers) {
+    balancer_->unregisterHandler(*handler);
+  }
+}
+
+TEST_F(LeastLoadedConnectionBalancerTest, SkewIsUpdatedPeriodically) {
+  initialize(1);
+  TestHandler a(0);
+  TestHandler b(0);
+  balancer_->registerHandler(a);
+  balancer_->registerHandler(b);
+
+  // Sampling only a itself never hands off, so the skew grows with every accepted connection.
+  ON_CALL(random_, random()).WillByDefault(Return(0));
+  for (uint32_t i = 0; i < LeastLoadedConnectionBalancerImpl::SkewUpdateInterval; i++) {
+    balancer_->pickTargetHandler(a);
+  }
+  EXPECT_EQ(1, skew());
+  balancer_->pickTargetHandler(a);
+  EXPECT_EQ(LeastLoadedConnectionBalancerImpl::SkewUpdateInterval + 1, skew());
+}
+
+TEST(LeastLoadedConnectionBalanceFactoryTest, CreatesBalancerFromConfig) {
+  auto* factory = Registry::FactoryRegistry<Envoy::Network::ConnectionBalanceFactory>::getFactory(
+      "envoy.network.connection_balance.least_loaded");
+  ASSERT_NE(nullptr, factory);
+  EXPECT_NE(nullptr, dynamic_cast<LeastLoadedConfig*>(factory->createEmptyConfigProto().get()));
+
+  NiceMock<Server::Configuration::MockFactoryContext> context;
+  envoy::config::core::v3::TypedExtensionConfig typed_config;
+  typed_config.set_name("envoy.network.connection_balance.least_loaded");
+  LeastLoadedConfig config;
+  config.mutable_choice_count()->set_value(3);
+  typed_config.mutable_typed_config()->PackFrom(config);
+
+  Envoy::Network::ConnectionBalancerSharedPtr balancer =
+      factory->createConnectionBalancerFromProto(typed_config, context);
+  EXPECT_NE(nullptr, dynamic_cast<LeastLoadedConnectionBalancerImpl*>(balancer.get()));
+
+  config.mutable_choice_count()->set_value(0);
+  typed_config.mutable_typed_config()->PackFrom(config);
+  EXPECT_THROW(factory->createConnectionBalancerFromProto(typed_config, context),
+               ProtoValidationException);
+}
+
+} // namespace
+} // namespace ConnectionBalance
+} // namespace Network
+} // namespace Extensions
+} // namespace Envoy
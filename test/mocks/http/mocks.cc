@@ -51,6 +51,13 @@ MockFilterChainManager::MockFilterChainManager() {
   ON_CALL(*this, applyFilterFactoryCb(_, _))
       .WillByDefault(
           Invoke([this](FilterContext, FilterFactoryCb& factory) { factory(callbacks_); }));
+  // Shared contexts are applied like copies, so that expectations on applyFilterFactoryCb() hold
+  // for both.
+  ON_CALL(*this, applySharedFilterFactoryCb(_, _))
+      .WillByDefault(
+          Invoke([this](const FilterContext& context, FilterFactoryCb& factory) {
+            applyFilterFactoryCb(context, factory);
+          }));
 }
 
 MockFilterChainManager::~MockFilterChainManager() = default;
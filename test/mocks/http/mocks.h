@@ -191,6 +191,8 @@ public:
 
   // Http::FilterChainManager
   MOCK_METHOD(void, applyFilterFactoryCb, (FilterContext context, FilterFactoryCb& factory));
+  MOCK_METHOD(void, applySharedFilterFactoryCb,
+              (const FilterContext& context, FilterFactoryCb& factory));
 
   NiceMock<MockFilterChainFactoryCallbacks> callbacks_;
 };
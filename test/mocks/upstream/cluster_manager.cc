@@ -26,6 +26,13 @@ MockClusterManager::MockClusterManager()
   ON_CALL(*this, grpcAsyncClientManager()).WillByDefault(ReturnRef(async_client_manager_));
   ON_CALL(*this, localClusterName()).WillByDefault((ReturnRef(local_cluster_name_)));
   ON_CALL(*this, subscriptionFactory()).WillByDefault(ReturnRef(subscription_factory_));
+  ON_CALL(*this, configIngestionConcurrency()).WillByDefault(Return(1));
+  ON_CALL(*this, configIngestionParallelFor(_, _))
+      .WillByDefault(Invoke([](size_t count, const std::function<void(size_t)>& fn) {
+        for (size_t i = 0; i < count; ++i) {
+          fn(i);
+        }
+      }));
   ON_CALL(*this, allocateOdCdsApi(_, _, _))
       .WillByDefault(Invoke([](const envoy::config::core::v3::ConfigSource&,
                                OptRef<xds::core::v3::ResourceLocator>,
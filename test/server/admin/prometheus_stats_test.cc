@@ -178,6 +178,29 @@ TEST_F(PrometheusStatsFormatterTest, CustomNamespaceWithInvalidPromnamespace) {
   EXPECT_FALSE(actual.has_value());
 }
 
+TEST_F(PrometheusStatsFormatterTest, MetricNameCache) {
+  Stats::CustomStatNamespacesImpl custom_namespaces;
+  custom_namespaces.registerStatNamespace("promstattest");
+  PrometheusMetricNameCache cache(*symbol_table_);
+
+  EXPECT_EQ("envoy_vulture_eats_liver",
+            cache.metricName(makeStat("vulture.eats-liver"), custom_namespaces).value());
+  EXPECT_FALSE(
+      cache.metricName(makeStat("promstattest.1234abcd.eats-liver"), custom_namespaces)
+          .has_value());
+  EXPECT_EQ(2, cache.size());
+
+  // The cache holds its own copy of each name, so entries outlive the stat names that were
+  // used to look them up.
+  pool_.clear();
+  EXPECT_EQ("envoy_vulture_eats_liver",
+            cache.metricName(makeStat("vulture.eats-liver"), custom_namespaces).value());
+  EXPECT_EQ(2, cache.size());
+
+  cache.clear();
+  EXPECT_EQ(0, cache.size());
+}
+
 TEST_F(PrometheusStatsFormatterTest, FormattedTags) {
   std::vector<Stats::Tag> tags;
   Stats::Tag tag1 = {"a.tag-name", "a.tag-value"};
@@ -5,6 +5,7 @@
 #include "source/common/http/header_map_impl.h"
 #include "source/common/stats/custom_stat_namespaces_impl.h"
 #include "source/common/stats/thread_local_store.h"
+#include "source/server/admin/prometheus_stats.h"
 #include "source/server/admin/stats_handler.h"
 
 #include "test/benchmark/main.h"
@@ -181,12 +182,31 @@ public:
       return data.length();
     }
     Admin::RequestPtr request = StatsHandler::makeRequest(*store_, params, cm_);
+    return streamRequest(*request);
+  }
+
+  /**
+   * Issues a streaming Prometheus request against the stats saved in store_,
+   * reusing the metric family names cached by previous requests.
+   */
+  uint64_t handlerPrometheusStreaming(const StatsParams& params) {
+    PrometheusStatsRequest request(*store_, params, cm_, custom_namespaces_, name_cache_);
+    return streamRequest(request);
+  }
+
+  /**
+   * Runs a request to completion, draining each chunk.
+   *
+   * @return the total size of the response.
+   */
+  static uint64_t streamRequest(Admin::Request& request) {
+    Buffer::OwnedImpl data;
     auto response_headers = Http::ResponseHeaderMapImpl::create();
-    request->start(*response_headers);
+    request.start(*response_headers);
     uint64_t count = 0;
     bool more = true;
     do {
-      more = request->nextChunk(data);
+      more = request.nextChunk(data);
       count += data.length();
       data.drain(data.length());
     } while (more);
@@ -196,6 +216,7 @@ public:
   std::vector<Stats::ScopeSharedPtr> scopes_;
   Envoy::Stats::CustomStatNamespacesImpl custom_namespaces_;
   FastMockClusterManager cm_;
+  PrometheusMetricNameCache name_cache_{store_->symbolTable()};
 };
 
 } // namespace Server
@@ -407,6 +428,50 @@ BENCHMARK_CAPTURE(BM_FilteredCountersPrometheus, per_endpoint_stats_disabled, fa
 BENCHMARK_CAPTURE(BM_FilteredCountersPrometheus, per_endpoint_stats_enabled, true)
     ->Unit(benchmark::kMillisecond);
 
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_AllCountersPrometheusStreaming(benchmark::State& state, bool per_endpoint_stats) {
+  Envoy::Server::StatsHandlerTest& test_context = testContext(per_endpoint_stats);
+  Envoy::Server::StatsParams params;
+  Envoy::Buffer::OwnedImpl response;
+  params.parse("?format=prometheus&type=Counters", response);
+
+  uint64_t count;
+  for (auto _ : state) { // NOLINT
+    count = test_context.handlerPrometheusStreaming(params);
+    RELEASE_ASSERT(count > 250 * 1000 * 1000, "expected count > 250M");
+  }
+
+  auto label = absl::StrCat("output per iteration: ", count);
+  state.SetLabel(label);
+}
+BENCHMARK_CAPTURE(BM_AllCountersPrometheusStreaming, per_endpoint_stats_disabled, false)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_AllCountersPrometheusStreaming, per_endpoint_stats_enabled, true)
+    ->Unit(benchmark::kMillisecond);
+
+// NOLINTNEXTLINE(readability-identifier-naming)
+static void BM_UsedCountersPrometheusStreaming(benchmark::State& state, bool per_endpoint_stats) {
+  Envoy::Server::StatsHandlerTest& test_context = testContext(per_endpoint_stats);
+  Envoy::Server::StatsParams params;
+  Envoy::Buffer::OwnedImpl response;
+  params.parse("?format=prometheus&usedonly&type=Counters", response);
+
+  const uint64_t upper_limit = per_endpoint_stats ? 200 * 1000 * 1000 : 3 * 1000 * 1000;
+  uint64_t count;
+  for (auto _ : state) { // NOLINT
+    count = test_context.handlerPrometheusStreaming(params);
+    RELEASE_ASSERT(count > 1000 * 1000, "expected count > 1M");
+    RELEASE_ASSERT(count < upper_limit, "expected count < upper_limit");
+  }
+
+  auto label = absl::StrCat("output per iteration: ", count);
+  state.SetLabel(label);
+}
+BENCHMARK_CAPTURE(BM_UsedCountersPrometheusStreaming, per_endpoint_stats_disabled, false)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_UsedCountersPrometheusStreaming, per_endpoint_stats_enabled, true)
+    ->Unit(benchmark::kMillisecond);
+
 // NOLINTNEXTLINE(readability-identifier-naming)
 static void BM_HistogramsJson(benchmark::State& state) {
   Envoy::Server::StatsHandlerTest& test_context = testContext(false);
@@ -4,6 +4,7 @@
 #include "source/common/common/regex.h"
 #include "source/common/stats/custom_stat_namespaces_impl.h"
 #include "source/common/stats/thread_local_store.h"
+#include "source/server/admin/prometheus_stats.h"
 #include "source/server/admin/stats_handler.h"
 #include "source/server/admin/stats_request.h"
 
@@ -76,9 +77,10 @@ public:
    * Issues an admin request against the stats saved in store_.
    *
    * @param url the admin endpoint to query.
+   * @param prometheus_endpoint whether to handle the request as /stats/prometheus.
    * @return the Http Code and the response body as a string.
    */
-  CodeResponse handlerStats(absl::string_view url) {
+  CodeResponse handlerStats(absl::string_view url, bool prometheus_endpoint = false) {
     NiceMock<MockInstance> instance;
     EXPECT_CALL(admin_stream_, getRequestHeaders()).WillRepeatedly(ReturnRef(request_headers_));
     EXPECT_CALL(instance, statsConfig()).WillRepeatedly(ReturnRef(stats_config_));
@@ -89,7 +91,8 @@ public:
     EXPECT_CALL(api_, customStatNamespaces()).WillRepeatedly(ReturnRef(custom_namespaces_));
     StatsHandler handler(instance);
     request_headers_.setPath(url);
-    Admin::RequestPtr request = handler.makeRequest(admin_stream_);
+    Admin::RequestPtr request = prometheus_endpoint ? handler.makePrometheusRequest(admin_stream_)
+                                                    : handler.makeRequest(admin_stream_);
     Http::TestResponseHeaderMapImpl response_headers;
     Http::Code code = request->start(response_headers);
     Buffer::OwnedImpl data;
@@ -1413,6 +1416,57 @@ TEST_F(StatsHandlerPrometheusDefaultTest, StatsHandlerPrometheusInvalidRegex) {
   EXPECT_THAT(code_response.second, HasSubstr("Invalid re2 regex"));
 }
 
+TEST_F(StatsHandlerPrometheusDefaultTest, PrometheusEndpointIgnoresFormat) {
+  createTestStats();
+
+  const CodeResponse code_response = handlerStats("/stats/prometheus?format=json", true);
+  EXPECT_EQ(Http::Code::OK, code_response.first);
+  EXPECT_EQ(handlerStats("/stats?format=prometheus").second, code_response.second);
+}
+
+TEST_F(StatsHandlerPrometheusDefaultTest, StreamedOutputMatchesBuffered) {
+  createTestStats();
+  for (uint32_t i = 0; i < 10; ++i) {
+    store_->rootScope()->counterFromString(absl::StrCat("counter_", i)).add(i);
+    store_->rootScope()->histogramFromString(absl::StrCat("histogram_", i),
+                                             Stats::Histogram::Unit::Unspecified);
+  }
+
+  StatsParams params;
+  Buffer::OwnedImpl parse_response;
+  ASSERT_EQ(Http::Code::OK, params.parse("/stats/prometheus?text_readouts", parse_response));
+  Buffer::OwnedImpl buffered;
+  StatsHandler::prometheusRender(*store_, custom_namespaces_, endpoints_helper_.cm_, params,
+                                 buffered);
+
+  PrometheusMetricNameCache name_cache(symbol_table_);
+  uint64_t cached_names = 0;
+  for (uint64_t chunk_size : {1, 100, 1000 * 1000}) {
+    PrometheusStatsRequest request(*store_, params, endpoints_helper_.cm_, custom_namespaces_,
+                                   name_cache);
+    request.setChunkSize(chunk_size);
+    Http::TestResponseHeaderMapImpl response_headers;
+    EXPECT_EQ(Http::Code::OK, request.start(response_headers));
+    Buffer::OwnedImpl data;
+    uint32_t num_chunks = 1;
+    while (request.nextChunk(data)) {
+      ++num_chunks;
+    }
+    EXPECT_EQ(buffered.toString(), data.toString()) << chunk_size;
+    if (chunk_size == 1) {
+      // With a tiny chunk size, each chunk holds a single stat.
+      EXPECT_LT(20, num_chunks);
+    }
+
+    // The family names are all resolved by the first request, and reused after that.
+    if (cached_names == 0) {
+      cached_names = name_cache.size();
+      EXPECT_LE(23, cached_names);
+    }
+    EXPECT_EQ(cached_names, name_cache.size());
+  }
+}
+
 class StatsHandlerPrometheusWithTextReadoutsTest
     : public StatsHandlerPrometheusTest,
       public testing::TestWithParam<std::tuple<Network::Address::IpVersion, std::string>> {};
@@ -1,5 +1,6 @@
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "envoy/stats/sink.h"
 #include "envoy/stats/stats.h"
@@ -8,7 +9,9 @@
 #include "source/server/server.h"
 
 #include "test/benchmark/main.h"
+#include "test/mocks/event/mocks.h"
 #include "test/mocks/stats/mocks.h"
+#include "test/mocks/thread_local/mocks.h"
 #include "test/mocks/upstream/cluster_manager.h"
 #include "test/test_common/simulated_time_system.h"
 #include "test/test_common/utility.h"
@@ -118,10 +121,74 @@ static void bmFlushToSinksWithPredicatesSet(::benchmark::State& state) {
   speed_test.test(state);
 }
 
+// Measures merging histograms at flush time when only some of them were recorded during the
+// interval, which is typical of stores with many histograms.
+class HistogramMergeSpeedTest {
+public:
+  HistogramMergeSpeedTest(size_t num_histograms, size_t num_recorded)
+      : num_recorded_(num_recorded), stats_allocator_(symbol_table_),
+        stats_store_(stats_allocator_) {
+    stats_store_.initializeThreading(dispatcher_, tls_);
+    for (uint64_t idx = 0; idx < num_histograms; ++idx) {
+      Stats::Histogram& histogram = stats_store_.histogramFromString(
+          absl::StrCat("histogram.", idx), Stats::Histogram::Unit::Unspecified);
+      histogram.recordValue(idx);
+      histograms_.push_back(&histogram);
+    }
+    // Merge once, so that every histogram has been used and takes part in later merges.
+    stats_store_.mergeHistograms([]() -> void {});
+  }
+
+  ~HistogramMergeSpeedTest() {
+    tls_.shutdownGlobalThreading();
+    stats_store_.shutdownThreading();
+    tls_.shutdownThread();
+  }
+
+  void test(::benchmark::State& state) {
+    for (auto _ : state) {
+      UNREFERENCED_PARAMETER(_);
+      for (size_t idx = 0; idx < num_recorded_; ++idx) {
+        histograms_[idx]->recordValue(idx);
+      }
+      stats_store_.mergeHistograms([]() -> void {});
+    }
+  }
+
+private:
+  const size_t num_recorded_;
+  Stats::SymbolTableImpl symbol_table_;
+  testing::NiceMock<Event::MockDispatcher> dispatcher_;
+  testing::NiceMock<ThreadLocal::MockInstance> tls_;
+  Stats::AllocatorImpl stats_allocator_;
+  Stats::ThreadLocalStoreImpl stats_store_;
+  std::vector<Stats::Histogram*> histograms_;
+};
+
+// Args: number of histograms, and the percentage of them recorded in each interval.
+static void bmMergeHistograms(::benchmark::State& state) {
+  // Skip expensive benchmarks for unit tests.
+  if (benchmark::skipExpensiveBenchmarks() && state.range(0) > 100) {
+    state.SkipWithError("Skipping expensive benchmark");
+    return;
+  }
+
+  HistogramMergeSpeedTest speed_test(state.range(0), state.range(0) * state.range(1) / 100);
+  speed_test.test(state);
+}
+
 BENCHMARK(bmFlushToSinks)->Unit(::benchmark::kMillisecond)->RangeMultiplier(10)->Range(10, 1000000);
 BENCHMARK(bmFlushToSinksWithPredicatesSet)
     ->Unit(::benchmark::kMillisecond)
     ->RangeMultiplier(10)
     ->Range(10, 1000000);
+BENCHMARK(bmMergeHistograms)
+    ->Unit(::benchmark::kMillisecond)
+    ->Args({100, 0})
+    ->Args({100, 10})
+    ->Args({100, 100})
+    ->Args({50000, 0})
+    ->Args({50000, 10})
+    ->Args({50000, 100});
 
 } // namespace Envoy